@@ -0,0 +1,46 @@
+/****** Bench_PM_Library.cc ******************************
+*          Author: Daniel Mendez
+*            Date: 11/01/2022
+*         Purpose: Driver code to benchmark Pauli Matrix Library kernels. 
+* Compile Command: g++  -O3  -DNDEBUG  -std=gnu++17  -Wall  -Werror  Bench_PM_Library.cc  Pauli_Matrix_Library.cc -o  Bench_PM_Library
+*     Run Command: ./Bench_PM_Library
+*************************************/
+#include "Pauli_Matrix_Library.h"
+
+
+int main(void) {
+
+    cout << "*************************** Benchmark 1: Complex Matrix Multiplication ***************************" << endl;
+    const vector<size_t> matmul_side_lengths = {64, 256, 1024};
+    const unsigned short int matmul_num_of_repeats = 3;
+    const string instruction_sets[] = {"scalar", "avx2", "avx512"};
+    for ( const string &instruction_set : instruction_sets ) {
+        if ( SetSimdInstructionSet(instruction_set) ) {
+            BenchmarkMatrixMultiply(matmul_side_lengths, matmul_num_of_repeats, INTERLEAVED_LAYOUT);
+            BenchmarkMatrixMultiply(matmul_side_lengths, matmul_num_of_repeats, SPLIT_LAYOUT);
+        }
+    }
+
+    cout << "*************************** Benchmark 2: Fused Matrix Expressions ***************************" << endl;
+    BenchmarkMatrixExpressions({256, 1024, 4096}, 3);
+
+    cout << "*************************** Benchmark 3: Kronecker Products ***************************" << endl;
+    BenchmarkKroneckerProduct({8, 10, 12}, 3);
+
+    cout << "*************************** Benchmark 4: Factored Kronecker Operators ***************************" << endl;
+    BenchmarkKroneckerOperator({8, 10, 12}, 3);
+
+    cout << "*************************** Benchmark 5: Fused Matrix Reductions ***************************" << endl;
+    BenchmarkMatrixReductions({256, 1024, 2048}, 3);
+
+    cout << "*************************** Benchmark 6: Large Matrix Storage ***************************" << endl;
+    BenchmarkLargeMatrixStorage(8192, 3);
+
+    cout << "*************************** Benchmark 7: Scalar Types ***************************" << endl;
+    BenchmarkDenseMatrices({256, 1024}, 3, 10);
+
+    cout << "*************************** Benchmark 8: Matrix Allocators ***************************" << endl;
+    BenchmarkMatrixAllocators({2, 4, 6}, 10000);
+
+    return 0;
+}
@@ -4,1439 +4,9462 @@
 *         Purpose: Definition of Pauli Matrix functions. 
 *************************************/
 #include "Pauli_Matrix_Library.h"
-
-CMatrix::CMatrix()
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// x86 builds with GCC or Clang compile AVX2 and AVX-512 kernels next to the scalar ones and pick one at run time.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PML_X86_DISPATCH
+#include <immintrin.h>
+#endif
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <limits>
+// Large aligned allocations ask Linux for transparent huge pages.
+#if defined(__linux__)
+#include <sys/mman.h>
+#if defined(MADV_HUGEPAGE)
+#define PML_HUGE_PAGE_ADVICE
+#endif
+#endif
+
+
+#if defined(PML_COUNT_ALLOCATIONS)
+static atomic<size_t> g_iNumOfAllocations(0);
+
+
+void *operator new(size_t inSize)
 /********************************************
- *       Purpose: Default Square Matrix Constructor 
- *                intializes a 2 x 2 matrix with all 0 entries.                  
- *  Precondition: N/A
- * Postcondition: N/A
- *          Note: N/A
+ *       Purpose: Global operator new that counts every allocation for GetNumOfAllocations().
+ *  Precondition: Only compiled with PML_COUNT_ALLOCATIONS.
+ * Postcondition: Throws bad_alloc when out of memory, like the default.
+ *          Note: The default array and nothrow forms call this one.
 ********************************************/ 
 {
-    m_iRowSize = 2;
-    m_iColSize = 2;
-
-    unsigned short int num_of_entries = m_iRowSize * m_iColSize;
-    m_vecMatrix = vector<complex<float> >(num_of_entries, complex<float>(0, 0));
+    g_iNumOfAllocations++;
+    void *m_pMemory = malloc(inSize == 0 ? 1 : inSize);
+    if ( m_pMemory == NULL )
+        throw bad_alloc();
+    return m_pMemory;
 }
 
 
-CMatrix::CMatrix(string inPauliID) : CMatrix()
+// GCC sees free() on memory from operator new, which is exactly what this replacement pair does.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *inMemory) noexcept
 /********************************************
- *       Purpose: Initialize a 2 x 2 Pauli Matrix.        
- *  Precondition: N/A
+ *       Purpose: Global operator delete matching the counting operator new.
+ *  Precondition: Only compiled with PML_COUNT_ALLOCATIONS.
  * Postcondition: N/A
- *          Note: N/A
 ********************************************/ 
 {
-    if (!inPauliID.compare("X") || !inPauliID.compare("x")) {         
-        // Row 1
-        m_vecMatrix.at(0) = complex<float>(0, 0);
-        m_vecMatrix.at(1) = complex<float>(1, 0);
+    free(inMemory);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
 
-        // Row 2
-        m_vecMatrix.at(2) = complex<float>(1, 0);
-        m_vecMatrix.at(3) = complex<float>(0, 0);
-        // cout << matrix.size() << endl;
 
-    }
-    else if (!inPauliID.compare("Y") || !inPauliID.compare("y")) {     
-        // Row 1
-        m_vecMatrix.at(0) = complex<float>(0, 0);
-        m_vecMatrix.at(1) = complex<float>(0, -1);
+void *operator new(size_t inSize, align_val_t inAlignment)
+/********************************************
+ *       Purpose: Global operator new for over-aligned types, such as containers of CMatrix, whose inline 
+ *                entries start on a 64 byte boundary. Counted through AllocateAligned().
+ *  Precondition: Only compiled with PML_COUNT_ALLOCATIONS.
+ * Postcondition: Throws bad_alloc when out of memory, like the default.
+ *          Note: The default array, nothrow and sized forms call this one or the matching operator delete.
+********************************************/ 
+{
+    return AllocateAligned(inSize == 0 ? 1 : inSize, max(size_t(inAlignment), sizeof(void *)));
+}
 
-        // Row 2
-        m_vecMatrix.at(2) = complex<float>(0, 1);
-        m_vecMatrix.at(3) = complex<float>(0, 0);
-    }
-    else if (!inPauliID.compare("Z") || !inPauliID.compare("z")) {
-        // Row 1
-        m_vecMatrix.at(0) = complex<float>(1, 0);
-        m_vecMatrix.at(1) = complex<float>(0, 0);
 
-        // Row 2
-        m_vecMatrix.at(2) = complex<float>(0, 0);
-        m_vecMatrix.at(3) = complex<float>(-1, 0);
-    }
-    // Identity Matrix
-    else {
-        // Row 1
-        m_vecMatrix.at(0) = complex<float>(1, 0);
-        m_vecMatrix.at(1) = complex<float>(0, 0);
+void operator delete(void *inMemory, align_val_t) noexcept
+/********************************************
+ *       Purpose: Global operator delete matching the counting over-aligned operator new.
+ *  Precondition: Only compiled with PML_COUNT_ALLOCATIONS.
+ * Postcondition: N/A
+********************************************/ 
+{
+    FreeAligned(inMemory);
+}
+#endif
 
-        // Row 2
-        m_vecMatrix.at(2) = complex<float>(0, 0);
-        m_vecMatrix.at(3) = complex<float>(1, 0);
-    }
 
+void RecordAllocation()
+/********************************************
+ *       Purpose: Count one allocation that does not go through operator new, such as CAlignedAllocator.
+ *  Precondition: N/A
+ * Postcondition: Does nothing unless compiled with PML_COUNT_ALLOCATIONS.
+********************************************/ 
+{
+#if defined(PML_COUNT_ALLOCATIONS)
+    g_iNumOfAllocations++;
+#endif
 }
 
 
-CMatrix::CMatrix(unsigned short int inRowSize, unsigned short int inColSize)
+size_t GetNumOfAllocations()
 /********************************************
- *       Purpose: Square Matrix constructor initializes a 
- *                size_of_row  x  size_of_col  matrix with all 0 entries.                
+ *       Purpose: Return the number of heap allocations made so far.
  *  Precondition: N/A
- * Postcondition: N/A
- *          Note: N/A
- *          TODO: Add support for non square matrices.
+ * Postcondition: Always 0 unless compiled with PML_COUNT_ALLOCATIONS.
 ********************************************/ 
 {
+#if defined(PML_COUNT_ALLOCATIONS)
+    return g_iNumOfAllocations;
+#else
+    return 0;
+#endif
+}
 
-    // This guarantees a square matrix.
-    if ( inRowSize != inColSize ) {
-        cout << "ERROR: Please provide n * n dimensions for the square matrix." << "Non Square matrix support will be added later." << '\n' 
-             << "Error caught in Matrix(size_of_row, size_of_col) contructor. " << '\n'
-             << "EXITING PROGRAM. . ." << endl;
-        exit(1);
-    }
-    else {
-        m_iRowSize = inRowSize;
-        m_iColSize = inColSize;
-
-        // Intialize matrix to all 0's
-        unsigned short int m_iNumOfEntries = m_iRowSize * m_iColSize;
-        m_vecMatrix = vector<complex<float> >(m_iNumOfEntries, complex<float>(0, 0));
-    }
 
+static atomic<bool> &HugePagesFlag()
+/********************************************
+ *       Purpose: Return whether large allocations ask for huge pages. Read from the 
+ *                PML_HUGE_PAGES environment variable on first use, where 0 turns them off.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    static atomic<bool> m_bIsEnabled(getenv("PML_HUGE_PAGES") == NULL || strtoul(getenv("PML_HUGE_PAGES"), NULL, 10) != 0);
+    return m_bIsEnabled;
 }
 
-CMatrix::CMatrix(const CMatrix &inMatrix2)
+
+bool GetHugePages()
 /********************************************
- *       Purpose: Copy Constructor.                
+ *       Purpose: Return whether allocations of at least HUGE_PAGE_SIZE bytes ask for huge pages.
  *  Precondition: N/A
  * Postcondition: N/A
- *          Note: N/A
- *          TODO: N/A
 ********************************************/ 
 {
-    m_iRowSize = inMatrix2.GetRowSize();
-    m_iColSize = inMatrix2.GetColSize();
-    m_vecMatrix = inMatrix2.GetMatrix();
+    return HugePagesFlag();
 }
 
 
-void CMatrix::PrintMatrix() const 
+void SetHugePages(const bool inIsEnabled)
 /********************************************
- *       Purpose: Print all entries of the matrix data member.
+ *       Purpose: Turn huge pages for allocations of at least HUGE_PAGE_SIZE bytes on or off.
  *  Precondition: N/A
- * Postcondition: Must NOT modify any data members of Matrix Object.
- *          Note: N/A
- *          TODO: 
+ * Postcondition: Overrides the PML_HUGE_PAGES environment variable. Storage that is already allocated keeps its pages.
 ********************************************/ 
 {
-    for ( unsigned short int r = 0; r < m_iRowSize; r++ ) {
-        for ( unsigned short int c = 0; c < m_iColSize; c++ ) {
-            cout << GetValueAt(r, c) << " ";
-        }
-        cout << "\n" << endl;
-    }
+    HugePagesFlag() = inIsEnabled;
 }
 
 
-complex<float> CMatrix::GetValueAt(const unsigned short int inRowIndex,  const unsigned short int inColIndex) const
+void *AllocateAligned(const size_t inNumOfBytes, const size_t inAlignment)
 /********************************************
- *       Purpose: Get 2D matrix index for a 1D vector
- *                The 1D vector acts as a 2D matrix.
- *  Precondition: N/A
- * Postcondition: Must NOT modify any data members of Matrix Object.
- *          Note: N/A
- *          TODO: N/A
+ *       Purpose: Return inNumOfBytes bytes starting on an inAlignment byte boundary. With huge pages on, 
+ *                allocations of at least HUGE_PAGE_SIZE bytes start on a HUGE_PAGE_SIZE boundary instead, 
+ *                and on Linux the kernel is advised to back them with transparent huge pages.
+ *  Precondition: inAlignment is a power of 2 and a multiple of sizeof(void *). Free with FreeAligned().
+ * Postcondition: Throws bad_alloc when out of memory. 
+ *          Note: The advice is only a hint. Without transparent huge pages the storage uses normal pages.
 ********************************************/ 
 {
-    unsigned short int m_iOneDIndex = inRowIndex * m_iColSize + inColIndex;
-    try {
-        return m_vecMatrix.at(m_iOneDIndex);
-    }
-    catch(const std::out_of_range& oor) {
-        cerr << "Out of Range error: " << oor.what() << '\n' 
-             << "Error caught in GetValueAt() method. Likely because you are trying to access " << m_iRowSize * m_iColSize << " entries in a for loop, when there are only " << m_vecMatrix.size() << " entries." << '\n' 
-             << "EXITING PROGRAM . . ." << '\n';
-        exit(1);
-    }
+    RecordAllocation();
+    const bool m_bIsHuge = inNumOfBytes >= HUGE_PAGE_SIZE && GetHugePages();
+    const size_t m_iAlignment = m_bIsHuge ? max(inAlignment, HUGE_PAGE_SIZE) : inAlignment;
+    void *m_pMemory = NULL;
+#if defined(_MSC_VER)
+    m_pMemory = _aligned_malloc(inNumOfBytes, m_iAlignment);
+#else
+    if ( posix_memalign(&m_pMemory, m_iAlignment, inNumOfBytes) != 0 )
+        m_pMemory = NULL;
+#endif
+    if ( m_pMemory == NULL )
+        throw bad_alloc();
+#if defined(PML_HUGE_PAGE_ADVICE)
+    if ( m_bIsHuge )
+        madvise(m_pMemory, inNumOfBytes, MADV_HUGEPAGE);
+#endif
+    return m_pMemory;
 }
 
 
-void CMatrix::ModifyValueAt(const unsigned short int inRowIndex,  const unsigned short int inColIndex, const complex<float> inVal)
+void FreeAligned(void *inMemory)
 /********************************************
- *       Purpose: Modify Value at index of 1D vector.
+ *       Purpose: Free storage from AllocateAligned().
  *  Precondition: N/A
  * Postcondition: N/A
- *          Note: N/A
- *          TODO: N/A
 ********************************************/ 
 {
-    unsigned short int m_iOneDIndex = inRowIndex * m_iColSize + inColIndex;
-    try {
-        m_vecMatrix.at(m_iOneDIndex) = inVal;
-    }
-    catch(const std::out_of_range& oor) {
-        cerr << "Out of Range error: " << oor.what() << '\n' 
-             << "Error caught in ModifyValueAt() method. Likely because you are trying to access " << inRowIndex * inColIndex << " entries in a for loop, when there are only " << m_vecMatrix.size() << " entries." << '\n' 
-             << "EXITING PROGRAM . . ." << '\n';
-        exit(1);
-    }
+#if defined(_MSC_VER)
+    _aligned_free(inMemory);
+#else
+    free(inMemory);
+#endif
 }
 
 
-CPauliMatrix::CPauliMatrix() : CMatrix("I")
+// Matrix allocator that takes storage straight from AllocateAligned(), as every CMatrix did before allocators.
+class CDefaultMatrixAllocator : public CMatrixAllocator {
+public:
+    void *Allocate(const size_t inNumOfBytes, const size_t inAlignment) override { return AllocateAligned(inNumOfBytes, inAlignment); }
+    void Deallocate(void *inMemory, const size_t) override { FreeAligned(inMemory); }
+};
+static thread_local CMatrixAllocator *t_pMatrixAllocator = NULL;
+
+
+CMatrixAllocator *GetDefaultMatrixAllocator()
 /********************************************
- *       Purpose: Default Pauli Constructor creates the Pauli I matrix.                  
+ *       Purpose: Return the allocator that takes CMatrix storage straight from AllocateAligned().
  *  Precondition: N/A
- * Postcondition: N/A
- *          Note: N/A
+ * Postcondition: The allocator is never destroyed, so static matrices can give storage back to it at exit. 
+ *                It may be used from any thread.
 ********************************************/ 
 {
-    m_cxPauliFactor = complex<float>(1, 0);
-    m_sPauliString = "I";
+    alignas(CDefaultMatrixAllocator) static unsigned char m_arrStorage[sizeof(CDefaultMatrixAllocator)];
+    static CMatrixAllocator *const m_pAllocator = new (m_arrStorage) CDefaultMatrixAllocator();
+    return m_pAllocator;
 }
 
 
-CPauliMatrix::CPauliMatrix(string inPauliID) : CMatrix(inPauliID)
+CMatrixAllocator *GetMatrixAllocator()
 /********************************************
- *       Purpose: Constructor creates Pauli matrix according to 
- *                input pauli_id. Invalid string, will give Identity 
- *                matrix by default.
+ *       Purpose: Return the allocator that CMatrix storage made on the calling thread comes from.
  *  Precondition: N/A
- * Postcondition: N/A
- *          Note: N/A
+ * Postcondition: The default allocator unless a CMatrixAllocatorScope is open on the calling thread.
 ********************************************/ 
 {
-    m_cxPauliFactor = complex<float>(1, 0);
-
-    // TODO: Refactor. Ignore letter case sensitivity.
-    if (!inPauliID.compare("I") || !inPauliID.compare("i"))
-        m_sPauliString = "I";
+    return t_pMatrixAllocator != NULL ? t_pMatrixAllocator : GetDefaultMatrixAllocator();
+}
 
-    else if (!inPauliID.compare("X") || !inPauliID.compare("x"))
-        m_sPauliString = "X";
-    
-    else if ( !inPauliID.compare("Y") || !inPauliID.compare("y") ) 
-        m_sPauliString = "Y";
-    
-    else if ( !inPauliID.compare("Z") || !inPauliID.compare("z") ) 
-        m_sPauliString = "Z";
 
-    else {
-        cout << "CPauliMatrix(string inPauliID) failed because pauli ID is not valid. Use one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
-        cout << "Exiting Program . . . " << endl;
-        exit(1);
-    }
+CMatrixAllocatorScope::CMatrixAllocatorScope(CMatrixAllocator &ioAllocator)
+/********************************************
+ *       Purpose: Make ioAllocator the matrix allocator of the calling thread.
+ *  Precondition: ioAllocator outlives every CMatrix storage it hands out.
+ * Postcondition: Scopes nest. Worker threads of ParallelFor() keep their own allocator.
+********************************************/ 
+{
+    m_pPreviousAllocator = t_pMatrixAllocator;
+    t_pMatrixAllocator = &ioAllocator;
 }
 
 
-CPauliMatrix::CPauliMatrix(unsigned short int inRowSize, unsigned short int inColSize) : CMatrix(inRowSize, inColSize)
+CMatrixAllocatorScope::~CMatrixAllocatorScope()
 /********************************************
- *       Purpose: Square Matrix constructor initializes a 
- *                row_size  x  col_size  matrix with all 0 entries.
- *                This constructor does not produce a Pauli Matrix, 
- *                but is essential to the PauliAlgebraElement class.
- *  Precondition: N/A
- * Postcondition: All entries are initialized to 0.
- *          Note: N/A
+ *       Purpose: Restore the matrix allocator the calling thread had before the scope.
+ *  Precondition: Scopes end in the reverse order they were opened, on the thread that opened them.
+ * Postcondition: N/A
 ********************************************/ 
 {
-    m_cxPauliFactor = complex<float>(1, 0);
-    m_sPauliString = "";
+    t_pMatrixAllocator = m_pPreviousAllocator;
 }
 
 
-string CPauliMatrix::PauliToString() const
+static void RecordBytesInUse(CAllocatorStatistics &ioStatistics, const size_t inNumOfBytesInUse)
 /********************************************
- *       Purpose: Returns Pauli String representation.
- *                For Example, -iY returns "-iY". 
- *                For Example,  XY returns  "iZ".
+ *       Purpose: Set the bytes in use of an allocator and raise its high-water mark to match.
  *  Precondition: N/A
- * Postcondition: Must NOT modify any data members of PauliMatrix Object.
- *          Note: N/A
+ * Postcondition: N/A
 ********************************************/ 
 {
-    string m_sResult = m_sPauliString;
-
-    if (m_cxPauliFactor == complex<float>(-1, 0))
-        m_sResult = "-" + m_sResult;
-
-    else if (m_cxPauliFactor == complex<float>(0, 1))
-        m_sResult = "i" + m_sResult;
-
-    else if (m_cxPauliFactor == complex<float>(0, -1))
-        m_sResult = "-i" + m_sResult;
+    ioStatistics.m_iNumOfBytesInUse = inNumOfBytesInUse;
+    ioStatistics.m_iHighWaterMark = max(ioStatistics.m_iHighWaterMark, inNumOfBytesInUse);
+}
 
-    // else pauli factor is +1 so concatenate nothing.
 
-    return m_sResult;
+CMatrixArena::CMatrixArena(const size_t inBlockSize)
+/********************************************
+ *       Purpose: Create an empty arena that takes blocks of inBlockSize bytes from AllocateAligned().
+ *  Precondition: inBlockSize > 0
+ * Postcondition: No memory is taken until the first Allocate(). Larger requests get a block of their own size.
+********************************************/ 
+    : m_iBlockSize(inBlockSize), m_iBlockIndex(0), m_iOffset(0), m_iBytesBeforeBlock(0), m_pLastAllocation(NULL), m_asStatistics()
+{
 }
 
 
-CPauliMatrix CPauliMatrix::operator*(const CPauliMatrix &inPauli2) const
+CMatrixArena::~CMatrixArena()
 /********************************************
- *       Purpose: Multiply two pauli matrices then return the resulting pauli matrix object.
- *
- *              Pauli Matrices are: I, X, Y, Z
- *              IX = XI = X
- *              IY = YI = Y
- *              IZ = ZI = Z
- *              XY = iZ 
- *              XZ = -iY
- *              YX = -iZ
- *              YZ = iX
- *              ZX = iY
- *              ZY = -iX
- *              
- *              Associativity Rule: 
- *              c(AB) = c(A)B = A(cB)
- *              where c is a constant
- *              A and B are matrices.
- * 
- *  Precondition: N/A
+ *       Purpose: Free every block of the arena.
+ *  Precondition: No CMatrix still uses storage from the arena.
  * Postcondition: N/A
- *          Note: N/A
 ********************************************/ 
 {
-    CPauliMatrix m_pmResult = CPauliMatrix("I");
+    for ( size_t b = 0; b < m_vecBlocks.size(); b++ )
+        FreeAligned(m_vecBlocks[b].m_pMemory);
+}
 
-    // Update member variables
-    m_pmResult.m_cxPauliFactor = this->m_cxPauliFactor * inPauli2.m_cxPauliFactor;
-    
-    if (!this->m_sPauliString.compare("X") && !inPauli2.m_sPauliString.compare("Y")) {
-        m_pmResult.m_sPauliString = "Z"; 
-        m_pmResult.m_cxPauliFactor = m_pmResult.m_cxPauliFactor * complex<float>(0, 1);
-    }
-    else if (!this->m_sPauliString.compare("X") && !inPauli2.m_sPauliString.compare("Z")) {
-        m_pmResult.m_sPauliString = "Y"; 
-        m_pmResult.m_cxPauliFactor = m_pmResult.m_cxPauliFactor * complex<float>(0, -1);
-    }
-    else if (!this->m_sPauliString.compare("Y") && !inPauli2.m_sPauliString.compare("X")) {
-        m_pmResult.m_sPauliString = "Z"; 
-        m_pmResult.m_cxPauliFactor = m_pmResult.m_cxPauliFactor * complex<float>(0, -1);
-    }
-    else if (!this->m_sPauliString.compare("Y") && !inPauli2.m_sPauliString.compare("Z")) {
-        m_pmResult.m_sPauliString = "X"; 
-        m_pmResult.m_cxPauliFactor = m_pmResult.m_cxPauliFactor * complex<float>(0, 1);
-    }
-    else if (!this->m_sPauliString.compare("Z") && !inPauli2.m_sPauliString.compare("X")) {
-        m_pmResult.m_sPauliString = "Y"; 
-        m_pmResult.m_cxPauliFactor = m_pmResult.m_cxPauliFactor * complex<float>(0, 1);
-    }
-    else if (!this->m_sPauliString.compare("Z") && !inPauli2.m_sPauliString.compare("Y")) {
-        m_pmResult.m_sPauliString = "X"; 
-        m_pmResult.m_cxPauliFactor = m_pmResult.m_cxPauliFactor * complex<float>(0, -1);
-    }
-    else { // Both input pauli matrices are the same. Only difference may be a factor of phi.
-        m_pmResult.m_sPauliString = "I"; 
-    }
 
+void *CMatrixArena::Allocate(const size_t inNumOfBytes, const size_t inAlignment)
+/********************************************
+ *       Purpose: Return inNumOfBytes bytes on an inAlignment byte boundary by advancing the arena pointer.
+ *  Precondition: inAlignment is a power of 2 of at most 64. Exits otherwise.
+ * Postcondition: The tail of a block that is too small is skipped until Reset(). 
+ *                Only a request that fits in no kept block takes a new block from AllocateAligned().
+********************************************/ 
+{
+    if ( inAlignment > 64 ) {
+        cout << "ERROR: CMatrixArena blocks are aligned to 64 bytes, not " << inAlignment << "." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
 
-    // Matrix Multiplication between first and second matrix.
-    for ( unsigned short int r = 0; r < this->m_iRowSize; r++ ) {
-        for ( unsigned short int c = 0; c < this->m_iColSize; c++) {
-            complex<float> m_cxResult = complex<float>(0, 0);
-            for ( unsigned short int s = 0; s < this->m_iRowSize; s++ ) {
-                complex<float> m_cxEntry1 = this->GetValueAt(r, s);
-                complex<float> m_cxEntry2 = inPauli2.GetValueAt(s, c);
-                m_cxResult = m_cxResult + (m_cxEntry1 * m_cxEntry2);
+    m_asStatistics.m_iNumOfAllocations++;
+    while ( true ) {
+        if ( m_iBlockIndex < m_vecBlocks.size() ) {
+            const CBlock &m_bBlock = m_vecBlocks[m_iBlockIndex];
+            const size_t m_iStart = (m_iOffset + inAlignment - 1) & ~(inAlignment - 1);
+            if ( m_iStart + inNumOfBytes <= m_bBlock.m_iSize ) {
+                m_iOffset = m_iStart + inNumOfBytes;
+                m_pLastAllocation = m_bBlock.m_pMemory + m_iStart;
+                RecordBytesInUse(m_asStatistics, m_iBytesBeforeBlock + m_iOffset);
+                return m_pLastAllocation;
+            }
+            if ( m_iBlockIndex + 1 < m_vecBlocks.size() ) {
+                m_iBytesBeforeBlock += m_bBlock.m_iSize;
+                m_iBlockIndex++;
+                m_iOffset = 0;
+                continue;
             }
-            m_pmResult.ModifyValueAt(r, c, m_cxResult);
         }
-    }
 
-    return m_pmResult;
+        // Blocks start on a 64 byte boundary, so an offset of 0 suits any alignment up to 64.
+        const size_t m_iNewBlockSize = max(m_iBlockSize, inNumOfBytes);
+        CBlock m_bNewBlock = { static_cast<char *>(AllocateAligned(m_iNewBlockSize, 64)), m_iNewBlockSize };
+        m_asStatistics.m_iNumOfUpstreamAllocations++;
+        m_asStatistics.m_iNumOfBytesReserved += m_iNewBlockSize;
+        if ( m_iBlockIndex < m_vecBlocks.size() ) {
+            m_iBytesBeforeBlock += m_vecBlocks[m_iBlockIndex].m_iSize;
+            m_iBlockIndex++;
+        }
+        m_vecBlocks.push_back(m_bNewBlock);
+        m_iOffset = 0;
+    }
 }
 
 
-CPauliMatrix MultiplyPauli(const CPauliMatrix &inPauli1, const CPauliMatrix &inPauli2)
+void CMatrixArena::Deallocate(void *inMemory, const size_t inNumOfBytes)
 /********************************************
- *       Purpose: Multiply matrix of PauliMatrix object by matrix of PauliMatrix object, 
- *                then return the resulting PauliMatrix object containing that new matrix.
- *  Precondition: N/A
+ *       Purpose: Give back the storage at inMemory if it is the most recent allocation. Other storage comes back at Reset().
+ *  Precondition: inMemory came from Allocate() on this arena since the last Reset().
  * Postcondition: N/A
- *          Note: N/A
 ********************************************/ 
 {
-  return inPauli1 * inPauli2;
+    if ( inMemory == NULL || inMemory != m_pLastAllocation )
+        return;
+    const size_t m_iStart = size_t(static_cast<char *>(inMemory) - m_vecBlocks[m_iBlockIndex].m_pMemory);
+    if ( m_iStart + inNumOfBytes == m_iOffset ) {
+        m_iOffset = m_iStart;
+        m_pLastAllocation = NULL;
+        RecordBytesInUse(m_asStatistics, m_iBytesBeforeBlock + m_iOffset);
+    }
 }
 
 
-void CPauliMatrix::operator*(const complex<float> inPhi)
+void CMatrixArena::Reset()
 /********************************************
- *       Purpose: Multiply a pauli matrix by a factor of phi.
- *  Precondition: N/A
- * Postcondition: input PauliMatrix object must be modified by input phi parameter.
- *          Note: N/A
-            TODO: Prevent -0 entries in matrix.  
+ *       Purpose: Give back every byte of the arena in O(1) and keep its blocks for the next computation.
+ *  Precondition: No CMatrix still uses storage from the arena. Destroy or clear them before calling Reset().
+ * Postcondition: Bytes in use are 0. The high-water mark and the other counters are kept.
 ********************************************/ 
 {
-    for ( unsigned short int r = 0; r < this->m_iRowSize; r++ ) {
-        for ( unsigned short int c = 0; c < this->m_iColSize; c++ ) {
-            complex<float> m_cxEntry = this->GetValueAt(r, c);
-            // TODO: Prevent -0 entries in matrix.  
-            // if (entry.real() != 0 )
-            this->ModifyValueAt(r, c, inPhi * m_cxEntry); 
-        }
-    }
-
-    // Update value of pauli_factor
-    this->m_cxPauliFactor *= inPhi;
+    m_iBlockIndex = 0;
+    m_iOffset = 0;
+    m_iBytesBeforeBlock = 0;
+    m_pLastAllocation = NULL;
+    m_asStatistics.m_iNumOfBytesInUse = 0;
 }
 
 
-void MultiplyPhase(const complex<float> inPhi, CPauliMatrix &inPauli)
+static size_t PoolSizeClass(const size_t inNumOfBytes, const size_t inMinSizeClass)
 /********************************************
- *       Purpose: Multiply the matrix data member of a PauliMatrix object by a factor of phi.
+ *       Purpose: Return the smallest k of at least inMinSizeClass with 2^k >= inNumOfBytes.
  *  Precondition: N/A
  * Postcondition: N/A
- *          Note: N/A
 ********************************************/ 
 {
-    if ( inPhi != complex<float>(1, 0) && inPhi != complex<float>(-1, 0) &&
-         inPhi != complex<float>(0, 1) && inPhi != complex<float>(0, -1)) {
-         cout << "Function failed because phi is not one of the following: { 1, -1, i, -i }"<< endl;
-         cout << "Exiting Program . . ." << endl;
-         exit(1);
-    }
-    else 
-        inPauli * inPhi;
+    size_t m_iSizeClass = inMinSizeClass;
+    while ( (size_t(1) << m_iSizeClass) < inNumOfBytes )
+        m_iSizeClass++;
+    return m_iSizeClass;
 }
 
 
-void TestMultiplyPhase(const complex<float> &inPhi1, const complex<float> &inPhi2)
+CMatrixPool::CMatrixPool()
 /********************************************
- *       Purpose: Verify all pauli multiplication by phase is correct.
- *  Precondition: Input phi1 and phi2 parameters must be one of the following: { 1, -1, i, -i }
- * Postcondition: N/A
+ *       Purpose: Create an empty pool.
+ *  Precondition: N/A
+ * Postcondition: No memory is taken until the first Allocate().
 ********************************************/ 
+    : m_vecFreeLists(8 * sizeof(size_t)), m_asStatistics()
 {
-    if ( inPhi1 != complex<float>(1, 0) && inPhi1 != complex<float>(-1, 0) &&
-         inPhi1 != complex<float>(0, 1) && inPhi1 != complex<float>(0, -1))
-         cout << "Function failed because first phi is not one of the following: { 1, -1, i, -i }"<< endl;
+}
 
-    else if ( inPhi2 != complex<float>(1, 0) && inPhi2 != complex<float>(-1, 0) &&
-              inPhi2 != complex<float>(0, 1) && inPhi2 != complex<float>(0, -1))
-         cout << "Function failed because second phi is not one of the following: { 1, -1, i, -i }"<< endl;
-
-    else {
-        cout << "__________________________________" << endl;
-        cout << "phi1 = " << inPhi1 << endl;
-        cout << "phi2 = " << inPhi2 << endl;
-
-        array<string, 4> m_arrsPauliIDs = { "I", "X", "Y", "Z"};
-        for (auto p = m_arrsPauliIDs.begin(); p != m_arrsPauliIDs.end(); ++p){
-            cout << "__________________________________" << endl;
-            CPauliMatrix m_pmResult = CPauliMatrix(*p);
-            cout << "Initial Pauli Matrix: " << m_pmResult.PauliToString() << endl;
-            m_pmResult.PrintMatrix();
-
-            MultiplyPhase(inPhi1, m_pmResult);
-            cout << "After phi1 multiplication: " << m_pmResult.PauliToString() << endl;
-            m_pmResult.PrintMatrix();
-
-            MultiplyPhase(inPhi2, m_pmResult);
-            cout << "After phi2 multiplication: " << m_pmResult.PauliToString() << endl;
-            m_pmResult.PrintMatrix();
-        }
-    }
-}
 
-
-void TestPauliIsHermitian()
+CMatrixPool::~CMatrixPool()
 /********************************************
- *       Purpose: Multiply Pauli objects by themselves to check they're Hermitian. 
- *                The resulting Pauli object should contain an Identity matrix.
- *  Precondition: N/A
+ *       Purpose: Free the buffers cached by the pool.
+ *  Precondition: No CMatrix still uses storage from the pool.
  * Postcondition: N/A
 ********************************************/ 
 {
-    // PauliMatrix i_matrix = PauliMatrix("I");
-    array<string, 4> m_arrsPauliIDs = { "I", "X", "Y", "Z"};
-
-    for (auto p = m_arrsPauliIDs.begin(); p != m_arrsPauliIDs.end(); ++p){
-        CPauliMatrix m_pmPauli1 = CPauliMatrix(*p);
-        CPauliMatrix m_pmPauli2 = CPauliMatrix(*p);
-        cout << m_pmPauli1.PauliToString() << endl;
-        m_pmPauli1.PrintMatrix();
-
-
-        CPauliMatrix m_pmResult = MultiplyPauli(m_pmPauli1, m_pmPauli2);
-        // TODO: Operator Overload for == between two Pauli Matrices.
-        // if (p_squared == i_matrix)
-        cout << m_pmPauli1.PauliToString() << "^2" << " = " << m_pmResult.PauliToString() << endl;
-        m_pmResult.PrintMatrix();
-    }
-
+    Release();
 }
 
 
-void ShortTestMultiplyPauli(const complex<float> &inPhi1, const string &inPauliID1, const complex<float> &inPhi2, const string &inPauliID2)
+void *CMatrixPool::Allocate(const size_t inNumOfBytes, const size_t inAlignment)
 /********************************************
- *       Purpose: Test Pauli Multiplication.
- *  Precondition: N/A
- * Postcondition: N/A
+ *       Purpose: Return a buffer of at least inNumOfBytes bytes, reusing a free buffer of the same size class when there is one.
+ *  Precondition: inAlignment is a power of 2 of at most 64.
+ * Postcondition: The buffer holds 2^k bytes, for the smallest 2^k of at least 64 and inNumOfBytes.
 ********************************************/ 
 {
-
-    // Verifying valid input parameters.
-    // DELETE. Took care of checking in CPauliMatrix(string inPauliID)
-    if (!inPauliID1.compare("X") && !inPauliID1.compare("x") && 
-        !inPauliID1.compare("Y") && !inPauliID1.compare("y") &&
-        !inPauliID1.compare("Z") && !inPauliID1.compare("z") &&
-        !inPauliID1.compare("I") && !inPauliID1.compare("i")) {
-        cout << "HelperShortTestMultiplyPauli failed because first pauli ID is not valid. Use one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
-        cout << "Exiting Program . . . " << endl;
-        exit(1);
-    }
-    // DELETE. Took care of checking in CPauliMatrix(string inPauliID)
-    else if (!inPauliID2.compare("X") && !inPauliID2.compare("x") && 
-             !inPauliID2.compare("Y") && !inPauliID2.compare("y") &&
-             !inPauliID2.compare("Z") && !inPauliID2.compare("z") &&
-             !inPauliID2.compare("I") && !inPauliID2.compare("i")) {
-        cout << "HelperShortTestMultiplyPauli failed because second pauli ID is not valid. Use one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
-        cout << "Exiting Program . . . " << endl;
-        exit(1);
-    }
-    else if ( inPhi1 != complex<float>(1, 0) && inPhi1 != complex<float>(-1, 0) &&
-              inPhi1 != complex<float>(0, 1) && inPhi1 != complex<float>(0, -1)) {
-        cout << "HelperShortTestMultiplyPauli failed because phi1 is not valid. Use one of the following: { 1, -1, i, -i }"<< endl;
-        cout << "Exiting Program . . . " << endl;
-        exit(1);
-    }
-    else if ( inPhi2 != complex<float>(1, 0) && inPhi2 != complex<float>(-1, 0) &&
-              inPhi2 != complex<float>(0, 1) && inPhi2 != complex<float>(0, -1)) {
-        cout << "HelperShortTestMultiplyPauli failed because phi2 is not valid. Use one of the following: { 1, -1, i, -i }"<< endl;
-        cout << "Exiting Program . . . " << endl;
+    if ( inAlignment > (size_t(1) << MIN_SIZE_CLASS) ) {
+        cout << "ERROR: CMatrixPool buffers are aligned to " << (size_t(1) << MIN_SIZE_CLASS) << " bytes, not " << inAlignment << "." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
         exit(1);
     }
 
-    CPauliMatrix m_pmPauli1 = CPauliMatrix(inPauliID1);
-    MultiplyPhase(inPhi1, m_pmPauli1);
-    cout << "First Pauli Matrix:  " << m_pmPauli1.PauliToString() << endl;
-    m_pmPauli1.PrintMatrix();
-    
-    CPauliMatrix m_pmPauli2 = CPauliMatrix(inPauliID2);
-    MultiplyPhase(inPhi2, m_pmPauli2);
-    cout << "Second Pauli Matrix:  " << m_pmPauli2.PauliToString() << endl;
-    m_pmPauli2.PrintMatrix();
+    const size_t m_iSizeClass = PoolSizeClass(inNumOfBytes, MIN_SIZE_CLASS);
+    vector<void *> &m_vecFreeList = m_vecFreeLists[m_iSizeClass];
+    m_asStatistics.m_iNumOfAllocations++;
+    RecordBytesInUse(m_asStatistics, m_asStatistics.m_iNumOfBytesInUse + (size_t(1) << m_iSizeClass));
+    if ( !m_vecFreeList.empty() ) {
+        void *m_pMemory = m_vecFreeList.back();
+        m_vecFreeList.pop_back();
+        return m_pMemory;
+    }
 
-    CPauliMatrix m_pmResult = MultiplyPauli(m_pmPauli1, m_pmPauli2);
-    cout << m_pmPauli1.PauliToString() << "   *   " << m_pmPauli2.PauliToString() << " = " << m_pmResult.PauliToString() << endl;
-    m_pmResult.PrintMatrix();
+    m_asStatistics.m_iNumOfUpstreamAllocations++;
+    m_asStatistics.m_iNumOfBytesReserved += size_t(1) << m_iSizeClass;
+    return AllocateAligned(size_t(1) << m_iSizeClass, size_t(1) << MIN_SIZE_CLASS);
 }
 
-void FullTestMultiplyPauli(const string &inPauliID1,  const string &inPauliID2)
+
+void CMatrixPool::Deallocate(void *inMemory, const size_t inNumOfBytes)
 /********************************************
- *       Purpose: Test Pauli Multiplication. Given two pauli matrices, 
- *                for example, Z and Z, perform the following 16 tests
- *                and verify they provide the correct resulting matrix.
- *                 Z  x    Z    test 1
- *                 Z  x   -Z    test 2
- *                 Z  x   iZ    test 3
- *                 Z  x  -iZ    test 4
- * 
- *                -Z  x   -Z    test 5
- *                -Z  x    Z    test 6
- *                -Z  x   iZ    test 7
- *                -Z  x  -iZ    test 8
- *                              
- *                iZ  x  iZ     test 9
- *                iZ  x   Z     test 10
- *                iZ  x  -Z     test 11
- *                iZ  x -iZ     test 12
- *  
- *               -iZ  x -iZ     test 13
- *               -iZ  x   Z     test 14
- *               -iZ  x  -Z     test 15
- *               -iZ  x  iZ     test 16
- *                 
- *  Precondition: N/A
- * Postcondition: N/A
+ *       Purpose: Put the buffer at inMemory on the free list of its size class.
+ *  Precondition: inMemory came from Allocate() on this pool with the same inNumOfBytes.
+ * Postcondition: The buffer stays reserved until Release() or the pool is destroyed.
 ********************************************/ 
 {
-    array<complex<float>, 4> m_arrcxPhis = { complex<float>(1, 0), complex<float>(-1, 0), complex<float>(0, 1), complex<float>(0, -1)  };
-
-    for ( unsigned short int r = 0; r < m_arrcxPhis.size(); r++ ) {
-        for (unsigned short int c = 0; c < m_arrcxPhis.size(); c++ ) {
-            cout << "_________" << endl;
-            cout << "Test " << r * m_arrcxPhis.size() + (c + 1) << ": " << endl;
-            ShortTestMultiplyPauli(m_arrcxPhis.at(r), inPauliID1, m_arrcxPhis.at(c), inPauliID2);
-        }
-    }
+    if ( inMemory == NULL )
+        return;
+    const size_t m_iSizeClass = PoolSizeClass(inNumOfBytes, MIN_SIZE_CLASS);
+    m_vecFreeLists[m_iSizeClass].push_back(inMemory);
+    m_asStatistics.m_iNumOfBytesInUse -= size_t(1) << m_iSizeClass;
 }
 
 
-CPauliAlgebraElement::CPauliAlgebraElement(string inPauliID) : CPauliMatrix(inPauliID)
+void CMatrixPool::Release()
 /********************************************
- *       Purpose: Creates a PauliAlgebraElement object. 
- *                The matrix data member Is a 2 x 2 pauli matrix.
+ *       Purpose: Free every buffer on the free lists.
  *  Precondition: N/A
- * Postcondition: Must NOT modify any data members of Matrix Object.
+ * Postcondition: Buffers still in use are not touched and go back on the free lists when they are given back.
 ********************************************/ 
 {
-    // Initialize Data Members
-    m_cxElementPhase = m_cxPauliFactor;
-    m_sElementString = m_sPauliString;    
+    for ( size_t k = 0; k < m_vecFreeLists.size(); k++ ) {
+        for ( void *m_pMemory : m_vecFreeLists[k] )
+            FreeAligned(m_pMemory);
+        m_asStatistics.m_iNumOfBytesReserved -= m_vecFreeLists[k].size() << k;
+        m_vecFreeLists[k].clear();
+    }
 }
 
 
-CPauliAlgebraElement::CPauliAlgebraElement(unsigned short int inRowSize, unsigned short int inColSize) : CPauliMatrix(inRowSize, inColSize)
+static inline unsigned int PopCount64(const uint64_t inWord)
 /********************************************
- *       Purpose: Creates a PauliAlgebraElement object that is row_size x col_size. 
- *                All elements are intialized to 0;
+ *       Purpose: Return the number of set bits in a 64 bit word.
  *  Precondition: N/A
  * Postcondition: N/A
+ *          Note: Compiles to a single popcnt instruction when available.
 ********************************************/ 
 {
-    // Initialize Data Members
-    m_cxElementPhase = complex<float>(1, 0);
-    m_sElementString = "";
+#if defined(_MSC_VER)
+    return (unsigned int) __popcnt64(inWord);
+#else
+    return (unsigned int) __builtin_popcountll(inWord);
+#endif
 }
 
 
-string CPauliAlgebraElement::PauliAlgebraElementToString() const
+static inline uint64_t HighestSetBit(const uint64_t inWord)
 /********************************************
- *       Purpose: Returns the Pauli Algebra element as a string.
- *                For Example "(5 + 10i)Z"
+ *       Purpose: Return the highest set bit of a 64 bit word as a mask. 
+ *                For Example: 0b0110 returns 0b0100.
  *  Precondition: N/A
- * Postcondition: N/A
- *          Note: N/A
+ * Postcondition: Returns 0 if no bit is set.
 ********************************************/ 
 {
-    string m_sResult = m_sElementString;
-
-    if (m_cxElementPhase.imag() == 0 )
-        m_sResult = to_string((int) m_cxElementPhase.real()) + m_sResult;
-    
-    else if ( m_cxElementPhase.real() == 0 )
-        m_sResult = to_string((int) m_cxElementPhase.imag()) + "i" + m_sResult;
-
-    else if ( m_cxElementPhase.real() != 0 && m_cxElementPhase.imag() != 0 )
-        m_sResult = "(" + to_string((int) m_cxElementPhase.real()) + " + " + to_string((int) m_cxElementPhase.imag()) + "i" + ")" + m_sResult;
-
-    return m_sResult;
+    if (inWord == 0)
+        return 0;
+#if defined(_MSC_VER)
+    unsigned long m_iIndex;
+    _BitScanReverse64(&m_iIndex, inWord);
+    return uint64_t(1) << m_iIndex;
+#else
+    return uint64_t(1) << (63 - __builtin_clzll(inWord));
+#endif
 }
 
 
-CPauliAlgebraElement CPauliAlgebraElement::operator*(const CPauliAlgebraElement &inPAElement2) const
+template <class T>
+static inline complex<T> MultiplyByPowerOfI(const complex<T> inZ, const unsigned int inExponent)
 /********************************************
- *       Purpose: Returns a PauliAlgebraElement object where the matrix data member is
- *                the tensor product between the first input parameter and the second input parameter.
- *                For Example, p1_algebra_matrix @ p2_alebgra_matrix
+ *       Purpose: Return i^inExponent * inZ without a complex multiplication.
  *  Precondition: N/A
  * Postcondition: N/A
 ********************************************/ 
 {
-    unsigned short int m_iNewRowSize = this->m_iRowSize * inPAElement2.m_iRowSize;
-    unsigned short int m_iNewColSize = this->m_iColSize * inPAElement2.m_iColSize;
-    CPauliAlgebraElement m_paeResult = CPauliAlgebraElement(m_iNewRowSize, m_iNewColSize);
-    m_paeResult.m_cxElementPhase = this->m_cxElementPhase * inPAElement2.m_cxElementPhase;
-    m_paeResult.m_sElementString = this->m_sElementString + " @ " + inPAElement2.m_sElementString;
+    switch (inExponent & 3) {
+        case 1:  return complex<T>(-inZ.imag(), inZ.real());
+        case 2:  return -inZ;
+        case 3:  return complex<T>(inZ.imag(), -inZ.real());
+        default: return inZ;
+    }
+}
 
 
-    for (unsigned short int r=0; r < this->m_iRowSize; r++){
-        for (unsigned short int c=0; c < this->m_iColSize; c++){
-            complex<float> m_cxMatrix1Val = this->GetValueAt(r, c); 
+// Rows in a register tile of the matrix multiplication. Every micro kernel is written out for exactly 4 rows.
+static const size_t GEMM_MR = 4;
 
-            for ( unsigned short int r2=0; r2 < inPAElement2.m_iRowSize; r2++ ) {
-                for (unsigned short int c2=0; c2 < inPAElement2.m_iColSize; c2++ ) {
-                    complex<float> m_cxMatrix2Val = inPAElement2.GetValueAt(r2, c2);
-                    m_paeResult.ModifyValueAt( (r * inPAElement2.m_iRowSize )+r2, ( c * inPAElement2.m_iColSize )+c2, m_cxMatrix1Val * m_cxMatrix2Val );
-                }
-            }
 
-        }
-    }
+// Real and imaginary parts of a row major complex matrix in either CMatrix layout.
+// Entry (r, c) has its real part at m_pRe[r * m_iRowStride + c * m_iColStride] and its imaginary part 
+// at the same offset from m_pIm.  Interleaved: m_pIm = m_pRe + 1 and m_iColStride = 2.  Split: m_iColStride = 1.
+struct CStridedComplex {
+    float *m_pRe;
+    float *m_pIm;
+    size_t m_iRowStride;
+    size_t m_iColStride;
+};
 
-    return m_paeResult;
+
+static inline CStridedComplex OffsetStridedComplex(const CStridedComplex &inMatrix, const size_t inRowIndex, const size_t inColIndex)
+/********************************************
+ *       Purpose: Return the view of inMatrix that starts at entry (inRowIndex, inColIndex).
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    const size_t m_iOffset = inRowIndex * inMatrix.m_iRowStride + inColIndex * inMatrix.m_iColStride;
+    CStridedComplex m_scResult = { inMatrix.m_pRe + m_iOffset, inMatrix.m_pIm + m_iOffset, inMatrix.m_iRowStride, inMatrix.m_iColStride };
+    return m_scResult;
 }
 
 
-CPauliAlgebraElement MakePauliAlgebraElement(string inPauliGroupString)
+static inline void AddSplitTileRowScalar(const CStridedComplex &ioC, const size_t inRowIndex, const float *inRe, const float *inIm, const size_t inNumOfCols)
 /********************************************
- *       Purpose: Creates a PauliAlgebraElement object from a string.
- *                For example "XYZ" will create a PauliAlgebraElement object 
- *                where the matrix data memebr is the result of taking the tensor product 
- *                between X tensor Y tensor Z. In my notation it would be: X @ Y @ Z
- *                where @ is the tensor product symbol.
+ *       Purpose: Add inNumOfCols split complex values to row inRowIndex of ioC.
  *  Precondition: N/A
  * Postcondition: N/A
 ********************************************/ 
 {
-
-    if (inPauliGroupString.size() == 0) {
-        cout << "Empty String. Try again." << endl;
-        cout << "Exiting Program . . . " << endl;
-        exit(1);
+    float *m_pRe = ioC.m_pRe + inRowIndex * ioC.m_iRowStride;
+    float *m_pIm = ioC.m_pIm + inRowIndex * ioC.m_iRowStride;
+    for ( size_t c = 0; c < inNumOfCols; c++ ) {
+        m_pRe[c * ioC.m_iColStride] += inRe[c];
+        m_pIm[c * ioC.m_iColStride] += inIm[c];
     }
+}
 
-    CPauliAlgebraElement m_paeResult = CPauliAlgebraElement(string(1, inPauliGroupString.at(0)));
 
-    for ( unsigned short int e = 1; e < inPauliGroupString.size(); e++ ){
-        // Verify valid input which must be one of the following: { "I", "X", "Y", "Z" }
-        string m_sPauliChar = string(1, inPauliGroupString.at(e));
-        if (m_sPauliChar.compare("X") && m_sPauliChar.compare("x") && 
-            m_sPauliChar.compare("Y") && m_sPauliChar.compare("y") &&
-            m_sPauliChar.compare("Z") && m_sPauliChar.compare("z") &&
-            m_sPauliChar.compare("I") && m_sPauliChar.compare("i")) {
-            cout << "MakePauliAlgebraElement failed because " << "from your input string " << "\"" << inPauliGroupString << "\"" << "," << "\"" << m_sPauliChar << "\"" << " is not valid. " << "Replace " << "\"" << m_sPauliChar << "\"" << " with one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
-            cout << "Exiting Program . . . " << endl;
-            exit(1);
+static void GemmMicroKernelScalar(const size_t inDepth, const float *inPackedA, const float *inPackedB, 
+                                  const CStridedComplex &ioC, const size_t inNumOfRows, const size_t inNumOfCols)
+/********************************************
+ *       Purpose: C += A * B for one 4 x 8 tile of C, where A and B are packed split complex slivers.
+ *                The loop order is k, column, row, so the column loop runs over contiguous 
+ *                real and imaginary planes and the compiler can keep the whole tile in vector registers.
+ *  Precondition: Only the top left inNumOfRows x inNumOfCols corner of the tile is stored back.
+ * Postcondition: N/A
+********************************************/ 
+{
+    const size_t NR = 8;
+    float m_arrfRe[GEMM_MR][NR] = {};
+    float m_arrfIm[GEMM_MR][NR] = {};
+
+    for ( size_t k = 0; k < inDepth; k++ ) {
+        const float *m_pARe = inPackedA + k * 2 * GEMM_MR;
+        const float *m_pAIm = m_pARe + GEMM_MR;
+        const float *m_pBRe = inPackedB + k * 2 * NR;
+        const float *m_pBIm = m_pBRe + NR;
+        // The GEMM_MR rows are written out so every row of the tile stays in its own registers.
+        for ( size_t c = 0; c < NR; c++ ) {
+            const float m_fBRe = m_pBRe[c];
+            const float m_fBIm = m_pBIm[c];
+            m_arrfRe[0][c] += m_pARe[0] * m_fBRe - m_pAIm[0] * m_fBIm;
+            m_arrfIm[0][c] += m_pARe[0] * m_fBIm + m_pAIm[0] * m_fBRe;
+            m_arrfRe[1][c] += m_pARe[1] * m_fBRe - m_pAIm[1] * m_fBIm;
+            m_arrfIm[1][c] += m_pARe[1] * m_fBIm + m_pAIm[1] * m_fBRe;
+            m_arrfRe[2][c] += m_pARe[2] * m_fBRe - m_pAIm[2] * m_fBIm;
+            m_arrfIm[2][c] += m_pARe[2] * m_fBIm + m_pAIm[2] * m_fBRe;
+            m_arrfRe[3][c] += m_pARe[3] * m_fBRe - m_pAIm[3] * m_fBIm;
+            m_arrfIm[3][c] += m_pARe[3] * m_fBIm + m_pAIm[3] * m_fBRe;
         }
-
-        m_paeResult = m_paeResult * CPauliAlgebraElement(m_sPauliChar);
     }
-    
-    return m_paeResult;
+
+    for ( size_t r = 0; r < inNumOfRows; r++ )
+        AddSplitTileRowScalar(ioC, r, m_arrfRe[r], m_arrfIm[r], inNumOfCols);
 }
 
 
-void CPauliAlgebraElement::operator*(const complex<float> &inZ)
+static void MatrixVectorScalar(const complex<float> *inMatrix, const size_t inNumOfRows, const size_t inNumOfCols, const size_t inLd, 
+                               const complex<float> *inVector, complex<float> *outVector)
 /********************************************
- *       Purpose: Multiply matrix data member of a PauliAlgebraElement object by a 
- *                scalar. The scalar may be a complex number.
- *  Precondition: N/A
+ *       Purpose: y = A * x for a row major interleaved complex matrix A.
+ *  Precondition: outVector must not overlap inMatrix or inVector.
  * Postcondition: N/A
 ********************************************/ 
 {
-    // Update value of pauli_factor
-    this->m_cxElementPhase = this->m_cxElementPhase * inZ;
-
-    // Update matrix
-    for ( unsigned short int r = 0; r < this->m_iRowSize; r++ ) {
-        for ( unsigned short int c = 0; c < this->m_iColSize; c++ ) {
-            complex<float> m_cxEntry = this->GetValueAt(r, c);
-            // TODO: Prevent -0 entries in matrix.  
-            // if (entry.real() != 0 )
-            this->ModifyValueAt(r, c, inZ * m_cxEntry); 
+    for ( size_t r = 0; r < inNumOfRows; r++ ) {
+        const complex<float> *m_pRow = inMatrix + r * inLd;
+        float m_fRe = 0, m_fIm = 0;
+        for ( size_t c = 0; c < inNumOfCols; c++ ) {
+            m_fRe += m_pRow[c].real() * inVector[c].real() - m_pRow[c].imag() * inVector[c].imag();
+            m_fIm += m_pRow[c].real() * inVector[c].imag() + m_pRow[c].imag() * inVector[c].real();
         }
+        outVector[r] = complex<float>(m_fRe, m_fIm);
     }
 }
 
 
-void MultiplyPauliAlgebraByScalar(const complex<float> &inZ, CPauliAlgebraElement &inPAElement)
+static void AddScalar(const complex<float> *inValues1, const complex<float> *inValues2, complex<float> *outValues, const size_t inLength)
 /********************************************
- *       Purpose: Multiply PauliAlgebraElement by a scalar. Scalar may be a complex number.
+ *       Purpose: out[i] = in1[i] + in2[i]
  *  Precondition: N/A
- * Postcondition: N/A
+ * Postcondition: outValues may alias either input.
 ********************************************/ 
 {
-    inPAElement * inZ;
+    const float *m_pValues1 = reinterpret_cast<const float *>(inValues1);
+    const float *m_pValues2 = reinterpret_cast<const float *>(inValues2);
+    float *m_pOut = reinterpret_cast<float *>(outValues);
+    for ( size_t i = 0; i < 2 * inLength; i++ )
+        m_pOut[i] = m_pValues1[i] + m_pValues2[i];
 }
 
 
-CPauliAlgebraElement CPauliAlgebraElement::operator+(const CPauliAlgebraElement &inPAElement2) const
+static void ScaleScalar(const complex<float> *inValues, const complex<float> inZ, complex<float> *outValues, const size_t inLength)
 /********************************************
- *       Purpose: Add matrix data member entries of first input PauliAlgebraElement object 
- *                with the matrix data member entries of second input PauliAlgebraElement object.
- * 
- *  Precondition: First and Second input PauliAlgebraElement objects may only differ by
- *                a scalar factor. Otherwise, addition fails.
- *                Good, -9XYZ + 7XYZ  =  -1XYZ
- *                 Bad,  4XYZ +  ZZZ  
- * Postcondition: N/A
-********************************************/
+ *       Purpose: out[i] = z * in[i]
+ *  Precondition: N/A
+ * Postcondition: outValues may alias inValues.
+ *          Note: The product is spelled out in real arithmetic so no NaN recovery call is made per entry.
+********************************************/ 
 {
-    // Pauli Elements do NOT match. For example: XYZ + XY
-    if (this->m_sElementString.compare(inPAElement2.m_sElementString) ||
-        this->m_iRowSize * this->m_iColSize != inPAElement2.m_iRowSize * inPAElement2.m_iColSize) {
-        cout << "Adding Pauli Elements Failed. Pauli elements do not match: " << this->m_sElementString << " and " << inPAElement2.m_sElementString << endl;
-        exit(1);
+    for ( size_t i = 0; i < inLength; i++ ) {
+        const float m_fRe = inValues[i].real();
+        const float m_fIm = inValues[i].imag();
+        outValues[i] = complex<float>(inZ.real() * m_fRe - inZ.imag() * m_fIm, inZ.real() * m_fIm + inZ.imag() * m_fRe);
     }
+}
 
-    // Pauli Elements do match. For example: XYZ + 2XYZ
-    CPauliAlgebraElement m_paeResult = CPauliAlgebraElement(this->m_iRowSize, this->m_iColSize);
-    m_paeResult.m_cxElementPhase = this->m_cxElementPhase + inPAElement2.m_cxElementPhase;
-    m_paeResult.m_sElementString = this->m_sElementString; 
-
-
-    // Add pauli elements
-    for ( unsigned short int r = 0; r < this->m_iRowSize; r++ ) {
-        for ( unsigned short int c = 0; c < this->m_iColSize; c++ ) {
-            complex<float> m_cxEntry1 = this->GetValueAt(r, c);
-            complex<float> m_cxEntry2 = inPAElement2.GetValueAt(r, c);
 
-            // TODO: Prevent -0 entries in matrix.  
-            // if (entry.real() != 0 )
-            m_paeResult.ModifyValueAt(r, c, m_cxEntry1 + m_cxEntry2); 
+static void ConjugateTransposeScalar(complex<float> *ioMatrix, const size_t inSideLength, const size_t inBegin)
+/********************************************
+ *       Purpose: Conjugate transpose every pair of entries (r, c), (c, r) of a square 
+ *                row major matrix with max(r, c) >= inBegin.
+ *  Precondition: N/A
+ * Postcondition: inBegin = 0 conjugate transposes the whole matrix. The SIMD kernels 
+ *                handle the top left inBegin x inBegin block themselves and call this for the edges.
+********************************************/ 
+{
+    for ( size_t c = inBegin; c < inSideLength; c++ ) {
+        for ( size_t r = 0; r < c; r++ ) {
+            const complex<float> m_cxEntry = ioMatrix[r * inSideLength + c];
+            ioMatrix[r * inSideLength + c] = conj(ioMatrix[c * inSideLength + r]);
+            ioMatrix[c * inSideLength + r] = conj(m_cxEntry);
         }
+        ioMatrix[c * inSideLength + c] = conj(ioMatrix[c * inSideLength + c]);
     }
-
-    return m_paeResult;
 }
 
 
-CPauliAlgebraElement AddPauliAlgebra(const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2)
+static void ConjugateTransposeScalarKernel(complex<float> *ioMatrix, const size_t inSideLength, const size_t inRowBegin, const size_t inRowEnd)
 /********************************************
- *       Purpose: Add Pauli algebra elements first_pauli_matrix and second_pauli_matrix.
+ *       Purpose: Conjugate transpose every pair of entries (r, c), (c, r) of a square 
+ *                row major matrix with min(r, c) in [inRowBegin, inRowEnd).
  *  Precondition: N/A
- * Postcondition: N/A
-********************************************/
+ * Postcondition: Disjoint row ranges touch disjoint entries, so they may run on different threads.
+********************************************/ 
 {
-    return inPAElement1 + inPAElement2;
+    for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+        ioMatrix[r * inSideLength + r] = conj(ioMatrix[r * inSideLength + r]);
+        for ( size_t c = r + 1; c < inSideLength; c++ ) {
+            const complex<float> m_cxEntry = ioMatrix[r * inSideLength + c];
+            ioMatrix[r * inSideLength + c] = conj(ioMatrix[c * inSideLength + r]);
+            ioMatrix[c * inSideLength + r] = conj(m_cxEntry);
+        }
+    }
 }
 
 
-void TestConstructPauliElement( const complex<float> &inZ, const string inPauliGroupString )
+static bool EqualScalar(const complex<float> *inValues1, const complex<float> *inValues2, const size_t inLength)
 /********************************************
- *       Purpose: Test MakePauliAlgebraElement() function.
- *                Test MultiplyPauliAlgebraByScalar() function.
+ *       Purpose: Return true if in1[i] == in2[i] for every i.
  *  Precondition: N/A
- * Postcondition: N/A
-********************************************/
+ * Postcondition: Follows float comparison, so 0 == -0 and NaN != NaN.
+********************************************/ 
 {
-    CPauliAlgebraElement m_paeResult = MakePauliAlgebraElement(inPauliGroupString);
-    cout << "Initial tensor product matrix:" << endl;
-    cout << m_paeResult.PauliAlgebraElementToString() << endl;
-    m_paeResult.PrintMatrix();
+    for ( size_t i = 0; i < inLength; i++ )
+        if ( inValues1[i] != inValues2[i] )
+            return false;
+    return true;
+}
 
 
-    if (inZ.imag() == 0 )    
-        cout << "After Scalar Multiplication by " << "(" + to_string((int) inZ.real()) + ")" << endl;
+static inline void KahanAdd(float &ioSum, float &ioCompensation, const float inValue)
+/********************************************
+ *       Purpose: Add inValue to ioSum with Kahan compensated summation. 
+ *                ioCompensation keeps the low order bits lost so far, negated.
+ *  Precondition: Both start at 0.
+ * Postcondition: The compensated sum is ioSum - ioCompensation.
+********************************************/ 
+{
+    const float m_fValue = inValue - ioCompensation;
+    const float m_fSum = ioSum + m_fValue;
+    ioCompensation = (m_fSum - ioSum) - m_fValue;
+    ioSum = m_fSum;
+}
 
-    else if ( inZ.real() == 0 )
-        cout << "After Scalar Multiplication by " << "(" + to_string((int) inZ.imag()) + "i" + ")" << endl;
 
-    else if ( inZ.real() != 0 && inZ.imag() != 0 )
-        cout << "After Scalar Multiplication by " << "(" + to_string((int) inZ.real()) + " + " + to_string((int) inZ.imag()) + "i" + ")" << endl;
+static double DotScalar(const float *inValues1, const float *inValues2, const size_t inLength, const bool inIsCompensated)
+/********************************************
+ *       Purpose: Return the sum of in1[i] * in2[i] over inLength floats.
+ *  Precondition: N/A
+ * Postcondition: Accumulates in float, with Kahan compensation when inIsCompensated is true.
+********************************************/ 
+{
+    float m_fSum = 0, m_fCompensation = 0;
+    for ( size_t i = 0; i < inLength; i++ ) {
+        if ( inIsCompensated )
+            KahanAdd(m_fSum, m_fCompensation, inValues1[i] * inValues2[i]);
+        else
+            m_fSum += inValues1[i] * inValues2[i];
+    }
+    return double(m_fSum) - double(m_fCompensation);
+}
 
-    MultiplyPauliAlgebraByScalar(inZ, m_paeResult);
-    cout << m_paeResult.PauliAlgebraElementToString() << endl;
-    m_paeResult.PrintMatrix();
 
+static complex<double> ComplexDotScalar(const complex<float> *inValues1, const complex<float> *inValues2, const size_t inLength, 
+                                        const bool inIsConjugated, const bool inIsCompensated)
+/********************************************
+ *       Purpose: Return the sum of in1[i] * in2[i], or of conj(in1[i]) * in2[i] when inIsConjugated is true.
+ *  Precondition: N/A
+ * Postcondition: Accumulates in float, with Kahan compensation when inIsCompensated is true.
+********************************************/ 
+{
+    const float m_fSign = inIsConjugated ? -1.0f : 1.0f;
+    float m_fRe = 0, m_fIm = 0, m_fReCompensation = 0, m_fImCompensation = 0;
+    for ( size_t i = 0; i < inLength; i++ ) {
+        const float m_fRe1 = inValues1[i].real();
+        const float m_fIm1 = m_fSign * inValues1[i].imag();
+        const float m_fProductRe = m_fRe1 * inValues2[i].real() - m_fIm1 * inValues2[i].imag();
+        const float m_fProductIm = m_fRe1 * inValues2[i].imag() + m_fIm1 * inValues2[i].real();
+        if ( inIsCompensated ) {
+            KahanAdd(m_fRe, m_fReCompensation, m_fProductRe);
+            KahanAdd(m_fIm, m_fImCompensation, m_fProductIm);
+        }
+        else {
+            m_fRe += m_fProductRe;
+            m_fIm += m_fProductIm;
+        }
+    }
+    return complex<double>(double(m_fRe) - double(m_fReCompensation), double(m_fIm) - double(m_fImCompensation));
+}
 
-    if (inZ.imag() == 0 )    
-        cout << "After Scalar Conjugate Multiplication by " << "(" + to_string((int) conj(inZ).real()) + ")" << endl;
 
-    else if ( inZ.real() == 0 )
-        cout << "After Scalar Conjugate Multiplication by " << "(" + to_string((int) conj(inZ).imag()) + "i" + ")" << endl;
+#if defined(PML_X86_DISPATCH)
 
-    else if ( inZ.real() != 0 && inZ.imag() != 0 )
-        cout << "After Scalar Conjugate Multiplication by " << "(" + to_string((int) conj(inZ).real()) + " + " + to_string((int) conj(inZ).imag()) + "i" + ")" << endl;
+__attribute__((target("avx2,fma")))
+static inline void AddSplitTileAvx2(const CStridedComplex &ioC, const size_t inRowIndex, const __m256 inRe, const __m256 inIm, const size_t inNumOfCols)
+/********************************************
+ *       Purpose: Add 8 split complex values (real plane inRe, imaginary plane inIm) 
+ *                to the first inNumOfCols entries of row inRowIndex of ioC.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    float *m_pRe = ioC.m_pRe + inRowIndex * ioC.m_iRowStride;
+    float *m_pIm = ioC.m_pIm + inRowIndex * ioC.m_iRowStride;
+    if ( inNumOfCols == 8 && ioC.m_iColStride == 2 ) {
+        // [r0 i0 r1 i1 | r4 i4 r5 i5] and [r2 i2 r3 i3 | r6 i6 r7 i7] 
+        const __m256 m_vLow = _mm256_unpacklo_ps(inRe, inIm);
+        const __m256 m_vHigh = _mm256_unpackhi_ps(inRe, inIm);
+        _mm256_storeu_ps(m_pRe,     _mm256_add_ps(_mm256_loadu_ps(m_pRe),     _mm256_permute2f128_ps(m_vLow, m_vHigh, 0x20)));
+        _mm256_storeu_ps(m_pRe + 8, _mm256_add_ps(_mm256_loadu_ps(m_pRe + 8), _mm256_permute2f128_ps(m_vLow, m_vHigh, 0x31)));
+    }
+    else if ( inNumOfCols == 8 && ioC.m_iColStride == 1 ) {
+        _mm256_storeu_ps(m_pRe, _mm256_add_ps(_mm256_loadu_ps(m_pRe), inRe));
+        _mm256_storeu_ps(m_pIm, _mm256_add_ps(_mm256_loadu_ps(m_pIm), inIm));
+    }
+    else {
+        float m_arrfRe[8], m_arrfIm[8];
+        _mm256_storeu_ps(m_arrfRe, inRe);
+        _mm256_storeu_ps(m_arrfIm, inIm);
+        AddSplitTileRowScalar(ioC, inRowIndex, m_arrfRe, m_arrfIm, inNumOfCols);
+    }
+}
 
-    MultiplyPauliAlgebraByScalar(conj(inZ), m_paeResult);
-    cout << m_paeResult.PauliAlgebraElementToString() << endl;
-    m_paeResult.PrintMatrix();
+
+__attribute__((target("avx2,fma")))
+static void GemmMicroKernelAvx2(const size_t inDepth, const float *inPackedA, const float *inPackedB, 
+                                const CStridedComplex &ioC, const size_t inNumOfRows, const size_t inNumOfCols)
+/********************************************
+ *       Purpose: AVX2 version of GemmMicroKernelScalar() for a 4 x 8 tile.
+ *                Each tile row is one real and one imaginary accumulator, updated by
+ *                re += a_re b_re - a_im b_im and im += a_re b_im + a_im b_re as fused multiply adds.
+ *  Precondition: See GemmMicroKernelScalar().
+ * Postcondition: N/A
+********************************************/ 
+{
+    __m256 m_vRe0 = _mm256_setzero_ps(), m_vIm0 = _mm256_setzero_ps();
+    __m256 m_vRe1 = _mm256_setzero_ps(), m_vIm1 = _mm256_setzero_ps();
+    __m256 m_vRe2 = _mm256_setzero_ps(), m_vIm2 = _mm256_setzero_ps();
+    __m256 m_vRe3 = _mm256_setzero_ps(), m_vIm3 = _mm256_setzero_ps();
+
+    for ( size_t k = 0; k < inDepth; k++ ) {
+        const float *m_pA = inPackedA + k * 2 * GEMM_MR;
+        const __m256 m_vBRe = _mm256_loadu_ps(inPackedB + k * 16);
+        const __m256 m_vBIm = _mm256_loadu_ps(inPackedB + k * 16 + 8);
+        __m256 m_vARe, m_vAIm;
+
+        m_vARe = _mm256_broadcast_ss(m_pA + 0);  m_vAIm = _mm256_broadcast_ss(m_pA + 4);
+        m_vRe0 = _mm256_fnmadd_ps(m_vAIm, m_vBIm, _mm256_fmadd_ps(m_vARe, m_vBRe, m_vRe0));
+        m_vIm0 = _mm256_fmadd_ps(m_vAIm, m_vBRe, _mm256_fmadd_ps(m_vARe, m_vBIm, m_vIm0));
+        m_vARe = _mm256_broadcast_ss(m_pA + 1);  m_vAIm = _mm256_broadcast_ss(m_pA + 5);
+        m_vRe1 = _mm256_fnmadd_ps(m_vAIm, m_vBIm, _mm256_fmadd_ps(m_vARe, m_vBRe, m_vRe1));
+        m_vIm1 = _mm256_fmadd_ps(m_vAIm, m_vBRe, _mm256_fmadd_ps(m_vARe, m_vBIm, m_vIm1));
+        m_vARe = _mm256_broadcast_ss(m_pA + 2);  m_vAIm = _mm256_broadcast_ss(m_pA + 6);
+        m_vRe2 = _mm256_fnmadd_ps(m_vAIm, m_vBIm, _mm256_fmadd_ps(m_vARe, m_vBRe, m_vRe2));
+        m_vIm2 = _mm256_fmadd_ps(m_vAIm, m_vBRe, _mm256_fmadd_ps(m_vARe, m_vBIm, m_vIm2));
+        m_vARe = _mm256_broadcast_ss(m_pA + 3);  m_vAIm = _mm256_broadcast_ss(m_pA + 7);
+        m_vRe3 = _mm256_fnmadd_ps(m_vAIm, m_vBIm, _mm256_fmadd_ps(m_vARe, m_vBRe, m_vRe3));
+        m_vIm3 = _mm256_fmadd_ps(m_vAIm, m_vBRe, _mm256_fmadd_ps(m_vARe, m_vBIm, m_vIm3));
+    }
+
+    if ( inNumOfRows > 0 ) AddSplitTileAvx2(ioC, 0, m_vRe0, m_vIm0, inNumOfCols);
+    if ( inNumOfRows > 1 ) AddSplitTileAvx2(ioC, 1, m_vRe1, m_vIm1, inNumOfCols);
+    if ( inNumOfRows > 2 ) AddSplitTileAvx2(ioC, 2, m_vRe2, m_vIm2, inNumOfCols);
+    if ( inNumOfRows > 3 ) AddSplitTileAvx2(ioC, 3, m_vRe3, m_vIm3, inNumOfCols);
 }
 
 
-void TestAddPauliAlgebra( const complex<float> &inZ1, const string &inPAString1, const complex<float> &inZ2, const string &inPAString2)
+__attribute__((target("avx2,fma")))
+static void MatrixVectorAvx2(const complex<float> *inMatrix, const size_t inNumOfRows, const size_t inNumOfCols, const size_t inLd, 
+                             const complex<float> *inVector, complex<float> *outVector)
 /********************************************
- *       Purpose: Test AddPauliAlgebra() function.
- *  Precondition: N/A
+ *       Purpose: AVX2 version of MatrixVectorScalar() on interleaved complex data.
+ *                With a = [a_re a_im ...] and x = [x_re x_im ...], one accumulator sums a * x 
+ *                and another sums a * swap(x). The real part is then the even lanes minus the 
+ *                odd lanes of the first and the imaginary part is all lanes of the second.
+ *  Precondition: See MatrixVectorScalar().
  * Postcondition: N/A
-********************************************/
+********************************************/ 
 {
-    CPauliAlgebraElement m_paeElement1 = MakePauliAlgebraElement(inPAString1);
-    MultiplyPauliAlgebraByScalar(inZ1, m_paeElement1);
-    cout << "First Pauli Element: " << m_paeElement1.PauliAlgebraElementToString() << endl;
-    m_paeElement1.PrintMatrix();
+    const size_t m_iNumOfVectorCols = inNumOfCols & ~size_t(3);
+    const __m256 m_vSigns = _mm256_setr_ps(1, -1, 1, -1, 1, -1, 1, -1);
+    const float *m_pVector = reinterpret_cast<const float *>(inVector);
+
+    for ( size_t r = 0; r < inNumOfRows; r++ ) {
+        const float *m_pRow = reinterpret_cast<const float *>(inMatrix + r * inLd);
+        __m256 m_vDirect = _mm256_setzero_ps();
+        __m256 m_vSwapped = _mm256_setzero_ps();
+        for ( size_t c = 0; c < m_iNumOfVectorCols; c += 4 ) {
+            const __m256 m_vA = _mm256_loadu_ps(m_pRow + 2 * c);
+            const __m256 m_vX = _mm256_loadu_ps(m_pVector + 2 * c);
+            m_vDirect = _mm256_fmadd_ps(m_vA, m_vX, m_vDirect);
+            m_vSwapped = _mm256_fmadd_ps(m_vA, _mm256_permute_ps(m_vX, 0xB1), m_vSwapped);
+        }
 
-    CPauliAlgebraElement m_paeElement2 = MakePauliAlgebraElement(inPAString2);
-    MultiplyPauliAlgebraByScalar(inZ2, m_paeElement2);
-    cout << "Second Pauli Element: " << m_paeElement2.PauliAlgebraElementToString() << endl;
-    m_paeElement2.PrintMatrix();
+        float m_arrfDirect[8], m_arrfSwapped[8];
+        _mm256_storeu_ps(m_arrfDirect, _mm256_mul_ps(m_vDirect, m_vSigns));
+        _mm256_storeu_ps(m_arrfSwapped, m_vSwapped);
+        float m_fRe = 0, m_fIm = 0;
+        for ( size_t i = 0; i < 8; i++ ) {
+            m_fRe += m_arrfDirect[i];
+            m_fIm += m_arrfSwapped[i];
+        }
+        for ( size_t c = m_iNumOfVectorCols; c < inNumOfCols; c++ ) {
+            const complex<float> m_cxEntry = inMatrix[r * inLd + c];
+            m_fRe += m_cxEntry.real() * inVector[c].real() - m_cxEntry.imag() * inVector[c].imag();
+            m_fIm += m_cxEntry.real() * inVector[c].imag() + m_cxEntry.imag() * inVector[c].real();
+        }
+        outVector[r] = complex<float>(m_fRe, m_fIm);
+    }
+}
 
-    CPauliAlgebraElement m_paeResult = AddPauliAlgebra(m_paeElement1, m_paeElement2);
-    cout << "First plus Second Element: " << "(" << m_paeElement1.PauliAlgebraElementToString() << ")" << " + " << "(" << m_paeElement2.PauliAlgebraElementToString() << ")" << " = " << m_paeResult.PauliAlgebraElementToString() << endl;
-    m_paeResult.PrintMatrix();
+
+__attribute__((target("avx2,fma")))
+static void AddAvx2(const complex<float> *inValues1, const complex<float> *inValues2, complex<float> *outValues, const size_t inLength)
+/********************************************
+ *       Purpose: AVX2 version of AddScalar().
+ *  Precondition: N/A
+ * Postcondition: outValues may alias either input.
+********************************************/ 
+{
+    const float *m_pValues1 = reinterpret_cast<const float *>(inValues1);
+    const float *m_pValues2 = reinterpret_cast<const float *>(inValues2);
+    float *m_pOut = reinterpret_cast<float *>(outValues);
+    const size_t m_iNumOfFloats = 2 * inLength;
+    size_t i = 0;
+    for ( ; i + 8 <= m_iNumOfFloats; i += 8 )
+        _mm256_storeu_ps(m_pOut + i, _mm256_add_ps(_mm256_loadu_ps(m_pValues1 + i), _mm256_loadu_ps(m_pValues2 + i)));
+    for ( ; i < m_iNumOfFloats; i++ )
+        m_pOut[i] = m_pValues1[i] + m_pValues2[i];
 }
 
-void GetPauliString(const string &inPauliChar1, const string &inPauliChar2, complex<float> &outFactor, string &outPauliChar3)
+
+__attribute__((target("avx2,fma")))
+static void ScaleAvx2(const complex<float> *inValues, const complex<float> inZ, complex<float> *outValues, const size_t inLength)
 /********************************************
- *       Purpose: 4th input parameter is modified to the single character string 
- *                representing the resulting matrix of multiplying the first input 
- *                parameter matrix string with the second input parameter matrix.
- *                3rd input parameter is the resulting factor.
- * 
- *                Pauli Matrix Strings are: "I", "X", "Y", "Z"
- *                IX = XI = X
- *                IY = YI = Y
- *                IZ = ZI = Z
- *                XY = iZ 
- *                XZ = -iY
- *                YX = -iZ
- *                YZ = iX
- *                ZX = iY
- *                ZY = -iX
- *              
- *              Associativity Rule: 
- *              c(AB) = c(A)B = A(cB)
- *              where c is a constant
- *              A and B are matrices.
- * 
- *  Precondition: Must not modify 1st and 2nd input parameters.
- * Postcondition: Must modify 3rd and 4th input parameters.
- *          Note: N/A
+ *       Purpose: AVX2 version of ScaleScalar() on interleaved complex data.
+ *                With v = [re im ...], z * v = fmaddsub(v, z_re, swap(v) * z_im).
+ *  Precondition: N/A
+ * Postcondition: outValues may alias inValues.
 ********************************************/ 
-{    
-    if (!inPauliChar1.compare("I") && (!inPauliChar2.compare("I")  ||
-                                       !inPauliChar2.compare("X")  || 
-                                       !inPauliChar2.compare("Y")  ||
-                                       !inPauliChar2.compare("Z")))
-    {
-        outFactor = complex<float>(1, 0);
-        outPauliChar3 = inPauliChar2;
-    }
-    else if (!inPauliChar2.compare("I") && (!inPauliChar1.compare("I")  ||
-                                            !inPauliChar1.compare("X")  || 
-                                            !inPauliChar1.compare("Y")  ||
-                                            !inPauliChar1.compare("Z")))
-    {
-        outFactor = complex<float>(1, 0);
-        outPauliChar3 = inPauliChar1;
+{
+    const float *m_pIn = reinterpret_cast<const float *>(inValues);
+    float *m_pOut = reinterpret_cast<float *>(outValues);
+    const __m256 m_vZRe = _mm256_set1_ps(inZ.real());
+    const __m256 m_vZIm = _mm256_set1_ps(inZ.imag());
+    size_t i = 0;
+    for ( ; i + 4 <= inLength; i += 4 ) {
+        const __m256 m_vValues = _mm256_loadu_ps(m_pIn + 2 * i);
+        const __m256 m_vSwapped = _mm256_mul_ps(_mm256_permute_ps(m_vValues, 0xB1), m_vZIm);
+        _mm256_storeu_ps(m_pOut + 2 * i, _mm256_fmaddsub_ps(m_vValues, m_vZRe, m_vSwapped));
     }
-    // Both inputs are the same.
-    else if (!inPauliChar1.compare(inPauliChar2)) {
-        outFactor = complex<float>(1, 0);
-        outPauliChar3 = "I";
+    ScaleScalar(inValues + i, inZ, outValues + i, inLength - i);
+}
+
+
+__attribute__((target("avx2,fma")))
+static inline void ConjugateTransposeTileAvx2(__m256d &ioRow0, __m256d &ioRow1, __m256d &ioRow2, __m256d &ioRow3)
+/********************************************
+ *       Purpose: Conjugate transpose a 4 x 4 tile of interleaved complex floats held in 4 registers.
+ *                Each complex float is moved as one 64 bit lane.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    const __m256d m_vConjugate = _mm256_castps_pd(_mm256_setr_ps(0, -0.0f, 0, -0.0f, 0, -0.0f, 0, -0.0f));
+    const __m256d m_vLow01 = _mm256_unpacklo_pd(ioRow0, ioRow1);
+    const __m256d m_vHigh01 = _mm256_unpackhi_pd(ioRow0, ioRow1);
+    const __m256d m_vLow23 = _mm256_unpacklo_pd(ioRow2, ioRow3);
+    const __m256d m_vHigh23 = _mm256_unpackhi_pd(ioRow2, ioRow3);
+    ioRow0 = _mm256_xor_pd(_mm256_permute2f128_pd(m_vLow01, m_vLow23, 0x20), m_vConjugate);
+    ioRow1 = _mm256_xor_pd(_mm256_permute2f128_pd(m_vHigh01, m_vHigh23, 0x20), m_vConjugate);
+    ioRow2 = _mm256_xor_pd(_mm256_permute2f128_pd(m_vLow01, m_vLow23, 0x31), m_vConjugate);
+    ioRow3 = _mm256_xor_pd(_mm256_permute2f128_pd(m_vHigh01, m_vHigh23, 0x31), m_vConjugate);
+}
+
+
+__attribute__((target("avx2,fma")))
+static void ConjugateTransposeAvx2(complex<float> *ioMatrix, const size_t inSideLength, const size_t inRowBegin, const size_t inRowEnd)
+/********************************************
+ *       Purpose: AVX2 version of ConjugateTransposeScalarKernel().
+ *                4 x 4 tiles are swapped with their mirror tiles, the edges are done one entry at a time 
+ *                by the range that ends at inSideLength.
+ *  Precondition: inRowBegin is a multiple of 4, and so is inRowEnd unless it is inSideLength.
+ * Postcondition: Disjoint row ranges touch disjoint entries, so they may run on different threads.
+********************************************/ 
+{
+    const size_t m_iTiledLength = inSideLength & ~size_t(3);
+    double *m_pMatrix = reinterpret_cast<double *>(ioMatrix);
+
+    for ( size_t tr = inRowBegin; tr < min(inRowEnd, m_iTiledLength); tr += 4 ) {
+        for ( size_t tc = tr; tc < m_iTiledLength; tc += 4 ) {
+            double *m_pTile1 = m_pMatrix + tr * inSideLength + tc;
+            double *m_pTile2 = m_pMatrix + tc * inSideLength + tr;
+            __m256d m_vRow10 = _mm256_loadu_pd(m_pTile1);
+            __m256d m_vRow11 = _mm256_loadu_pd(m_pTile1 + inSideLength);
+            __m256d m_vRow12 = _mm256_loadu_pd(m_pTile1 + 2 * inSideLength);
+            __m256d m_vRow13 = _mm256_loadu_pd(m_pTile1 + 3 * inSideLength);
+            ConjugateTransposeTileAvx2(m_vRow10, m_vRow11, m_vRow12, m_vRow13);
+
+            if ( tr != tc ) {
+                __m256d m_vRow20 = _mm256_loadu_pd(m_pTile2);
+                __m256d m_vRow21 = _mm256_loadu_pd(m_pTile2 + inSideLength);
+                __m256d m_vRow22 = _mm256_loadu_pd(m_pTile2 + 2 * inSideLength);
+                __m256d m_vRow23 = _mm256_loadu_pd(m_pTile2 + 3 * inSideLength);
+                ConjugateTransposeTileAvx2(m_vRow20, m_vRow21, m_vRow22, m_vRow23);
+                _mm256_storeu_pd(m_pTile1, m_vRow20);
+                _mm256_storeu_pd(m_pTile1 + inSideLength, m_vRow21);
+                _mm256_storeu_pd(m_pTile1 + 2 * inSideLength, m_vRow22);
+                _mm256_storeu_pd(m_pTile1 + 3 * inSideLength, m_vRow23);
+            }
+            _mm256_storeu_pd(m_pTile2, m_vRow10);
+            _mm256_storeu_pd(m_pTile2 + inSideLength, m_vRow11);
+            _mm256_storeu_pd(m_pTile2 + 2 * inSideLength, m_vRow12);
+            _mm256_storeu_pd(m_pTile2 + 3 * inSideLength, m_vRow13);
+        }
     }
-    else if (!inPauliChar1.compare("X") && !inPauliChar2.compare("Y")) {
-        outFactor = complex<float>(0, 1);
-        outPauliChar3 = "Z"; 
+    if ( inRowEnd == inSideLength )
+        ConjugateTransposeScalar(ioMatrix, inSideLength, m_iTiledLength);
+}
+
+
+__attribute__((target("avx2,fma")))
+static bool EqualAvx2(const complex<float> *inValues1, const complex<float> *inValues2, const size_t inLength)
+/********************************************
+ *       Purpose: AVX2 version of EqualScalar(). Compares 4 complex entries at a time.
+ *  Precondition: N/A
+ * Postcondition: Follows float comparison, so 0 == -0 and NaN != NaN.
+********************************************/ 
+{
+    const float *m_pValues1 = reinterpret_cast<const float *>(inValues1);
+    const float *m_pValues2 = reinterpret_cast<const float *>(inValues2);
+    size_t i = 0;
+    for ( ; i + 4 <= inLength; i += 4 ) {
+        const __m256 m_vEqual = _mm256_cmp_ps(_mm256_loadu_ps(m_pValues1 + 2 * i), _mm256_loadu_ps(m_pValues2 + 2 * i), _CMP_EQ_OQ);
+        if ( _mm256_movemask_ps(m_vEqual) != 0xFF )
+            return false;
     }
-    else if (!inPauliChar1.compare("X") && !inPauliChar2.compare("Z")) {
-        outFactor = complex<float>(0, -1);
-        outPauliChar3 = "Y"; 
+    return EqualScalar(inValues1 + i, inValues2 + i, inLength - i);
+}
+
+
+__attribute__((target("avx2,fma")))
+static double DotAvx2(const float *inValues1, const float *inValues2, const size_t inLength, const bool inIsCompensated)
+/********************************************
+ *       Purpose: AVX2 version of DotScalar(). Each of the 8 lanes keeps its own sum and compensation.
+ *  Precondition: N/A
+ * Postcondition: The lanes are added in double.
+********************************************/ 
+{
+    __m256 m_vSum = _mm256_setzero_ps();
+    __m256 m_vCompensation = _mm256_setzero_ps();
+    size_t i = 0;
+    if ( inIsCompensated ) {
+        for ( ; i + 8 <= inLength; i += 8 ) {
+            const __m256 m_vValue = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(inValues1 + i), _mm256_loadu_ps(inValues2 + i)), m_vCompensation);
+            const __m256 m_vNewSum = _mm256_add_ps(m_vSum, m_vValue);
+            m_vCompensation = _mm256_sub_ps(_mm256_sub_ps(m_vNewSum, m_vSum), m_vValue);
+            m_vSum = m_vNewSum;
+        }
     }
-    else if (!inPauliChar1.compare("Y") && !inPauliChar2.compare("X")) {
-        outFactor = complex<float>(0, -1);
-        outPauliChar3 = "Z"; 
+    else
+        for ( ; i + 8 <= inLength; i += 8 )
+            m_vSum = _mm256_fmadd_ps(_mm256_loadu_ps(inValues1 + i), _mm256_loadu_ps(inValues2 + i), m_vSum);
+
+    float m_arrfSum[8], m_arrfCompensation[8];
+    _mm256_storeu_ps(m_arrfSum, m_vSum);
+    _mm256_storeu_ps(m_arrfCompensation, m_vCompensation);
+    double m_dSum = 0;
+    for ( size_t l = 0; l < 8; l++ )
+        m_dSum += double(m_arrfSum[l]) - double(m_arrfCompensation[l]);
+    return m_dSum + DotScalar(inValues1 + i, inValues2 + i, inLength - i, inIsCompensated);
+}
+
+
+__attribute__((target("avx2,fma")))
+static complex<double> ComplexDotAvx2(const complex<float> *inValues1, const complex<float> *inValues2, const size_t inLength, 
+                                      const bool inIsConjugated, const bool inIsCompensated)
+/********************************************
+ *       Purpose: AVX2 version of ComplexDotScalar() on interleaved complex data.
+ *                As in MatrixVectorAvx2(), one accumulator sums x * y and another sums x * swap(y). 
+ *                Their even and odd lanes are combined with the signs of the plain or conjugated product at the end.
+ *  Precondition: N/A
+ * Postcondition: Each lane keeps its own sum and compensation. The lanes are added in double.
+********************************************/ 
+{
+    const float *m_pValues1 = reinterpret_cast<const float *>(inValues1);
+    const float *m_pValues2 = reinterpret_cast<const float *>(inValues2);
+    __m256 m_vDirect = _mm256_setzero_ps();
+    __m256 m_vSwapped = _mm256_setzero_ps();
+    __m256 m_vDirectCompensation = _mm256_setzero_ps();
+    __m256 m_vSwappedCompensation = _mm256_setzero_ps();
+    size_t i = 0;
+    for ( ; i + 4 <= inLength; i += 4 ) {
+        const __m256 m_vX = _mm256_loadu_ps(m_pValues1 + 2 * i);
+        const __m256 m_vY = _mm256_loadu_ps(m_pValues2 + 2 * i);
+        if ( inIsCompensated ) {
+            const __m256 m_vDirectValue = _mm256_sub_ps(_mm256_mul_ps(m_vX, m_vY), m_vDirectCompensation);
+            const __m256 m_vSwappedValue = _mm256_sub_ps(_mm256_mul_ps(m_vX, _mm256_permute_ps(m_vY, 0xB1)), m_vSwappedCompensation);
+            const __m256 m_vNewDirect = _mm256_add_ps(m_vDirect, m_vDirectValue);
+            const __m256 m_vNewSwapped = _mm256_add_ps(m_vSwapped, m_vSwappedValue);
+            m_vDirectCompensation = _mm256_sub_ps(_mm256_sub_ps(m_vNewDirect, m_vDirect), m_vDirectValue);
+            m_vSwappedCompensation = _mm256_sub_ps(_mm256_sub_ps(m_vNewSwapped, m_vSwapped), m_vSwappedValue);
+            m_vDirect = m_vNewDirect;
+            m_vSwapped = m_vNewSwapped;
+        }
+        else {
+            m_vDirect = _mm256_fmadd_ps(m_vX, m_vY, m_vDirect);
+            m_vSwapped = _mm256_fmadd_ps(m_vX, _mm256_permute_ps(m_vY, 0xB1), m_vSwapped);
+        }
     }
-    else if (!inPauliChar1.compare("Y") && !inPauliChar2.compare("Z")) {
-        outFactor = complex<float>(0, 1);
-        outPauliChar3 = "X"; 
+
+    // Even lanes of x * y hold re re, odd lanes im im. Even lanes of x * swap(y) hold re im, odd lanes im re.
+    float m_arrfDirect[8], m_arrfSwapped[8], m_arrfDirectCompensation[8], m_arrfSwappedCompensation[8];
+    _mm256_storeu_ps(m_arrfDirect, m_vDirect);
+    _mm256_storeu_ps(m_arrfSwapped, m_vSwapped);
+    _mm256_storeu_ps(m_arrfDirectCompensation, m_vDirectCompensation);
+    _mm256_storeu_ps(m_arrfSwappedCompensation, m_vSwappedCompensation);
+    const double m_dOddSign = inIsConjugated ? 1.0 : -1.0;
+    double m_dRe = 0, m_dIm = 0;
+    for ( size_t l = 0; l < 8; l += 2 ) {
+        m_dRe += (double(m_arrfDirect[l]) - double(m_arrfDirectCompensation[l])) + m_dOddSign * (double(m_arrfDirect[l + 1]) - double(m_arrfDirectCompensation[l + 1]));
+        m_dIm += (double(m_arrfSwapped[l]) - double(m_arrfSwappedCompensation[l])) - m_dOddSign * (double(m_arrfSwapped[l + 1]) - double(m_arrfSwappedCompensation[l + 1]));
     }
-    else if (!inPauliChar1.compare("Z") && !inPauliChar2.compare("X")) {
-        outFactor = complex<float>(0, 1);
-        outPauliChar3 = "Y"; 
+    return complex<double>(m_dRe, m_dIm) + ComplexDotScalar(inValues1 + i, inValues2 + i, inLength - i, inIsConjugated, inIsCompensated);
+}
+
+// GCC's own AVX-512 intrinsics start from _mm512_undefined_ps(), which -Wmaybe-uninitialized reports as a false positive.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f")))
+static inline void AddSplitTileAvx512(const CStridedComplex &ioC, const size_t inRowIndex, const __m512 inRe, const __m512 inIm, const size_t inNumOfCols)
+/********************************************
+ *       Purpose: Add 16 split complex values to the first inNumOfCols entries of row inRowIndex of ioC.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    float *m_pRe = ioC.m_pRe + inRowIndex * ioC.m_iRowStride;
+    float *m_pIm = ioC.m_pIm + inRowIndex * ioC.m_iRowStride;
+    if ( inNumOfCols == 16 && ioC.m_iColStride == 2 ) {
+        const __m512i m_vLowIndex = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+        const __m512i m_vHighIndex = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+        _mm512_storeu_ps(m_pRe,      _mm512_add_ps(_mm512_loadu_ps(m_pRe),      _mm512_permutex2var_ps(inRe, m_vLowIndex, inIm)));
+        _mm512_storeu_ps(m_pRe + 16, _mm512_add_ps(_mm512_loadu_ps(m_pRe + 16), _mm512_permutex2var_ps(inRe, m_vHighIndex, inIm)));
     }
-    else if (!inPauliChar1.compare("Z") && !inPauliChar2.compare("Y")) {
-        outFactor = complex<float>(0, -1);
-        outPauliChar3 = "X"; 
+    else if ( inNumOfCols == 16 && ioC.m_iColStride == 1 ) {
+        _mm512_storeu_ps(m_pRe, _mm512_add_ps(_mm512_loadu_ps(m_pRe), inRe));
+        _mm512_storeu_ps(m_pIm, _mm512_add_ps(_mm512_loadu_ps(m_pIm), inIm));
     }
     else {
-        cout << "ERROR: One of your input strings is not a pauli character." << "\n"
-             << "Exiting Program . . .";
-        exit(1);
+        float m_arrfRe[16], m_arrfIm[16];
+        _mm512_storeu_ps(m_arrfRe, inRe);
+        _mm512_storeu_ps(m_arrfIm, inIm);
+        AddSplitTileRowScalar(ioC, inRowIndex, m_arrfRe, m_arrfIm, inNumOfCols);
     }
 }
 
 
-CPauliAlgebraElement CPauliAlgebraElement::operator%(const CPauliAlgebraElement &inPAElement2) const
+__attribute__((target("avx512f")))
+static void GemmMicroKernelAvx512(const size_t inDepth, const float *inPackedA, const float *inPackedB, 
+                                  const CStridedComplex &ioC, const size_t inNumOfRows, const size_t inNumOfCols)
 /********************************************
- *       Purpose: Add matrix data member entries of first input PauliAlgebraElement object 
- *                with the matrix data member entries of second input PauliAlgebraElement object.
- *                i(Z @ X) * -(Z @ Y) = I @ Z
- *  Precondition: N/A
+ *       Purpose: AVX-512 version of GemmMicroKernelAvx2() for a 4 x 16 tile.
+ *  Precondition: See GemmMicroKernelScalar().
  * Postcondition: N/A
- *          TODO: - REFACTOR, OPTIMIZE CODE, MAINTAIN DATA ENCAPSULATION.
- *                - Change operator % to something else.
- *                  Operator overloading should be for * operator.
- *                  However, the * operator is already overloaded for 
- *                  PauliAlgebraElement() * PauliAlgebraElement(). 
- *                  Add another parameter to operator overload for *
- *                  that acts as a key to switch between different 
- *                  functionalities.
- *                - Verify valid input parameters.
-********************************************/
+********************************************/ 
 {
-    if (this->m_sElementString.size() != inPAElement2.m_sElementString.size()) {
-        cout << "Multiplying Pauli Elements Failed. Pauli elements do not match in size: " << this->m_sElementString << " and " << inPAElement2.m_sElementString << endl;
-        exit(1);
+    __m512 m_vRe0 = _mm512_setzero_ps(), m_vIm0 = _mm512_setzero_ps();
+    __m512 m_vRe1 = _mm512_setzero_ps(), m_vIm1 = _mm512_setzero_ps();
+    __m512 m_vRe2 = _mm512_setzero_ps(), m_vIm2 = _mm512_setzero_ps();
+    __m512 m_vRe3 = _mm512_setzero_ps(), m_vIm3 = _mm512_setzero_ps();
+
+    for ( size_t k = 0; k < inDepth; k++ ) {
+        const float *m_pA = inPackedA + k * 2 * GEMM_MR;
+        const __m512 m_vBRe = _mm512_loadu_ps(inPackedB + k * 32);
+        const __m512 m_vBIm = _mm512_loadu_ps(inPackedB + k * 32 + 16);
+        __m512 m_vARe, m_vAIm;
+
+        m_vARe = _mm512_set1_ps(m_pA[0]);  m_vAIm = _mm512_set1_ps(m_pA[4]);
+        m_vRe0 = _mm512_fnmadd_ps(m_vAIm, m_vBIm, _mm512_fmadd_ps(m_vARe, m_vBRe, m_vRe0));
+        m_vIm0 = _mm512_fmadd_ps(m_vAIm, m_vBRe, _mm512_fmadd_ps(m_vARe, m_vBIm, m_vIm0));
+        m_vARe = _mm512_set1_ps(m_pA[1]);  m_vAIm = _mm512_set1_ps(m_pA[5]);
+        m_vRe1 = _mm512_fnmadd_ps(m_vAIm, m_vBIm, _mm512_fmadd_ps(m_vARe, m_vBRe, m_vRe1));
+        m_vIm1 = _mm512_fmadd_ps(m_vAIm, m_vBRe, _mm512_fmadd_ps(m_vARe, m_vBIm, m_vIm1));
+        m_vARe = _mm512_set1_ps(m_pA[2]);  m_vAIm = _mm512_set1_ps(m_pA[6]);
+        m_vRe2 = _mm512_fnmadd_ps(m_vAIm, m_vBIm, _mm512_fmadd_ps(m_vARe, m_vBRe, m_vRe2));
+        m_vIm2 = _mm512_fmadd_ps(m_vAIm, m_vBRe, _mm512_fmadd_ps(m_vARe, m_vBIm, m_vIm2));
+        m_vARe = _mm512_set1_ps(m_pA[3]);  m_vAIm = _mm512_set1_ps(m_pA[7]);
+        m_vRe3 = _mm512_fnmadd_ps(m_vAIm, m_vBIm, _mm512_fmadd_ps(m_vARe, m_vBRe, m_vRe3));
+        m_vIm3 = _mm512_fmadd_ps(m_vAIm, m_vBRe, _mm512_fmadd_ps(m_vARe, m_vBIm, m_vIm3));
     }
 
-    // First Pauli Algebra multiplication between the first two matrices.
-    // For example, if the algebra multiplication is i(Z @ X) * -(Z @ Y)
-    // then this code below does iZ * -Z = -iI
-    string m_sLeftPauChar = string(1, this->m_sElementString.at(0));
-    string m_sRightPauChar = string(1, inPAElement2.m_sElementString.at(0));
+    if ( inNumOfRows > 0 ) AddSplitTileAvx512(ioC, 0, m_vRe0, m_vIm0, inNumOfCols);
+    if ( inNumOfRows > 1 ) AddSplitTileAvx512(ioC, 1, m_vRe1, m_vIm1, inNumOfCols);
+    if ( inNumOfRows > 2 ) AddSplitTileAvx512(ioC, 2, m_vRe2, m_vIm2, inNumOfCols);
+    if ( inNumOfRows > 3 ) AddSplitTileAvx512(ioC, 3, m_vRe3, m_vIm3, inNumOfCols);
+}
+
+
+__attribute__((target("avx512f")))
+static void MatrixVectorAvx512(const complex<float> *inMatrix, const size_t inNumOfRows, const size_t inNumOfCols, const size_t inLd, 
+                               const complex<float> *inVector, complex<float> *outVector)
+/********************************************
+ *       Purpose: AVX-512 version of MatrixVectorAvx2().
+ *  Precondition: See MatrixVectorScalar().
+ * Postcondition: N/A
+********************************************/ 
+{
+    const size_t m_iNumOfVectorCols = inNumOfCols & ~size_t(7);
+    const __m512 m_vSigns = _mm512_setr_ps(1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1);
+    const float *m_pVector = reinterpret_cast<const float *>(inVector);
+
+    for ( size_t r = 0; r < inNumOfRows; r++ ) {
+        const float *m_pRow = reinterpret_cast<const float *>(inMatrix + r * inLd);
+        __m512 m_vDirect = _mm512_setzero_ps();
+        __m512 m_vSwapped = _mm512_setzero_ps();
+        for ( size_t c = 0; c < m_iNumOfVectorCols; c += 8 ) {
+            const __m512 m_vA = _mm512_loadu_ps(m_pRow + 2 * c);
+            const __m512 m_vX = _mm512_loadu_ps(m_pVector + 2 * c);
+            m_vDirect = _mm512_fmadd_ps(m_vA, m_vX, m_vDirect);
+            m_vSwapped = _mm512_fmadd_ps(m_vA, _mm512_permute_ps(m_vX, 0xB1), m_vSwapped);
+        }
 
-    complex<float> m_cxPhase;
-    string m_sPauliChar;
-    GetPauliString(m_sLeftPauChar, m_sRightPauChar, m_cxPhase, m_sPauliChar); // Z * Z = 1I where m_cxPhase = 1, m_sPauliChar = I
-    m_cxPhase *= this->m_cxElementPhase * inPAElement2.m_cxElementPhase;      // m_cxPhase = 1 * i * -1 = -i // Only need to do this once for the first algebra element multiplication.
-    CPauliAlgebraElement m_paeElement1 = CPauliAlgebraElement(m_sPauliChar);  // m_paeElement1 = I           // Verified m_sPauliChar is valid in the CPauliMatrix(string inPauliID) constructor.
-    MultiplyPauliAlgebraByScalar(m_cxPhase, m_paeElement1);                   // m_paeElement1 = -iI
+        float m_fRe = _mm512_reduce_add_ps(_mm512_mul_ps(m_vDirect, m_vSigns));
+        float m_fIm = _mm512_reduce_add_ps(m_vSwapped);
+        for ( size_t c = m_iNumOfVectorCols; c < inNumOfCols; c++ ) {
+            const complex<float> m_cxEntry = inMatrix[r * inLd + c];
+            m_fRe += m_cxEntry.real() * inVector[c].real() - m_cxEntry.imag() * inVector[c].imag();
+            m_fIm += m_cxEntry.real() * inVector[c].imag() + m_cxEntry.imag() * inVector[c].real();
+        }
+        outVector[r] = complex<float>(m_fRe, m_fIm);
+    }
+}
 
 
-    // Determine the number of Pauli Algebra Multiplications.
-    // For Example: Go from "X @ X @ I" to "XXI" which requires cutting out "@" and " ".
-    // TODO: Refactor this by using this format, "XXI", rather than this format, "X @ X @ I", for the data member m_sElementString.
-    string stripped_pstring = this->m_sElementString;
-    stripped_pstring.erase(std::remove(stripped_pstring.begin(), stripped_pstring.end(), '@'), stripped_pstring.end());
-    stripped_pstring.erase(std::remove(stripped_pstring.begin(), stripped_pstring.end(), ' '), stripped_pstring.end());
+__attribute__((target("avx512f")))
+static void AddAvx512(const complex<float> *inValues1, const complex<float> *inValues2, complex<float> *outValues, const size_t inLength)
+/********************************************
+ *       Purpose: AVX-512 version of AddScalar().
+ *  Precondition: N/A
+ * Postcondition: outValues may alias either input.
+********************************************/ 
+{
+    const float *m_pValues1 = reinterpret_cast<const float *>(inValues1);
+    const float *m_pValues2 = reinterpret_cast<const float *>(inValues2);
+    float *m_pOut = reinterpret_cast<float *>(outValues);
+    const size_t m_iNumOfFloats = 2 * inLength;
+    size_t i = 0;
+    for ( ; i + 16 <= m_iNumOfFloats; i += 16 )
+        _mm512_storeu_ps(m_pOut + i, _mm512_add_ps(_mm512_loadu_ps(m_pValues1 + i), _mm512_loadu_ps(m_pValues2 + i)));
+    for ( ; i < m_iNumOfFloats; i++ )
+        m_pOut[i] = m_pValues1[i] + m_pValues2[i];
+}
 
-    string stripped_pstring2 = inPAElement2.m_sElementString;
-    stripped_pstring2.erase(std::remove(stripped_pstring2.begin(), stripped_pstring2.end(), '@'), stripped_pstring2.end());
-    stripped_pstring2.erase(std::remove(stripped_pstring2.begin(), stripped_pstring2.end(), ' '), stripped_pstring2.end());
 
+__attribute__((target("avx512f")))
+static void ScaleAvx512(const complex<float> *inValues, const complex<float> inZ, complex<float> *outValues, const size_t inLength)
+/********************************************
+ *       Purpose: AVX-512 version of ScaleAvx2().
+ *  Precondition: N/A
+ * Postcondition: outValues may alias inValues.
+********************************************/ 
+{
+    const float *m_pIn = reinterpret_cast<const float *>(inValues);
+    float *m_pOut = reinterpret_cast<float *>(outValues);
+    const __m512 m_vZRe = _mm512_set1_ps(inZ.real());
+    const __m512 m_vZIm = _mm512_set1_ps(inZ.imag());
+    size_t i = 0;
+    for ( ; i + 8 <= inLength; i += 8 ) {
+        const __m512 m_vValues = _mm512_loadu_ps(m_pIn + 2 * i);
+        const __m512 m_vSwapped = _mm512_mul_ps(_mm512_permute_ps(m_vValues, 0xB1), m_vZIm);
+        _mm512_storeu_ps(m_pOut + 2 * i, _mm512_fmaddsub_ps(m_vValues, m_vZRe, m_vSwapped));
+    }
+    ScaleScalar(inValues + i, inZ, outValues + i, inLength - i);
+}
 
-    for ( unsigned short int e = 1; e < stripped_pstring.size(); e++ ) {
-        m_sLeftPauChar = string(1, stripped_pstring.at(e));
-        m_sRightPauChar = string(1, stripped_pstring2.at(e));
-        
-        // Nth Pauli Algebra multiplication between the two matrices.
-        // For example, if the algebra multiplication is i(Z @ X) * -(Z @ Y)
-        // then this code below does X * Y = iZ
-        complex<float> m_cxPhaseN;
-        string m_sPauliCharN;
-        GetPauliString(m_sLeftPauChar, m_sRightPauChar, m_cxPhaseN, m_sPauliCharN); // X * Y = iZ where m_cxPhase = i, m_sPauliChar = Z
-        CPauliAlgebraElement m_paeElement2 = CPauliAlgebraElement(m_sPauliCharN);   // m_paeElement2 = Z  // Verified m_sPauliChar is valid in the CPauliMatrix(string inPauliID) constructor.
-        MultiplyPauliAlgebraByScalar(m_cxPhaseN, m_paeElement2);                    // m_paeElement2 = iZ  
 
-        // Update current AlgebraElement. (i.e. update m_paeElement1)
-        // Does the tensor product, @,  between two pauli algebra elements.
-        // For example, if the algebra multiplication is i(Z @ X) * -(Z @ Y)
-        // then this code below does,  -iI @ iZ = 1(I @ Z) = m_paeElement1
-        string m_sP3String = m_paeElement1.m_sElementString + m_paeElement2.m_sElementString;
-        complex<float> m_cxTempPhase = m_paeElement1.m_cxElementPhase * m_paeElement2.m_cxElementPhase;
-        m_paeElement1 = MakePauliAlgebraElement(m_sP3String);
-        MultiplyPauliAlgebraByScalar(m_cxTempPhase, m_paeElement1);
+__attribute__((target("avx512f")))
+static bool EqualAvx512(const complex<float> *inValues1, const complex<float> *inValues2, const size_t inLength)
+/********************************************
+ *       Purpose: AVX-512 version of EqualScalar(). Compares 8 complex entries at a time.
+ *  Precondition: N/A
+ * Postcondition: Follows float comparison, so 0 == -0 and NaN != NaN.
+********************************************/ 
+{
+    const float *m_pValues1 = reinterpret_cast<const float *>(inValues1);
+    const float *m_pValues2 = reinterpret_cast<const float *>(inValues2);
+    size_t i = 0;
+    for ( ; i + 8 <= inLength; i += 8 ) {
+        if ( _mm512_cmp_ps_mask(_mm512_loadu_ps(m_pValues1 + 2 * i), _mm512_loadu_ps(m_pValues2 + 2 * i), _CMP_EQ_OQ) != 0xFFFF )
+            return false;
     }
+    return EqualScalar(inValues1 + i, inValues2 + i, inLength - i);
+}
+
 
-    return m_paeElement1;
+__attribute__((target("avx512f")))
+static double DotAvx512(const float *inValues1, const float *inValues2, const size_t inLength, const bool inIsCompensated)
+/********************************************
+ *       Purpose: AVX-512 version of DotScalar(). Each of the 16 lanes keeps its own sum and compensation.
+ *  Precondition: N/A
+ * Postcondition: The lanes are added in double.
+********************************************/ 
+{
+    __m512 m_vSum = _mm512_setzero_ps();
+    __m512 m_vCompensation = _mm512_setzero_ps();
+    size_t i = 0;
+    if ( inIsCompensated ) {
+        for ( ; i + 16 <= inLength; i += 16 ) {
+            const __m512 m_vValue = _mm512_sub_ps(_mm512_mul_ps(_mm512_loadu_ps(inValues1 + i), _mm512_loadu_ps(inValues2 + i)), m_vCompensation);
+            const __m512 m_vNewSum = _mm512_add_ps(m_vSum, m_vValue);
+            m_vCompensation = _mm512_sub_ps(_mm512_sub_ps(m_vNewSum, m_vSum), m_vValue);
+            m_vSum = m_vNewSum;
+        }
+    }
+    else
+        for ( ; i + 16 <= inLength; i += 16 )
+            m_vSum = _mm512_fmadd_ps(_mm512_loadu_ps(inValues1 + i), _mm512_loadu_ps(inValues2 + i), m_vSum);
+
+    float m_arrfSum[16], m_arrfCompensation[16];
+    _mm512_storeu_ps(m_arrfSum, m_vSum);
+    _mm512_storeu_ps(m_arrfCompensation, m_vCompensation);
+    double m_dSum = 0;
+    for ( size_t l = 0; l < 16; l++ )
+        m_dSum += double(m_arrfSum[l]) - double(m_arrfCompensation[l]);
+    return m_dSum + DotScalar(inValues1 + i, inValues2 + i, inLength - i, inIsCompensated);
 }
 
 
-CPauliAlgebraElement MultiplyPauliAlgebra(const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2)
+__attribute__((target("avx512f")))
+static complex<double> ComplexDotAvx512(const complex<float> *inValues1, const complex<float> *inValues2, const size_t inLength, 
+                                        const bool inIsConjugated, const bool inIsCompensated)
 /********************************************
- *       Purpose: Multiply first input Pauli algebra elements with second input Pauli algebra element.
+ *       Purpose: AVX-512 version of ComplexDotScalar() on interleaved complex data.
+ *                As in MatrixVectorAvx512(), one accumulator sums x * y and another sums x * swap(y). 
+ *                Their even and odd lanes are combined with the signs of the plain or conjugated product at the end.
  *  Precondition: N/A
- * Postcondition: N/A
- *          TODO: N/A
-********************************************/
+ * Postcondition: Each lane keeps its own sum and compensation. The lanes are added in double.
+********************************************/ 
 {
-    return inPAElement1 % inPAElement2;
+    const float *m_pValues1 = reinterpret_cast<const float *>(inValues1);
+    const float *m_pValues2 = reinterpret_cast<const float *>(inValues2);
+    __m512 m_vDirect = _mm512_setzero_ps();
+    __m512 m_vSwapped = _mm512_setzero_ps();
+    __m512 m_vDirectCompensation = _mm512_setzero_ps();
+    __m512 m_vSwappedCompensation = _mm512_setzero_ps();
+    size_t i = 0;
+    for ( ; i + 8 <= inLength; i += 8 ) {
+        const __m512 m_vX = _mm512_loadu_ps(m_pValues1 + 2 * i);
+        const __m512 m_vY = _mm512_loadu_ps(m_pValues2 + 2 * i);
+        if ( inIsCompensated ) {
+            const __m512 m_vDirectValue = _mm512_sub_ps(_mm512_mul_ps(m_vX, m_vY), m_vDirectCompensation);
+            const __m512 m_vSwappedValue = _mm512_sub_ps(_mm512_mul_ps(m_vX, _mm512_permute_ps(m_vY, 0xB1)), m_vSwappedCompensation);
+            const __m512 m_vNewDirect = _mm512_add_ps(m_vDirect, m_vDirectValue);
+            const __m512 m_vNewSwapped = _mm512_add_ps(m_vSwapped, m_vSwappedValue);
+            m_vDirectCompensation = _mm512_sub_ps(_mm512_sub_ps(m_vNewDirect, m_vDirect), m_vDirectValue);
+            m_vSwappedCompensation = _mm512_sub_ps(_mm512_sub_ps(m_vNewSwapped, m_vSwapped), m_vSwappedValue);
+            m_vDirect = m_vNewDirect;
+            m_vSwapped = m_vNewSwapped;
+        }
+        else {
+            m_vDirect = _mm512_fmadd_ps(m_vX, m_vY, m_vDirect);
+            m_vSwapped = _mm512_fmadd_ps(m_vX, _mm512_permute_ps(m_vY, 0xB1), m_vSwapped);
+        }
+    }
+
+    // Even lanes of x * y hold re re, odd lanes im im. Even lanes of x * swap(y) hold re im, odd lanes im re.
+    float m_arrfDirect[16], m_arrfSwapped[16], m_arrfDirectCompensation[16], m_arrfSwappedCompensation[16];
+    _mm512_storeu_ps(m_arrfDirect, m_vDirect);
+    _mm512_storeu_ps(m_arrfSwapped, m_vSwapped);
+    _mm512_storeu_ps(m_arrfDirectCompensation, m_vDirectCompensation);
+    _mm512_storeu_ps(m_arrfSwappedCompensation, m_vSwappedCompensation);
+    const double m_dOddSign = inIsConjugated ? 1.0 : -1.0;
+    double m_dRe = 0, m_dIm = 0;
+    for ( size_t l = 0; l < 16; l += 2 ) {
+        m_dRe += (double(m_arrfDirect[l]) - double(m_arrfDirectCompensation[l])) + m_dOddSign * (double(m_arrfDirect[l + 1]) - double(m_arrfDirectCompensation[l + 1]));
+        m_dIm += (double(m_arrfSwapped[l]) - double(m_arrfSwappedCompensation[l])) - m_dOddSign * (double(m_arrfSwapped[l + 1]) - double(m_arrfSwappedCompensation[l + 1]));
+    }
+    return complex<double>(m_dRe, m_dIm) + ComplexDotScalar(inValues1 + i, inValues2 + i, inLength - i, inIsConjugated, inIsCompensated);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+
+// One set of CMatrix kernels for one instruction set. 
+// GemmMicroKernel updates a GEMM_MR x m_iGemmNR tile, so B must be packed in slivers of m_iGemmNR columns.
+struct CMatrixKernels {
+    const char *m_sName;
+    size_t m_iGemmNR;
+    void (*GemmMicroKernel)(const size_t, const float *, const float *, const CStridedComplex &, const size_t, const size_t);
+    void (*MatrixVector)(const complex<float> *, const size_t, const size_t, const size_t, const complex<float> *, complex<float> *);
+    void (*Add)(const complex<float> *, const complex<float> *, complex<float> *, const size_t);
+    void (*Scale)(const complex<float> *, const complex<float>, complex<float> *, const size_t);
+    void (*ConjugateTranspose)(complex<float> *, const size_t, const size_t, const size_t);
+    bool (*Equal)(const complex<float> *, const complex<float> *, const size_t);
+    double (*Dot)(const float *, const float *, const size_t, const bool);
+    complex<double> (*ComplexDot)(const complex<float> *, const complex<float> *, const size_t, const bool, const bool);
+};
+
+static const CMatrixKernels SCALAR_KERNELS = { "scalar", 8, GemmMicroKernelScalar, MatrixVectorScalar, AddScalar, ScaleScalar, 
+                                               ConjugateTransposeScalarKernel, EqualScalar, DotScalar, ComplexDotScalar };
+#if defined(PML_X86_DISPATCH)
+static const CMatrixKernels AVX2_KERNELS = { "avx2", 8, GemmMicroKernelAvx2, MatrixVectorAvx2, AddAvx2, ScaleAvx2, 
+                                             ConjugateTransposeAvx2, EqualAvx2, DotAvx2, ComplexDotAvx2 };
+// The AVX2 transpose is already bound by memory, so the AVX-512 set reuses it.
+static const CMatrixKernels AVX512_KERNELS = { "avx512", 16, GemmMicroKernelAvx512, MatrixVectorAvx512, AddAvx512, ScaleAvx512, 
+                                               ConjugateTransposeAvx2, EqualAvx512, DotAvx512, ComplexDotAvx512 };
+#endif
+
+
+static const CMatrixKernels *FindMatrixKernels(const string &inInstructionSet)
+/********************************************
+ *       Purpose: Return the kernels for "scalar", "avx2" or "avx512" if this CPU supports them.
+ *  Precondition: N/A
+ * Postcondition: Returns NULL for unknown or unsupported instruction sets.
+********************************************/ 
+{
+    if ( inInstructionSet == "scalar" )
+        return &SCALAR_KERNELS;
+#if defined(PML_X86_DISPATCH)
+    __builtin_cpu_init();
+    if ( inInstructionSet == "avx2" && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") )
+        return &AVX2_KERNELS;
+    if ( inInstructionSet == "avx512" && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") )
+        return &AVX512_KERNELS;
+#endif
+    return NULL;
 }
 
 
-void TestMultiplyPauliAlgebra( const complex<float> &z1, const string &p1_algebra_string, const complex<float> &z2, const string &p2_algebra_string )
+static const CMatrixKernels *PickDefaultKernels()
 /********************************************
- *       Purpose: Test the MultiplyPauliAlgebra() function.
+ *       Purpose: Return the PML_SIMD environment variable's kernels if it names a supported instruction set, 
+ *                otherwise the widest ones this CPU supports.
  *  Precondition: N/A
- * Postcondition: N/A
-********************************************/
+ * Postcondition: Never returns NULL.
+********************************************/ 
 {
-    CPauliAlgebraElement p1 = MakePauliAlgebraElement(p1_algebra_string);
-    MultiplyPauliAlgebraByScalar(z1, p1);
-    cout << "First Pauli Element: " << p1.PauliAlgebraElementToString() << endl;
-    p1.PrintMatrix();
+    const CMatrixKernels *m_pKernels = NULL;
+    const char *m_sRequested = getenv("PML_SIMD");
+    if ( m_sRequested != NULL )
+        m_pKernels = FindMatrixKernels(m_sRequested);
+    const char *m_arrsWidestFirst[] = { "avx512", "avx2", "scalar" };
+    for ( size_t i = 0; i < 3 && m_pKernels == NULL; i++ )
+        m_pKernels = FindMatrixKernels(m_arrsWidestFirst[i]);
+    return m_pKernels;
+}
 
-    CPauliAlgebraElement p2 = MakePauliAlgebraElement(p2_algebra_string);
-    MultiplyPauliAlgebraByScalar(z2, p2);
-    cout << "Second Pauli Element: " << p2.PauliAlgebraElementToString() << endl;
-    p2.PrintMatrix();
 
-    const CPauliAlgebraElement p3 = MultiplyPauliAlgebra(p1, p2);    
-    cout << "Multiplication between pauli elements: " << "(" << p1.PauliAlgebraElementToString() << ")" << " * " << "(" << p2.PauliAlgebraElementToString() << ")" << " = " << p3.PauliAlgebraElementToString() << endl;
-    p3.PrintMatrix();
+static atomic<const CMatrixKernels *> &ActiveMatrixKernels()
+/********************************************
+ *       Purpose: Return the kernels in use. They are picked by PickDefaultKernels() on first use, in a 
+ *                static initializer, so the first calls may come from several ParallelFor() workers at once.
+ *  Precondition: N/A
+ * Postcondition: SetSimdInstructionSet() replaces the pointer atomically.
+********************************************/ 
+{
+    static atomic<const CMatrixKernels *> m_pKernels(PickDefaultKernels());
+    return m_pKernels;
 }
 
 
+static inline const CMatrixKernels &MatrixKernels()
+/********************************************
+ *       Purpose: Return the CMatrix kernels in use. See ActiveMatrixKernels().
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: Operations read the kernels once, before their parallel loop, so every chunk uses the same kernels.
+********************************************/ 
+{
+    return *ActiveMatrixKernels().load(memory_order_acquire);
+}
+
+
+string GetSimdInstructionSet()
+/********************************************
+ *       Purpose: Return the instruction set of the CMatrix kernels in use: "scalar", "avx2" or "avx512".
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    return MatrixKernels().m_sName;
+}
+
+
+bool SetSimdInstructionSet(const string &inInstructionSet)
+/********************************************
+ *       Purpose: Switch the CMatrix kernels to "scalar", "avx2" or "avx512".
+ *  Precondition: N/A
+ * Postcondition: Returns false and keeps the current kernels if this CPU does not support inInstructionSet.
+ *                Operations already running finish with the kernels they started with.
+********************************************/ 
+{
+    const CMatrixKernels *m_pKernels = FindMatrixKernels(inInstructionSet);
+    if ( m_pKernels == NULL )
+        return false;
+    ActiveMatrixKernels().store(m_pKernels, memory_order_release);
+    return true;
+}
+
+
+// Worker threads behind ParallelFor(). The calling thread runs chunks too, so a pool of 
+// N threads has N - 1 workers. Workers take chunks from a shared counter, so uneven chunks balance out.
+// One parallel loop runs at a time. A loop started inside a loop, or from another thread while 
+// a loop is running, stays on its own thread.
+class CThreadPool {
+public:
+    CThreadPool();
+    size_t GetNumOfThreads() const { return m_vecWorkers.size() + 1; };
+    void SetNumOfThreads(const size_t inNumOfThreads);
+    void Run(const size_t inNumOfChunks, const CFunctionReference<void(size_t)> &inChunkBody);
+
+private:
+    void StartWorkers(size_t inNumOfThreads);
+    void StopWorkers();
+    void WorkerLoop();
+    size_t RunChunks(const CFunctionReference<void(size_t)> &inChunkBody, const size_t inNumOfChunks);
+
+    vector<thread> m_vecWorkers;
+    mutex m_mtxLoop;                          // Held by the thread running a parallel loop.
+    mutex m_mtxJob;                           // Guards every member below except m_iNextChunk.
+    condition_variable m_cvWork;
+    condition_variable m_cvDone;
+    const CFunctionReference<void(size_t)> *m_pJob; // NULL when no loop is running.
+    size_t m_iNumOfChunks;
+    atomic<size_t> m_iNextChunk;
+    size_t m_iNumOfFinishedChunks;
+    size_t m_iNumOfActiveWorkers;             // Workers that took the current job and have not handed it back.
+    unsigned long m_iGeneration;              // Incremented for every job, so workers wake once per job.
+    bool m_bIsStopping;
+};
+
+static thread_local bool t_bIsInParallelLoop = false;
+
+
+CThreadPool::CThreadPool() 
+    : m_pJob(NULL), m_iNumOfChunks(0), m_iNextChunk(0), m_iNumOfFinishedChunks(0), m_iNumOfActiveWorkers(0), m_iGeneration(0), m_bIsStopping(false)
+/********************************************
+ *       Purpose: Start PML_NUM_THREADS threads if that environment variable is a positive number, 
+ *                otherwise one per core.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    size_t m_iNumOfThreads = 0;
+    const char *m_sRequested = getenv("PML_NUM_THREADS");
+    if ( m_sRequested != NULL )
+        m_iNumOfThreads = strtoul(m_sRequested, NULL, 10);
+    StartWorkers(m_iNumOfThreads);
+}
+
+
+void CThreadPool::StartWorkers(size_t inNumOfThreads)
+/********************************************
+ *       Purpose: Start inNumOfThreads - 1 workers. 0 means one thread per core.
+ *  Precondition: No workers are running.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if ( inNumOfThreads == 0 )
+        inNumOfThreads = max<size_t>(1, thread::hardware_concurrency());
+    for ( size_t t = 1; t < inNumOfThreads; t++ )
+        m_vecWorkers.push_back(thread(&CThreadPool::WorkerLoop, this));
+}
+
+
+void CThreadPool::StopWorkers()
+/********************************************
+ *       Purpose: Stop and join every worker.
+ *  Precondition: No parallel loop is running.
+ * Postcondition: N/A
+********************************************/ 
+{
+    {
+        lock_guard<mutex> m_lockJob(m_mtxJob);
+        m_bIsStopping = true;
+    }
+    m_cvWork.notify_all();
+    for ( size_t t = 0; t < m_vecWorkers.size(); t++ )
+        m_vecWorkers[t].join();
+    m_vecWorkers.clear();
+    m_bIsStopping = false;
+}
+
+
+void CThreadPool::SetNumOfThreads(const size_t inNumOfThreads)
+/********************************************
+ *       Purpose: Replace the workers so the pool has inNumOfThreads threads. 0 means one per core.
+ *  Precondition: N/A
+ * Postcondition: Waits for a running parallel loop to finish first.
+********************************************/ 
+{
+    lock_guard<mutex> m_lockLoop(m_mtxLoop);
+    StopWorkers();
+    StartWorkers(inNumOfThreads);
+}
+
+
+size_t CThreadPool::RunChunks(const CFunctionReference<void(size_t)> &inChunkBody, const size_t inNumOfChunks)
+/********************************************
+ *       Purpose: Run chunks of the current job until none are left.
+ *  Precondition: N/A
+ * Postcondition: Returns the number of chunks this thread ran.
+********************************************/ 
+{
+    size_t m_iNumOfRunChunks = 0;
+    t_bIsInParallelLoop = true;
+    for ( size_t ch = m_iNextChunk++; ch < inNumOfChunks; ch = m_iNextChunk++ ) {
+        inChunkBody(ch);
+        m_iNumOfRunChunks++;
+    }
+    t_bIsInParallelLoop = false;
+    return m_iNumOfRunChunks;
+}
+
+
+void CThreadPool::WorkerLoop()
+/********************************************
+ *       Purpose: Body of every worker. Wait for a job, help run its chunks, repeat until stopped.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: A worker that wakes after its job is finished finds m_pJob NULL and waits again, 
+ *                so it never runs a chunk index against the wrong job.
+********************************************/ 
+{
+    unique_lock<mutex> m_lockJob(m_mtxJob);
+    unsigned long m_iSeenGeneration = m_iGeneration;
+    while ( true ) {
+        m_cvWork.wait(m_lockJob, [&]() { return m_bIsStopping || m_iGeneration != m_iSeenGeneration; });
+        if ( m_bIsStopping )
+            return;
+        m_iSeenGeneration = m_iGeneration;
+        if ( m_pJob == NULL )
+            continue;
+
+        const CFunctionReference<void(size_t)> *m_pJobBody = m_pJob;
+        const size_t m_iJobChunks = m_iNumOfChunks;
+        m_iNumOfActiveWorkers++;
+        m_lockJob.unlock();
+        const size_t m_iNumOfRunChunks = RunChunks(*m_pJobBody, m_iJobChunks);
+        m_lockJob.lock();
+        m_iNumOfFinishedChunks += m_iNumOfRunChunks;
+        m_iNumOfActiveWorkers--;
+        m_cvDone.notify_all();
+    }
+}
+
+
+void CThreadPool::Run(const size_t inNumOfChunks, const CFunctionReference<void(size_t)> &inChunkBody)
+/********************************************
+ *       Purpose: Call inChunkBody(ch) for every ch in [0, inNumOfChunks) across the pool.
+ *  Precondition: Chunks must be independent of each other.
+ * Postcondition: All chunks have finished when this returns.
+********************************************/ 
+{
+    if ( t_bIsInParallelLoop ) {
+        for ( size_t ch = 0; ch < inNumOfChunks; ch++ )
+            inChunkBody(ch);
+        return;
+    }
+    unique_lock<mutex> m_lockLoop(m_mtxLoop, try_to_lock);
+    if ( !m_lockLoop.owns_lock() || m_vecWorkers.empty() || inNumOfChunks < 2 ) {
+        for ( size_t ch = 0; ch < inNumOfChunks; ch++ )
+            inChunkBody(ch);
+        return;
+    }
+
+    {
+        lock_guard<mutex> m_lockJob(m_mtxJob);
+        m_pJob = &inChunkBody;
+        m_iNumOfChunks = inNumOfChunks;
+        m_iNextChunk = 0;
+        m_iNumOfFinishedChunks = 0;
+        m_iGeneration++;
+    }
+    m_cvWork.notify_all();
+    const size_t m_iNumOfRunChunks = RunChunks(inChunkBody, inNumOfChunks);
+
+    unique_lock<mutex> m_lockJob(m_mtxJob);
+    m_iNumOfFinishedChunks += m_iNumOfRunChunks;
+    m_cvDone.wait(m_lockJob, [&]() { return m_iNumOfFinishedChunks == m_iNumOfChunks && m_iNumOfActiveWorkers == 0; });
+    m_pJob = NULL;
+}
+
+
+static CThreadPool &ThreadPool()
+/********************************************
+ *       Purpose: Return the pool shared by every ParallelFor(). It is started on first use.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: The pool is never destroyed, so exit() from inside a parallel loop 
+ *                does not wait on the workers.
+********************************************/ 
+{
+    static CThreadPool *m_pPool = new CThreadPool();
+    return *m_pPool;
+}
+
+
+size_t GetNumOfThreads()
+/********************************************
+ *       Purpose: Return the number of threads parallel loops run on, counting the calling thread.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    return ThreadPool().GetNumOfThreads();
+}
+
+
+void SetNumOfThreads(const size_t inNumOfThreads)
+/********************************************
+ *       Purpose: Run parallel loops on inNumOfThreads threads, counting the calling thread. 
+ *                0 means one thread per core, 1 keeps everything on the calling thread.
+ *  Precondition: Must not be called from inside a parallel loop.
+ * Postcondition: Overrides the PML_NUM_THREADS environment variable.
+********************************************/ 
+{
+    ThreadPool().SetNumOfThreads(inNumOfThreads);
+}
+
+
+void ParallelFor(const size_t inBegin, const size_t inEnd, const size_t inGrainSize, const CFunctionReference<void(size_t, size_t)> &inBody)
+/********************************************
+ *       Purpose: Split [inBegin, inEnd) into contiguous chunks of at least 
+ *                inGrainSize iterations and run inBody(chunk_begin, chunk_end) 
+ *                on each chunk across the thread pool.
+ *  Precondition: Chunks must be independent of each other.
+ * Postcondition: All chunks have finished when this returns.
+ *          Note: Runs inline when the range is too small to be worth a thread. 
+ *                Up to 4 chunks per thread are made so uneven chunks balance out.
+********************************************/ 
+{
+    if (inEnd <= inBegin)
+        return;
+
+    const size_t m_iNumOfIterations = inEnd - inBegin;
+    const size_t m_iNumOfThreads = GetNumOfThreads();
+    size_t m_iNumOfChunks = min(4 * m_iNumOfThreads, max<size_t>(1, m_iNumOfIterations / max<size_t>(1, inGrainSize)));
+
+    if (m_iNumOfThreads == 1 || m_iNumOfChunks == 1) {
+        inBody(inBegin, inEnd);
+        return;
+    }
+
+    const size_t m_iChunkSize = (m_iNumOfIterations + m_iNumOfChunks - 1) / m_iNumOfChunks;
+    m_iNumOfChunks = (m_iNumOfIterations + m_iChunkSize - 1) / m_iChunkSize;
+    ThreadPool().Run(m_iNumOfChunks, [&](size_t inChunk) {
+        inBody(inBegin + inChunk * m_iChunkSize, min(inEnd, inBegin + (inChunk + 1) * m_iChunkSize));
+    });
+}
+
+
+static complex<double> ParallelSum(const size_t inBegin, const size_t inEnd, const size_t inBlockSize, 
+                                   const CFunctionReference<complex<double>(size_t, size_t)> &inBlockSum)
+/********************************************
+ *       Purpose: Return the sum over [inBegin, inEnd) given inBlockSum(block_begin, block_end), 
+ *                the sum over one block of inBlockSize iterations.
+ *  Precondition: N/A
+ * Postcondition: Blocks only depend on inBlockSize and their sums are added in order, 
+ *                so the result is the same for every number of threads.
+********************************************/ 
+{
+    if (inEnd <= inBegin)
+        return complex<double>(0, 0);
+
+    // The block sums reuse this thread's spare buffer. A sum nested inside a block finds it taken and allocates its own.
+    thread_local vector<complex<double>> t_vecSpareBlockSums;
+    const size_t m_iNumOfBlocks = (inEnd - inBegin + inBlockSize - 1) / inBlockSize;
+    vector<complex<double>> m_vecBlockSums;
+    m_vecBlockSums.swap(t_vecSpareBlockSums);
+    m_vecBlockSums.resize(m_iNumOfBlocks);
+    ParallelFor(0, m_iNumOfBlocks, 1, [&](size_t inBlockBegin, size_t inBlockEnd) {
+        for ( size_t b = inBlockBegin; b < inBlockEnd; b++ )
+            m_vecBlockSums[b] = inBlockSum(inBegin + b * inBlockSize, min(inEnd, inBegin + (b + 1) * inBlockSize));
+    });
+
+    complex<double> m_cxSum = 0;
+    for ( size_t b = 0; b < m_iNumOfBlocks; b++ )
+        m_cxSum += m_vecBlockSums[b];
+    t_vecSpareBlockSums.swap(m_vecBlockSums);
+    return m_cxSum;
+}
+
+
+CMatrix::CMatrix()
+/********************************************
+ *       Purpose: Default Square Matrix Constructor 
+ *                intializes a 2 x 2 matrix with all 0 entries.                  
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+    m_iRowSize = 2;
+    m_iColSize = 2;
+    m_eLayout = INTERLEAVED_LAYOUT;
+
+    size_t num_of_entries = m_iRowSize * m_iColSize;
+    m_vecMatrix.assign(num_of_entries, complex<float>(0, 0));
+}
+
+
+CMatrix::CMatrix(string inPauliID) : CMatrix()
+/********************************************
+ *       Purpose: Initialize a 2 x 2 Pauli Matrix.        
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+    if (!inPauliID.compare("X") || !inPauliID.compare("x")) {         
+        // Row 1
+        m_vecMatrix.at(0) = complex<float>(0, 0);
+        m_vecMatrix.at(1) = complex<float>(1, 0);
+
+        // Row 2
+        m_vecMatrix.at(2) = complex<float>(1, 0);
+        m_vecMatrix.at(3) = complex<float>(0, 0);
+        // cout << matrix.size() << endl;
+
+    }
+    else if (!inPauliID.compare("Y") || !inPauliID.compare("y")) {     
+        // Row 1
+        m_vecMatrix.at(0) = complex<float>(0, 0);
+        m_vecMatrix.at(1) = complex<float>(0, -1);
+
+        // Row 2
+        m_vecMatrix.at(2) = complex<float>(0, 1);
+        m_vecMatrix.at(3) = complex<float>(0, 0);
+    }
+    else if (!inPauliID.compare("Z") || !inPauliID.compare("z")) {
+        // Row 1
+        m_vecMatrix.at(0) = complex<float>(1, 0);
+        m_vecMatrix.at(1) = complex<float>(0, 0);
+
+        // Row 2
+        m_vecMatrix.at(2) = complex<float>(0, 0);
+        m_vecMatrix.at(3) = complex<float>(-1, 0);
+    }
+    // Identity Matrix
+    else {
+        // Row 1
+        m_vecMatrix.at(0) = complex<float>(1, 0);
+        m_vecMatrix.at(1) = complex<float>(0, 0);
+
+        // Row 2
+        m_vecMatrix.at(2) = complex<float>(0, 0);
+        m_vecMatrix.at(3) = complex<float>(1, 0);
+    }
+
+}
+
+
+CMatrix::CMatrix(size_t inRowSize, size_t inColSize, EMatrixLayout inLayout)
+/********************************************
+ *       Purpose: Matrix constructor initializes a 
+ *                size_of_row  x  size_of_col  matrix with all 0 entries.                
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: inLayout picks the storage layout. See EMatrixLayout. 
+ *                Any shape works, such as an N x 1 state vector or a tall N x k block of columns.
+********************************************/ 
+{
+    if ( inRowSize > MAX_SIDE_LENGTH || inColSize > MAX_SIDE_LENGTH ) {
+        cout << "ERROR: A " << inRowSize << " x " << inColSize << " matrix is larger than " 
+             << MAX_SIDE_LENGTH << " x " << MAX_SIDE_LENGTH << "." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+    else {
+        m_iRowSize = inRowSize;
+        m_iColSize = inColSize;
+        m_eLayout = inLayout;
+
+        // Intialize matrix to all 0's
+        size_t m_iNumOfEntries = m_iRowSize * m_iColSize;
+        if ( m_eLayout == INTERLEAVED_LAYOUT )
+            m_vecMatrix.assign(m_iNumOfEntries, complex<float>(0, 0));
+        else
+            m_vecSplitMatrix.assign(2 * GetPlaneSize(), 0.0f);
+    }
+
+}
+
+CMatrix::CMatrix(const CMatrix &inMatrix2)
+/********************************************
+ *       Purpose: Copy Constructor.                
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+ *          TODO: N/A
+********************************************/ 
+{
+    m_iRowSize = inMatrix2.m_iRowSize;
+    m_iColSize = inMatrix2.m_iColSize;
+    m_eLayout = inMatrix2.m_eLayout;
+    m_vecMatrix = inMatrix2.m_vecMatrix;
+    m_vecSplitMatrix = inMatrix2.m_vecSplitMatrix;
+}
+
+
+CMatrix::CMatrix(CMatrix &&inMatrix2) noexcept
+    : m_vecMatrix(std::move(inMatrix2.m_vecMatrix)), m_vecSplitMatrix(std::move(inMatrix2.m_vecSplitMatrix)), 
+      m_eLayout(inMatrix2.m_eLayout), m_iRowSize(inMatrix2.m_iRowSize), m_iColSize(inMatrix2.m_iColSize)
+/********************************************
+ *       Purpose: Move Constructor. Takes the storage of inMatrix2 without copying or allocating.
+ *  Precondition: N/A
+ * Postcondition: inMatrix2 is left a 0 x 0 matrix in its layout.
+ *          Note: Entries of a small matrix live inside the object, so those are copied.
+********************************************/ 
+{
+    inMatrix2.m_iRowSize = 0;
+    inMatrix2.m_iColSize = 0;
+}
+
+
+CMatrix &CMatrix::operator=(const CMatrix &inMatrix2)
+/********************************************
+ *       Purpose: Copy Assignment. Takes the size, layout and entries of inMatrix2.
+ *  Precondition: N/A
+ * Postcondition: Storage that is already large enough is reused, so copying between 
+ *                matrices of the same size and layout does not allocate.
+********************************************/ 
+{
+    if ( this == &inMatrix2 )
+        return *this;
+    m_eLayout = inMatrix2.m_eLayout;
+    m_iRowSize = inMatrix2.m_iRowSize;
+    m_iColSize = inMatrix2.m_iColSize;
+    if ( m_eLayout == INTERLEAVED_LAYOUT ) {
+        m_vecMatrix.assign(inMatrix2.m_vecMatrix.begin(), inMatrix2.m_vecMatrix.end());
+        m_vecSplitMatrix.clear();
+    }
+    else {
+        m_vecSplitMatrix.assign(inMatrix2.m_vecSplitMatrix.begin(), inMatrix2.m_vecSplitMatrix.end());
+        m_vecMatrix.clear();
+    }
+    return *this;
+}
+
+
+CMatrix &CMatrix::operator=(CMatrix &&inMatrix2) noexcept
+/********************************************
+ *       Purpose: Move Assignment. Swaps storage with inMatrix2 instead of copying.
+ *  Precondition: N/A
+ * Postcondition: inMatrix2 is left a 0 x 0 matrix holding the old storage of this matrix, 
+ *                which it frees when it is destroyed or reuses when it is assigned again.
+********************************************/ 
+{
+    if ( this == &inMatrix2 )
+        return *this;
+    m_vecMatrix.swap(inMatrix2.m_vecMatrix);
+    m_vecSplitMatrix.swap(inMatrix2.m_vecSplitMatrix);
+    swap(m_eLayout, inMatrix2.m_eLayout);
+    m_iRowSize = inMatrix2.m_iRowSize;
+    m_iColSize = inMatrix2.m_iColSize;
+    inMatrix2.m_iRowSize = 0;
+    inMatrix2.m_iColSize = 0;
+    inMatrix2.m_vecMatrix.clear();
+    inMatrix2.m_vecSplitMatrix.clear();
+    return *this;
+}
+
+
+size_t CMatrix::GetPlaneSize() const
+/********************************************
+ *       Purpose: Return the number of floats in each plane of the SPLIT_LAYOUT, 
+ *                which is the number of entries rounded up to a multiple of 16.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: 16 floats fill one 64 byte cache line and one AVX-512 register, 
+ *                so the imaginary plane is aligned like the real plane.
+********************************************/ 
+{
+    return (m_iRowSize * m_iColSize + 15) & ~size_t(15);
+}
+
+
+void CMatrix::Resize(const size_t inRowSize, const size_t inColSize)
+/********************************************
+ *       Purpose: Make the matrix inRowSize x inColSize, keeping its layout.
+ *  Precondition: N/A
+ * Postcondition: Entries are unspecified unless the size is unchanged, 
+ *                in which case nothing is reallocated or modified.
+ *          Note: Used by expression assignment, which overwrites every entry.
+********************************************/ 
+{
+    if ( inRowSize == m_iRowSize && inColSize == m_iColSize )
+        return;
+
+    m_iRowSize = inRowSize;
+    m_iColSize = inColSize;
+    if ( m_eLayout == INTERLEAVED_LAYOUT )
+        m_vecMatrix.assign(inRowSize * inColSize, complex<float>(0, 0));
+    else
+        m_vecSplitMatrix.assign(2 * GetPlaneSize(), 0.0f);
+}
+
+
+void CheckExpressionSizes(const size_t inRowSize1, const size_t inColSize1, 
+                          const size_t inRowSize2, const size_t inColSize2, const char *inOperation)
+/********************************************
+ *       Purpose: Exit when two operands of an elementwise matrix expression differ in size.
+ *  Precondition: inOperation names the expression for the error message.
+ * Postcondition: Returns only when the sizes match.
+********************************************/ 
+{
+    if ( inRowSize1 != inRowSize2 || inColSize1 != inColSize2 ) {
+        cout << "ERROR: Cannot " << inOperation << " a " << inRowSize1 << " x " << inColSize1 
+             << " matrix and a " << inRowSize2 << " x " << inColSize2 << " matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+}
+
+
+void ReportIndexOutOfRange(const size_t inRowIndex, const size_t inColIndex, const size_t inRowSize, const size_t inColSize)
+/********************************************
+ *       Purpose: Exit for an out of range index found by CheckIndexRange() under PML_BOUNDS_CHECKS.
+ *  Precondition: N/A
+ * Postcondition: Never returns.
+ *          Note: Out of line so the inline checks stay small.
+********************************************/ 
+{
+    cout << "ERROR: Entry (" << inRowIndex << ", " << inColIndex << ") is outside of a " 
+         << inRowSize << " x " << inColSize << " matrix." << '\n'
+         << "EXITING PROGRAM . . ." << endl;
+    exit(1);
+}
+
+
+void ReportSplitLayoutData()
+/********************************************
+ *       Purpose: Exit for a call to CMatrix::Data() on a SPLIT_LAYOUT matrix.
+ *  Precondition: N/A
+ * Postcondition: Never returns.
+ *          Note: Out of line so Data() stays small.
+********************************************/ 
+{
+    cout << "ERROR: Data() needs a matrix in INTERLEAVED_LAYOUT. Read a SPLIT_LAYOUT matrix through View() or operator()." << '\n'
+         << "EXITING PROGRAM . . ." << endl;
+    exit(1);
+}
+
+
+void CheckViewRange(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize, 
+                    const size_t inRowStep, const size_t inColStep, const size_t inParentRowSize, const size_t inParentColSize)
+/********************************************
+ *       Purpose: Exit when an inRowSize x inColSize view starting at (inRowBegin, inColBegin) and taking 
+ *                every inRowStep-th row and inColStep-th column does not fit in an inParentRowSize x inParentColSize view.
+ *  Precondition: N/A
+ * Postcondition: Returns only when every entry of the view is inside its parent.
+********************************************/ 
+{
+    const bool m_bIsEmpty = (inRowSize == 0 || inColSize == 0);
+    if ( inRowStep == 0 || inColStep == 0 || inRowSize > MAX_SIDE_LENGTH || inColSize > MAX_SIDE_LENGTH
+         || (!m_bIsEmpty && (inRowBegin + (inRowSize - 1) * inRowStep >= inParentRowSize || inColBegin + (inColSize - 1) * inColStep >= inParentColSize)) ) {
+        cout << "ERROR: A " << inRowSize << " x " << inColSize << " view from (" << inRowBegin << ", " << inColBegin 
+             << ") with steps (" << inRowStep << ", " << inColStep << ") does not fit in a " 
+             << inParentRowSize << " x " << inParentColSize << " matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+}
+
+
+vector<complex<float>> CMatrix::GetMatrix() const
+/********************************************
+ *       Purpose: Return the entries in the interleaved layout.
+ *  Precondition: N/A
+ * Postcondition: Must NOT modify any data members of Matrix Object.
+ *          Note: A SPLIT_LAYOUT matrix is interleaved into the returned copy. Every entry is copied, 
+ *                so loops should read through View() or operator() instead, or through Data() on an 
+ *                INTERLEAVED_LAYOUT matrix.
+********************************************/ 
+{
+    if ( m_eLayout == INTERLEAVED_LAYOUT )
+        return vector<complex<float>>(m_vecMatrix.begin(), m_vecMatrix.end());
+
+    const size_t m_iNumOfEntries = m_iRowSize * m_iColSize;
+    vector<complex<float>> m_vecEntries(m_iNumOfEntries);
+    for ( size_t i = 0; i < m_iNumOfEntries; i++ )
+        m_vecEntries[i] = GetEntry(i);
+    return m_vecEntries;
+}
+
+
+void CMatrix::SetLayout(const EMatrixLayout inLayout)
+/********************************************
+ *       Purpose: Convert the entries to inLayout.
+ *  Precondition: N/A
+ * Postcondition: Entries are unchanged, only the way they are stored. 
+ *          Note: Costs nothing when the matrix already uses inLayout, otherwise 
+ *                it is a single pass and the old storage is released.
+********************************************/ 
+{
+    if ( inLayout == m_eLayout )
+        return;
+
+    const size_t m_iNumOfEntries = size_t(m_iRowSize) * m_iColSize;
+    const size_t m_iPlaneSize = GetPlaneSize();
+    if ( inLayout == SPLIT_LAYOUT ) {
+        m_vecSplitMatrix.assign(2 * m_iPlaneSize, 0.0f);
+        for ( size_t i = 0; i < m_iNumOfEntries; i++ ) {
+            m_vecSplitMatrix[i] = m_vecMatrix[i].real();
+            m_vecSplitMatrix[m_iPlaneSize + i] = m_vecMatrix[i].imag();
+        }
+        m_vecMatrix.clear();
+        m_vecMatrix.shrink_to_fit();
+    }
+    else {
+        m_vecMatrix.resize(m_iNumOfEntries);
+        for ( size_t i = 0; i < m_iNumOfEntries; i++ )
+            m_vecMatrix[i] = complex<float>(m_vecSplitMatrix[i], m_vecSplitMatrix[m_iPlaneSize + i]);
+        m_vecSplitMatrix.clear();
+        m_vecSplitMatrix.shrink_to_fit();
+    }
+    m_eLayout = inLayout;
+}
+
+
+const float *CMatrix::GetRealPlane() const
+/********************************************
+ *       Purpose: Return the 64 byte aligned plane of real parts, entry (r, c) at index r * n + c.
+ *  Precondition: The matrix uses SPLIT_LAYOUT.
+ * Postcondition: The plane holds GetPlaneSize() floats. Floats past the entries are 0.
+********************************************/ 
+{
+    if ( m_eLayout != SPLIT_LAYOUT ) {
+        cout << "ERROR: GetRealPlane() needs a matrix in SPLIT_LAYOUT. Call SetLayout(SPLIT_LAYOUT) first." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+    return m_vecSplitMatrix.data();
+}
+
+
+const float *CMatrix::GetImagPlane() const
+/********************************************
+ *       Purpose: Return the 64 byte aligned plane of imaginary parts, entry (r, c) at index r * n + c.
+ *  Precondition: The matrix uses SPLIT_LAYOUT.
+ * Postcondition: See GetRealPlane().
+********************************************/ 
+{
+    return GetRealPlane() + GetPlaneSize();
+}
+
+
+void CMatrix::ScaleEntries(const complex<float> inZ)
+/********************************************
+ *       Purpose: Multiply every entry by inZ in either layout.
+ *  Precondition: N/A
+ * Postcondition: Padding of the SPLIT_LAYOUT planes stays 0.
+********************************************/ 
+{
+    if ( m_eLayout == INTERLEAVED_LAYOUT ) {
+        complex<float> *m_pEntries = m_vecMatrix.data();
+        const CMatrixKernels &m_kernels = MatrixKernels();
+        ParallelFor(0, m_vecMatrix.size(), PARALLEL_GRAIN_SIZE, [&](size_t inBegin, size_t inEnd) {
+            m_kernels.Scale(m_pEntries + inBegin, inZ, m_pEntries + inBegin, inEnd - inBegin);
+        });
+        return;
+    }
+
+    const size_t m_iPlaneSize = GetPlaneSize();
+    float *m_pRe = m_vecSplitMatrix.data();
+    float *m_pIm = m_pRe + m_iPlaneSize;
+    const float m_fZRe = inZ.real();
+    const float m_fZIm = inZ.imag();
+    ParallelFor(0, m_iPlaneSize, PARALLEL_GRAIN_SIZE, [&](size_t inBegin, size_t inEnd) {
+        for ( size_t i = inBegin; i < inEnd; i++ ) {
+            const float m_fRe = m_pRe[i];
+            m_pRe[i] = m_fZRe * m_fRe - m_fZIm * m_pIm[i];
+            m_pIm[i] = m_fZRe * m_pIm[i] + m_fZIm * m_fRe;
+        }
+    });
+}
+
+
+void CMatrix::PrintMatrix() const 
+/********************************************
+ *       Purpose: Print all entries of the matrix data member.
+ *  Precondition: N/A
+ * Postcondition: Must NOT modify any data members of Matrix Object.
+ *          Note: N/A
+ *          TODO: 
+********************************************/ 
+{
+    for ( size_t r = 0; r < m_iRowSize; r++ ) {
+        for ( size_t c = 0; c < m_iColSize; c++ ) {
+            cout << (*this)(r, c) << " ";
+        }
+        cout << "\n" << endl;
+    }
+}
+
+
+complex<float> CMatrix::GetValueAt(const size_t inRowIndex,  const size_t inColIndex) const
+/********************************************
+ *       Purpose: Get 2D matrix index for a 1D vector
+ *                The 1D vector acts as a 2D matrix.
+ *  Precondition: N/A
+ * Postcondition: Must NOT modify any data members of Matrix Object.
+ *          Note: N/A
+ *          TODO: N/A
+********************************************/ 
+{
+    size_t m_iOneDIndex = inRowIndex * m_iColSize + inColIndex;
+    try {
+        if ( m_eLayout == SPLIT_LAYOUT ) {
+            if ( inRowIndex >= m_iRowSize || inColIndex >= m_iColSize )
+                throw out_of_range("split layout index out of range");
+            return GetEntry(m_iOneDIndex);
+        }
+        return m_vecMatrix.at(m_iOneDIndex);
+    }
+    catch(const std::out_of_range& oor) {
+        cerr << "Out of Range error: " << oor.what() << '\n' 
+             << "Error caught in GetValueAt() method. Likely because you are trying to access " << m_iRowSize * m_iColSize << " entries in a for loop, when there are only " << size_t(m_iRowSize) * m_iColSize << " entries." << '\n' 
+             << "EXITING PROGRAM . . ." << '\n';
+        exit(1);
+    }
+}
+
+
+void CMatrix::ModifyValueAt(const size_t inRowIndex,  const size_t inColIndex, const complex<float> inVal)
+/********************************************
+ *       Purpose: Modify Value at index of 1D vector.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+ *          TODO: N/A
+********************************************/ 
+{
+    size_t m_iOneDIndex = inRowIndex * m_iColSize + inColIndex;
+    try {
+        if ( m_eLayout == SPLIT_LAYOUT ) {
+            if ( inRowIndex >= m_iRowSize || inColIndex >= m_iColSize )
+                throw out_of_range("split layout index out of range");
+            m_vecSplitMatrix[m_iOneDIndex] = inVal.real();
+            m_vecSplitMatrix[GetPlaneSize() + m_iOneDIndex] = inVal.imag();
+        }
+        else
+            m_vecMatrix.at(m_iOneDIndex) = inVal;
+    }
+    catch(const std::out_of_range& oor) {
+        cerr << "Out of Range error: " << oor.what() << '\n' 
+             << "Error caught in ModifyValueAt() method. Likely because you are trying to access " << inRowIndex * inColIndex << " entries in a for loop, when there are only " << size_t(m_iRowSize) * m_iColSize << " entries." << '\n' 
+             << "EXITING PROGRAM . . ." << '\n';
+        exit(1);
+    }
+}
+
+
+CPauliMatrix::CPauliMatrix() : CMatrix("I")
+/********************************************
+ *       Purpose: Default Pauli Constructor creates the Pauli I matrix.                  
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+    m_cxPauliFactor = complex<float>(1, 0);
+    m_sPauliString = "I";
+}
+
+
+CPauliMatrix::CPauliMatrix(string inPauliID) : CMatrix(inPauliID)
+/********************************************
+ *       Purpose: Constructor creates Pauli matrix according to 
+ *                input pauli_id. Invalid string, will give Identity 
+ *                matrix by default.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+    m_cxPauliFactor = complex<float>(1, 0);
+
+    const int m_iPauliIndex = inPauliID.size() == 1 ? PauliCharToIndex(inPauliID[0]) : -1;
+    if (m_iPauliIndex < 0) {
+        cout << "CPauliMatrix(string inPauliID) failed because pauli ID is not valid. Use one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
+        cout << "Exiting Program . . . " << endl;
+        exit(1);
+    }
+    m_sPauliString = string(1, PAULI_CHARS[m_iPauliIndex]);
+}
+
+
+CPauliMatrix::CPauliMatrix(size_t inRowSize, size_t inColSize) : CMatrix(inRowSize, inColSize)
+/********************************************
+ *       Purpose: Matrix constructor initializes a 
+ *                row_size  x  col_size  matrix with all 0 entries.
+ *                This constructor does not produce a Pauli Matrix, 
+ *                but is essential to the PauliAlgebraElement class.
+ *  Precondition: N/A
+ * Postcondition: All entries are initialized to 0.
+ *          Note: N/A
+********************************************/ 
+{
+    m_cxPauliFactor = complex<float>(1, 0);
+    m_sPauliString = "";
+}
+
+
+string CPauliMatrix::PauliToString() const
+/********************************************
+ *       Purpose: Returns Pauli String representation.
+ *                For Example, -iY returns "-iY". 
+ *                For Example,  XY returns  "iZ".
+ *  Precondition: N/A
+ * Postcondition: Must NOT modify any data members of PauliMatrix Object.
+ *          Note: N/A
+********************************************/ 
+{
+    string m_sResult = m_sPauliString;
+
+    if (m_cxPauliFactor == complex<float>(-1, 0))
+        m_sResult = "-" + m_sResult;
+
+    else if (m_cxPauliFactor == complex<float>(0, 1))
+        m_sResult = "i" + m_sResult;
+
+    else if (m_cxPauliFactor == complex<float>(0, -1))
+        m_sResult = "-i" + m_sResult;
+
+    // else pauli factor is +1 so concatenate nothing.
+
+    return m_sResult;
+}
+
+
+CPauliMatrix CPauliMatrix::operator*(const CPauliMatrix &inPauli2) const
+/********************************************
+ *       Purpose: Multiply two pauli matrices then return the resulting pauli matrix object.
+ *
+ *              Pauli Matrices are: I, X, Y, Z
+ *              IX = XI = X
+ *              IY = YI = Y
+ *              IZ = ZI = Z
+ *              XY = iZ 
+ *              XZ = -iY
+ *              YX = -iZ
+ *              YZ = iX
+ *              ZX = iY
+ *              ZY = -iX
+ *              
+ *              Associativity Rule: 
+ *              c(AB) = c(A)B = A(cB)
+ *              where c is a constant
+ *              A and B are matrices.
+ * 
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+    CPauliMatrix m_pmResult = CPauliMatrix("I");
+
+    // Update member variables
+    m_pmResult.m_cxPauliFactor = this->m_cxPauliFactor * inPauli2.m_cxPauliFactor;
+    
+    const int m_iPauliIndex1 = this->m_sPauliString.size() == 1 ? PauliCharToIndex(this->m_sPauliString[0]) : -1;
+    const int m_iPauliIndex2 = inPauli2.m_sPauliString.size() == 1 ? PauliCharToIndex(inPauli2.m_sPauliString[0]) : -1;
+    if (m_iPauliIndex1 >= 0 && m_iPauliIndex2 >= 0) {
+        const CPauliProduct m_ppProduct = PAULI_PRODUCT_TABLE[m_iPauliIndex1][m_iPauliIndex2];
+        m_pmResult.m_sPauliString = string(1, PAULI_CHARS[m_ppProduct.m_iPauliIndex]);
+        m_pmResult.m_cxPauliFactor = m_pmResult.m_cxPauliFactor * PAULI_PHASES[m_ppProduct.m_iPhaseExponent];
+    }
+
+
+    // Matrix Multiplication between first and second matrix. 
+    // MultiplyInto() runs the unrolled CFixedMatrix2 kernel for 2 x 2 Pauli matrices.
+    MultiplyInto(m_pmResult, *this, inPauli2);
+
+    return m_pmResult;
+}
+
+
+CPauliMatrix MultiplyPauli(const CPauliMatrix &inPauli1, const CPauliMatrix &inPauli2)
+/********************************************
+ *       Purpose: Multiply matrix of PauliMatrix object by matrix of PauliMatrix object, 
+ *                then return the resulting PauliMatrix object containing that new matrix.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+  return inPauli1 * inPauli2;
+}
+
+
+CPauliMatrix &CPauliMatrix::operator*=(const complex<float> inPhi)
+/********************************************
+ *       Purpose: Multiply a pauli matrix by a factor of phi.
+ *  Precondition: N/A
+ * Postcondition: input PauliMatrix object must be modified by input phi parameter.
+ *          Note: N/A
+            TODO: Prevent -0 entries in matrix.  
+********************************************/ 
+{
+    // TODO: Prevent -0 entries in matrix.  
+    this->ScaleEntries(inPhi);
+
+    // Update value of pauli_factor
+    this->m_cxPauliFactor *= inPhi;
+    return *this;
+}
+
+
+CPauliMatrix CPauliMatrix::operator*(const complex<float> inPhi) const
+/********************************************
+ *       Purpose: Return a copy of this pauli matrix multiplied by a factor of phi.
+ *  Precondition: N/A
+ * Postcondition: Must NOT modify any data members of PauliMatrix Object.
+********************************************/ 
+{
+    CPauliMatrix m_pmResult = *this;
+    m_pmResult *= inPhi;
+    return m_pmResult;
+}
+
+
+void MultiplyPhase(const complex<float> inPhi, CPauliMatrix &inPauli)
+/********************************************
+ *       Purpose: Multiply the matrix data member of a PauliMatrix object by a factor of phi.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+    if ( inPhi != complex<float>(1, 0) && inPhi != complex<float>(-1, 0) &&
+         inPhi != complex<float>(0, 1) && inPhi != complex<float>(0, -1)) {
+         cout << "Function failed because phi is not one of the following: { 1, -1, i, -i }"<< endl;
+         cout << "Exiting Program . . ." << endl;
+         exit(1);
+    }
+    else 
+        inPauli *= inPhi;
+}
+
+
+void TestMultiplyPhase(const complex<float> &inPhi1, const complex<float> &inPhi2)
+/********************************************
+ *       Purpose: Verify all pauli multiplication by phase is correct.
+ *  Precondition: Input phi1 and phi2 parameters must be one of the following: { 1, -1, i, -i }
+ * Postcondition: N/A
+********************************************/ 
+{
+    if ( inPhi1 != complex<float>(1, 0) && inPhi1 != complex<float>(-1, 0) &&
+         inPhi1 != complex<float>(0, 1) && inPhi1 != complex<float>(0, -1))
+         cout << "Function failed because first phi is not one of the following: { 1, -1, i, -i }"<< endl;
+
+    else if ( inPhi2 != complex<float>(1, 0) && inPhi2 != complex<float>(-1, 0) &&
+              inPhi2 != complex<float>(0, 1) && inPhi2 != complex<float>(0, -1))
+         cout << "Function failed because second phi is not one of the following: { 1, -1, i, -i }"<< endl;
+
+    else {
+        cout << "__________________________________" << endl;
+        cout << "phi1 = " << inPhi1 << endl;
+        cout << "phi2 = " << inPhi2 << endl;
+
+        array<string, 4> m_arrsPauliIDs = { "I", "X", "Y", "Z"};
+        for (auto p = m_arrsPauliIDs.begin(); p != m_arrsPauliIDs.end(); ++p){
+            cout << "__________________________________" << endl;
+            CPauliMatrix m_pmResult = CPauliMatrix(*p);
+            cout << "Initial Pauli Matrix: " << m_pmResult.PauliToString() << endl;
+            m_pmResult.PrintMatrix();
+
+            MultiplyPhase(inPhi1, m_pmResult);
+            cout << "After phi1 multiplication: " << m_pmResult.PauliToString() << endl;
+            m_pmResult.PrintMatrix();
+
+            MultiplyPhase(inPhi2, m_pmResult);
+            cout << "After phi2 multiplication: " << m_pmResult.PauliToString() << endl;
+            m_pmResult.PrintMatrix();
+        }
+    }
+}
+
+
+void TestPauliIsHermitian()
+/********************************************
+ *       Purpose: Multiply Pauli objects by themselves to check they're Hermitian. 
+ *                The resulting Pauli object should contain an Identity matrix.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    // PauliMatrix i_matrix = PauliMatrix("I");
+    array<string, 4> m_arrsPauliIDs = { "I", "X", "Y", "Z"};
+
+    for (auto p = m_arrsPauliIDs.begin(); p != m_arrsPauliIDs.end(); ++p){
+        CPauliMatrix m_pmPauli1 = CPauliMatrix(*p);
+        CPauliMatrix m_pmPauli2 = CPauliMatrix(*p);
+        cout << m_pmPauli1.PauliToString() << endl;
+        m_pmPauli1.PrintMatrix();
+
+
+        CPauliMatrix m_pmResult = MultiplyPauli(m_pmPauli1, m_pmPauli2);
+        // TODO: Operator Overload for == between two Pauli Matrices.
+        // if (p_squared == i_matrix)
+        cout << m_pmPauli1.PauliToString() << "^2" << " = " << m_pmResult.PauliToString() << endl;
+        m_pmResult.PrintMatrix();
+    }
+
+}
+
+
+void ShortTestMultiplyPauli(const complex<float> &inPhi1, const string &inPauliID1, const complex<float> &inPhi2, const string &inPauliID2)
+/********************************************
+ *       Purpose: Test Pauli Multiplication.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+
+    // Verifying valid input parameters.
+    // DELETE. Took care of checking in CPauliMatrix(string inPauliID)
+    if (!inPauliID1.compare("X") && !inPauliID1.compare("x") && 
+        !inPauliID1.compare("Y") && !inPauliID1.compare("y") &&
+        !inPauliID1.compare("Z") && !inPauliID1.compare("z") &&
+        !inPauliID1.compare("I") && !inPauliID1.compare("i")) {
+        cout << "HelperShortTestMultiplyPauli failed because first pauli ID is not valid. Use one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
+        cout << "Exiting Program . . . " << endl;
+        exit(1);
+    }
+    // DELETE. Took care of checking in CPauliMatrix(string inPauliID)
+    else if (!inPauliID2.compare("X") && !inPauliID2.compare("x") && 
+             !inPauliID2.compare("Y") && !inPauliID2.compare("y") &&
+             !inPauliID2.compare("Z") && !inPauliID2.compare("z") &&
+             !inPauliID2.compare("I") && !inPauliID2.compare("i")) {
+        cout << "HelperShortTestMultiplyPauli failed because second pauli ID is not valid. Use one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
+        cout << "Exiting Program . . . " << endl;
+        exit(1);
+    }
+    else if ( inPhi1 != complex<float>(1, 0) && inPhi1 != complex<float>(-1, 0) &&
+              inPhi1 != complex<float>(0, 1) && inPhi1 != complex<float>(0, -1)) {
+        cout << "HelperShortTestMultiplyPauli failed because phi1 is not valid. Use one of the following: { 1, -1, i, -i }"<< endl;
+        cout << "Exiting Program . . . " << endl;
+        exit(1);
+    }
+    else if ( inPhi2 != complex<float>(1, 0) && inPhi2 != complex<float>(-1, 0) &&
+              inPhi2 != complex<float>(0, 1) && inPhi2 != complex<float>(0, -1)) {
+        cout << "HelperShortTestMultiplyPauli failed because phi2 is not valid. Use one of the following: { 1, -1, i, -i }"<< endl;
+        cout << "Exiting Program . . . " << endl;
+        exit(1);
+    }
+
+    CPauliMatrix m_pmPauli1 = CPauliMatrix(inPauliID1);
+    MultiplyPhase(inPhi1, m_pmPauli1);
+    cout << "First Pauli Matrix:  " << m_pmPauli1.PauliToString() << endl;
+    m_pmPauli1.PrintMatrix();
+    
+    CPauliMatrix m_pmPauli2 = CPauliMatrix(inPauliID2);
+    MultiplyPhase(inPhi2, m_pmPauli2);
+    cout << "Second Pauli Matrix:  " << m_pmPauli2.PauliToString() << endl;
+    m_pmPauli2.PrintMatrix();
+
+    CPauliMatrix m_pmResult = MultiplyPauli(m_pmPauli1, m_pmPauli2);
+    cout << m_pmPauli1.PauliToString() << "   *   " << m_pmPauli2.PauliToString() << " = " << m_pmResult.PauliToString() << endl;
+    m_pmResult.PrintMatrix();
+}
+
+void FullTestMultiplyPauli(const string &inPauliID1,  const string &inPauliID2)
+/********************************************
+ *       Purpose: Test Pauli Multiplication. Given two pauli matrices, 
+ *                for example, Z and Z, perform the following 16 tests
+ *                and verify they provide the correct resulting matrix.
+ *                 Z  x    Z    test 1
+ *                 Z  x   -Z    test 2
+ *                 Z  x   iZ    test 3
+ *                 Z  x  -iZ    test 4
+ * 
+ *                -Z  x   -Z    test 5
+ *                -Z  x    Z    test 6
+ *                -Z  x   iZ    test 7
+ *                -Z  x  -iZ    test 8
+ *                              
+ *                iZ  x  iZ     test 9
+ *                iZ  x   Z     test 10
+ *                iZ  x  -Z     test 11
+ *                iZ  x -iZ     test 12
+ *  
+ *               -iZ  x -iZ     test 13
+ *               -iZ  x   Z     test 14
+ *               -iZ  x  -Z     test 15
+ *               -iZ  x  iZ     test 16
+ *                 
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    array<complex<float>, 4> m_arrcxPhis = { complex<float>(1, 0), complex<float>(-1, 0), complex<float>(0, 1), complex<float>(0, -1)  };
+
+    for ( unsigned short int r = 0; r < m_arrcxPhis.size(); r++ ) {
+        for (unsigned short int c = 0; c < m_arrcxPhis.size(); c++ ) {
+            cout << "_________" << endl;
+            cout << "Test " << r * m_arrcxPhis.size() + (c + 1) << ": " << endl;
+            ShortTestMultiplyPauli(m_arrcxPhis.at(r), inPauliID1, m_arrcxPhis.at(c), inPauliID2);
+        }
+    }
+}
+
+
+CPauliAlgebraElement::CPauliAlgebraElement(string inPauliID) : CPauliMatrix(inPauliID)
+/********************************************
+ *       Purpose: Creates a PauliAlgebraElement object. 
+ *                The matrix data member Is a 2 x 2 pauli matrix.
+ *  Precondition: N/A
+ * Postcondition: Must NOT modify any data members of Matrix Object.
+********************************************/ 
+{
+    // Initialize Data Members
+    m_cxElementPhase = m_cxPauliFactor;
+    m_sElementString = m_sPauliString;    
+}
+
+
+CPauliAlgebraElement::CPauliAlgebraElement(size_t inRowSize, size_t inColSize) : CPauliMatrix(inRowSize, inColSize)
+/********************************************
+ *       Purpose: Creates a PauliAlgebraElement object that is row_size x col_size. 
+ *                All elements are intialized to 0;
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    // Initialize Data Members
+    m_cxElementPhase = complex<float>(1, 0);
+    m_sElementString = "";
+}
+
+
+string CPauliAlgebraElement::PauliAlgebraElementToString() const
+/********************************************
+ *       Purpose: Returns the Pauli Algebra element as a string.
+ *                For Example "(5 + 10i)Z"
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+    string m_sResult = m_sElementString;
+
+    if (m_cxElementPhase.imag() == 0 )
+        m_sResult = to_string((int) m_cxElementPhase.real()) + m_sResult;
+    
+    else if ( m_cxElementPhase.real() == 0 )
+        m_sResult = to_string((int) m_cxElementPhase.imag()) + "i" + m_sResult;
+
+    else if ( m_cxElementPhase.real() != 0 && m_cxElementPhase.imag() != 0 )
+        m_sResult = "(" + to_string((int) m_cxElementPhase.real()) + " + " + to_string((int) m_cxElementPhase.imag()) + "i" + ")" + m_sResult;
+
+    return m_sResult;
+}
+
+
+CPauliAlgebraElement CPauliAlgebraElement::operator*(const CPauliAlgebraElement &inPAElement2) const
+/********************************************
+ *       Purpose: Returns a PauliAlgebraElement object where the matrix data member is
+ *                the tensor product between the first input parameter and the second input parameter.
+ *                For Example, p1_algebra_matrix @ p2_alebgra_matrix
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    CPauliAlgebraElement m_paeResult = CPauliAlgebraElement(0, 0);
+    m_paeResult.m_cxElementPhase = this->m_cxElementPhase * inPAElement2.m_cxElementPhase;
+    m_paeResult.m_sElementString = this->m_sElementString + " @ " + inPAElement2.m_sElementString;
+    KroneckerProductInto(m_paeResult, *this, inPAElement2);
+
+    return m_paeResult;
+}
+
+
+CPauliAlgebraElement MakePauliAlgebraElement(string inPauliGroupString)
+/********************************************
+ *       Purpose: Creates a PauliAlgebraElement object from a string.
+ *                For example "XYZ" will create a PauliAlgebraElement object 
+ *                where the matrix data memebr is the result of taking the tensor product 
+ *                between X tensor Y tensor Z. In my notation it would be: X @ Y @ Z
+ *                where @ is the tensor product symbol.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+
+    if (inPauliGroupString.size() == 0) {
+        cout << "Empty String. Try again." << endl;
+        cout << "Exiting Program . . . " << endl;
+        exit(1);
+    }
+
+    CPauliAlgebraElement m_paeFirst = CPauliAlgebraElement(string(1, inPauliGroupString.at(0)));
+    if (inPauliGroupString.size() == 1)
+        return m_paeFirst;
+
+    // Every factor goes into one n-ary Kronecker product instead of n - 1 growing pairwise products.
+    // The factors are the four Pauli matrices, so only pointers to them are gathered.
+    static const CPauliMatrix m_arrpmPaulis[4] = { CPauliMatrix("I"), CPauliMatrix("X"), CPauliMatrix("Y"), CPauliMatrix("Z") };
+    thread_local vector<const CMatrix *> m_vecFactors;
+    CPauliAlgebraElement m_paeResult = CPauliAlgebraElement(0, 0);
+    m_paeResult.m_cxElementPhase = m_paeFirst.m_cxElementPhase;
+    m_paeResult.m_sElementString = m_paeFirst.m_sElementString;
+    m_vecFactors.clear();
+    m_vecFactors.push_back(&m_paeFirst);
+
+    for ( unsigned short int e = 1; e < inPauliGroupString.size(); e++ ){
+        // Verify valid input which must be one of the following: { "I", "X", "Y", "Z" }
+        const int m_iPauliIndex = PauliCharToIndex(inPauliGroupString.at(e));
+        if (m_iPauliIndex < 0) {
+            string m_sPauliChar = string(1, inPauliGroupString.at(e));
+            cout << "MakePauliAlgebraElement failed because " << "from your input string " << "\"" << inPauliGroupString << "\"" << "," << "\"" << m_sPauliChar << "\"" << " is not valid. " << "Replace " << "\"" << m_sPauliChar << "\"" << " with one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
+            cout << "Exiting Program . . . " << endl;
+            exit(1);
+        }
+
+        m_paeResult.m_sElementString += " @ ";
+        m_paeResult.m_sElementString += PAULI_CHARS[m_iPauliIndex];
+        m_vecFactors.push_back(&m_arrpmPaulis[m_iPauliIndex]);
+    }
+    KroneckerProductInto(m_paeResult, m_vecFactors.data(), m_vecFactors.size());
+    
+    return m_paeResult;
+}
+
+
+CPauliAlgebraElement &CPauliAlgebraElement::operator*=(const complex<float> &inZ)
+/********************************************
+ *       Purpose: Multiply matrix data member of a PauliAlgebraElement object by a 
+ *                scalar. The scalar may be a complex number.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    // Update value of pauli_factor
+    this->m_cxElementPhase = this->m_cxElementPhase * inZ;
+
+    // Update matrix
+    // TODO: Prevent -0 entries in matrix.  
+    this->ScaleEntries(inZ);
+    return *this;
+}
+
+
+CPauliAlgebraElement CPauliAlgebraElement::operator*(const complex<float> &inZ) const
+/********************************************
+ *       Purpose: Return a copy of this PauliAlgebraElement object multiplied by a scalar.
+ *  Precondition: N/A
+ * Postcondition: Must NOT modify any data members of PauliAlgebraElement Object.
+********************************************/ 
+{
+    CPauliAlgebraElement m_paeResult = *this;
+    m_paeResult *= inZ;
+    return m_paeResult;
+}
+
+
+void MultiplyPauliAlgebraByScalar(const complex<float> &inZ, CPauliAlgebraElement &inPAElement)
+/********************************************
+ *       Purpose: Multiply PauliAlgebraElement by a scalar. Scalar may be a complex number.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    inPAElement *= inZ;
+}
+
+
+CPauliAlgebraElement CPauliAlgebraElement::operator+(const CPauliAlgebraElement &inPAElement2) const
+/********************************************
+ *       Purpose: Add matrix data member entries of first input PauliAlgebraElement object 
+ *                with the matrix data member entries of second input PauliAlgebraElement object.
+ * 
+ *  Precondition: First and Second input PauliAlgebraElement objects may only differ by
+ *                a scalar factor. Otherwise, addition fails.
+ *                Good, -9XYZ + 7XYZ  =  -1XYZ
+ *                 Bad,  4XYZ +  ZZZ  
+ * Postcondition: N/A
+ *          Note: The sum takes the layout of the first element. See AddPauliAlgebraInto().
+********************************************/
+{
+    CPauliAlgebraElement m_paeResult = CPauliAlgebraElement(0, 0);
+    m_paeResult.SetLayout(this->m_eLayout);
+    AddPauliAlgebraInto(m_paeResult, *this, inPAElement2);
+    return m_paeResult;
+}
+
+
+void AddPauliAlgebraInto(CPauliAlgebraElement &outPAElement, const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2)
+/********************************************
+ *       Purpose: outPAElement = inPAElement1 + inPAElement2, reusing the storage of outPAElement.
+ *  Precondition: Same as operator+. outPAElement may be either input.
+ * Postcondition: outPAElement keeps its layout. Nothing is allocated when it already has the size of the sum.
+********************************************/
+{
+    // Pauli Elements do NOT match. For example: XYZ + XY
+    if (inPAElement1.m_sElementString.compare(inPAElement2.m_sElementString) ||
+        inPAElement1.m_iRowSize * inPAElement1.m_iColSize != inPAElement2.m_iRowSize * inPAElement2.m_iColSize) {
+        cout << "Adding Pauli Elements Failed. Pauli elements do not match: " << inPAElement1.m_sElementString << " and " << inPAElement2.m_sElementString << endl;
+        exit(1);
+    }
+
+    // Pauli Elements do match. For example: XYZ + 2XYZ
+    outPAElement.m_cxElementPhase = inPAElement1.m_cxElementPhase + inPAElement2.m_cxElementPhase;
+    outPAElement.m_sElementString = inPAElement1.m_sElementString; 
+    outPAElement.m_cxPauliFactor = complex<float>(1, 0);
+    outPAElement.m_sPauliString.clear();
+    outPAElement.Resize(inPAElement1.m_iRowSize, inPAElement1.m_iColSize);
+
+    // Mixed layouts go through a fused expression, which reads either layout without converting it.
+    if ( inPAElement1.m_eLayout != outPAElement.m_eLayout || inPAElement2.m_eLayout != outPAElement.m_eLayout ) {
+        static_cast<CMatrix &>(outPAElement) = static_cast<const CMatrix &>(inPAElement1) + static_cast<const CMatrix &>(inPAElement2);
+        return;
+    }
+
+    // Add pauli elements
+    // TODO: Prevent -0 entries in matrix.  
+    // Addition does not mix real and imaginary parts, so the split planes are added as one buffer.
+    const complex<float> *m_pEntries1 = inPAElement1.m_vecMatrix.data();
+    const complex<float> *m_pEntries2 = inPAElement2.m_vecMatrix.data();
+    complex<float> *m_pResult = outPAElement.m_vecMatrix.data();
+    size_t m_iNumOfEntries = outPAElement.m_vecMatrix.size();
+    if ( outPAElement.m_eLayout == SPLIT_LAYOUT ) {
+        m_pEntries1 = reinterpret_cast<const complex<float> *>(inPAElement1.m_vecSplitMatrix.data());
+        m_pEntries2 = reinterpret_cast<const complex<float> *>(inPAElement2.m_vecSplitMatrix.data());
+        m_pResult = reinterpret_cast<complex<float> *>(outPAElement.m_vecSplitMatrix.data());
+        m_iNumOfEntries = outPAElement.GetPlaneSize();
+    }
+    const CMatrixKernels &m_kernels = MatrixKernels();
+    ParallelFor(0, m_iNumOfEntries, PARALLEL_GRAIN_SIZE, [&](size_t inBegin, size_t inEnd) {
+        m_kernels.Add(m_pEntries1 + inBegin, m_pEntries2 + inBegin, m_pResult + inBegin, inEnd - inBegin);
+    });
+}
+
+
+CPauliAlgebraElement AddPauliAlgebra(const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2)
+/********************************************
+ *       Purpose: Add Pauli algebra elements first_pauli_matrix and second_pauli_matrix.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/
+{
+    return inPAElement1 + inPAElement2;
+}
+
+
+void TestConstructPauliElement( const complex<float> &inZ, const string inPauliGroupString )
+/********************************************
+ *       Purpose: Test MakePauliAlgebraElement() function.
+ *                Test MultiplyPauliAlgebraByScalar() function.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/
+{
+    CPauliAlgebraElement m_paeResult = MakePauliAlgebraElement(inPauliGroupString);
+    cout << "Initial tensor product matrix:" << endl;
+    cout << m_paeResult.PauliAlgebraElementToString() << endl;
+    m_paeResult.PrintMatrix();
+
+
+    if (inZ.imag() == 0 )    
+        cout << "After Scalar Multiplication by " << "(" + to_string((int) inZ.real()) + ")" << endl;
+
+    else if ( inZ.real() == 0 )
+        cout << "After Scalar Multiplication by " << "(" + to_string((int) inZ.imag()) + "i" + ")" << endl;
+
+    else if ( inZ.real() != 0 && inZ.imag() != 0 )
+        cout << "After Scalar Multiplication by " << "(" + to_string((int) inZ.real()) + " + " + to_string((int) inZ.imag()) + "i" + ")" << endl;
+
+    MultiplyPauliAlgebraByScalar(inZ, m_paeResult);
+    cout << m_paeResult.PauliAlgebraElementToString() << endl;
+    m_paeResult.PrintMatrix();
+
+
+    if (inZ.imag() == 0 )    
+        cout << "After Scalar Conjugate Multiplication by " << "(" + to_string((int) conj(inZ).real()) + ")" << endl;
+
+    else if ( inZ.real() == 0 )
+        cout << "After Scalar Conjugate Multiplication by " << "(" + to_string((int) conj(inZ).imag()) + "i" + ")" << endl;
+
+    else if ( inZ.real() != 0 && inZ.imag() != 0 )
+        cout << "After Scalar Conjugate Multiplication by " << "(" + to_string((int) conj(inZ).real()) + " + " + to_string((int) conj(inZ).imag()) + "i" + ")" << endl;
+
+    MultiplyPauliAlgebraByScalar(conj(inZ), m_paeResult);
+    cout << m_paeResult.PauliAlgebraElementToString() << endl;
+    m_paeResult.PrintMatrix();
+}
+
+
+void TestAddPauliAlgebra( const complex<float> &inZ1, const string &inPAString1, const complex<float> &inZ2, const string &inPAString2)
+/********************************************
+ *       Purpose: Test AddPauliAlgebra() function.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/
+{
+    CPauliAlgebraElement m_paeElement1 = MakePauliAlgebraElement(inPAString1);
+    MultiplyPauliAlgebraByScalar(inZ1, m_paeElement1);
+    cout << "First Pauli Element: " << m_paeElement1.PauliAlgebraElementToString() << endl;
+    m_paeElement1.PrintMatrix();
+
+    CPauliAlgebraElement m_paeElement2 = MakePauliAlgebraElement(inPAString2);
+    MultiplyPauliAlgebraByScalar(inZ2, m_paeElement2);
+    cout << "Second Pauli Element: " << m_paeElement2.PauliAlgebraElementToString() << endl;
+    m_paeElement2.PrintMatrix();
+
+    CPauliAlgebraElement m_paeResult = AddPauliAlgebra(m_paeElement1, m_paeElement2);
+    cout << "First plus Second Element: " << "(" << m_paeElement1.PauliAlgebraElementToString() << ")" << " + " << "(" << m_paeElement2.PauliAlgebraElementToString() << ")" << " = " << m_paeResult.PauliAlgebraElementToString() << endl;
+    m_paeResult.PrintMatrix();
+}
+
+void GetPauliString(const string &inPauliChar1, const string &inPauliChar2, complex<float> &outFactor, string &outPauliChar3)
+/********************************************
+ *       Purpose: 4th input parameter is modified to the single character string 
+ *                representing the resulting matrix of multiplying the first input 
+ *                parameter matrix string with the second input parameter matrix.
+ *                3rd input parameter is the resulting factor.
+ * 
+ *                Pauli Matrix Strings are: "I", "X", "Y", "Z"
+ *                IX = XI = X
+ *                IY = YI = Y
+ *                IZ = ZI = Z
+ *                XY = iZ 
+ *                XZ = -iY
+ *                YX = -iZ
+ *                YZ = iX
+ *                ZX = iY
+ *                ZY = -iX
+ *              
+ *              Associativity Rule: 
+ *              c(AB) = c(A)B = A(cB)
+ *              where c is a constant
+ *              A and B are matrices.
+ * 
+ *  Precondition: Must not modify 1st and 2nd input parameters.
+ * Postcondition: Must modify 3rd and 4th input parameters.
+ *          Note: The product is read from PAULI_PRODUCT_TABLE.
+********************************************/ 
+{    
+    const int m_iPauliIndex1 = inPauliChar1.size() == 1 ? PauliCharToIndex(inPauliChar1[0]) : -1;
+    const int m_iPauliIndex2 = inPauliChar2.size() == 1 ? PauliCharToIndex(inPauliChar2[0]) : -1;
+    if (m_iPauliIndex1 < 0 || m_iPauliIndex2 < 0) {
+        cout << "ERROR: One of your input strings is not a pauli character." << "\n"
+             << "Exiting Program . . .";
+        exit(1);
+    }
+
+    const CPauliProduct m_ppProduct = PAULI_PRODUCT_TABLE[m_iPauliIndex1][m_iPauliIndex2];
+    outFactor = PAULI_PHASES[m_ppProduct.m_iPhaseExponent];
+    outPauliChar3 = string(1, PAULI_CHARS[m_ppProduct.m_iPauliIndex]);
+}
+
+
+CPauliAlgebraElement CPauliAlgebraElement::operator%(const CPauliAlgebraElement &inPAElement2) const
+/********************************************
+ *       Purpose: Multiply first PauliAlgebraElement object with the second 
+ *                PauliAlgebraElement object.
+ *                i(Z @ X) * -(Z @ Y) = I @ Z
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: See MultiplyPauliAlgebraInto(). The result takes the layout of the first element.
+ *          TODO: - Change operator % to something else.
+ *                  Operator overloading should be for * operator.
+ *                  However, the * operator is already overloaded for 
+ *                  PauliAlgebraElement() * PauliAlgebraElement(). 
+ *                  Add another parameter to operator overload for *
+ *                  that acts as a key to switch between different 
+ *                  functionalities.
+********************************************/
+{
+    CPauliAlgebraElement m_paeResult = CPauliAlgebraElement(0, 0);
+    m_paeResult.SetLayout(this->m_eLayout);
+    MultiplyPauliAlgebraInto(m_paeResult, *this, inPAElement2);
+    return m_paeResult;
+}
+
+
+static void ParsePauliElementString(const string &inElementString, size_t &outNumOfQubits, uint64_t &outXMask, uint64_t &outZMask)
+/********************************************
+ *       Purpose: Read an element string such as "X @ Y @ Z" into X and Z bit masks. Qubit 0, the leftmost 
+ *                factor, is the highest bit, so bit q of the masks belongs to bit q of a matrix index.
+ *  Precondition: At most 64 qubits.
+ * Postcondition: Characters other than I, X, Y and Z are separators. Nothing is allocated.
+********************************************/ 
+{
+    outNumOfQubits = 0;
+    outXMask = 0;
+    outZMask = 0;
+    for ( size_t i = 0; i < inElementString.size(); i++ ) {
+        const char m_cPauliChar = inElementString[i];
+        if ( m_cPauliChar != 'I' && m_cPauliChar != 'X' && m_cPauliChar != 'Y' && m_cPauliChar != 'Z' )
+            continue;
+        outXMask = (outXMask << 1) | uint64_t(m_cPauliChar == 'X' || m_cPauliChar == 'Y');
+        outZMask = (outZMask << 1) | uint64_t(m_cPauliChar == 'Z' || m_cPauliChar == 'Y');
+        outNumOfQubits++;
+    }
+}
+
+
+void MultiplyPauliAlgebraInto(CPauliAlgebraElement &outPAElement, const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2)
+/********************************************
+ *       Purpose: outPAElement = inPAElement1 * inPAElement2, reusing the storage of outPAElement.
+ *                i(Z @ X) * -(Z @ Y) = I @ Z
+ *  Precondition: Both elements have the same number of qubits, at least 1 and at most MAX_NUM_OF_QUBITS. 
+ *                outPAElement may be either input.
+ * Postcondition: outPAElement keeps its layout. Nothing is allocated when it already has the size 
+ *                and string capacity of the product.
+ *          Note: The Pauli Strings are multiplied as X and Z bit masks. The product has one nonzero entry 
+ *                per row, so the dense matrix is written in O(4^n) for the zeros plus O(2^n) for the entries.
+********************************************/
+{
+    size_t m_iNumOfQubits1, m_iNumOfQubits2;
+    uint64_t m_iXMask1, m_iZMask1, m_iXMask2, m_iZMask2;
+    ParsePauliElementString(inPAElement1.m_sElementString, m_iNumOfQubits1, m_iXMask1, m_iZMask1);
+    ParsePauliElementString(inPAElement2.m_sElementString, m_iNumOfQubits2, m_iXMask2, m_iZMask2);
+    if (m_iNumOfQubits1 != m_iNumOfQubits2) {
+        cout << "Multiplying Pauli Elements Failed. Pauli elements do not match in size: " << inPAElement1.m_sElementString << " and " << inPAElement2.m_sElementString << endl;
+        exit(1);
+    }
+    if (m_iNumOfQubits1 == 0 || m_iNumOfQubits1 > MAX_NUM_OF_QUBITS) {
+        cout << "ERROR: Multiplying Pauli Elements needs 1 to " << MAX_NUM_OF_QUBITS << " qubits, not " << m_iNumOfQubits1 << "." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    // With P = i^|x & z| X^x Z^z, the product is (-1)^|z1 & x2| i^(|x1 & z1| + |x2 & z2|) X^x Z^z for x = x1 ^ x2 and z = z1 ^ z2.
+    const uint64_t m_iXMask = m_iXMask1 ^ m_iXMask2;
+    const uint64_t m_iZMask = m_iZMask1 ^ m_iZMask2;
+    const unsigned int m_iExponent = PopCount64(m_iXMask1 & m_iZMask1) + PopCount64(m_iXMask2 & m_iZMask2) 
+                                     + 2 * PopCount64(m_iZMask1 & m_iXMask2) + 3 * PopCount64(m_iXMask & m_iZMask);
+    const complex<float> m_cxPhase = MultiplyByPowerOfI(inPAElement1.m_cxElementPhase * inPAElement2.m_cxElementPhase, m_iExponent);
+
+    // For Example: "I @ Z". Resizing a string to the same length keeps its storage.
+    const size_t m_iNumOfQubits = m_iNumOfQubits1;
+    outPAElement.m_sElementString.resize(4 * m_iNumOfQubits - 3);
+    const char m_arrcPauliChars[] = { 'I', 'X', 'Z', 'Y' };
+    for ( size_t q = 0; q < m_iNumOfQubits; q++ ) {
+        const uint64_t m_iBit = uint64_t(1) << (m_iNumOfQubits - 1 - q);
+        outPAElement.m_sElementString[4 * q] = m_arrcPauliChars[((m_iXMask & m_iBit) ? 1 : 0) + ((m_iZMask & m_iBit) ? 2 : 0)];
+        if ( q + 1 < m_iNumOfQubits ) {
+            outPAElement.m_sElementString[4 * q + 1] = ' ';
+            outPAElement.m_sElementString[4 * q + 2] = '@';
+            outPAElement.m_sElementString[4 * q + 3] = ' ';
+        }
+    }
+    outPAElement.m_cxElementPhase = m_cxPhase;
+    outPAElement.m_cxPauliFactor = complex<float>(1, 0);
+    if ( m_iNumOfQubits == 1 )
+        outPAElement.m_sPauliString.assign(1, outPAElement.m_sElementString[0]);
+    else
+        outPAElement.m_sPauliString.clear();
+
+    // Entry (c ^ x, c) is m_cxPhase i^|x & z| (-1)^|c & z|, every other entry is 0.
+    const size_t m_iSideLength = size_t(1) << m_iNumOfQubits;
+    outPAElement.Resize(m_iSideLength, m_iSideLength);
+    if ( outPAElement.m_eLayout == INTERLEAVED_LAYOUT )
+        fill(outPAElement.m_vecMatrix.begin(), outPAElement.m_vecMatrix.end(), complex<float>(0, 0));
+    else
+        fill(outPAElement.m_vecSplitMatrix.begin(), outPAElement.m_vecSplitMatrix.end(), 0.0f);
+    // Adding 0 turns the -0 parts that sign flips leave behind into 0.
+    const complex<float> m_cxEntry = MultiplyByPowerOfI(m_cxPhase, PopCount64(m_iXMask & m_iZMask));
+    const complex<float> m_cxEntries[] = { m_cxEntry + complex<float>(0, 0), -m_cxEntry + complex<float>(0, 0) };
+    for ( size_t c = 0; c < m_iSideLength; c++ )
+        outPAElement(c ^ m_iXMask, c) = m_cxEntries[PopCount64(c & m_iZMask) & 1];
+}
+
+
+CPauliAlgebraElement MultiplyPauliAlgebra(const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2)
+/********************************************
+ *       Purpose: Multiply first input Pauli algebra elements with second input Pauli algebra element.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          TODO: N/A
+********************************************/
+{
+    return inPAElement1 % inPAElement2;
+}
+
+
+void TestMultiplyPauliAlgebra( const complex<float> &z1, const string &p1_algebra_string, const complex<float> &z2, const string &p2_algebra_string )
+/********************************************
+ *       Purpose: Test the MultiplyPauliAlgebra() function.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/
+{
+    CPauliAlgebraElement p1 = MakePauliAlgebraElement(p1_algebra_string);
+    MultiplyPauliAlgebraByScalar(z1, p1);
+    cout << "First Pauli Element: " << p1.PauliAlgebraElementToString() << endl;
+    p1.PrintMatrix();
+
+    CPauliAlgebraElement p2 = MakePauliAlgebraElement(p2_algebra_string);
+    MultiplyPauliAlgebraByScalar(z2, p2);
+    cout << "Second Pauli Element: " << p2.PauliAlgebraElementToString() << endl;
+    p2.PrintMatrix();
+
+    const CPauliAlgebraElement p3 = MultiplyPauliAlgebra(p1, p2);    
+    cout << "Multiplication between pauli elements: " << "(" << p1.PauliAlgebraElementToString() << ")" << " * " << "(" << p2.PauliAlgebraElementToString() << ")" << " = " << p3.PauliAlgebraElementToString() << endl;
+    p3.PrintMatrix();
+}
+
+
+
+static void TransposePlane(float *ioPlane, const size_t inSideLength, const bool inWillNegate)
+/********************************************
+ *       Purpose: Transpose a square row major plane of floats in place, and negate it if inWillNegate.
+ *                Entries are swapped in 32 x 32 blocks so both blocks of a pair stay in cache.
+ *  Precondition: N/A
+ * Postcondition: Rows of blocks are split across threads. Each pair of blocks belongs to the upper one.
+********************************************/ 
+{
+    const size_t BLOCK = 32;
+    const float m_fSign = inWillNegate ? -1.0f : 1.0f;
+    const size_t m_iNumOfBlockRows = (inSideLength + BLOCK - 1) / BLOCK;
+    ParallelFor(0, m_iNumOfBlockRows, max<size_t>(1, PARALLEL_GRAIN_SIZE / (BLOCK * inSideLength)), [&](size_t inBlockRowBegin, size_t inBlockRowEnd) {
+        for ( size_t br = inBlockRowBegin * BLOCK; br < min(inBlockRowEnd * BLOCK, inSideLength); br += BLOCK ) {
+            for ( size_t bc = br; bc < inSideLength; bc += BLOCK ) {
+                for ( size_t r = br; r < min(br + BLOCK, inSideLength); r++ ) {
+                    for ( size_t c = max(bc, r + 1); c < min(bc + BLOCK, inSideLength); c++ ) {
+                        const float m_fEntry = ioPlane[r * inSideLength + c];
+                        ioPlane[r * inSideLength + c] = m_fSign * ioPlane[c * inSideLength + r];
+                        ioPlane[c * inSideLength + r] = m_fSign * m_fEntry;
+                    }
+                }
+            }
+            for ( size_t r = br; r < min(br + BLOCK, inSideLength); r++ )
+                ioPlane[r * inSideLength + r] *= m_fSign;
+        }
+    });
+}
+
+
+void CMatrix::ConjugateTranspose()
+/********************************************
+ *       Purpose: Take the complex conjugate and transpose of a matrix.
+ *  Precondition: N/A
+ * Postcondition: Matrix data member must have changed to its conjugate transpose. 
+ *                An M x N matrix becomes N x M.
+ *          Note: Square matrices are transposed in place. Other shapes go through the fused 
+ *                adjoint expression and one temporary, since their entries move to a new row length.
+********************************************/ 
+{
+    if ( m_iRowSize != m_iColSize ) {
+        *this = Adjoint();
+        return;
+    }
+
+    // Rows are handed out in blocks of 32, a multiple of the 4 x 4 tiles of the SIMD kernels.
+    const size_t BLOCK = 32;
+    if ( m_eLayout == INTERLEAVED_LAYOUT ) {
+        const size_t m_iSideLength = m_iRowSize;
+        complex<float> *m_pEntries = m_vecMatrix.data();
+        const CMatrixKernels &m_kernels = MatrixKernels();
+        ParallelFor(0, (m_iSideLength + BLOCK - 1) / BLOCK, max<size_t>(1, PARALLEL_GRAIN_SIZE / (BLOCK * max<size_t>(1, m_iSideLength))), 
+                    [&](size_t inBlockRowBegin, size_t inBlockRowEnd) {
+            m_kernels.ConjugateTranspose(m_pEntries, m_iSideLength, inBlockRowBegin * BLOCK, min(inBlockRowEnd * BLOCK, m_iSideLength));
+        });
+    }
+    else {
+        TransposePlane(m_vecSplitMatrix.data(), m_iRowSize, false);
+        TransposePlane(m_vecSplitMatrix.data() + GetPlaneSize(), m_iRowSize, true);
+    }
+}
+
+
+CMatrix GenerateHermitianMatrix(const unsigned short int inBoundParam, unsigned short int inSideLength)
+/********************************************
+ *       Purpose: Return a random Hermitian Matrix.
+ *  Precondition: boundParam must be a positive real number.
+ * Postcondition: Random Hermitian Matrix entries (both real and complex) 
+ *                are bounded by the interval [-boundParam, boundParam]
+ *          Note: N/A
+ *          TODO: - In body, change matrix variable to be a Matrix object type. 
+ *                  Update function body accordingly.
+********************************************/ 
+{
+    // Generate a random N for an N x N matrix.
+    // TODO: Generate random numbers across EVERY program invocation using std::random_device.
+    static default_random_engine generator;
+    uniform_int_distribution<int> matrix_length_distribution(1,10); 
+    if (inSideLength == 0)
+        inSideLength = matrix_length_distribution(generator);
+    // cout << matrix_side_length << endl;
+    uniform_int_distribution<int> matrix_entry_distribution(-inBoundParam/2, inBoundParam/2);
+
+
+    CMatrix m_mInitMatrix(inSideLength, inSideLength);
+
+
+    // Create random complex entries for the N x N matrix.
+    for ( size_t r = 0; r < m_mInitMatrix.GetRowSize(); r++ ){
+        for ( size_t c = 0; c < m_mInitMatrix.GetColSize(); c++ ){
+            int real_value = matrix_entry_distribution(generator);
+            int imag_value = matrix_entry_distribution(generator);
+            complex<float> complex_value = complex<float>(real_value, imag_value);
+            m_mInitMatrix(r, c) = complex_value;
+
+            // For Debugging. Can Delete.
+            // cout << "     real_value: " <<  real_value << endl;
+            // cout << "     imag_value: " << imag_value << endl;
+            // cout << "  complex_value: " << complex<double>(real_value, imag_value) << endl;
+        }
+    }
+
+
+    // For Debugging. Can Delete.
+    // cout << "Random Matrix" << endl;
+    // HelperPrintMatrix(matrix);
+
+
+    // Hermitian Matrix. The sum and conjugate transpose are fused into one pass, 
+    // so no copy of the random matrix is made.
+    CMatrix matrix_dagger = m_mInitMatrix + m_mInitMatrix.Adjoint();
+
+    // For Debugging. Can Delete.
+    // cout << "Hermitian Matrix" << endl;
+    // HelperPrintMatrix(matrix_dagger);
+
+    // For Debugging. Can Delete.
+    // Inverse of Hermitian Matrix is the conjugate transpose. Which should remain the same.
+    // HelperConjugateTranspose(matrix_dagger);
+
+    // For Debugging. Can Delete.
+    // cout << "Inverse of Hermitian Matrix" << endl;
+    // HelperPrintMatrix(matrix_dagger);
+
+
+    return matrix_dagger;
+}
+
+
+bool CMatrix::operator==(const CMatrix& inMatrix2)
+/********************************************
+ *       Purpose: Return true if the data members between both matrices are equal.
+ *                   
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+ *          TODO: N/A
+********************************************/
+{
+    if (this->m_iRowSize != inMatrix2.m_iRowSize || this->m_iColSize != inMatrix2.m_iColSize)
+        return false;
+
+    if ( this->m_eLayout == INTERLEAVED_LAYOUT && inMatrix2.m_eLayout == INTERLEAVED_LAYOUT )
+        return MatrixKernels().Equal(this->m_vecMatrix.data(), inMatrix2.m_vecMatrix.data(), this->m_vecMatrix.size());
+
+    // Both planes are compared as one buffer. The padding is 0 in both matrices.
+    if ( this->m_eLayout == SPLIT_LAYOUT && inMatrix2.m_eLayout == SPLIT_LAYOUT )
+        return MatrixKernels().Equal(reinterpret_cast<const complex<float> *>(this->m_vecSplitMatrix.data()), 
+                                     reinterpret_cast<const complex<float> *>(inMatrix2.m_vecSplitMatrix.data()), this->GetPlaneSize());
+
+    const size_t m_iNumOfEntries = size_t(m_iRowSize) * m_iColSize;
+    for ( size_t i = 0; i < m_iNumOfEntries; i++ )
+        if ( this->GetEntry(i) != inMatrix2.GetEntry(i) )
+            return false;
+    return true;
+} 
+
+void Goal1Test(unsigned short int inNumOfTests, unsigned short int inBoundParam, bool inWillPrintMatrix)
+/********************************************
+ *       Purpose: Verify that all random matrices generated, are hermitian.
+ *                (R + R_dagger) == (R + R_dagger)_dagger 
+ *                      H        ==       H_dagger
+ * 
+ *                           Random Matrix = R
+ *                Conjugate Transpose of R = R_dagger
+ *                        Hermitian Matrix = H
+ *                   
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: Only set print_matrices to true if num_of_tests
+ *                is less than 11. Matrices will be print to terminal.
+ *          TODO: - Print out matrices and results to a file rather 
+ *                  than the terminal.
+********************************************/ 
+{
+    int hermitian_count = 0;
+    int not_hermitian_count = 0;
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Hermitian matrix entries, real and imaginary parts, bounded by the interval: " << "[" << -inBoundParam << ", " << inBoundParam << "]" << endl;
+
+
+    cout << "Performing Tests . . . " << endl;
+    for ( int i = 1; i <= inNumOfTests; i++ ) {
+
+        if ( inWillPrintMatrix )
+            cout << "Test " << i << ": " << endl;
+
+        CMatrix m_mMatrix = GenerateHermitianMatrix(inBoundParam);
+        CMatrix m_mMatrixDagger = m_mMatrix;
+        m_mMatrixDagger.ConjugateTranspose();
+        
+        if ( m_mMatrix == m_mMatrixDagger ) {
+            hermitian_count++;
+            if ( inWillPrintMatrix ) {
+                cout << "Matrix is Hermitian!" << endl;
+                m_mMatrix.PrintMatrix();
+            }
+        }
+        else {
+            not_hermitian_count++;
+            if ( inWillPrintMatrix ) {
+                cout << "Matrix is NOT Hermitian!" << endl;
+                m_mMatrix.PrintMatrix();
+            }
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of Random Matrices that are Hermitian: " << hermitian_count << endl;
+    cout << "Total Number of Random Matrices that are NOT Hermitian: " << not_hermitian_count << endl;
+    cout << "      Percentage of Random Matrices that are Hermitian: " << ( hermitian_count / (hermitian_count + not_hermitian_count) ) * 100 << "%" << endl;        
+}
+
+
+complex<float> CMatrix::Trace() const
+/********************************************
+ *       Purpose: Return the Trace of a matrix
+ *  Precondition: N/A
+ * Postcondition: Input matrix must not be modified.
+ *         Notes: Summed in double over fixed blocks of the diagonal, so the 
+ *                result does not depend on the number of threads.
+********************************************/ 
+{
+    const size_t m_iDiagonalLength = min(m_iRowSize, m_iColSize);
+    return complex<float>(ParallelSum(0, m_iDiagonalLength, PARALLEL_GRAIN_SIZE, [&](size_t inBegin, size_t inEnd) {
+        complex<double> m_cxBlockTrace = 0;
+        for ( size_t r = inBegin; r < inEnd; r++ )
+            m_cxBlockTrace += complex<double>(GetEntry(r * m_iColSize + r));
+        return m_cxBlockTrace;
+    }));
+}
+
+
+complex<float> TraceOfProduct(const CMatrix &inMatrix1, const CMatrix &inMatrix2, const bool inIsCompensated)
+/********************************************
+ *       Purpose: Return Tr(A B) = sum over i, k of A[i][k] B[k][i] without forming A B.
+ *                Rows of A are read as they are stored. Columns of B are gathered 32 at a time 
+ *                into a per thread 32 x N panel, reading B one short row segment at a time, 
+ *                so every sum over k is a contiguous SIMD dot product.
+ *  Precondition: A is M x N and B is N x M, in either layout.
+ * Postcondition: O(M N) work and no M x M temporary. Dot products accumulate in float, with Kahan 
+ *                compensation when inIsCompensated is true, and are added in double over fixed blocks 
+ *                of rows, so the result does not depend on the number of threads.
+********************************************/ 
+{
+    CheckExpressionSizes(inMatrix1.m_iRowSize, inMatrix1.m_iColSize, inMatrix2.m_iColSize, inMatrix2.m_iRowSize, "take the trace of the product of");
+    const size_t TILE = 32;
+    const size_t m_iNumOfRows = inMatrix1.m_iRowSize;
+    const size_t m_iDepth = inMatrix1.m_iColSize;
+    const size_t m_iNumOfTiles = (m_iNumOfRows + TILE - 1) / TILE;
+
+    const CMatrixKernels &m_kernels = MatrixKernels();
+    return complex<float>(ParallelSum(0, m_iNumOfTiles, max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, TILE * m_iDepth)), [&](size_t inTileBegin, size_t inTileEnd) {
+        thread_local vector<complex<float>> m_vecPanel;
+        thread_local vector<complex<float>> m_vecRow;
+        m_vecPanel.resize(TILE * m_iDepth);
+        m_vecRow.resize(m_iDepth);
+        complex<double> m_cxBlockSum = 0;
+        for ( size_t t = inTileBegin; t < inTileEnd; t++ ) {
+            const size_t m_iRowBegin = t * TILE;
+            const size_t m_iRowEnd = min(m_iNumOfRows, m_iRowBegin + TILE);
+
+            // Panel row i - m_iRowBegin is column i of B. Rows of B have m_iNumOfRows entries.
+            if ( inMatrix2.m_eLayout == INTERLEAVED_LAYOUT ) {
+                for ( size_t k = 0; k < m_iDepth; k++ ) {
+                    const complex<float> *m_pSegment = inMatrix2.m_vecMatrix.data() + k * m_iNumOfRows;
+                    for ( size_t i = m_iRowBegin; i < m_iRowEnd; i++ )
+                        m_vecPanel[(i - m_iRowBegin) * m_iDepth + k] = m_pSegment[i];
+                }
+            }
+            else {
+                const float *m_pRe = inMatrix2.m_vecSplitMatrix.data();
+                const float *m_pIm = m_pRe + inMatrix2.GetPlaneSize();
+                for ( size_t k = 0; k < m_iDepth; k++ )
+                    for ( size_t i = m_iRowBegin; i < m_iRowEnd; i++ )
+                        m_vecPanel[(i - m_iRowBegin) * m_iDepth + k] = complex<float>(m_pRe[k * m_iNumOfRows + i], m_pIm[k * m_iNumOfRows + i]);
+            }
+
+            for ( size_t i = m_iRowBegin; i < m_iRowEnd; i++ ) {
+                const complex<float> *m_pRow = inMatrix1.m_vecMatrix.data() + i * m_iDepth;
+                if ( inMatrix1.m_eLayout == SPLIT_LAYOUT ) {
+                    for ( size_t k = 0; k < m_iDepth; k++ )
+                        m_vecRow[k] = inMatrix1.GetEntry(i * m_iDepth + k);
+                    m_pRow = m_vecRow.data();
+                }
+                m_cxBlockSum += m_kernels.ComplexDot(m_pRow, m_vecPanel.data() + (i - m_iRowBegin) * m_iDepth, m_iDepth, false, inIsCompensated);
+            }
+        }
+        return m_cxBlockSum;
+    }));
+}
+
+
+complex<float> HilbertSchmidtInner(const CMatrix &inMatrix1, const CMatrix &inMatrix2, const bool inIsCompensated)
+/********************************************
+ *       Purpose: Return the Hilbert-Schmidt inner product <A, B> = Tr(A^dagger B) = sum over all entries of conj(A[i][k]) B[i][k]
+ *                without forming A^dagger B. Both matrices are read once, front to back.
+ *  Precondition: Both matrices are the same size, in either layout.
+ * Postcondition: O(N^2) work and no temporary. Two interleaved matrices take one SIMD complex dot product per block 
+ *                and two split ones take four real dot products per block, accumulated in float with Kahan compensation 
+ *                when inIsCompensated is true. Mixed layouts sum entry by entry in double. Blocks are added in double 
+ *                in order, so the result does not depend on the number of threads.
+********************************************/ 
+{
+    CheckExpressionSizes(inMatrix1.m_iRowSize, inMatrix1.m_iColSize, inMatrix2.m_iRowSize, inMatrix2.m_iColSize, "take the inner product of");
+    const size_t m_iNumOfEntries = size_t(inMatrix1.m_iRowSize) * inMatrix1.m_iColSize;
+    const size_t m_iPlaneSize1 = inMatrix1.GetPlaneSize();
+    const size_t m_iPlaneSize2 = inMatrix2.GetPlaneSize();
+
+    const CMatrixKernels &m_kernels = MatrixKernels();
+    return complex<float>(ParallelSum(0, m_iNumOfEntries, PARALLEL_GRAIN_SIZE, [&](size_t inBegin, size_t inEnd) {
+        if ( inMatrix1.m_eLayout == INTERLEAVED_LAYOUT && inMatrix2.m_eLayout == INTERLEAVED_LAYOUT )
+            return m_kernels.ComplexDot(inMatrix1.m_vecMatrix.data() + inBegin, inMatrix2.m_vecMatrix.data() + inBegin, inEnd - inBegin, true, inIsCompensated);
+
+        if ( inMatrix1.m_eLayout == SPLIT_LAYOUT && inMatrix2.m_eLayout == SPLIT_LAYOUT ) {
+            const float *m_pRe1 = inMatrix1.m_vecSplitMatrix.data() + inBegin;
+            const float *m_pIm1 = inMatrix1.m_vecSplitMatrix.data() + m_iPlaneSize1 + inBegin;
+            const float *m_pRe2 = inMatrix2.m_vecSplitMatrix.data() + inBegin;
+            const float *m_pIm2 = inMatrix2.m_vecSplitMatrix.data() + m_iPlaneSize2 + inBegin;
+            const size_t m_iLength = inEnd - inBegin;
+            return complex<double>(m_kernels.Dot(m_pRe1, m_pRe2, m_iLength, inIsCompensated) + m_kernels.Dot(m_pIm1, m_pIm2, m_iLength, inIsCompensated), 
+                                   m_kernels.Dot(m_pRe1, m_pIm2, m_iLength, inIsCompensated) - m_kernels.Dot(m_pIm1, m_pRe2, m_iLength, inIsCompensated));
+        }
+
+        complex<double> m_cxBlockSum = 0;
+        for ( size_t i = inBegin; i < inEnd; i++ )
+            m_cxBlockSum += conj(complex<double>(inMatrix1.GetEntry(i))) * complex<double>(inMatrix2.GetEntry(i));
+        return m_cxBlockSum;
+    }));
+}
+
+
+float FrobeniusNorm(const CMatrix &inMatrix, const bool inIsCompensated)
+/********************************************
+ *       Purpose: Return the Frobenius norm ||A||_F = sqrt(sum over all entries of |A[i][k]|^2).
+ *                The entries are one contiguous run of floats in either layout, since the 
+ *                padding of the split planes is 0, so this is a single SIMD dot product of the storage with itself.
+ *  Precondition: N/A
+ * Postcondition: Accumulates in float, with Kahan compensation when inIsCompensated is true. 
+ *                Blocks are added in double in order, so the result does not depend on the number of threads.
+********************************************/ 
+{
+    const float *m_pValues = (inMatrix.m_eLayout == INTERLEAVED_LAYOUT) ? reinterpret_cast<const float *>(inMatrix.m_vecMatrix.data()) 
+                                                                         : inMatrix.m_vecSplitMatrix.data();
+    const size_t m_iNumOfFloats = (inMatrix.m_eLayout == INTERLEAVED_LAYOUT) ? 2 * inMatrix.m_vecMatrix.size() : inMatrix.m_vecSplitMatrix.size();
+
+    const CMatrixKernels &m_kernels = MatrixKernels();
+    const complex<double> m_cxSumOfSquares = ParallelSum(0, m_iNumOfFloats, PARALLEL_GRAIN_SIZE, [&](size_t inBegin, size_t inEnd) {
+        return complex<double>(m_kernels.Dot(m_pValues + inBegin, m_pValues + inBegin, inEnd - inBegin, inIsCompensated), 0);
+    });
+    return float(sqrt(m_cxSumOfSquares.real()));
+}
+
+
+// Packed panel and cache block sizes for the complex matrix multiplication.
+// A GEMM_MR x NR tile of C lives in registers, a GEMM_KC x NR sliver of B stays in L1, 
+// a GEMM_MC x GEMM_KC block of A stays in L2 and a GEMM_KC x GEMM_NC panel of B stays in L3.
+// NR comes from the kernels in use. GEMM_NC must be a multiple of every NR.
+static const size_t GEMM_KC = 256;
+static const size_t GEMM_MC = 64;
+static const size_t GEMM_NC = 512;
+static const size_t GEMM_SMALL_SIZE = 16 * 16 * 16;
+
+
+static void PackGemmPanelA(const CStridedComplex &inA, const size_t inNumOfRows, const size_t inDepth, float *outPacked)
+/********************************************
+ *       Purpose: Copy an inNumOfRows x inDepth block of A into GEMM_MR row slivers. 
+ *                For every column k a sliver holds GEMM_MR real parts followed by GEMM_MR imaginary parts.
+ *  Precondition: outPacked holds ceil(inNumOfRows / GEMM_MR) * GEMM_MR * inDepth * 2 floats.
+ * Postcondition: Rows past inNumOfRows are padded with 0's.
+********************************************/ 
+{
+    for ( size_t s = 0; s < inNumOfRows; s += GEMM_MR ) {
+        const size_t m_iNumOfSliverRows = min(GEMM_MR, inNumOfRows - s);
+        for ( size_t k = 0; k < inDepth; k++ ) {
+            for ( size_t r = 0; r < GEMM_MR; r++ ) {
+                const size_t m_iOffset = (s + r) * inA.m_iRowStride + k * inA.m_iColStride;
+                outPacked[r] = (r < m_iNumOfSliverRows) ? inA.m_pRe[m_iOffset] : 0.0f;
+                outPacked[GEMM_MR + r] = (r < m_iNumOfSliverRows) ? inA.m_pIm[m_iOffset] : 0.0f;
+            }
+            outPacked += 2 * GEMM_MR;
+        }
+    }
+}
+
+
+static void PackGemmPanelB(const CStridedComplex &inB, const size_t inDepth, const size_t inNumOfCols, const size_t inNR, float *outPacked)
+/********************************************
+ *       Purpose: Copy an inDepth x inNumOfCols block of B into inNR column slivers. 
+ *                For every row k a sliver holds inNR real parts followed by inNR imaginary parts.
+ *  Precondition: outPacked holds ceil(inNumOfCols / inNR) * inNR * inDepth * 2 floats.
+ * Postcondition: Columns past inNumOfCols are padded with 0's.
+ *          Note: A split B is already in this format, so its rows are plain copies.
+********************************************/ 
+{
+    for ( size_t s = 0; s < inNumOfCols; s += inNR ) {
+        const size_t m_iNumOfSliverCols = min(inNR, inNumOfCols - s);
+        for ( size_t k = 0; k < inDepth; k++ ) {
+            const float *m_pRe = inB.m_pRe + k * inB.m_iRowStride + s * inB.m_iColStride;
+            const float *m_pIm = inB.m_pIm + k * inB.m_iRowStride + s * inB.m_iColStride;
+            for ( size_t c = 0; c < inNR; c++ ) {
+                outPacked[c] = (c < m_iNumOfSliverCols) ? m_pRe[c * inB.m_iColStride] : 0.0f;
+                outPacked[inNR + c] = (c < m_iNumOfSliverCols) ? m_pIm[c * inB.m_iColStride] : 0.0f;
+            }
+            outPacked += 2 * inNR;
+        }
+    }
+}
+
+
+static void ComplexGemm(const size_t inM, const size_t inN, const size_t inK, 
+                        const CStridedComplex &inA, const CStridedComplex &inB, const CStridedComplex &outC)
+/********************************************
+ *       Purpose: C = A * B for an inM x inK matrix A and inK x inN matrix B, each in either layout.
+ *                B is packed one GEMM_KC x GEMM_NC panel at a time and A one GEMM_MC x GEMM_KC 
+ *                block at a time, then every GEMM_MR x NR tile of C is updated by the micro kernel 
+ *                of the instruction set in use. The GEMM_MC row blocks of A are split across threads, 
+ *                which share the packed panel of B.
+ *  Precondition: C must not overlap A or B.
+ * Postcondition: The packing buffers are kept per thread, so after the first call 
+ *                on a thread no memory is allocated. Every entry of C is summed in the 
+ *                same order for any number of threads.
+********************************************/ 
+{
+    for ( size_t r = 0; r < inM; r++ ) {
+        for ( size_t c = 0; c < inN; c++ ) {
+            outC.m_pRe[r * outC.m_iRowStride + c * outC.m_iColStride] = 0;
+            outC.m_pIm[r * outC.m_iRowStride + c * outC.m_iColStride] = 0;
+        }
+    }
+
+    // Small products are not worth packing.
+    if ( inM * inN * inK <= GEMM_SMALL_SIZE ) {
+        for ( size_t r = 0; r < inM; r++ ) {
+            for ( size_t k = 0; k < inK; k++ ) {
+                const float m_fARe = inA.m_pRe[r * inA.m_iRowStride + k * inA.m_iColStride];
+                const float m_fAIm = inA.m_pIm[r * inA.m_iRowStride + k * inA.m_iColStride];
+                for ( size_t c = 0; c < inN; c++ ) {
+                    const float m_fBRe = inB.m_pRe[k * inB.m_iRowStride + c * inB.m_iColStride];
+                    const float m_fBIm = inB.m_pIm[k * inB.m_iRowStride + c * inB.m_iColStride];
+                    outC.m_pRe[r * outC.m_iRowStride + c * outC.m_iColStride] += m_fARe * m_fBRe - m_fAIm * m_fBIm;
+                    outC.m_pIm[r * outC.m_iRowStride + c * outC.m_iColStride] += m_fARe * m_fBIm + m_fAIm * m_fBRe;
+                }
+            }
+        }
+        return;
+    }
+
+    thread_local vector<float> m_vecPackedB;
+    if ( m_vecPackedB.empty() )
+        m_vecPackedB.resize(GEMM_KC * GEMM_NC * 2);
+
+    const CMatrixKernels &m_kernels = MatrixKernels();
+    const size_t NR = m_kernels.m_iGemmNR;
+    const size_t m_iNumOfRowBlocks = (inM + GEMM_MC - 1) / GEMM_MC;
+
+    for ( size_t jc = 0; jc < inN; jc += GEMM_NC ) {
+        const size_t m_iNumOfCols = min(GEMM_NC, inN - jc);
+        for ( size_t pc = 0; pc < inK; pc += GEMM_KC ) {
+            const size_t m_iDepth = min(GEMM_KC, inK - pc);
+            PackGemmPanelB(OffsetStridedComplex(inB, pc, jc), m_iDepth, m_iNumOfCols, NR, m_vecPackedB.data());
+            const float *m_pPackedPanelB = m_vecPackedB.data();
+
+            // One GEMM_MC x GEMM_KC block times the panel is 8 GEMM_MC GEMM_KC m_iNumOfCols flops.
+            const size_t m_iGrainSize = max<size_t>(1, 4 * PARALLEL_GRAIN_SIZE / (GEMM_MC * m_iDepth * m_iNumOfCols));
+            ParallelFor(0, m_iNumOfRowBlocks, m_iGrainSize, [&](size_t inRowBlockBegin, size_t inRowBlockEnd) {
+                thread_local vector<float> m_vecPackedA(GEMM_MC * GEMM_KC * 2);
+                for ( size_t ic = inRowBlockBegin * GEMM_MC; ic < min(inRowBlockEnd * GEMM_MC, inM); ic += GEMM_MC ) {
+                    const size_t m_iNumOfRows = min(GEMM_MC, inM - ic);
+                    PackGemmPanelA(OffsetStridedComplex(inA, ic, pc), m_iNumOfRows, m_iDepth, m_vecPackedA.data());
+
+                    for ( size_t jr = 0; jr < m_iNumOfCols; jr += NR ) {
+                        const float *m_pPackedB = m_pPackedPanelB + jr * m_iDepth * 2;
+                        for ( size_t ir = 0; ir < m_iNumOfRows; ir += GEMM_MR ) {
+                            const float *m_pPackedA = m_vecPackedA.data() + ir * m_iDepth * 2;
+                            m_kernels.GemmMicroKernel(m_iDepth, m_pPackedA, m_pPackedB, OffsetStridedComplex(outC, ic + ir, jc + jr), 
+                                                      min(GEMM_MR, m_iNumOfRows - ir), min(NR, m_iNumOfCols - jr));
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+
+static CStridedComplex StridedEntries(const CMatrix &inMatrix, const CSmallVector<complex<float>, SMALL_MATRIX_NUM_OF_ENTRIES> &inInterleaved, 
+                                      const CSmallVector<float, 0> &inSplit)
+/********************************************
+ *       Purpose: Return the CStridedComplex view of a CMatrix given its storage vectors.
+ *  Precondition: inInterleaved and inSplit are the storage of inMatrix.
+ * Postcondition: The view is only written through when inMatrix is not const.
+********************************************/ 
+{
+    CStridedComplex m_scResult;
+    if ( inMatrix.GetLayout() == INTERLEAVED_LAYOUT ) {
+        m_scResult.m_pRe = reinterpret_cast<float *>(const_cast<complex<float> *>(inInterleaved.data()));
+        m_scResult.m_pIm = m_scResult.m_pRe + 1;
+        m_scResult.m_iRowStride = 2 * size_t(inMatrix.GetColSize());
+        m_scResult.m_iColStride = 2;
+    }
+    else {
+        m_scResult.m_pRe = const_cast<float *>(inSplit.data());
+        m_scResult.m_pIm = m_scResult.m_pRe + inMatrix.GetPlaneSize();
+        m_scResult.m_iRowStride = inMatrix.GetColSize();
+        m_scResult.m_iColStride = 1;
+    }
+    return m_scResult;
+}
+
+
+template <size_t N>
+static void MultiplyFixedInto(CMatrix &outMatrix, const CMatrix &inMatrix1, const CMatrix &inMatrix2)
+/********************************************
+ *       Purpose: outMatrix = inMatrix1 * inMatrix2 through the unrolled CFixedMatrix<N> product.
+ *  Precondition: All three matrices are N x N, in any layout.
+ * Postcondition: Nothing is allocated.
+********************************************/ 
+{
+    const CFixedMatrix<N> m_fmProduct = CFixedMatrix<N>(inMatrix1) * CFixedMatrix<N>(inMatrix2);
+    for ( size_t r = 0; r < N; r++ )
+        for ( size_t c = 0; c < N; c++ )
+            outMatrix(r, c) = m_fmProduct(r, c);
+}
+
+
+void MultiplyInto(CMatrix &outMatrix, const CMatrix &inMatrix1, const CMatrix &inMatrix2)
+/********************************************
+ *       Purpose: outMatrix = inMatrix1 * inMatrix2 using the cache blocked matrix multiplication.
+ *  Precondition: inMatrix1 is M x K and inMatrix2 is K x N. Either may use either layout.
+ * Postcondition: outMatrix is M x N and keeps its layout. No memory is allocated when outMatrix already has 
+ *                the right size and does not alias an input. Otherwise outMatrix is resized, or the 
+ *                product is formed in a temporary first, so aliasing is still safe.
+ *          Note: 2 x 2, 4 x 4 and 8 x 8 products, one to three qubits, use the unrolled CFixedMatrix kernels.
+********************************************/ 
+{
+    if ( inMatrix1.m_iColSize != inMatrix2.m_iRowSize ) {
+        cout << "ERROR: Unable to matrix multiply a " << inMatrix1.m_iRowSize << " x " << inMatrix1.m_iColSize << " matrix with a " 
+             << inMatrix2.m_iRowSize << " x " << inMatrix2.m_iColSize << " matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    if ( &outMatrix == &inMatrix1 || &outMatrix == &inMatrix2 ) {
+        CMatrix m_mResult = CMatrix(inMatrix1.m_iRowSize, inMatrix2.m_iColSize, outMatrix.m_eLayout);
+        MultiplyInto(m_mResult, inMatrix1, inMatrix2);
+        outMatrix = std::move(m_mResult);
+        return;
+    }
+
+    outMatrix.m_iRowSize = inMatrix1.m_iRowSize;
+    outMatrix.m_iColSize = inMatrix2.m_iColSize;
+    if ( outMatrix.m_eLayout == INTERLEAVED_LAYOUT )
+        outMatrix.m_vecMatrix.resize(size_t(outMatrix.m_iRowSize) * outMatrix.m_iColSize);
+    else if ( outMatrix.m_vecSplitMatrix.size() != 2 * outMatrix.GetPlaneSize() )
+        outMatrix.m_vecSplitMatrix.assign(2 * outMatrix.GetPlaneSize(), 0.0f);
+
+    if ( inMatrix1.m_iRowSize == inMatrix1.m_iColSize && inMatrix2.m_iRowSize == inMatrix2.m_iColSize ) {
+        switch ( inMatrix1.m_iRowSize ) {
+            case 2: MultiplyFixedInto<2>(outMatrix, inMatrix1, inMatrix2); return;
+            case 4: MultiplyFixedInto<4>(outMatrix, inMatrix1, inMatrix2); return;
+            case 8: MultiplyFixedInto<8>(outMatrix, inMatrix1, inMatrix2); return;
+            default: break;
+        }
+    }
+
+    ComplexGemm(inMatrix1.m_iRowSize, inMatrix2.m_iColSize, inMatrix1.m_iColSize, 
+                StridedEntries(inMatrix1, inMatrix1.m_vecMatrix, inMatrix1.m_vecSplitMatrix), 
+                StridedEntries(inMatrix2, inMatrix2.m_vecMatrix, inMatrix2.m_vecSplitMatrix), 
+                StridedEntries(outMatrix, outMatrix.m_vecMatrix, outMatrix.m_vecSplitMatrix));
+}
+
+
+CMatrixView MakeMatrixView(complex<float> *inData, const size_t inRowSize, const size_t inColSize, 
+                           const size_t inLeadingDimension, const EMatrixOrder inOrder)
+/********************************************
+ *       Purpose: Return a view of an inRowSize x inColSize matrix of interleaved entries at inData, 
+ *                stored in inOrder with leading dimension inLeadingDimension. Nothing is copied, 
+ *                so a BLAS style column major buffer or a panel of a larger array can be used directly.
+ *  Precondition: inData holds every entry of the matrix and outlives the view.
+ * Postcondition: The view has no owning CMatrix, so writing an expression that reads the same memory 
+ *                into it must go through a CMatrix temporary.
+********************************************/ 
+{
+    const size_t m_iMinLeadingDimension = (inOrder == ROW_MAJOR) ? inColSize : inRowSize;
+    if ( inRowSize > MAX_SIDE_LENGTH || inColSize > MAX_SIDE_LENGTH || inLeadingDimension < m_iMinLeadingDimension ) {
+        cout << "ERROR: Unable to view a " << inRowSize << " x " << inColSize << (inOrder == ROW_MAJOR ? " row" : " column") 
+             << " major matrix with leading dimension " << inLeadingDimension << "." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    float *m_pReal = reinterpret_cast<float *>(inData);
+    if ( inOrder == ROW_MAJOR )
+        return CMatrixView(m_pReal, m_pReal + 1, inRowSize, inColSize, 2 * inLeadingDimension, 2, NULL);
+    return CMatrixView(m_pReal, m_pReal + 1, inRowSize, inColSize, 2, 2 * inLeadingDimension, NULL);
+}
+
+
+CConstMatrixView MakeMatrixView(const complex<float> *inData, const size_t inRowSize, const size_t inColSize, 
+                                const size_t inLeadingDimension, const EMatrixOrder inOrder)
+/********************************************
+ *       Purpose: Read only version of MakeMatrixView().
+ *  Precondition: See MakeMatrixView().
+ * Postcondition: N/A
+********************************************/ 
+{
+    return MakeMatrixView(const_cast<complex<float> *>(inData), inRowSize, inColSize, inLeadingDimension, inOrder);
+}
+
+
+template <class T>
+static CStridedComplex StridedEntries(const CMatrixViewBase<T> &inView)
+/********************************************
+ *       Purpose: Return the CStridedComplex form of a view.
+ *  Precondition: N/A
+ * Postcondition: The result is only written through when T is not const.
+********************************************/ 
+{
+    CStridedComplex m_scResult = { const_cast<float *>(inView.GetRealData()), const_cast<float *>(inView.GetImagData()), 
+                                   inView.GetRowStride(), inView.GetColStride() };
+    return m_scResult;
+}
+
+
+static void StridedMatrixVector(const size_t inNumOfRows, const size_t inNumOfCols, 
+                                const CStridedComplex &inA, const CStridedComplex &inX, const CStridedComplex &outY)
+/********************************************
+ *       Purpose: y = A * x for an inNumOfRows x inNumOfCols matrix A and column vectors x and y of any stride. 
+ *                Rows are split across threads. When A is row major, or interleaved with contiguous vectors, 
+ *                every entry of y is a dot product along a row. Otherwise A is read a column at a time 
+ *                within each block of rows, so the inner loop runs down a contiguous column.
+ *  Precondition: y must not overlap A or x.
+ * Postcondition: Every entry of y is summed in the same order for any number of threads.
+********************************************/ 
+{
+    const size_t m_iGrainSize = max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, inNumOfCols));
+    const bool m_bIsInterleaved = (inA.m_pIm == inA.m_pRe + 1 && inX.m_pIm == inX.m_pRe + 1 && outY.m_pIm == outY.m_pRe + 1);
+    if ( m_bIsInterleaved && inA.m_iColStride == 2 && inX.m_iRowStride == 2 && outY.m_iRowStride == 2 ) {
+        const complex<float> *m_pA = reinterpret_cast<const complex<float> *>(inA.m_pRe);
+        const complex<float> *m_pX = reinterpret_cast<const complex<float> *>(inX.m_pRe);
+        complex<float> *m_pY = reinterpret_cast<complex<float> *>(outY.m_pRe);
+        const size_t m_iLeadingDimension = inA.m_iRowStride / 2;
+        const CMatrixKernels &m_kernels = MatrixKernels();
+        ParallelFor(0, inNumOfRows, m_iGrainSize, [&](size_t inRowBegin, size_t inRowEnd) {
+            m_kernels.MatrixVector(m_pA + inRowBegin * m_iLeadingDimension, inRowEnd - inRowBegin, inNumOfCols, m_iLeadingDimension, 
+                                   m_pX, m_pY + inRowBegin);
+        });
+        return;
+    }
+
+    const bool m_bIsRowMajor = (inA.m_iColStride <= inA.m_iRowStride);
+    ParallelFor(0, inNumOfRows, m_iGrainSize, [&](size_t inRowBegin, size_t inRowEnd) {
+        if ( m_bIsRowMajor ) {
+            for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+                const float *m_pRowRe = inA.m_pRe + r * inA.m_iRowStride;
+                const float *m_pRowIm = inA.m_pIm + r * inA.m_iRowStride;
+                float m_fRe = 0, m_fIm = 0;
+                for ( size_t c = 0; c < inNumOfCols; c++ ) {
+                    const float m_fXRe = inX.m_pRe[c * inX.m_iRowStride];
+                    const float m_fXIm = inX.m_pIm[c * inX.m_iRowStride];
+                    m_fRe += m_pRowRe[c * inA.m_iColStride] * m_fXRe - m_pRowIm[c * inA.m_iColStride] * m_fXIm;
+                    m_fIm += m_pRowRe[c * inA.m_iColStride] * m_fXIm + m_pRowIm[c * inA.m_iColStride] * m_fXRe;
+                }
+                outY.m_pRe[r * outY.m_iRowStride] = m_fRe;
+                outY.m_pIm[r * outY.m_iRowStride] = m_fIm;
+            }
+            return;
+        }
+
+        thread_local vector<float> m_vecSums;
+        m_vecSums.assign(2 * (inRowEnd - inRowBegin), 0.0f);
+        float *m_pSumRe = m_vecSums.data();
+        float *m_pSumIm = m_pSumRe + (inRowEnd - inRowBegin);
+        for ( size_t c = 0; c < inNumOfCols; c++ ) {
+            const float m_fXRe = inX.m_pRe[c * inX.m_iRowStride];
+            const float m_fXIm = inX.m_pIm[c * inX.m_iRowStride];
+            const float *m_pColRe = inA.m_pRe + c * inA.m_iColStride;
+            const float *m_pColIm = inA.m_pIm + c * inA.m_iColStride;
+            for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+                m_pSumRe[r - inRowBegin] += m_pColRe[r * inA.m_iRowStride] * m_fXRe - m_pColIm[r * inA.m_iRowStride] * m_fXIm;
+                m_pSumIm[r - inRowBegin] += m_pColRe[r * inA.m_iRowStride] * m_fXIm + m_pColIm[r * inA.m_iRowStride] * m_fXRe;
+            }
+        }
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            outY.m_pRe[r * outY.m_iRowStride] = m_pSumRe[r - inRowBegin];
+            outY.m_pIm[r * outY.m_iRowStride] = m_pSumIm[r - inRowBegin];
+        }
+    });
+}
+
+
+void MultiplyInto(const CMatrixView &outView, const CConstMatrixView &inView1, const CConstMatrixView &inView2)
+/********************************************
+ *       Purpose: outView = inView1 * inView2 for views of any shape, stride and order, using the cache 
+ *                blocked matrix multiplication. A product with a single column is a matrix vector product.
+ *  Precondition: inView1 is M x K, inView2 is K x N and outView is M x N. outView must not overlap 
+ *                either input unless both are views of the same CMatrix.
+ * Postcondition: No memory is allocated after the first call on a thread, unless outView and an input 
+ *                view the same CMatrix, in which case the product is formed in a temporary first.
+********************************************/ 
+{
+    if ( inView1.GetColSize() != inView2.GetRowSize() || outView.GetRowSize() != inView1.GetRowSize() || outView.GetColSize() != inView2.GetColSize() ) {
+        cout << "ERROR: Unable to matrix multiply a " << inView1.GetRowSize() << " x " << inView1.GetColSize() << " view with a " 
+             << inView2.GetRowSize() << " x " << inView2.GetColSize() << " view into a " 
+             << outView.GetRowSize() << " x " << outView.GetColSize() << " view." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    if ( outView.GetOwner() != NULL && (outView.GetOwner() == inView1.GetOwner() || outView.GetOwner() == inView2.GetOwner()) ) {
+        CMatrix m_mResult = CMatrix(outView.GetRowSize(), outView.GetColSize());
+        MultiplyInto(m_mResult.View(), inView1, inView2);
+        CMatrixView m_vTarget = outView;
+        m_vTarget = m_mResult;
+        return;
+    }
+
+    if ( outView.GetColSize() == 1 )
+        StridedMatrixVector(inView1.GetRowSize(), inView1.GetColSize(), StridedEntries(inView1), StridedEntries(inView2), StridedEntries(outView));
+    else
+        ComplexGemm(inView1.GetRowSize(), inView2.GetColSize(), inView1.GetColSize(), 
+                    StridedEntries(inView1), StridedEntries(inView2), StridedEntries(outView));
+}
+
+
+static void SplitMatrixVector(const float *inRe, const float *inIm, const size_t inNumOfRows, const size_t inNumOfCols, 
+                              const complex<float> *inVector, complex<float> *outVector)
+/********************************************
+ *       Purpose: y = A * x for a row major matrix A stored as a real plane and an imaginary plane.
+ *                x is split into planes once, then every row is four real dot products 
+ *                over contiguous floats that the compiler vectorizes. Rows are split across threads.
+ *  Precondition: outVector must not overlap inVector.
+ * Postcondition: N/A
+********************************************/ 
+{
+    thread_local vector<float> m_vecVectorPlanes;
+    m_vecVectorPlanes.resize(2 * inNumOfCols);
+    float *m_pXRe = m_vecVectorPlanes.data();
+    float *m_pXIm = m_pXRe + inNumOfCols;
+    for ( size_t c = 0; c < inNumOfCols; c++ ) {
+        m_pXRe[c] = inVector[c].real();
+        m_pXIm[c] = inVector[c].imag();
+    }
+
+    ParallelFor(0, inNumOfRows, max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, inNumOfCols)), [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            const float *m_pRowRe = inRe + r * inNumOfCols;
+            const float *m_pRowIm = inIm + r * inNumOfCols;
+            float m_fRe = 0, m_fIm = 0;
+            for ( size_t c = 0; c < inNumOfCols; c++ ) {
+                m_fRe += m_pRowRe[c] * m_pXRe[c] - m_pRowIm[c] * m_pXIm[c];
+                m_fIm += m_pRowRe[c] * m_pXIm[c] + m_pRowIm[c] * m_pXRe[c];
+            }
+            outVector[r] = complex<float>(m_fRe, m_fIm);
+        }
+    });
+}
+
+
+void MultiplyInto(vector<complex<float>> &outVector, const CMatrix &inMatrix, const vector<complex<float>> &inVector)
+/********************************************
+ *       Purpose: outVector = inMatrix * inVector
+ *  Precondition: inVector has as many entries as inMatrix has columns.
+ * Postcondition: No memory is allocated when outVector already has the right size and 
+ *                is not inVector. Otherwise outVector is resized, or the product is formed in a temporary first.
+********************************************/ 
+{
+    if ( inVector.size() != inMatrix.m_iColSize ) {
+        cout << "ERROR: Unable to multiply a " << inMatrix.m_iRowSize << " x " << inMatrix.m_iColSize << " matrix with a vector of " 
+             << inVector.size() << " entries." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    if ( &outVector == &inVector ) {
+        vector<complex<float>> m_vecResult(inMatrix.m_iRowSize);
+        MultiplyInto(m_vecResult, inMatrix, inVector);
+        outVector.swap(m_vecResult);
+        return;
+    }
+
+    outVector.resize(inMatrix.m_iRowSize);
+    if ( inMatrix.m_eLayout == INTERLEAVED_LAYOUT ) {
+        const size_t m_iNumOfCols = inMatrix.m_iColSize;
+        const CMatrixKernels &m_kernels = MatrixKernels();
+        ParallelFor(0, inMatrix.m_iRowSize, max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, m_iNumOfCols)), [&](size_t inRowBegin, size_t inRowEnd) {
+            m_kernels.MatrixVector(inMatrix.m_vecMatrix.data() + inRowBegin * m_iNumOfCols, inRowEnd - inRowBegin, m_iNumOfCols, m_iNumOfCols, 
+                                   inVector.data(), outVector.data() + inRowBegin);
+        });
+    }
+    else
+        SplitMatrixVector(inMatrix.m_vecSplitMatrix.data(), inMatrix.m_vecSplitMatrix.data() + inMatrix.GetPlaneSize(), 
+                          inMatrix.m_iRowSize, inMatrix.m_iColSize, inVector.data(), outVector.data());
+}
+
+
+vector<complex<float>> CMatrix::operator*(const vector<complex<float>> &inVector) const
+/********************************************
+ *       Purpose: Return the matrix vector product between this CMatrix and inVector.
+ *  Precondition: inVector has as many entries as this CMatrix has columns.
+ * Postcondition: Neither input is modified.
+ *         Notes: See MultiplyInto() to reuse the storage of an existing result.
+********************************************/ 
+{
+    vector<complex<float>> m_vecResult(m_iRowSize);
+    MultiplyInto(m_vecResult, *this, inVector);
+    return m_vecResult;
+}
+
+
+CMatrix CMatrix::operator*(const CMatrix &inMatrix2) const
+/********************************************
+ *       Purpose: Return the matrix multiplication between the first CMatrix and second CMatrix.
+ *  Precondition: The first CMatrix is M x N and the second CMatrix is N x P.
+ * Postcondition: Neither CMatrix is modified. The result is M x P.
+ *         Notes: See MultiplyInto() to reuse the storage of an existing result.
+********************************************/ 
+{
+    CMatrix m_mResult = CMatrix(m_iRowSize, inMatrix2.m_iColSize);
+    MultiplyInto(m_mResult, *this, inMatrix2);
+    return m_mResult;
+}
+
+void CMatrix::MatrixMultiply(const CMatrix &inMatrix2)
+/********************************************
+ *       Purpose: Replace each entry of the first CMatrix with each entry of the
+ *                resulting matrix multiplication between the firt CMatrix and second CMatrix.
+ *  Precondition: The first CMatrix is M x N and the second CMatrix is N x P.
+ * Postcondition: First CMatric must be modified.
+ *                Input CMatrix parameter must not be modified.
+ *         Notes: N/A
+ *          TODO: N/A
+********************************************/ 
+{
+    MultiplyInto(*this, *this, inMatrix2);
+}
+
+
+void KroneckerProductInto(CMatrix &outMatrix, const CMatrix *const *inFactors, const size_t inNumOfFactors)
+/********************************************
+ *       Purpose: outMatrix = F_0 @ F_1 @ ... @ F_{k-1}, the Kronecker (tensor) product of every factor at once, 
+ *                where F_f is *inFactors[f]. Row r of the product is the product of one row of each factor, picked by the 
+ *                mixed radix digits of r. Each output row is built right to left, one contiguous 
+ *                scaled copy per entry of each factor. Output rows are split across threads.
+ *  Precondition: Factors may be any size and layout. The product must fit in MAX_SIDE_LENGTH x MAX_SIDE_LENGTH.
+ * Postcondition: outMatrix keeps its layout. The product of no factors is the 1 x 1 matrix [1]. 
+ *                Nothing is allocated once outMatrix and this thread's scratch rows have the size of the product.
+ *          Note: Entry products associate right to left, F_0 (F_1 (F_2 ...)). Pauli factors give exact products either way.
+********************************************/ 
+{
+    size_t m_iRowSize = 1;
+    size_t m_iColSize = 1;
+    for ( size_t f = 0; f < inNumOfFactors; f++ ) {
+        m_iRowSize *= inFactors[f]->GetRowSize();
+        m_iColSize *= inFactors[f]->GetColSize();
+        if ( m_iRowSize > MAX_SIDE_LENGTH || m_iColSize > MAX_SIDE_LENGTH ) {
+            cout << "ERROR: The Kronecker product of these " << inNumOfFactors << " factors is larger than " 
+                 << MAX_SIDE_LENGTH << " x " << MAX_SIDE_LENGTH << "." << '\n'
+                 << "EXITING PROGRAM . . ." << endl;
+            exit(1);
+        }
+    }
+
+    // Resizing outMatrix would destroy a factor it is also passed as.
+    for ( size_t f = 0; f < inNumOfFactors; f++ ) {
+        if ( inFactors[f] == &outMatrix ) {
+            CMatrix m_mResult = CMatrix(0, 0, outMatrix.m_eLayout);
+            KroneckerProductInto(m_mResult, inFactors, inNumOfFactors);
+            outMatrix = std::move(m_mResult);
+            return;
+        }
+    }
+
+    outMatrix.Resize(m_iRowSize, m_iColSize);
+    if ( m_iRowSize * m_iColSize == 0 )
+        return;
+    if ( inNumOfFactors == 0 ) {
+        outMatrix(0, 0) = complex<float>(1, 0);
+        return;
+    }
+
+    // Interleaved factors are read in place. Split factors are interleaved into scratch copies, 
+    // so the inner loops do not branch on layout. They are tiny next to the product.
+    thread_local vector<const complex<float> *> t_vecFactorEntries;
+    thread_local vector<vector<complex<float>>> t_vecSplitFactorCopies;
+    const size_t m_iNumOfFactors = inNumOfFactors;
+    if ( t_vecFactorEntries.size() < m_iNumOfFactors ) {
+        t_vecFactorEntries.resize(m_iNumOfFactors);
+        t_vecSplitFactorCopies.resize(m_iNumOfFactors);
+    }
+    for ( size_t f = 0; f < m_iNumOfFactors; f++ ) {
+        const CMatrix &m_mFactor = *inFactors[f];
+        if ( m_mFactor.m_eLayout == INTERLEAVED_LAYOUT ) {
+            t_vecFactorEntries[f] = m_mFactor.m_vecMatrix.data();
+            continue;
+        }
+        vector<complex<float>> &m_vecCopy = t_vecSplitFactorCopies[f];
+        m_vecCopy.resize(size_t(m_mFactor.m_iRowSize) * m_mFactor.m_iColSize);
+        for ( size_t i = 0; i < m_vecCopy.size(); i++ )
+            m_vecCopy[i] = m_mFactor.GetEntry(i);
+        t_vecFactorEntries[f] = m_vecCopy.data();
+    }
+    const complex<float> *const *m_ppFactorEntries = t_vecFactorEntries.data();
+
+    const bool m_bIsSplit = (outMatrix.m_eLayout == SPLIT_LAYOUT);
+    const size_t m_iPlaneSize = outMatrix.GetPlaneSize();
+    ParallelFor(0, m_iRowSize, max<size_t>(1, PARALLEL_GRAIN_SIZE / m_iColSize), [&](size_t inRowBegin, size_t inRowEnd) {
+        thread_local vector<complex<float>> m_vecSuffix;
+        thread_local vector<complex<float>> m_vecNext;
+        thread_local vector<size_t> m_vecDigits;
+        m_vecSuffix.resize(m_iColSize);
+        m_vecNext.resize(m_iColSize);
+        m_vecDigits.resize(m_iNumOfFactors);
+
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            size_t m_iRest = r;
+            for ( size_t f = m_iNumOfFactors; f-- > 0; ) {
+                m_vecDigits[f] = m_iRest % inFactors[f]->GetRowSize();
+                m_iRest /= inFactors[f]->GetRowSize();
+            }
+
+            // Row r is built right to left: row r_{k-1} of the last factor, then F_{k-2} @ that, and so on. 
+            // Each step scales the whole suffix by one entry, a long contiguous loop, and zero entries are plain fills.
+            // The first factor writes the finished row, straight into the output when it is interleaved.
+            complex<float> *m_pOutRow = m_bIsSplit ? NULL : outMatrix.m_vecMatrix.data() + r * m_iColSize;
+            const size_t m_iLastColSize = inFactors[m_iNumOfFactors - 1]->GetColSize();
+            const complex<float> *m_pLastRow = m_ppFactorEntries[m_iNumOfFactors - 1] + m_vecDigits[m_iNumOfFactors - 1] * m_iLastColSize;
+            if ( m_iNumOfFactors == 1 && !m_bIsSplit ) {
+                copy(m_pLastRow, m_pLastRow + m_iLastColSize, m_pOutRow);
+                continue;
+            }
+            copy(m_pLastRow, m_pLastRow + m_iLastColSize, m_vecSuffix.begin());
+            size_t m_iSuffixLength = m_iLastColSize;
+            for ( size_t f = m_iNumOfFactors - 1; f-- > 0; ) {
+                const size_t m_iFactorColSize = inFactors[f]->GetColSize();
+                const complex<float> *m_pFactorRow = m_ppFactorEntries[f] + m_vecDigits[f] * m_iFactorColSize;
+                const complex<float> *m_pSuffix = m_vecSuffix.data();
+                complex<float> *m_pTarget = (f == 0 && !m_bIsSplit) ? m_pOutRow : m_vecNext.data();
+                for ( size_t j = 0; j < m_iFactorColSize; j++ ) {
+                    const complex<float> m_cxEntry = m_pFactorRow[j];
+                    complex<float> *m_pBlock = m_pTarget + j * m_iSuffixLength;
+                    if ( m_cxEntry == complex<float>(0, 0) )
+                        fill(m_pBlock, m_pBlock + m_iSuffixLength, complex<float>(0, 0));
+                    else
+                        for ( size_t s = 0; s < m_iSuffixLength; s++ )
+                            m_pBlock[s] = CElementwiseMultiplyOperation::Apply(m_cxEntry, m_pSuffix[s]);
+                }
+                m_iSuffixLength *= m_iFactorColSize;
+                m_vecSuffix.swap(m_vecNext);
+            }
+
+            if ( m_bIsSplit ) {
+                const complex<float> *m_pRow = m_vecSuffix.data();
+                for ( size_t c = 0; c < m_iColSize; c++ ) {
+                    outMatrix.m_vecSplitMatrix[r * m_iColSize + c] = m_pRow[c].real();
+                    outMatrix.m_vecSplitMatrix[m_iPlaneSize + r * m_iColSize + c] = m_pRow[c].imag();
+                }
+            }
+        }
+    });
+}
+
+
+void KroneckerProductInto(CMatrix &outMatrix, const vector<CMatrix> &inFactors)
+/********************************************
+ *       Purpose: outMatrix = F_0 @ F_1 @ ... @ F_{k-1} for the factors in inFactors.
+ *  Precondition: See KroneckerProductInto() above.
+ * Postcondition: See KroneckerProductInto() above.
+********************************************/ 
+{
+    thread_local vector<const CMatrix *> t_vecFactors;
+    t_vecFactors.clear();
+    for ( size_t f = 0; f < inFactors.size(); f++ )
+        t_vecFactors.push_back(&inFactors[f]);
+    KroneckerProductInto(outMatrix, t_vecFactors.data(), t_vecFactors.size());
+}
+
+
+void KroneckerProductInto(CMatrix &outMatrix, const CMatrix &inMatrix1, const CMatrix &inMatrix2)
+/********************************************
+ *       Purpose: outMatrix = inMatrix1 @ inMatrix2 without copying either factor.
+ *  Precondition: See KroneckerProductInto() above. outMatrix may be either factor.
+ * Postcondition: See KroneckerProductInto() above.
+********************************************/ 
+{
+    const CMatrix *const m_arrpFactors[] = { &inMatrix1, &inMatrix2 };
+    KroneckerProductInto(outMatrix, m_arrpFactors, 2);
+}
+
+
+CMatrix KroneckerProduct(const vector<CMatrix> &inFactors)
+/********************************************
+ *       Purpose: Return F_0 @ F_1 @ ... @ F_{k-1}. See KroneckerProductInto().
+ *  Precondition: The product must fit in MAX_SIDE_LENGTH x MAX_SIDE_LENGTH.
+ * Postcondition: The result uses INTERLEAVED_LAYOUT.
+********************************************/ 
+{
+    CMatrix m_mResult = CMatrix(0, 0);
+    KroneckerProductInto(m_mResult, inFactors);
+    return m_mResult;
+}
+
+
+static CMatrix GenerateRandomMatrix(const size_t inRowSize, const size_t inColSize, default_random_engine &ioGenerator)
+/********************************************
+ *       Purpose: Return an inRowSize x inColSize matrix with random real and imaginary parts in [-1, 1].
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+    CMatrix m_mResult = CMatrix(inRowSize, inColSize);
+    for ( size_t r = 0; r < inRowSize; r++ )
+        for ( size_t c = 0; c < inColSize; c++ )
+            m_mResult(r, c) = complex<float>(entry_distribution(ioGenerator), entry_distribution(ioGenerator));
+    return m_mResult;
+}
+
+
+static CMatrix GenerateRandomMatrix(const size_t inSideLength, default_random_engine &ioGenerator)
+/********************************************
+ *       Purpose: Return a square matrix with random real and imaginary parts in [-1, 1].
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    return GenerateRandomMatrix(inSideLength, inSideLength, ioGenerator);
+}
+
+
+static CMatrix NaiveMatrixMultiply(const CMatrix &inMatrix1, const CMatrix &inMatrix2)
+/********************************************
+ *       Purpose: Reference r-c-s triple loop matrix multiplication through GetValueAt().
+ *  Precondition: inMatrix1 is M x K and inMatrix2 is K x N.
+ * Postcondition: Entries are summed in double.
+********************************************/ 
+{
+    const size_t m_iDepth = inMatrix1.GetColSize();
+    CMatrix m_mResult = CMatrix(inMatrix1.GetRowSize(), inMatrix2.GetColSize());
+    for ( size_t r = 0; r < m_mResult.GetRowSize(); r++ ) {
+        for ( size_t c = 0; c < m_mResult.GetColSize(); c++ ) {
+            complex<double> m_cxResult = 0;
+            for ( size_t s = 0; s < m_iDepth; s++ )
+                m_cxResult += complex<double>(inMatrix1.GetValueAt(r, s)) * complex<double>(inMatrix2.GetValueAt(s, c));
+            m_mResult.ModifyValueAt(r, c, complex<float>(m_cxResult));
+        }
+    }
+    return m_mResult;
+}
+
+
+void TestMatrixMultiply(const unsigned short int inNumOfTests, const unsigned short int inMaxSideLength)
+/********************************************
+ *       Purpose: Compare operator*(), MultiplyInto() and MatrixMultiply() against the 
+ *                reference triple loop on random matrices with random side lengths.
+ *  Precondition: inMaxSideLength >= 1
+ * Postcondition: N/A
+ *          Note: Side lengths that are not multiples of the tile sizes exercise the padded edges.
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> side_length_distribution(1, inMaxSideLength);
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using side lengths up to " << inMaxSideLength << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        const unsigned short int m_iSideLength = side_length_distribution(generator);
+        const CMatrix m_mMatrix1 = GenerateRandomMatrix(m_iSideLength, generator);
+        const CMatrix m_mMatrix2 = GenerateRandomMatrix(m_iSideLength, generator);
+        const CMatrix m_mExpected = NaiveMatrixMultiply(m_mMatrix1, m_mMatrix2);
+
+        const CMatrix m_mProduct = m_mMatrix1 * m_mMatrix2;
+        CMatrix m_mInto = CMatrix(m_iSideLength, m_iSideLength);
+        MultiplyInto(m_mInto, m_mMatrix1, m_mMatrix2);
+        CMatrix m_mInPlace = m_mMatrix1;
+        m_mInPlace.MatrixMultiply(m_mMatrix2);
+
+        // Each entry is a sum of m_iSideLength products bounded by 2.
+        const float m_fTolerance = 1e-5f * 2 * m_iSideLength;
+        bool m_bIsCorrect = true;
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                const complex<float> m_cxExpected = m_mExpected.GetValueAt(r, c);
+                if ( abs(m_mProduct.GetValueAt(r, c) - m_cxExpected) > m_fTolerance || abs(m_mInto.GetValueAt(r, c) - m_cxExpected) > m_fTolerance 
+                     || abs(m_mInPlace.GetValueAt(r, c) - m_cxExpected) > m_fTolerance )
+                    m_bIsCorrect = false;
+            }
+        }
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": " << m_iSideLength << " x " << m_iSideLength << " product does NOT match the reference." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful matrix multiplications: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL matrix multiplications: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void TestSimdKernels(const unsigned short int inNumOfTests, const unsigned short int inMaxSideLength)
+/********************************************
+ *       Purpose: Run matrix multiplication, matrix vector multiplication, addition, scaling, 
+ *                conjugate transpose and equality with every instruction set this CPU supports, 
+ *                and compare them against reference loops over GetValueAt().
+ *  Precondition: inMaxSideLength >= 1
+ * Postcondition: The instruction set in use is restored afterwards.
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> side_length_distribution(1, inMaxSideLength);
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+    const string m_sInitialInstructionSet = GetSimdInstructionSet();
+    const string m_arrsInstructionSets[] = { "scalar", "avx2", "avx512" };
+
+    for ( size_t s = 0; s < 3; s++ ) {
+        if ( !SetSimdInstructionSet(m_arrsInstructionSets[s]) ) {
+            cout << "Instruction set " << m_arrsInstructionSets[s] << " is not supported by this CPU. Skipping." << endl;
+            continue;
+        }
+
+        unsigned short int m_iNumOfSuccTests = 0;
+        unsigned short int m_iNumOfUnsuccTests = 0;
+        cout << "Instruction set: " << GetSimdInstructionSet() << endl;
+        cout << "Performing Tests . . . " << endl;
+
+        for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+            const unsigned short int m_iSideLength = side_length_distribution(generator);
+            const float m_fTolerance = 1e-5f * 2 * m_iSideLength;
+            const CMatrix m_mMatrix1 = GenerateRandomMatrix(m_iSideLength, generator);
+            const CMatrix m_mMatrix2 = GenerateRandomMatrix(m_iSideLength, generator);
+            vector<complex<float>> m_vecVector(m_iSideLength);
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                m_vecVector[c] = complex<float>(entry_distribution(generator), entry_distribution(generator));
+            const complex<float> m_cxZ = complex<float>(entry_distribution(generator), entry_distribution(generator));
+
+            const CMatrix m_mProduct = m_mMatrix1 * m_mMatrix2;
+            const CMatrix m_mExpectedProduct = NaiveMatrixMultiply(m_mMatrix1, m_mMatrix2);
+            const vector<complex<float>> m_vecProduct = m_mMatrix1 * m_vecVector;
+
+            CPauliAlgebraElement m_paeElement1 = CPauliAlgebraElement(m_iSideLength, m_iSideLength);
+            CPauliAlgebraElement m_paeElement2 = CPauliAlgebraElement(m_iSideLength, m_iSideLength);
+            for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+                for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                    m_paeElement1.ModifyValueAt(r, c, m_mMatrix1.GetValueAt(r, c));
+                    m_paeElement2.ModifyValueAt(r, c, m_mMatrix2.GetValueAt(r, c));
+                }
+            }
+            const CPauliAlgebraElement m_paeSum = m_paeElement1 + m_paeElement2;
+            CPauliAlgebraElement m_paeScaled = m_paeElement1;
+            m_paeScaled *= m_cxZ;
+
+            CMatrix m_mDagger = m_mMatrix1;
+            m_mDagger.ConjugateTranspose();
+
+            bool m_bIsCorrect = true;
+            for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+                complex<double> m_cxExpected = 0;
+                for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                    const complex<float> m_cxEntry1 = m_mMatrix1.GetValueAt(r, c);
+                    const complex<float> m_cxEntry2 = m_mMatrix2.GetValueAt(r, c);
+                    m_cxExpected += complex<double>(m_cxEntry1) * complex<double>(m_vecVector[c]);
+
+                    if ( abs(m_mProduct.GetValueAt(r, c) - m_mExpectedProduct.GetValueAt(r, c)) > m_fTolerance 
+                         || abs(m_paeSum.GetValueAt(r, c) - (m_cxEntry1 + m_cxEntry2)) > 1e-6f 
+                         || abs(m_paeScaled.GetValueAt(r, c) - m_cxZ * m_cxEntry1) > 1e-6f 
+                         || m_mDagger.GetValueAt(c, r) != conj(m_cxEntry1) )
+                        m_bIsCorrect = false;
+                }
+                if ( abs(complex<double>(m_vecProduct[r]) - m_cxExpected) > m_fTolerance )
+                    m_bIsCorrect = false;
+            }
+
+            CMatrix m_mCopy = m_mMatrix1;
+            if ( !(m_mCopy == m_mMatrix1) )
+                m_bIsCorrect = false;
+            const unsigned short int m_iChangedIndex = side_length_distribution(generator) % m_iSideLength;
+            m_mCopy.ModifyValueAt(m_iChangedIndex, m_iSideLength - 1 - m_iChangedIndex, complex<float>(2, 2));
+            if ( m_mCopy == m_mMatrix1 )
+                m_bIsCorrect = false;
+
+            if (m_bIsCorrect)
+                m_iNumOfSuccTests++;
+            else {
+                m_iNumOfUnsuccTests++;
+                cout << "Test " << i << ": " << m_iSideLength << " x " << m_iSideLength << " kernels do NOT match the reference." << endl;
+            }
+        }
+
+        cout << "Finished Tests. " << endl;
+        cout << "    Total Number of successful " << GetSimdInstructionSet() << " kernel tests: " << m_iNumOfSuccTests << endl;
+        cout << "  Total Number of UNSUCCESSFUL " << GetSimdInstructionSet() << " kernel tests: " << m_iNumOfUnsuccTests << endl;
+    }
+
+    SetSimdInstructionSet(m_sInitialInstructionSet);
+}
+
+
+void TestSplitLayout(const unsigned short int inNumOfTests, const unsigned short int inMaxSideLength)
+/********************************************
+ *       Purpose: Check that every CMatrix operation gives the same entries in SPLIT_LAYOUT 
+ *                as in INTERLEAVED_LAYOUT, including products that mix both layouts, 
+ *                and that the split planes are 64 byte aligned.
+ *  Precondition: inMaxSideLength >= 1
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> side_length_distribution(1, inMaxSideLength);
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using side lengths up to " << inMaxSideLength << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        // Every other test uses a 2^n side length so the Pauli decomposition runs too.
+        unsigned short int m_iSideLength = side_length_distribution(generator);
+        if ( i % 2 == 0 )
+            m_iSideLength = (unsigned short int) HighestSetBit(m_iSideLength);
+        const float m_fTolerance = 1e-5f * 2 * m_iSideLength;
+
+        CPauliAlgebraElement m_paeInterleaved1 = CPauliAlgebraElement(m_iSideLength, m_iSideLength);
+        CPauliAlgebraElement m_paeInterleaved2 = CPauliAlgebraElement(m_iSideLength, m_iSideLength);
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                m_paeInterleaved1.ModifyValueAt(r, c, complex<float>(entry_distribution(generator), entry_distribution(generator)));
+                m_paeInterleaved2.ModifyValueAt(r, c, complex<float>(entry_distribution(generator), entry_distribution(generator)));
+            }
+        }
+        CPauliAlgebraElement m_paeSplit1 = m_paeInterleaved1;
+        CPauliAlgebraElement m_paeSplit2 = m_paeInterleaved2;
+        m_paeSplit1.SetLayout(SPLIT_LAYOUT);
+        m_paeSplit2.SetLayout(SPLIT_LAYOUT);
+        vector<complex<float>> m_vecVector(m_iSideLength);
+        for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+            m_vecVector[c] = complex<float>(entry_distribution(generator), entry_distribution(generator));
+        const complex<float> m_cxZ = complex<float>(entry_distribution(generator), entry_distribution(generator));
+
+        // A second, separately converted split copy exercises the split against split path of operator==.
+        CPauliAlgebraElement m_paeSplitCopy1 = m_paeInterleaved1;
+        m_paeSplitCopy1.SetLayout(SPLIT_LAYOUT);
+        bool m_bIsCorrect = (m_paeSplit1 == m_paeInterleaved1) && (m_paeSplit1 == m_paeSplitCopy1) && !(m_paeSplit1 == m_paeSplit2) 
+                            && m_paeSplit1.Trace() == m_paeInterleaved1.Trace()
+                            && size_t(m_paeSplit1.GetRealPlane()) % 64 == 0 && size_t(m_paeSplit1.GetImagPlane()) % 64 == 0;
+
+        // Products in every combination of layouts. CPauliAlgebraElement::operator* is the tensor product, so use CMatrix.
+        const CMatrix &m_mInterleaved1 = m_paeInterleaved1;
+        const CMatrix &m_mSplit1 = m_paeSplit1;
+        const CMatrix m_mExpectedProduct = m_mInterleaved1 * m_paeInterleaved2;
+        CMatrix m_mSplitProduct = CMatrix(m_iSideLength, m_iSideLength, SPLIT_LAYOUT);
+        MultiplyInto(m_mSplitProduct, m_paeSplit1, m_paeSplit2);
+        const CMatrix m_mMixedProduct = m_mSplit1 * m_paeInterleaved2;
+        const vector<complex<float>> m_vecExpectedVector = m_mInterleaved1 * m_vecVector;
+        const vector<complex<float>> m_vecSplitVector = m_mSplit1 * m_vecVector;
+
+        // Element wise operations.
+        const CPauliAlgebraElement m_paeExpectedSum = m_paeInterleaved1 + m_paeInterleaved2;
+        const CPauliAlgebraElement m_paeSplitSum = m_paeSplit1 + m_paeInterleaved2;
+        CPauliAlgebraElement m_paeExpectedScaled = m_paeInterleaved1;
+        m_paeExpectedScaled *= m_cxZ;
+        CPauliAlgebraElement m_paeSplitScaled = m_paeSplit1;
+        m_paeSplitScaled *= m_cxZ;
+        CMatrix m_mExpectedDagger = m_paeInterleaved1;
+        m_mExpectedDagger.ConjugateTranspose();
+        CMatrix m_mSplitDagger = m_paeSplit1;
+        m_mSplitDagger.ConjugateTranspose();
+
+        m_bIsCorrect = m_bIsCorrect && m_paeSplitSum.GetLayout() == SPLIT_LAYOUT && m_mSplitDagger == m_mExpectedDagger;
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                const complex<float> m_cxExpected = m_mExpectedProduct.GetValueAt(r, c);
+                if ( abs(m_mSplitProduct.GetValueAt(r, c) - m_cxExpected) > m_fTolerance || abs(m_mMixedProduct.GetValueAt(r, c) - m_cxExpected) > m_fTolerance 
+                     || abs(m_paeSplitSum.GetValueAt(r, c) - m_paeExpectedSum.GetValueAt(r, c)) > 1e-6f 
+                     || abs(m_paeSplitScaled.GetValueAt(r, c) - m_paeExpectedScaled.GetValueAt(r, c)) > 1e-6f )
+                    m_bIsCorrect = false;
+            }
+            if ( abs(m_vecSplitVector[r] - m_vecExpectedVector[r]) > m_fTolerance )
+                m_bIsCorrect = false;
+        }
+
+        if ( m_iSideLength == HighestSetBit(m_iSideLength) ) {
+            const vector<complex<float>> m_vecExpectedCoefficients = m_paeInterleaved1.PauliCoefficients();
+            const vector<complex<float>> m_vecSplitCoefficients = m_paeSplit1.PauliCoefficients();
+            if ( m_vecSplitCoefficients != m_vecExpectedCoefficients )
+                m_bIsCorrect = false;
+        }
+
+        // Round trip back to the interleaved layout.
+        m_paeSplit1.SetLayout(INTERLEAVED_LAYOUT);
+        if ( !(m_paeSplit1.GetMatrix() == m_paeInterleaved1.GetMatrix()) )
+            m_bIsCorrect = false;
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": " << m_iSideLength << " x " << m_iSideLength << " split layout does NOT match the interleaved layout." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful split layout tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL split layout tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void TestMatrixExpressions(const unsigned short int inNumOfTests, const unsigned short int inMaxSideLength)
+/********************************************
+ *       Purpose: Check every lazy matrix expression against an explicit loop over the entries, 
+ *                in both layouts, including assignments whose target is also an operand.
+ *  Precondition: inMaxSideLength >= 1
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> side_length_distribution(1, inMaxSideLength);
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using side lengths up to " << inMaxSideLength << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        const unsigned short int m_iSideLength = side_length_distribution(generator);
+        const EMatrixLayout m_eLayout = (i % 2 == 0) ? SPLIT_LAYOUT : INTERLEAVED_LAYOUT;
+        CMatrix m_mMatrix1 = GenerateRandomMatrix(m_iSideLength, generator);
+        CMatrix m_mMatrix2 = GenerateRandomMatrix(m_iSideLength, generator);
+        m_mMatrix1.SetLayout(m_eLayout);
+        const complex<float> m_cxZ = complex<float>(entry_distribution(generator), entry_distribution(generator));
+
+        // Hermitian part, sum, difference, scaling, negation and elementwise product. 
+        const CMatrix m_mHermitian = m_mMatrix1 + m_mMatrix1.Adjoint();
+        CMatrix m_mCombination = CMatrix(m_iSideLength, m_iSideLength, m_eLayout);
+        const float *m_pInitialPlane = (m_eLayout == SPLIT_LAYOUT) ? m_mCombination.GetRealPlane() : NULL;
+        m_mCombination = m_cxZ * m_mMatrix1 - (m_mMatrix2 * m_cxZ).Adjoint() + -ElementwiseProduct(m_mMatrix1, m_mMatrix2);
+        CMatrix m_mDoubleAdjoint = m_mMatrix2.Adjoint().Adjoint();
+
+        // Assignments that read the target. The first is transposed and must go through a temporary.
+        CMatrix m_mAliased = m_mMatrix1;
+        m_mAliased = m_mAliased + m_mAliased.Adjoint();
+        CMatrix m_mAliasedInPlace = m_mMatrix1;
+        m_mAliasedInPlace = m_mAliasedInPlace - m_cxZ * m_mMatrix2;
+
+        bool m_bIsCorrect = m_mHermitian.GetLayout() == INTERLEAVED_LAYOUT && m_mCombination.GetLayout() == m_eLayout 
+                            && m_mAliased.GetLayout() == m_eLayout && m_mDoubleAdjoint == m_mMatrix2;
+        // Assigning to a matrix of the same size must not reallocate.
+        if ( m_eLayout == SPLIT_LAYOUT && m_mCombination.GetRealPlane() != m_pInitialPlane )
+            m_bIsCorrect = false;
+
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                const complex<float> m_cxA = m_mMatrix1.GetValueAt(r, c);
+                const complex<float> m_cxB = m_mMatrix2.GetValueAt(r, c);
+                const complex<float> m_cxExpectedHermitian = m_cxA + conj(m_mMatrix1.GetValueAt(c, r));
+                const complex<float> m_cxExpectedCombination = m_cxZ * m_cxA - conj(m_mMatrix2.GetValueAt(c, r) * m_cxZ) - m_cxA * m_cxB;
+                if ( abs(m_mHermitian.GetValueAt(r, c) - m_cxExpectedHermitian) > 1e-6f 
+                     || abs(m_mAliased.GetValueAt(r, c) - m_cxExpectedHermitian) > 1e-6f
+                     || abs(m_mCombination.GetValueAt(r, c) - m_cxExpectedCombination) > 1e-5f 
+                     || abs(m_mAliasedInPlace.GetValueAt(r, c) - (m_cxA - m_cxZ * m_cxB)) > 1e-5f )
+                    m_bIsCorrect = false;
+            }
+        }
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": " << m_iSideLength << " x " << m_iSideLength << " matrix expressions do NOT match the explicit loops." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful matrix expression tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL matrix expression tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+static vector<vector<complex<float>>> ParallelResults(const CMatrix &inMatrix1, const CMatrix &inMatrix2, const vector<complex<float>> &inVector)
+/********************************************
+ *       Purpose: Return the entries of every CMatrix operation that runs on the thread pool, 
+ *                in both layouts, for TestThreadPool().
+ *  Precondition: Both input matrices are square matrices of the same size.
+ * Postcondition: N/A
+********************************************/ 
+{
+    vector<vector<complex<float>>> m_vecResults;
+    for ( int l = 0; l < 2; l++ ) {
+        const EMatrixLayout m_eLayout = (l == 0) ? INTERLEAVED_LAYOUT : SPLIT_LAYOUT;
+        CPauliAlgebraElement m_paeMatrix1 = CPauliAlgebraElement(inMatrix1.GetRowSize(), inMatrix1.GetColSize());
+        static_cast<CMatrix &>(m_paeMatrix1) = inMatrix1;
+        m_paeMatrix1.SetLayout(m_eLayout);
+        CMatrix m_mMatrix2 = inMatrix2;
+        m_mMatrix2.SetLayout(m_eLayout);
+        const CMatrix &m_mMatrix1 = m_paeMatrix1;
+
+        m_vecResults.push_back((m_mMatrix1 * m_mMatrix2).GetMatrix());
+        m_vecResults.push_back(m_mMatrix1 * inVector);
+        CMatrix m_mDagger = m_mMatrix1;
+        m_mDagger.ConjugateTranspose();
+        m_vecResults.push_back(m_mDagger.GetMatrix());
+        CMatrix m_mHermitian = CMatrix(0, 0, m_eLayout);
+        m_mHermitian = m_mMatrix1 + m_mMatrix1.Adjoint();
+        m_vecResults.push_back(m_mHermitian.GetMatrix());
+        CPauliAlgebraElement m_paeSum = m_paeMatrix1 + m_paeMatrix1;
+        m_paeSum *= complex<float>(0.5f, -2.0f);
+        m_vecResults.push_back(m_paeSum.GetMatrix());
+        m_vecResults.push_back(vector<complex<float>>(1, m_mMatrix1.Trace()));
+
+        // A 16 x 16 block of matrix 1 in a tensor product with a 32 x 32 block of matrix 2.
+        CPauliAlgebraElement m_paeSmall1 = CPauliAlgebraElement(16, 16);
+        CPauliAlgebraElement m_paeSmall2 = CPauliAlgebraElement(32, 32);
+        for ( unsigned short int r = 0; r < 32; r++ ) {
+            for ( unsigned short int c = 0; c < 32; c++ ) {
+                if ( r < 16 && c < 16 )
+                    m_paeSmall1.ModifyValueAt(r, c, inMatrix1.GetValueAt(r % inMatrix1.GetRowSize(), c % inMatrix1.GetColSize()));
+                m_paeSmall2.ModifyValueAt(r, c, inMatrix2.GetValueAt(r % inMatrix2.GetRowSize(), c % inMatrix2.GetColSize()));
+            }
+        }
+        m_paeSmall2.SetLayout(m_eLayout);
+        m_vecResults.push_back((m_paeSmall1 * m_paeSmall2).GetMatrix());
+    }
+    return m_vecResults;
+}
+
+
+void TestThreadPool(const unsigned short int inSideLength)
+/********************************************
+ *       Purpose: Check that every CMatrix operation on the thread pool gives bit for bit 
+ *                the same entries on 1, 2, 3 and 8 threads, that nested parallel loops 
+ *                cover their ranges exactly once, and that SetNumOfThreads() takes effect.
+ *  Precondition: inSideLength >= 1. Large enough sizes are needed for the loops to leave the calling thread.
+ * Postcondition: The number of threads is restored.
+********************************************/ 
+{
+    static default_random_engine generator;
+    const size_t m_iInitialNumOfThreads = GetNumOfThreads();
+    const CMatrix m_mMatrix1 = GenerateRandomMatrix(inSideLength, generator);
+    const CMatrix m_mMatrix2 = GenerateRandomMatrix(inSideLength, generator);
+    vector<complex<float>> m_vecVector(inSideLength);
+    for ( unsigned short int c = 0; c < inSideLength; c++ )
+        m_vecVector[c] = m_mMatrix2.GetValueAt(c, 0);
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Using " << inSideLength << " x " << inSideLength << " matrices" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    SetNumOfThreads(1);
+    const vector<vector<complex<float>>> m_vecExpected = ParallelResults(m_mMatrix1, m_mMatrix2, m_vecVector);
+
+    const size_t m_arriNumOfThreads[] = { 1, 2, 3, 8 };
+    for ( size_t t = 0; t < 4; t++ ) {
+        SetNumOfThreads(m_arriNumOfThreads[t]);
+        bool m_bIsCorrect = (GetNumOfThreads() == m_arriNumOfThreads[t]) && ParallelResults(m_mMatrix1, m_mMatrix2, m_vecVector) == m_vecExpected;
+
+        // Every (outer, inner) pair of a nested loop runs exactly once.
+        const size_t m_iOuterLength = 37;
+        const size_t m_iInnerLength = 53;
+        vector<int> m_vecVisits(m_iOuterLength * m_iInnerLength, 0);
+        ParallelFor(0, m_iOuterLength, 1, [&](size_t inOuterBegin, size_t inOuterEnd) {
+            for ( size_t o = inOuterBegin; o < inOuterEnd; o++ ) {
+                ParallelFor(0, m_iInnerLength, 1, [&](size_t inInnerBegin, size_t inInnerEnd) {
+                    for ( size_t i = inInnerBegin; i < inInnerEnd; i++ )
+                        m_vecVisits[o * m_iInnerLength + i]++;
+                });
+            }
+        });
+        if ( count(m_vecVisits.begin(), m_vecVisits.end(), 1) != int(m_vecVisits.size()) )
+            m_bIsCorrect = false;
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << t + 1 << ": " << m_arriNumOfThreads[t] << " threads do NOT match 1 thread." << endl;
+        }
+    }
+    SetNumOfThreads(m_iInitialNumOfThreads);
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful thread pool tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL thread pool tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+static complex<float> NaiveKroneckerEntry(const vector<CMatrix> &inFactors, size_t inRowIndex, size_t inColIndex)
+/********************************************
+ *       Purpose: Reference entry (r, c) of the Kronecker product of inFactors through GetValueAt().
+ *  Precondition: (r, c) is inside the product.
+ * Postcondition: Factors are multiplied left to right.
+********************************************/ 
+{
+    vector<complex<float>> m_vecEntries(inFactors.size());
+    for ( size_t f = inFactors.size(); f-- > 0; ) {
+        m_vecEntries[f] = inFactors[f].GetValueAt(inRowIndex % inFactors[f].GetRowSize(), inColIndex % inFactors[f].GetColSize());
+        inRowIndex /= inFactors[f].GetRowSize();
+        inColIndex /= inFactors[f].GetColSize();
+    }
+    complex<float> m_cxEntry = 1;
+    for ( size_t f = 0; f < inFactors.size(); f++ )
+        m_cxEntry *= m_vecEntries[f];
+    return m_cxEntry;
+}
+
+
+void TestKroneckerProduct(const unsigned short int inNumOfTests, const unsigned short int inMaxNumOfFactors)
+/********************************************
+ *       Purpose: Check KroneckerProduct() of random factors of different sizes and layouts, 
+ *                and MakePauliAlgebraElement() of random Pauli group strings, against 
+ *                the entry by entry definition.
+ *  Precondition: inMaxNumOfFactors >= 1
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> factor_count_distribution(1, inMaxNumOfFactors);
+    uniform_int_distribution<int> factor_size_distribution(1, 5);
+    uniform_int_distribution<int> pauli_distribution(0, 3);
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using up to " << inMaxNumOfFactors << " factors" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        const int m_iNumOfFactors = factor_count_distribution(generator);
+        vector<CMatrix> m_vecFactors;
+        for ( int f = 0; f < m_iNumOfFactors; f++ ) {
+            const unsigned short int m_iFactorSize = factor_size_distribution(generator);
+            CMatrix m_mFactor = CMatrix(m_iFactorSize, m_iFactorSize, (f % 2 == 0) ? INTERLEAVED_LAYOUT : SPLIT_LAYOUT);
+            for ( unsigned short int r = 0; r < m_mFactor.GetRowSize(); r++ )
+                for ( unsigned short int c = 0; c < m_mFactor.GetColSize(); c++ )
+                    m_mFactor.ModifyValueAt(r, c, complex<float>(entry_distribution(generator), entry_distribution(generator)));
+            m_vecFactors.push_back(m_mFactor);
+        }
+
+        const CMatrix m_mProduct = KroneckerProduct(m_vecFactors);
+        CMatrix m_mSplitProduct = CMatrix(1, 1, SPLIT_LAYOUT);
+        KroneckerProductInto(m_mSplitProduct, m_vecFactors);
+        bool m_bIsCorrect = m_mSplitProduct.GetLayout() == SPLIT_LAYOUT && m_mSplitProduct.GetMatrix() == m_mProduct.GetMatrix();
+        for ( unsigned short int r = 0; r < m_mProduct.GetRowSize(); r++ )
+            for ( unsigned short int c = 0; c < m_mProduct.GetColSize(); c++ )
+                if ( abs(m_mProduct.GetValueAt(r, c) - NaiveKroneckerEntry(m_vecFactors, r, c)) > 1e-5f )
+                    m_bIsCorrect = false;
+
+        // A Pauli group string of up to 6 qubits.
+        string m_sPauliGroupString;
+        vector<CMatrix> m_vecPauliFactors;
+        for ( int q = 0; q <= i % 6; q++ ) {
+            m_sPauliGroupString += m_arrcPauliChars[pauli_distribution(generator)];
+            m_vecPauliFactors.push_back(CMatrix(string(1, m_sPauliGroupString[q])));
+        }
+        CPauliAlgebraElement m_paeElement = MakePauliAlgebraElement(m_sPauliGroupString);
+        for ( unsigned short int r = 0; r < m_paeElement.GetRowSize(); r++ )
+            for ( unsigned short int c = 0; c < m_paeElement.GetColSize(); c++ )
+                if ( m_paeElement.GetValueAt(r, c) != NaiveKroneckerEntry(m_vecPauliFactors, r, c) )
+                    m_bIsCorrect = false;
+        if ( m_paeElement.GetRowSize() != (size_t(1) << m_sPauliGroupString.size()) )
+            m_bIsCorrect = false;
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": Kronecker product of " << m_iNumOfFactors << " factors, or " << m_sPauliGroupString << ", does NOT match the definition." << endl;
+        }
+    }
+
+    // The product of no factors is [1], and operator* is the product of two factors.
+    const CMatrix m_mEmptyProduct = KroneckerProduct(vector<CMatrix>());
+    const CPauliAlgebraElement m_paeXY = MakePauliAlgebraElement("X") * MakePauliAlgebraElement("Y");
+    const CPauliAlgebraElement m_paeExpectedXY = MakePauliAlgebraElement("XY");
+    if ( m_mEmptyProduct.GetRowSize() == 1 && m_mEmptyProduct.GetValueAt(0, 0) == complex<float>(1, 0) 
+         && m_paeXY.GetMatrix() == m_paeExpectedXY.GetMatrix() && m_paeXY.PauliAlgebraElementToString() == m_paeExpectedXY.PauliAlgebraElementToString() )
+        m_iNumOfSuccTests++;
+    else {
+        m_iNumOfUnsuccTests++;
+        cout << "Test " << inNumOfTests + 1 << ": The empty product or the product of two factors is NOT correct." << endl;
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful Kronecker product tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL Kronecker product tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void TestMatrixReductions(const unsigned short int inNumOfTests, const unsigned short int inMaxSideLength)
+/********************************************
+ *       Purpose: Check TraceOfProduct(), HilbertSchmidtInner() and FrobeniusNorm() of random matrices 
+ *                in random layouts, with and without compensated summation, against reference loops 
+ *                over GetValueAt() in double, with every instruction set this CPU supports. 
+ *                Then check that compensated float sums stay accurate for one large matrix with positive entries.
+ *  Precondition: inMaxSideLength >= 1
+ * Postcondition: The instruction set in use is restored afterwards.
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> side_length_distribution(1, inMaxSideLength);
+    uniform_int_distribution<int> layout_distribution(0, 1);
+    uniform_real_distribution<float> positive_distribution(0, 1);
+    const string m_sInitialInstructionSet = GetSimdInstructionSet();
+    const string m_arrsInstructionSets[] = { "scalar", "avx2", "avx512" };
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << " per instruction set" << endl;
+    cout << "Using matrices up to " << inMaxSideLength << " x " << inMaxSideLength << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( size_t s = 0; s < 3; s++ ) {
+        if ( !SetSimdInstructionSet(m_arrsInstructionSets[s]) )
+            continue;
+
+        for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+            const unsigned short int m_iSideLength = side_length_distribution(generator);
+            CMatrix m_mMatrix1 = GenerateRandomMatrix(m_iSideLength, generator);
+            CMatrix m_mMatrix2 = GenerateRandomMatrix(m_iSideLength, generator);
+            m_mMatrix1.SetLayout(layout_distribution(generator) ? SPLIT_LAYOUT : INTERLEAVED_LAYOUT);
+            m_mMatrix2.SetLayout(layout_distribution(generator) ? SPLIT_LAYOUT : INTERLEAVED_LAYOUT);
+
+            complex<double> m_cxExpectedTrace = 0;
+            complex<double> m_cxExpectedInner = 0;
+            double m_dExpectedSumOfSquares = 0;
+            for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+                for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                    const complex<double> m_cxEntry1 = complex<double>(m_mMatrix1.GetValueAt(r, c));
+                    m_cxExpectedTrace += m_cxEntry1 * complex<double>(m_mMatrix2.GetValueAt(c, r));
+                    m_cxExpectedInner += conj(m_cxEntry1) * complex<double>(m_mMatrix2.GetValueAt(r, c));
+                    m_dExpectedSumOfSquares += norm(m_cxEntry1);
+                }
+            }
+
+            bool m_bIsCorrect = true;
+            for ( int m_iIsCompensated = 0; m_iIsCompensated <= 1; m_iIsCompensated++ ) {
+                const double m_dTolerance = (m_iIsCompensated ? 1e-6 : 1e-5) * 2 * m_iSideLength;
+                if ( abs(complex<double>(TraceOfProduct(m_mMatrix1, m_mMatrix2, m_iIsCompensated)) - m_cxExpectedTrace) > m_dTolerance 
+                     || abs(complex<double>(HilbertSchmidtInner(m_mMatrix1, m_mMatrix2, m_iIsCompensated)) - m_cxExpectedInner) > m_dTolerance 
+                     || abs(FrobeniusNorm(m_mMatrix1, m_iIsCompensated) - sqrt(m_dExpectedSumOfSquares)) > m_dTolerance )
+                    m_bIsCorrect = false;
+            }
+
+            if (m_bIsCorrect)
+                m_iNumOfSuccTests++;
+            else {
+                m_iNumOfUnsuccTests++;
+                cout << "Test " << i << " (" << GetSimdInstructionSet() << "): " << m_iSideLength << " x " << m_iSideLength 
+                     << " reductions do NOT match the reference loops." << endl;
+            }
+        }
+
+        // Sums of 4 million positive terms. Plain float sums drift here, compensated ones must not.
+        const unsigned short int m_iLargeSideLength = 2048;
+        CMatrix m_mLarge = CMatrix(m_iLargeSideLength, m_iLargeSideLength);
+        double m_dLargeSumOfSquares = 0;
+        complex<double> m_cxLargeTrace = 0;
+        for ( unsigned short int r = 0; r < m_iLargeSideLength; r++ )
+            for ( unsigned short int c = 0; c < m_iLargeSideLength; c++ ) {
+                const complex<float> m_cxEntry = complex<float>(positive_distribution(generator), 0);
+                m_mLarge.ModifyValueAt(r, c, m_cxEntry);
+                m_dLargeSumOfSquares += norm(complex<double>(m_cxEntry));
+            }
+        for ( unsigned short int r = 0; r < m_iLargeSideLength; r++ )
+            for ( unsigned short int c = 0; c < m_iLargeSideLength; c++ )
+                m_cxLargeTrace += complex<double>(m_mLarge.GetValueAt(r, c)) * complex<double>(m_mLarge.GetValueAt(c, r));
+        if ( abs(FrobeniusNorm(m_mLarge) - sqrt(m_dLargeSumOfSquares)) <= 1e-6 * sqrt(m_dLargeSumOfSquares) 
+             && abs(complex<double>(HilbertSchmidtInner(m_mLarge, m_mLarge)) - m_dLargeSumOfSquares) <= 1e-6 * m_dLargeSumOfSquares 
+             && abs(complex<double>(TraceOfProduct(m_mLarge, m_mLarge)) - m_cxLargeTrace) <= 1e-6 * abs(m_cxLargeTrace) )
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << inNumOfTests + 1 << " (" << GetSimdInstructionSet() << "): Compensated sums of a " << m_iLargeSideLength 
+                 << " x " << m_iLargeSideLength << " matrix are NOT accurate." << endl;
+        }
+    }
+    SetSimdInstructionSet(m_sInitialInstructionSet);
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful matrix reduction tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL matrix reduction tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void TestMatrixViews(const unsigned short int inNumOfTests, const unsigned short int inMaxSideLength)
+/********************************************
+ *       Purpose: Check operator(), Data() and the Row(), Column(), Submatrix() and Strided() views of random 
+ *                matrices in both layouts against GetValueAt(): reads, writes through the views, views used in 
+ *                expressions, and assignment between overlapping views of the same matrix.
+ *  Precondition: inMaxSideLength >= 1
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> side_length_distribution(1, inMaxSideLength);
+    uniform_int_distribution<int> step_distribution(1, 3);
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << " per layout" << endl;
+    cout << "Using matrices up to " << inMaxSideLength << " x " << inMaxSideLength << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= 2 * inNumOfTests; i++ ) {
+        const EMatrixLayout m_eLayout = (i % 2) ? INTERLEAVED_LAYOUT : SPLIT_LAYOUT;
+        const unsigned short int m_iSideLength = side_length_distribution(generator);
+        CMatrix m_mMatrix = CMatrix(m_iSideLength, m_iSideLength, m_eLayout);
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ )
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                m_mMatrix(r, c) = complex<float>(entry_distribution(generator), entry_distribution(generator));
+        const CMatrix m_mOriginal = m_mMatrix;
+        const CMatrix &m_mConstMatrix = m_mMatrix;
+        bool m_bIsCorrect = true;
+
+        // Element access and the span of interleaved entries.
+        CSpan<const complex<float> > m_spanEntries;
+        if ( m_eLayout == INTERLEAVED_LAYOUT )
+            m_spanEntries = m_mConstMatrix.Data();
+        m_bIsCorrect = m_bIsCorrect && m_spanEntries.size() == ((m_eLayout == INTERLEAVED_LAYOUT) ? size_t(m_iSideLength) * m_iSideLength : 0);
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ )
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                m_bIsCorrect = m_bIsCorrect && m_mConstMatrix(r, c) == m_mOriginal.GetValueAt(r, c) 
+                               && (m_spanEntries.empty() || m_spanEntries[size_t(r) * m_iSideLength + c] == m_mOriginal.GetValueAt(r, c));
+
+        // A random strided view reads the entries it aliases, and writes reach the matrix.
+        const size_t m_iRowStep = step_distribution(generator);
+        const size_t m_iColStep = step_distribution(generator);
+        const size_t m_iRowBegin = uniform_int_distribution<size_t>(0, m_iSideLength - 1)(generator);
+        const size_t m_iColBegin = uniform_int_distribution<size_t>(0, m_iSideLength - 1)(generator);
+        const size_t m_iRowSize = uniform_int_distribution<size_t>(1, (m_iSideLength - 1 - m_iRowBegin) / m_iRowStep + 1)(generator);
+        const size_t m_iColSize = uniform_int_distribution<size_t>(1, (m_iSideLength - 1 - m_iColBegin) / m_iColStep + 1)(generator);
+        CMatrixView m_vwStrided = m_mMatrix.Strided(m_iRowBegin, m_iColBegin, m_iRowSize, m_iColSize, m_iRowStep, m_iColStep);
+        const CConstMatrixView m_vwConstStrided = m_mConstMatrix.Strided(m_iRowBegin, m_iColBegin, m_iRowSize, m_iColSize, m_iRowStep, m_iColStep);
+        const complex<float> m_cxZ = complex<float>(entry_distribution(generator), entry_distribution(generator));
+        for ( size_t r = 0; r < m_iRowSize; r++ ) {
+            for ( size_t c = 0; c < m_iColSize; c++ ) {
+                const complex<float> m_cxEntry = m_mOriginal.GetValueAt(m_iRowBegin + r * m_iRowStep, m_iColBegin + c * m_iColStep);
+                m_bIsCorrect = m_bIsCorrect && m_vwStrided.EntryAt(r, c) == m_cxEntry && complex<float>(m_vwConstStrided(r, c)) == m_cxEntry;
+                m_vwStrided(r, c) += m_cxZ;
+            }
+        }
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                const bool m_bIsInView = r >= m_iRowBegin && c >= m_iColBegin && (r - m_iRowBegin) % m_iRowStep == 0 && (c - m_iColBegin) % m_iColStep == 0 
+                                         && (r - m_iRowBegin) / m_iRowStep < m_iRowSize && (c - m_iColBegin) / m_iColStep < m_iColSize;
+                m_bIsCorrect = m_bIsCorrect && m_mMatrix.GetValueAt(r, c) == m_mOriginal.GetValueAt(r, c) + (m_bIsInView ? m_cxZ : complex<float>(0, 0));
+            }
+        }
+        static_cast<CMatrix &>(m_mMatrix) = m_mOriginal;
+
+        // Square submatrices in a fused expression, and the adjoint of a column written into an overlapping row.
+        const size_t m_iHalf = max<size_t>(1, m_iSideLength / 2);
+        CMatrix m_mSum = m_mMatrix.Submatrix(0, 0, m_iHalf, m_iHalf) + m_cxZ * m_mMatrix.Submatrix(m_iSideLength - m_iHalf, m_iSideLength - m_iHalf, m_iHalf, m_iHalf);
+        for ( size_t r = 0; r < m_iHalf; r++ )
+            for ( size_t c = 0; c < m_iHalf; c++ )
+                m_bIsCorrect = m_bIsCorrect && abs(m_mSum(r, c).Value() - (m_mOriginal.GetValueAt(r, c) + m_cxZ * m_mOriginal.GetValueAt(m_iSideLength - m_iHalf + r, m_iSideLength - m_iHalf + c))) <= 1e-6f;
+        m_mMatrix.Row(0) = m_mMatrix.Column(0).Adjoint();
+        for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+            m_bIsCorrect = m_bIsCorrect && m_mMatrix.GetValueAt(0, c) == conj(m_mOriginal.GetValueAt(c, 0));
+        m_mMatrix.Column(m_iSideLength - 1) = m_mOriginal.Column(0);
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ )
+            m_bIsCorrect = m_bIsCorrect && m_mMatrix.GetValueAt(r, m_iSideLength - 1) == m_mOriginal.GetValueAt(r, 0);
+
+        if ( m_bIsCorrect )
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << " (" << (m_eLayout == SPLIT_LAYOUT ? "split" : "interleaved") << "): Views of a " 
+                 << m_iSideLength << " x " << m_iSideLength << " matrix do NOT match GetValueAt()." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful matrix view tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL matrix view tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void BenchmarkMatrixMultiply(const vector<size_t> &inSideLengths, const unsigned short int inNumOfRepeats, const EMatrixLayout inLayout)
+/********************************************
+ *       Purpose: Print the time and GFLOP/s of MultiplyInto() for every side length in inSideLengths 
+ *                with all three matrices in inLayout.
+ *                A complex multiply add counts as 8 floating point operations, so an 
+ *                N x N product is 8 N^3 operations.
+ *  Precondition: inNumOfRepeats >= 1
+ * Postcondition: The best of inNumOfRepeats runs is reported. The reference triple loop 
+ *                is timed once for side lengths up to 256.
+********************************************/ 
+{
+    static default_random_engine generator;
+    cout << "Instruction set: " << GetSimdInstructionSet() << ", " << (inLayout == SPLIT_LAYOUT ? "split" : "interleaved") << " layout, " 
+         << GetNumOfThreads() << " thread(s)" << endl;
+
+    for ( size_t i = 0; i < inSideLengths.size(); i++ ) {
+        const size_t m_iSideLength = inSideLengths[i];
+        CMatrix m_mMatrix1 = GenerateRandomMatrix(m_iSideLength, generator);
+        CMatrix m_mMatrix2 = GenerateRandomMatrix(m_iSideLength, generator);
+        m_mMatrix1.SetLayout(inLayout);
+        m_mMatrix2.SetLayout(inLayout);
+        CMatrix m_mResult = CMatrix(m_iSideLength, m_iSideLength, inLayout);
+        const double m_dNumOfFlops = 8.0 * m_iSideLength * m_iSideLength * m_iSideLength;
+
+        // Warm up the packing buffers and caches.
+        MultiplyInto(m_mResult, m_mMatrix1, m_mMatrix2);
+        double m_dBestTime = 0;
+        for ( unsigned short int t = 0; t < inNumOfRepeats; t++ ) {
+            chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+            MultiplyInto(m_mResult, m_mMatrix1, m_mMatrix2);
+            chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            if ( t == 0 || m_tElapsed.count() < m_dBestTime )
+                m_dBestTime = m_tElapsed.count();
+        }
+        cout << m_iSideLength << " x " << m_iSideLength << " MultiplyInto: " << m_dBestTime << " seconds, " 
+             << m_dNumOfFlops / m_dBestTime * 1e-9 << " GFLOP/s" << endl;
+
+        if ( m_iSideLength <= 256 ) {
+            chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+            NaiveMatrixMultiply(m_mMatrix1, m_mMatrix2);
+            chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            cout << m_iSideLength << " x " << m_iSideLength << "    Reference: " << m_tElapsed.count() << " seconds, " 
+                 << m_dNumOfFlops / m_tElapsed.count() * 1e-9 << " GFLOP/s" << endl;
+        }
+    }
+}
+
+
+void BenchmarkMatrixExpressions(const vector<size_t> &inSideLengths, const unsigned short int inNumOfRepeats)
+/********************************************
+ *       Purpose: Print the time to build H = A + A^dagger for every side length in inSideLengths, 
+ *                once as a fused expression and once as a copy, ConjugateTranspose() and an entrywise add.
+ *  Precondition: inNumOfRepeats >= 1
+ * Postcondition: The best of inNumOfRepeats runs is reported for each.
+********************************************/ 
+{
+    static default_random_engine generator;
+
+    for ( size_t i = 0; i < inSideLengths.size(); i++ ) {
+        const size_t m_iSideLength = inSideLengths[i];
+        const CMatrix m_mMatrix = GenerateRandomMatrix(m_iSideLength, generator);
+        CMatrix m_mResult = CMatrix(m_iSideLength, m_iSideLength);
+
+        double m_dBestFusedTime = 0;
+        double m_dBestUnfusedTime = 0;
+        for ( unsigned short int t = 0; t < inNumOfRepeats; t++ ) {
+            chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+            m_mResult = m_mMatrix + m_mMatrix.Adjoint();
+            chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            if ( t == 0 || m_tElapsed.count() < m_dBestFusedTime )
+                m_dBestFusedTime = m_tElapsed.count();
+
+            m_tStart = chrono::steady_clock::now();
+            CMatrix m_mDagger = m_mMatrix;
+            m_mDagger.ConjugateTranspose();
+            for ( size_t r = 0; r < m_iSideLength; r++ )
+                for ( size_t c = 0; c < m_iSideLength; c++ )
+                    m_mDagger.ModifyValueAt(r, c, m_mDagger.GetValueAt(r, c) + m_mMatrix.GetValueAt(r, c));
+            m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            if ( t == 0 || m_tElapsed.count() < m_dBestUnfusedTime )
+                m_dBestUnfusedTime = m_tElapsed.count();
+        }
+        cout << m_iSideLength << " x " << m_iSideLength << " A + A.Adjoint(): " << m_dBestFusedTime << " seconds" << endl;
+        cout << m_iSideLength << " x " << m_iSideLength << "        Unfused: " << m_dBestUnfusedTime << " seconds" << endl;
+    }
+}
+
+
+void BenchmarkKroneckerProduct(const vector<unsigned short int> &inNumOfQubits, const unsigned short int inNumOfRepeats)
+/********************************************
+ *       Purpose: Print the time of MakePauliAlgebraElement(), one n-ary Kronecker product, 
+ *                against chaining n - 1 pairwise tensor products, for every qubit count in inNumOfQubits.
+ *  Precondition: inNumOfRepeats >= 1. Qubit counts are at most MAX_NUM_OF_QUBITS.
+ * Postcondition: The best of inNumOfRepeats runs is reported for each.
+********************************************/ 
+{
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+
+    for ( size_t i = 0; i < inNumOfQubits.size(); i++ ) {
+        string m_sPauliGroupString;
+        for ( unsigned short int q = 0; q < inNumOfQubits[i]; q++ )
+            m_sPauliGroupString += m_arrcPauliChars[(q * 7 + 1) % 4];
+
+        double m_dBestNaryTime = 0;
+        double m_dBestPairwiseTime = 0;
+        for ( unsigned short int t = 0; t < inNumOfRepeats; t++ ) {
+            chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+            CPauliAlgebraElement m_paeNary = MakePauliAlgebraElement(m_sPauliGroupString);
+            chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            if ( t == 0 || m_tElapsed.count() < m_dBestNaryTime )
+                m_dBestNaryTime = m_tElapsed.count();
+
+            m_tStart = chrono::steady_clock::now();
+            CPauliAlgebraElement m_paePairwise = CPauliAlgebraElement(string(1, m_sPauliGroupString[0]));
+            for ( size_t q = 1; q < m_sPauliGroupString.size(); q++ )
+                m_paePairwise = m_paePairwise * CPauliAlgebraElement(string(1, m_sPauliGroupString[q]));
+            m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            if ( t == 0 || m_tElapsed.count() < m_dBestPairwiseTime )
+                m_dBestPairwiseTime = m_tElapsed.count();
+        }
+        cout << inNumOfQubits[i] << " qubits MakePauliAlgebraElement: " << m_dBestNaryTime << " seconds" << endl;
+        cout << inNumOfQubits[i] << " qubits  Pairwise operator*: " << m_dBestPairwiseTime << " seconds" << endl;
+    }
+}
+
+
+void BenchmarkMatrixReductions(const vector<size_t> &inSideLengths, const unsigned short int inNumOfRepeats)
+/********************************************
+ *       Purpose: Print the time of TraceOfProduct() against forming A B and calling Trace(), 
+ *                and of HilbertSchmidtInner() and FrobeniusNorm(), for every side length in inSideLengths.
+ *  Precondition: inNumOfRepeats >= 1
+ * Postcondition: The best of inNumOfRepeats runs is reported for each.
+********************************************/ 
+{
+    static default_random_engine generator;
+    cout << "Instruction set: " << GetSimdInstructionSet() << ", " << GetNumOfThreads() << " thread(s)" << endl;
+
+    for ( size_t i = 0; i < inSideLengths.size(); i++ ) {
+        const size_t m_iSideLength = inSideLengths[i];
+        const CMatrix m_mMatrix1 = GenerateRandomMatrix(m_iSideLength, generator);
+        const CMatrix m_mMatrix2 = GenerateRandomMatrix(m_iSideLength, generator);
+
+        double m_arrdBestTimes[4] = { 0, 0, 0, 0 };
+        for ( unsigned short int t = 0; t < inNumOfRepeats; t++ ) {
+            chrono::steady_clock::time_point m_arrtTimes[5];
+            m_arrtTimes[0] = chrono::steady_clock::now();
+            TraceOfProduct(m_mMatrix1, m_mMatrix2);
+            m_arrtTimes[1] = chrono::steady_clock::now();
+            (m_mMatrix1 * m_mMatrix2).Trace();
+            m_arrtTimes[2] = chrono::steady_clock::now();
+            HilbertSchmidtInner(m_mMatrix1, m_mMatrix2);
+            m_arrtTimes[3] = chrono::steady_clock::now();
+            FrobeniusNorm(m_mMatrix1);
+            m_arrtTimes[4] = chrono::steady_clock::now();
+            for ( size_t k = 0; k < 4; k++ ) {
+                const chrono::duration<double> m_tElapsed = m_arrtTimes[k + 1] - m_arrtTimes[k];
+                if ( t == 0 || m_tElapsed.count() < m_arrdBestTimes[k] )
+                    m_arrdBestTimes[k] = m_tElapsed.count();
+            }
+        }
+        cout << m_iSideLength << " x " << m_iSideLength << "      TraceOfProduct: " << m_arrdBestTimes[0] << " seconds" << endl;
+        cout << m_iSideLength << " x " << m_iSideLength << " operator* and Trace: " << m_arrdBestTimes[1] << " seconds" << endl;
+        cout << m_iSideLength << " x " << m_iSideLength << " HilbertSchmidtInner: " << m_arrdBestTimes[2] << " seconds" << endl;
+        cout << m_iSideLength << " x " << m_iSideLength << "       FrobeniusNorm: " << m_arrdBestTimes[3] << " seconds" << endl;
+    }
+}
+
+
+void BenchmarkLargeMatrixStorage(const size_t inSideLength, const unsigned short int inNumOfRepeats)
+/********************************************
+ *       Purpose: Print the time and memory bandwidth of H = A + A^dagger for one inSideLength x inSideLength matrix, 
+ *                with huge pages off and then on. The adjoint reads A down its columns, so each 32 x 32 tile 
+ *                touches 32 pages per row of tiles, which is where huge pages save TLB misses.
+ *  Precondition: inNumOfRepeats >= 1. Two inSideLength x inSideLength matrices fit in memory.
+ * Postcondition: The best of inNumOfRepeats runs is reported for each. The huge page setting is restored.
+ *          Note: A is read twice and H written once, 3 N^2 complex<float> entries in all.
+********************************************/ 
+{
+    const bool m_bWereHugePagesOn = GetHugePages();
+    const double m_dNumOfBytes = 3.0 * inSideLength * inSideLength * sizeof(complex<float>);
+    cout << "Instruction set: " << GetSimdInstructionSet() << ", " << GetNumOfThreads() << " thread(s)" << endl;
+
+    for ( int m_iAreHugePagesOn = 0; m_iAreHugePagesOn <= 1; m_iAreHugePagesOn++ ) {
+        SetHugePages(m_iAreHugePagesOn != 0);
+        CMatrix m_mMatrix = CMatrix(inSideLength, inSideLength);
+        CMatrix m_mResult = CMatrix(inSideLength, inSideLength);
+        for ( size_t r = 0; r < inSideLength; r++ )
+            m_mMatrix(r, r) = complex<float>(float(r), 1);
+
+        double m_dBestTime = 0;
+        for ( unsigned short int t = 0; t < inNumOfRepeats; t++ ) {
+            chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+            m_mResult = m_mMatrix + m_mMatrix.Adjoint();
+            chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            if ( t == 0 || m_tElapsed.count() < m_dBestTime )
+                m_dBestTime = m_tElapsed.count();
+        }
+        cout << inSideLength << " x " << inSideLength << " A + A.Adjoint(), huge pages " << (m_iAreHugePagesOn ? " on: " : "off: ") 
+             << m_dBestTime << " seconds, " << m_dNumOfBytes / m_dBestTime * 1e-9 << " GB/s" << endl;
+    }
+    SetHugePages(m_bWereHugePagesOn);
+}
+
+
+static unsigned short int GetNumOfQubits(const size_t inRowSize, const size_t inColSize, const char *inCaller)
+/********************************************
+ *       Purpose: Return n for a 2^n x 2^n matrix.
+ *  Precondition: Matrix is square and its side length is a power of 2.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (inRowSize != inColSize || inRowSize == 0 || (inRowSize & (inRowSize - 1)) != 0) {
+        cout << "ERROR: " << inCaller << " needs a 2^n x 2^n matrix, but the matrix is " << inRowSize << " x " << inColSize << "." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    unsigned short int m_iNumOfQubits = 0;
+    while ((size_t(1) << m_iNumOfQubits) < inRowSize)
+        m_iNumOfQubits++;
+
+    return m_iNumOfQubits;
+}
+
+
+static inline uint64_t SpreadBits(uint64_t inBits)
+/********************************************
+ *       Purpose: Move bit b of a 32 bit value to bit 2b. 
+ *                For Example: 0b111 becomes 0b10101.
+ *  Precondition: inBits < 2^32
+ * Postcondition: N/A
+********************************************/ 
+{
+    inBits = (inBits | (inBits << 16)) & 0x0000FFFF0000FFFFULL;
+    inBits = (inBits | (inBits << 8))  & 0x00FF00FF00FF00FFULL;
+    inBits = (inBits | (inBits << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+    inBits = (inBits | (inBits << 2))  & 0x3333333333333333ULL;
+    inBits = (inBits | (inBits << 1))  & 0x5555555555555555ULL;
+    return inBits;
+}
+
+
+static inline uint64_t CompactBits(uint64_t inBits)
+/********************************************
+ *       Purpose: Move bit 2b of a 64 bit value to bit b. Inverse of SpreadBits().
+ *                For Example: 0b10101 becomes 0b111.
+ *  Precondition: N/A
+ * Postcondition: Odd bits of the input are ignored.
+********************************************/ 
+{
+    inBits &= 0x5555555555555555ULL;
+    inBits = (inBits | (inBits >> 1))  & 0x3333333333333333ULL;
+    inBits = (inBits | (inBits >> 2))  & 0x0F0F0F0F0F0F0F0FULL;
+    inBits = (inBits | (inBits >> 4))  & 0x00FF00FF00FF00FFULL;
+    inBits = (inBits | (inBits >> 8))  & 0x0000FFFF0000FFFFULL;
+    inBits = (inBits | (inBits >> 16)) & 0x00000000FFFFFFFFULL;
+    return inBits;
+}
+
+
+static inline uint64_t ReverseLowBits(uint64_t inBits, const size_t inNumOfBits)
+/********************************************
+ *       Purpose: Reverse the order of the lowest inNumOfBits bits. 
+ *                Turns a packed Pauli String word, where qubit q is bit q, 
+ *                into a basis state mask, where qubit q is bit n - 1 - q.
+ *  Precondition: inNumOfBits <= 64. Bits at or above inNumOfBits are 0.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (inNumOfBits == 0)
+        return 0;
+
+    inBits = ((inBits >> 1)  & 0x5555555555555555ULL) | ((inBits & 0x5555555555555555ULL) << 1);
+    inBits = ((inBits >> 2)  & 0x3333333333333333ULL) | ((inBits & 0x3333333333333333ULL) << 2);
+    inBits = ((inBits >> 4)  & 0x0F0F0F0F0F0F0F0FULL) | ((inBits & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    inBits = ((inBits >> 8)  & 0x00FF00FF00FF00FFULL) | ((inBits & 0x00FF00FF00FF00FFULL) << 8);
+    inBits = ((inBits >> 16) & 0x0000FFFF0000FFFFULL) | ((inBits & 0x0000FFFF0000FFFFULL) << 16);
+    inBits = (inBits >> 32) | (inBits << 32);
+    return inBits >> (64 - inNumOfBits);
+}
+
+
+static inline size_t PauliCoefficientIndex(const uint64_t inXMask, const uint64_t inZMask)
+/********************************************
+ *       Purpose: Return the index of the Pauli String P(x, z) in the coefficient 
+ *                vector returned by PauliCoefficients().
+ *                Each qubit is one base 4 digit: I = 0, X = 1, Y = 2, Z = 3
+ *                which is digit = 2z + (x ^ z). Bit b of a mask is digit b.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    return (size_t) (SpreadBits(inXMask ^ inZMask) | (SpreadBits(inZMask) << 1));
+}
+
+
+template <class T>
+static inline void WalshHadamardTransform(T *inValues, const size_t inLength)
+/********************************************
+ *       Purpose: In place unnormalized Walsh-Hadamard transform.
+ *                out[z] = sum over a of (-1)^popcount(a & z) in[a]
+ *  Precondition: inLength is a power of 2.
+ * Postcondition: Runs in O(inLength log(inLength)).
+ *          Note: Called on double or complex<double> values so integer valued matrices round trip exactly past 10 qubits.
+********************************************/ 
+{
+    for ( size_t h = 1; h < inLength; h *= 2 ) {
+        for ( size_t b = 0; b < inLength; b += 2 * h ) {
+            T *m_pLow = inValues + b;
+            T *m_pHigh = inValues + b + h;
+            for ( size_t j = 0; j < h; j++ ) {
+                T m_cxLow = m_pLow[j];
+                T m_cxHigh = m_pHigh[j];
+                m_pLow[j] = m_cxLow + m_cxHigh;
+                m_pHigh[j] = m_cxLow - m_cxHigh;
+            }
+        }
+    }
+}
+
+
+static string PauliStringFromIndex(const size_t inIndex, const unsigned short int inNumOfQubits)
+/********************************************
+ *       Purpose: Return the Pauli String at index inIndex of PauliCoefficients().
+ *                For Example: index 6 on 2 qubits is "XY".
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+
+    string m_sResult;
+    for ( unsigned short int q = 0; q < inNumOfQubits; q++ )
+        m_sResult += m_arrcPauliChars[(inIndex >> (2 * (inNumOfQubits - 1 - q))) & 3];
+
+    return m_sResult;
+}
+
+
+vector<complex<float>> CMatrix::PauliCoefficients() const
+/********************************************
+ *       Purpose: Decompose any 2^n x 2^n matrix M into all 4^n Pauli Strings
+ *                M = sum over P of c_P P   where   c_P = (1 / 2^n) Tr(P M)
+ * 
+ *                Writing P(x, z) = i^popcount(x & z) X^x Z^z gives
+ *                Tr(P M) = i^-popcount(x & z) sum over a of (-1)^popcount(a & z) M[a ^ x, a]
+ *                so for every X mask x the coefficients of all 2^n Z masks are one 
+ *                Walsh-Hadamard transform of the entries M[a ^ x, a]. 
+ * 
+ *  Precondition: Must be a 2^n x 2^n matrix.
+ * Postcondition: Input matrix must not be modified. 
+ *                Coefficient of the Pauli String "P_0 P_1 ... P_(n-1)" is at the base 4 index 
+ *                with P_0 as the most significant digit and I = 0, X = 1, Y = 2, Z = 3.
+ *                For a 2 x 2 matrix this is { c_I, c_X, c_Y, c_Z }.
+ *          Note: Runs in O(n 4^n). The X masks are independent and are split across threads.
+********************************************/ 
+{
+    // Exits unless the matrix is 2^n x 2^n.
+    GetNumOfQubits(m_iRowSize, m_iColSize, "PauliCoefficients()");
+
+    const size_t m_iSideLength = m_iRowSize;
+    const double m_dNormalization = 1.0 / m_iSideLength;
+    vector<complex<float>> m_vecCoefficients(m_iSideLength * m_iSideLength);
+
+    ParallelFor(0, m_iSideLength, max<size_t>(1, 4096 / m_iSideLength), [&](size_t inXBegin, size_t inXEnd) {
+        thread_local vector<complex<double>> m_vecScratch;
+        m_vecScratch.resize(m_iSideLength);
+
+        for ( size_t x = inXBegin; x < inXEnd; x++ ) {
+            // Gather the entries M[a ^ x, a] that X^x Z^z can pick out.
+            for ( size_t a = 0; a < m_iSideLength; a++ )
+                m_vecScratch[a] = complex<double>(GetEntry((a ^ x) * m_iSideLength + a));
+
+            WalshHadamardTransform(m_vecScratch.data(), m_iSideLength);
+
+            for ( size_t z = 0; z < m_iSideLength; z++ ) {
+                unsigned int m_iExponent = 4 - (PopCount64(x & z) & 3);
+                m_vecCoefficients[PauliCoefficientIndex(x, z)] = MultiplyByPowerOfI(complex<float>(m_vecScratch[z] * m_dNormalization), m_iExponent);
+            }
+        }
+    });
+
+    return m_vecCoefficients;
+}
+
+
+vector<float> CMatrix::PauliDecomposition() const
+/********************************************
+ *       Purpose: Decompose a 2^n x 2^n Hermitian matrix into 
+ *                the pauli matrices using the following formula:
+ *                H = r0 * I + r1 * X + r2 * Y + r3 * Z       (2 x 2 example)
+ *                where
+ *                r0 = (1/2)Tr(H)
+ *                r1 = (1/2)Tr(HX)
+ *                r2 = (1/2)Tr(HY)
+ *                r3 = (1/2)Tr(HZ)
+ * 
+ *  Precondition: Must be a 2^n x 2^n Hermitian Matrix.
+ * Postcondition: Input matrix must not be modified. 
+ *                Return a list containing the 4^n real constants, ordered as in PauliCoefficients().
+ *                For a 2 x 2 matrix this is r0, r1, r2, r3. 
+ *          Note: Coefficients of a Hermitian matrix are real. Use PauliCoefficients() for general matrices.
+ *                Coefficients are rounded to float. CDenseMatrix<complex<double> >::PauliDecomposition() keeps them in double.
+********************************************/ 
+{
+    vector<complex<float>> m_vecCoefficients = PauliCoefficients();
+
+    vector<float> m_vecRealConst(m_vecCoefficients.size());
+    for ( size_t i = 0; i < m_vecCoefficients.size(); i++ )
+        m_vecRealConst[i] = m_vecCoefficients[i].real();
+
+    return m_vecRealConst;
+}
+
+
+CPauliSum CMatrix::PauliDecompositionSparse(const float inDropTolerance) const
+/********************************************
+ *       Purpose: Decompose any 2^n x 2^n matrix into a Pauli Sum, keeping only 
+ *                the Pauli Strings whose coefficient magnitude is larger than inDropTolerance.
+ *  Precondition: Must be a 2^n x 2^n matrix.
+ * Postcondition: Input matrix must not be modified. 
+ *          Note: Terms are ordered as in PauliCoefficients(). See PauliCoefficients().
+********************************************/ 
+{
+    unsigned short int m_iNumOfQubits = GetNumOfQubits(m_iRowSize, m_iColSize, "PauliDecompositionSparse()");
+    vector<complex<float>> m_vecCoefficients = PauliCoefficients();
+
+    vector<uint64_t> m_vecXWords;
+    vector<uint64_t> m_vecZWords;
+    vector<complex<float>> m_vecKeptCoefficients;
+
+    for ( size_t i = 0; i < m_vecCoefficients.size(); i++ ) {
+        if (abs(m_vecCoefficients[i]) <= inDropTolerance)
+            continue;
+
+        // Base 4 digit of qubit q is digit n - 1 - q.
+        uint64_t m_iXWord = 0;
+        uint64_t m_iZWord = 0;
+        for ( unsigned short int q = 0; q < m_iNumOfQubits; q++ ) {
+            size_t m_iDigit = (i >> (2 * (m_iNumOfQubits - 1 - q))) & 3;
+            m_iXWord |= uint64_t(m_iDigit == 1 || m_iDigit == 2) << q;
+            m_iZWord |= uint64_t(m_iDigit == 2 || m_iDigit == 3) << q;
+        }
+
+        if (m_iNumOfQubits > 0) {
+            m_vecXWords.push_back(m_iXWord);
+            m_vecZWords.push_back(m_iZWord);
+        }
+        m_vecKeptCoefficients.push_back(m_vecCoefficients[i]);
+    }
+
+    return CPauliSum(m_iNumOfQubits, m_vecXWords, m_vecZWords, m_vecKeptCoefficients);
+}
+
+static void InverseFastPauliTransform(complex<float> *ioMatrix, const size_t inSideLength, const bool inIsParallel)
+/********************************************
+ *       Purpose: Turn a 2^n x 2^n matrix holding staged Pauli coefficients into 
+ *                the matrix they compose. Inverse of PauliCoefficients().
+ * 
+ *                The coefficient c of P(x, z) must be staged as i^popcount(x & z) c at entry [z ^ x, z]. 
+ *                Entries [a ^ x, a] of the composed matrix only depend on the coefficients with X mask x:
+ *                M[a ^ x, a] = sum over z of (-1)^popcount(a & z) i^popcount(x & z) c(x, z)
+ *                so each X mask is one Walsh-Hadamard transform that reads and writes the same N entries.
+ * 
+ *  Precondition: inSideLength is a power of 2.
+ * Postcondition: Runs in O(n 4^n) in place with O(2^n) scratch per thread.
+********************************************/ 
+{
+    size_t m_iGrainSize = inIsParallel ? max<size_t>(1, 4096 / inSideLength) : inSideLength;
+
+    ParallelFor(0, inSideLength, m_iGrainSize, [&](size_t inXBegin, size_t inXEnd) {
+        thread_local vector<complex<double>> m_vecScratch;
+        m_vecScratch.resize(inSideLength);
+
+        for ( size_t x = inXBegin; x < inXEnd; x++ ) {
+            for ( size_t z = 0; z < inSideLength; z++ )
+                m_vecScratch[z] = complex<double>(ioMatrix[(z ^ x) * inSideLength + z]);
+
+            WalshHadamardTransform(m_vecScratch.data(), inSideLength);
+
+            for ( size_t a = 0; a < inSideLength; a++ )
+                ioMatrix[(a ^ x) * inSideLength + a] = complex<float>(m_vecScratch[a]);
+        }
+    });
+}
+
+
+CMatrix ComposePauliCoefficients(const vector<complex<float>> &inCoefficients, const bool inIsParallel)
+/********************************************
+ *       Purpose: Compose the 2^n x 2^n matrix  sum over P of c_P P  from all 4^n Pauli coefficients.
+ *  Precondition: inCoefficients holds 4^n coefficients ordered as in PauliCoefficients().
+ * Postcondition: N/A
+ *          Note: Runs in O(n 4^n). Set inIsParallel to false to stay on the calling thread.
+********************************************/ 
+{
+    size_t m_iSideLength = 1;
+    while (m_iSideLength * m_iSideLength < inCoefficients.size())
+        m_iSideLength *= 2;
+
+    if (m_iSideLength * m_iSideLength != inCoefficients.size()) {
+        cout << "ERROR: Composing a matrix from Pauli coefficients needs 4^n coefficients, but " << inCoefficients.size() << " were given." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    CMatrix m_mResult = CMatrix(m_iSideLength, m_iSideLength);
+    complex<float> *m_pMatrix = m_mResult.m_vecMatrix.data();
+
+    // Stage coefficient c of P(x, z) at entry [z ^ x, z].
+    for ( size_t i = 0; i < inCoefficients.size(); i++ ) {
+        uint64_t m_iZMask = CompactBits(i >> 1);
+        uint64_t m_iXMask = CompactBits(i) ^ m_iZMask;
+        m_pMatrix[(m_iZMask ^ m_iXMask) * m_iSideLength + m_iZMask] = MultiplyByPowerOfI(inCoefficients[i], PopCount64(m_iXMask & m_iZMask));
+    }
+
+    InverseFastPauliTransform(m_pMatrix, m_iSideLength, inIsParallel);
+    return m_mResult;
+}
+
+
+CMatrix ComposePauliSum(const CPauliSum &inPauliSum, const bool inIsParallel)
+/********************************************
+ *       Purpose: Compose the dense 2^n x 2^n matrix of a Pauli Sum.
+ *  Precondition: The Pauli Sum acts on at most MAX_NUM_OF_QUBITS qubits. 
+ * Postcondition: N/A
+ *          Note: Runs in O(n 4^n) no matter how many terms the sum has. 
+ *                Set inIsParallel to false to stay on the calling thread.
+********************************************/ 
+{
+    const size_t m_iNumOfQubits = inPauliSum.GetNumOfQubits();
+    if (m_iNumOfQubits > MAX_NUM_OF_QUBITS) {
+        cout << "ERROR: ComposePauliSum() can not hold a dense " << m_iNumOfQubits << " qubit matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    const size_t m_iSideLength = size_t(1) << m_iNumOfQubits;
+    CMatrix m_mResult = CMatrix(m_iSideLength, m_iSideLength);
+    complex<float> *m_pMatrix = m_mResult.m_vecMatrix.data();
+
+    // Qubit q of a Pauli String is bit n - 1 - q of the row index.
+    for ( size_t t = 0; t < inPauliSum.GetNumOfTerms() && m_iNumOfQubits > 0; t++ ) {
+        uint64_t m_iXMask = ReverseLowBits(inPauliSum.GetXWordsAt(t)[0], m_iNumOfQubits);
+        uint64_t m_iZMask = ReverseLowBits(inPauliSum.GetZWordsAt(t)[0], m_iNumOfQubits);
+        m_pMatrix[(m_iZMask ^ m_iXMask) * m_iSideLength + m_iZMask] += MultiplyByPowerOfI(inPauliSum.GetCoefficientAt(t), PopCount64(m_iXMask & m_iZMask));
+    }
+    for ( size_t t = 0; t < inPauliSum.GetNumOfTerms() && m_iNumOfQubits == 0; t++ )
+        m_pMatrix[0] += inPauliSum.GetCoefficientAt(t);
+
+    InverseFastPauliTransform(m_pMatrix, m_iSideLength, inIsParallel);
+    return m_mResult;
+}
+
+
+CMatrix ComposeHermitian(const vector<float> &inRealConst)
+/********************************************
+ *       Purpose: Compose a 2^n x 2^n Hermitian matrix using 
+ *                the input real constants, and the Pauli Strings.
+ *                For Example, on 1 qubit: H = r0 * I + r1 * X + r2 * Y + r3 * Z
+ *                Return the resulting Hermitian matrix.
+ *                   
+ *  Precondition: Parameter containing the 4^n constants must be real numbers
+ *                ordered as in PauliDecomposition(). 
+ * Postcondition: N/A
+ *          Note: Inverse of PauliDecomposition(). Runs in O(n 4^n). For large matrices, 
+ *                CDenseMatrix<complex<double> >::ComposeHermitian() only rounds the composed entries to float once.
+********************************************/ 
+{
+    thread_local vector<complex<float>> m_vecCoefficients;
+    m_vecCoefficients.assign(inRealConst.begin(), inRealConst.end());
+    return ComposePauliCoefficients(m_vecCoefficients);
+}
+
+
+template <class T>
+static inline T MultiplyScalars(const T &inZ1, const T &inZ2)
+/********************************************
+ *       Purpose: Return inZ1 * inZ2. Complex scalars skip the NaN and infinity recovery of 
+ *                std::complex multiplication, as in CElementwiseMultiplyOperation.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    if constexpr ( CScalarTraits<T>::IS_COMPLEX )
+        return T(inZ1.real() * inZ2.real() - inZ1.imag() * inZ2.imag(), inZ1.real() * inZ2.imag() + inZ1.imag() * inZ2.real());
+    else
+        return inZ1 * inZ2;
+}
+
+
+template <class T>
+static inline T ConjugateScalar(const T &inZ)
+/********************************************
+ *       Purpose: Return the complex conjugate of inZ, which is inZ itself for a real scalar.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    if constexpr ( CScalarTraits<T>::IS_COMPLEX )
+        return conj(inZ);
+    else
+        return inZ;
+}
+
+
+template <class T>
+static T ScalarFromComplex(const complex<double> &inZ, const char *inCaller)
+/********************************************
+ *       Purpose: Return inZ as a T. 
+ *  Precondition: inZ is real when T is real.
+ * Postcondition: Exits when T is real and inZ has an imaginary part.
+********************************************/ 
+{
+    if constexpr ( CScalarTraits<T>::IS_COMPLEX )
+        return T(inZ);
+    else {
+        if ( inZ.imag() != 0 ) {
+            cout << "ERROR: " << inCaller << " produced the complex entry " << inZ << " in a real matrix." << '\n'
+                 << "EXITING PROGRAM . . ." << endl;
+            exit(1);
+        }
+        return T(inZ.real());
+    }
+}
+
+
+template <class T>
+CDenseMatrix<T>::CDenseMatrix(const size_t inRowSize, const size_t inColSize)
+/********************************************
+ *       Purpose: Initialize an inRowSize x inColSize matrix with all 0 entries.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+    : m_iRowSize(0), m_iColSize(0)
+{
+    Resize(inRowSize, inColSize);
+}
+
+
+template <class T>
+CDenseMatrix<T>::CDenseMatrix(const CMatrix &inMatrix)
+/********************************************
+ *       Purpose: Copy a CMatrix in either layout.
+ *  Precondition: Every entry is real when T is real.
+ * Postcondition: Exits when T is real and an entry has an imaginary part.
+********************************************/ 
+    : CDenseMatrix(inMatrix.GetRowSize(), inMatrix.GetColSize())
+{
+    for ( size_t r = 0; r < m_iRowSize; r++ )
+        for ( size_t c = 0; c < m_iColSize; c++ )
+            m_vecEntries[r * m_iColSize + c] = ScalarFromComplex<T>(complex<double>(inMatrix(r, c)), "Converting a CMatrix");
+}
+
+
+template <class T>
+CMatrix CDenseMatrix<T>::ToMatrix() const
+/********************************************
+ *       Purpose: Return the entries rounded to a complex<float> CMatrix.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    CMatrix m_mResult = CMatrix(m_iRowSize, m_iColSize);
+    for ( size_t r = 0; r < m_iRowSize; r++ )
+        for ( size_t c = 0; c < m_iColSize; c++ )
+            m_mResult(r, c) = complex<float>(m_vecEntries[r * m_iColSize + c]);
+    return m_mResult;
+}
+
+
+template <class T>
+void CDenseMatrix<T>::Resize(const size_t inRowSize, const size_t inColSize)
+/********************************************
+ *       Purpose: Make this an inRowSize x inColSize matrix with all 0 entries.
+ *  Precondition: N/A
+ * Postcondition: Nothing is allocated when the entries fit in the current storage.
+********************************************/ 
+{
+    if ( inRowSize > MAX_SIDE_LENGTH || inColSize > MAX_SIDE_LENGTH ) {
+        cout << "ERROR: A CDenseMatrix can be at most " << MAX_SIDE_LENGTH << " x " << MAX_SIDE_LENGTH << ", not " 
+             << inRowSize << " x " << inColSize << "." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+    m_iRowSize = inRowSize;
+    m_iColSize = inColSize;
+    m_vecEntries.assign(inRowSize * inColSize, T(0));
+}
+
+
+template <class T>
+CDenseMatrix<T> CDenseMatrix<T>::operator+(const CDenseMatrix &inMatrix2) const
+/********************************************
+ *       Purpose: Return the entrywise sum of both matrices.
+ *  Precondition: Both matrices have the same size.
+ * Postcondition: Neither matrix is modified.
+********************************************/ 
+{
+    CheckExpressionSizes(m_iRowSize, m_iColSize, inMatrix2.m_iRowSize, inMatrix2.m_iColSize, "add");
+    CDenseMatrix m_mResult = *this;
+    for ( size_t i = 0; i < m_vecEntries.size(); i++ )
+        m_mResult.m_vecEntries[i] += inMatrix2.m_vecEntries[i];
+    return m_mResult;
+}
+
+
+template <class T>
+CDenseMatrix<T> CDenseMatrix<T>::operator-(const CDenseMatrix &inMatrix2) const
+/********************************************
+ *       Purpose: Return the entrywise difference of both matrices.
+ *  Precondition: Both matrices have the same size.
+ * Postcondition: Neither matrix is modified.
+********************************************/ 
+{
+    CheckExpressionSizes(m_iRowSize, m_iColSize, inMatrix2.m_iRowSize, inMatrix2.m_iColSize, "subtract");
+    CDenseMatrix m_mResult = *this;
+    for ( size_t i = 0; i < m_vecEntries.size(); i++ )
+        m_mResult.m_vecEntries[i] -= inMatrix2.m_vecEntries[i];
+    return m_mResult;
+}
+
+
+template <class T>
+CDenseMatrix<T> CDenseMatrix<T>::operator*(const T &inZ) const
+/********************************************
+ *       Purpose: Return inZ times every entry.
+ *  Precondition: N/A
+ * Postcondition: This matrix is not modified.
+********************************************/ 
+{
+    CDenseMatrix m_mResult = *this;
+    for ( size_t i = 0; i < m_vecEntries.size(); i++ )
+        m_mResult.m_vecEntries[i] = MultiplyScalars(inZ, m_vecEntries[i]);
+    return m_mResult;
+}
+
+
+template <class T>
+void MultiplyInto(CDenseMatrix<T> &outMatrix, const CDenseMatrix<T> &inMatrix1, const CDenseMatrix<T> &inMatrix2)
+/********************************************
+ *       Purpose: outMatrix = inMatrix1 * inMatrix2. Each row of the result is a sum of rows of inMatrix2 
+ *                scaled by one entry of inMatrix1, taken GEMM_KC rows of inMatrix2 at a time so they stay in cache. 
+ *                The inner loop runs over contiguous entries and vectorizes for every scalar type. 
+ *                Rows of the result are split across threads.
+ *  Precondition: inMatrix1 is M x K and inMatrix2 is K x N.
+ * Postcondition: outMatrix is M x N. Entries are summed over k in order for any number of threads. 
+ *                No memory is allocated when outMatrix already has the right size and does not alias an input.
+********************************************/ 
+{
+    const size_t M = inMatrix1.GetRowSize();
+    const size_t K = inMatrix1.GetColSize();
+    const size_t N = inMatrix2.GetColSize();
+    if ( K != inMatrix2.GetRowSize() ) {
+        cout << "ERROR: Unable to matrix multiply a " << M << " x " << K << " matrix with a " 
+             << inMatrix2.GetRowSize() << " x " << N << " matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    if ( &outMatrix == &inMatrix1 || &outMatrix == &inMatrix2 ) {
+        CDenseMatrix<T> m_mResult = CDenseMatrix<T>(M, N);
+        MultiplyInto(m_mResult, inMatrix1, inMatrix2);
+        outMatrix = std::move(m_mResult);
+        return;
+    }
+
+    outMatrix.Resize(M, N);
+    const T *m_pA = inMatrix1.Data().data();
+    const T *m_pB = inMatrix2.Data().data();
+    T *m_pC = outMatrix.Data().data();
+    ParallelFor(0, M, max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, K * N)), [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t pc = 0; pc < K; pc += GEMM_KC ) {
+            const size_t m_iDepthEnd = min(K, pc + GEMM_KC);
+            for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+                T *m_pRow = m_pC + r * N;
+                for ( size_t k = pc; k < m_iDepthEnd; k++ ) {
+                    const T m_tEntry = m_pA[r * K + k];
+                    const T *m_pRowOfB = m_pB + k * N;
+                    for ( size_t c = 0; c < N; c++ )
+                        m_pRow[c] += MultiplyScalars(m_tEntry, m_pRowOfB[c]);
+                }
+            }
+        }
+    });
+}
+
+
+template <class T>
+CDenseMatrix<T> CDenseMatrix<T>::operator*(const CDenseMatrix &inMatrix2) const
+/********************************************
+ *       Purpose: Return the matrix multiplication of this M x K matrix and a K x N matrix.
+ *  Precondition: See MultiplyInto().
+ * Postcondition: Neither matrix is modified.
+********************************************/ 
+{
+    CDenseMatrix m_mResult;
+    MultiplyInto(m_mResult, *this, inMatrix2);
+    return m_mResult;
+}
+
+
+template <class T>
+CDenseMatrix<T> CDenseMatrix<T>::Adjoint() const
+/********************************************
+ *       Purpose: Return the conjugate transpose, which is the transpose for a real T. 
+ *                Entries are copied in 32 x 32 tiles so both matrices are read and written a tile at a time.
+ *  Precondition: N/A
+ * Postcondition: This matrix is not modified.
+********************************************/ 
+{
+    const size_t TILE = 32;
+    CDenseMatrix m_mResult = CDenseMatrix(m_iColSize, m_iRowSize);
+    for ( size_t tr = 0; tr < m_iRowSize; tr += TILE )
+        for ( size_t tc = 0; tc < m_iColSize; tc += TILE )
+            for ( size_t r = tr; r < min(tr + TILE, m_iRowSize); r++ )
+                for ( size_t c = tc; c < min(tc + TILE, m_iColSize); c++ )
+                    m_mResult.m_vecEntries[c * m_iRowSize + r] = ConjugateScalar(m_vecEntries[r * m_iColSize + c]);
+    return m_mResult;
+}
+
+
+template <class T>
+T CDenseMatrix<T>::Trace() const
+/********************************************
+ *       Purpose: Return the sum of the leading diagonal, of length min(rows, cols).
+ *  Precondition: N/A
+ * Postcondition: Summed in double or complex<double>.
+********************************************/ 
+{
+    typename CScalarTraits<T>::WideType m_wTrace = 0;
+    for ( size_t d = 0; d < min(m_iRowSize, m_iColSize); d++ )
+        m_wTrace += typename CScalarTraits<T>::WideType(m_vecEntries[d * m_iColSize + d]);
+    return T(m_wTrace);
+}
+
+
+template <class T>
+typename CDenseMatrix<T>::RealType CDenseMatrix<T>::FrobeniusNorm() const
+/********************************************
+ *       Purpose: Return the square root of the sum of |a|^2 over every entry.
+ *  Precondition: N/A
+ * Postcondition: Summed in double.
+********************************************/ 
+{
+    double m_dSumOfSquares = 0;
+    for ( size_t i = 0; i < m_vecEntries.size(); i++ )
+        m_dSumOfSquares += norm(typename CScalarTraits<T>::WideType(m_vecEntries[i]));
+    return RealType(sqrt(m_dSumOfSquares));
+}
+
+
+template <class T>
+vector<complex<typename CDenseMatrix<T>::RealType> > CDenseMatrix<T>::PauliCoefficients() const
+/********************************************
+ *       Purpose: Decompose a 2^n x 2^n matrix into all 4^n Pauli Strings. See CMatrix::PauliCoefficients(). 
+ *                The Walsh-Hadamard transforms run in double for a real T, so they do no imaginary arithmetic, 
+ *                and in complex<double> for a complex T.
+ *  Precondition: Must be a 2^n x 2^n matrix.
+ * Postcondition: Coefficients are ordered as in CMatrix::PauliCoefficients() and rounded to RealType.
+********************************************/ 
+{
+    GetNumOfQubits(m_iRowSize, m_iColSize, "CDenseMatrix::PauliCoefficients()");
+
+    const size_t m_iSideLength = m_iRowSize;
+    const double m_dNormalization = 1.0 / m_iSideLength;
+    vector<complex<RealType> > m_vecCoefficients(m_iSideLength * m_iSideLength);
+
+    ParallelFor(0, m_iSideLength, max<size_t>(1, 4096 / m_iSideLength), [&](size_t inXBegin, size_t inXEnd) {
+        vector<typename CScalarTraits<T>::WideType> m_vecScratch(m_iSideLength);
+        for ( size_t x = inXBegin; x < inXEnd; x++ ) {
+            for ( size_t a = 0; a < m_iSideLength; a++ )
+                m_vecScratch[a] = typename CScalarTraits<T>::WideType(m_vecEntries[(a ^ x) * m_iSideLength + a]);
+
+            WalshHadamardTransform(m_vecScratch.data(), m_iSideLength);
+
+            for ( size_t z = 0; z < m_iSideLength; z++ ) {
+                const unsigned int m_iExponent = 4 - (PopCount64(x & z) & 3);
+                m_vecCoefficients[PauliCoefficientIndex(x, z)] = complex<RealType>(MultiplyByPowerOfI(complex<double>(m_vecScratch[z]) * m_dNormalization, m_iExponent));
+            }
+        }
+    });
+
+    return m_vecCoefficients;
+}
+
+
+template <class T>
+vector<typename CDenseMatrix<T>::RealType> CDenseMatrix<T>::PauliDecomposition() const
+/********************************************
+ *       Purpose: Return the 4^n real Pauli coefficients of a 2^n x 2^n Hermitian matrix. See CMatrix::PauliDecomposition().
+ *  Precondition: Must be a 2^n x 2^n Hermitian Matrix, which for a real T means symmetric.
+ * Postcondition: Coefficients are ordered as in CMatrix::PauliCoefficients().
+********************************************/ 
+{
+    const vector<complex<RealType> > m_vecCoefficients = PauliCoefficients();
+    vector<RealType> m_vecRealConst(m_vecCoefficients.size());
+    for ( size_t i = 0; i < m_vecCoefficients.size(); i++ )
+        m_vecRealConst[i] = m_vecCoefficients[i].real();
+    return m_vecRealConst;
+}
+
+
+template <class T>
+static void InverseFastPauliTransform(CDenseMatrix<T> &ioMatrix)
+/********************************************
+ *       Purpose: Turn a 2^n x 2^n matrix holding staged Pauli coefficients into the matrix they compose, 
+ *                as InverseFastPauliTransform() does for a complex<float> matrix.
+ *  Precondition: ioMatrix is 2^n x 2^n and holds the staged coefficients.
+ * Postcondition: Each transform runs in double or complex<double>.
+********************************************/ 
+{
+    const size_t m_iSideLength = ioMatrix.GetRowSize();
+    T *m_pMatrix = ioMatrix.Data().data();
+    ParallelFor(0, m_iSideLength, max<size_t>(1, 4096 / max<size_t>(1, m_iSideLength)), [&](size_t inXBegin, size_t inXEnd) {
+        vector<typename CScalarTraits<T>::WideType> m_vecScratch(m_iSideLength);
+        for ( size_t x = inXBegin; x < inXEnd; x++ ) {
+            for ( size_t z = 0; z < m_iSideLength; z++ )
+                m_vecScratch[z] = typename CScalarTraits<T>::WideType(m_pMatrix[(z ^ x) * m_iSideLength + z]);
+
+            WalshHadamardTransform(m_vecScratch.data(), m_iSideLength);
+
+            for ( size_t a = 0; a < m_iSideLength; a++ )
+                m_pMatrix[(a ^ x) * m_iSideLength + a] = T(m_vecScratch[a]);
+        }
+    });
+}
+
+
+template <class T>
+CDenseMatrix<T> CDenseMatrix<T>::ComposePauliCoefficients(const vector<complex<RealType> > &inCoefficients)
+/********************************************
+ *       Purpose: Compose the 2^n x 2^n matrix  sum over P of c_P P  from all 4^n Pauli coefficients. 
+ *                See ComposePauliCoefficients().
+ *  Precondition: inCoefficients holds 4^n coefficients ordered as in CMatrix::PauliCoefficients(). 
+ *                For a real T, i^(number of Y's) c_P must be real for every P, as it is for any real matrix.
+ * Postcondition: Exits when a real T can not hold the composed matrix.
+********************************************/ 
+{
+    size_t m_iSideLength = 1;
+    while (m_iSideLength * m_iSideLength < inCoefficients.size())
+        m_iSideLength *= 2;
+
+    if (m_iSideLength * m_iSideLength != inCoefficients.size()) {
+        cout << "ERROR: Composing a matrix from Pauli coefficients needs 4^n coefficients, but " << inCoefficients.size() << " were given." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    // Stage coefficient c of P(x, z) at entry [z ^ x, z].
+    CDenseMatrix m_mResult = CDenseMatrix(m_iSideLength, m_iSideLength);
+    for ( size_t i = 0; i < inCoefficients.size(); i++ ) {
+        const uint64_t m_iZMask = CompactBits(i >> 1);
+        const uint64_t m_iXMask = CompactBits(i) ^ m_iZMask;
+        m_mResult.m_vecEntries[(m_iZMask ^ m_iXMask) * m_iSideLength + m_iZMask] = 
+            ScalarFromComplex<T>(MultiplyByPowerOfI(complex<double>(inCoefficients[i]), PopCount64(m_iXMask & m_iZMask)), "ComposePauliCoefficients()");
+    }
+
+    InverseFastPauliTransform(m_mResult);
+    return m_mResult;
+}
+
+
+template <class T>
+CDenseMatrix<T> CDenseMatrix<T>::ComposeHermitian(const vector<RealType> &inRealConst)
+/********************************************
+ *       Purpose: Compose a 2^n x 2^n Hermitian matrix from its 4^n real Pauli coefficients. See ComposeHermitian().
+ *  Precondition: inRealConst is ordered as in PauliDecomposition(). For a real T, coefficients of 
+ *                Pauli Strings with an odd number of Y's must be 0.
+ * Postcondition: Inverse of PauliDecomposition().
+********************************************/ 
+{
+    return ComposePauliCoefficients(vector<complex<RealType> >(inRealConst.begin(), inRealConst.end()));
+}
+
+
+template <class T>
+CDenseMatrix<T> CDenseMatrix<T>::ComposePauliSum(const CPauliSum &inPauliSum)
+/********************************************
+ *       Purpose: Compose the dense 2^n x 2^n matrix of a Pauli Sum. See ComposePauliSum(). 
+ *                Terms on the same Pauli String are added in T, so complex<double> keeps sums of many terms accurate.
+ *  Precondition: The Pauli Sum acts on at most MAX_NUM_OF_QUBITS qubits. For a real T, 
+ *                i^(number of Y's) c must be real for every term.
+ * Postcondition: Exits when a real T can not hold a term.
+********************************************/ 
+{
+    const size_t m_iNumOfQubits = inPauliSum.GetNumOfQubits();
+    if (m_iNumOfQubits > MAX_NUM_OF_QUBITS) {
+        cout << "ERROR: ComposePauliSum() can not hold a dense " << m_iNumOfQubits << " qubit matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    const size_t m_iSideLength = size_t(1) << m_iNumOfQubits;
+    CDenseMatrix m_mResult = CDenseMatrix(m_iSideLength, m_iSideLength);
+
+    // Qubit q of a Pauli String is bit n - 1 - q of the row index.
+    for ( size_t t = 0; t < inPauliSum.GetNumOfTerms(); t++ ) {
+        const uint64_t m_iXMask = (m_iNumOfQubits > 0) ? ReverseLowBits(inPauliSum.GetXWordsAt(t)[0], m_iNumOfQubits) : 0;
+        const uint64_t m_iZMask = (m_iNumOfQubits > 0) ? ReverseLowBits(inPauliSum.GetZWordsAt(t)[0], m_iNumOfQubits) : 0;
+        m_mResult.m_vecEntries[(m_iZMask ^ m_iXMask) * m_iSideLength + m_iZMask] += 
+            ScalarFromComplex<T>(MultiplyByPowerOfI(complex<double>(inPauliSum.GetCoefficientAt(t)), PopCount64(m_iXMask & m_iZMask)), "ComposePauliSum()");
+    }
+
+    InverseFastPauliTransform(m_mResult);
+    return m_mResult;
+}
+
+
+template class CDenseMatrix<float>;
+template class CDenseMatrix<double>;
+template class CDenseMatrix<complex<float> >;
+template class CDenseMatrix<complex<double> >;
+template void MultiplyInto(CDenseMatrix<float> &, const CDenseMatrix<float> &, const CDenseMatrix<float> &);
+template void MultiplyInto(CDenseMatrix<double> &, const CDenseMatrix<double> &, const CDenseMatrix<double> &);
+template void MultiplyInto(CDenseMatrix<complex<float> > &, const CDenseMatrix<complex<float> > &, const CDenseMatrix<complex<float> > &);
+template void MultiplyInto(CDenseMatrix<complex<double> > &, const CDenseMatrix<complex<double> > &, const CDenseMatrix<complex<double> > &);
+
+
+void Goal2Test(unsigned short int inNumOfTests, unsigned short int inBoundParam, unsigned short int inSideLength, bool inWillPrintMatrix)
+/********************************************
+ *       Purpose: Verify that any 2^n x 2^n Hermitian matrix can be 
+ *                decomposed into the Pauli Strings, then composed back.
+ *                   
+ *  Precondition: inSideLength is a power of 2.
+ * Postcondition: N/A
+ *          Note: Only set inWillPrintMatrix to true for small matrices. 
+ *                Matrices and all 4^n coefficients will be print to terminal.
+ *          TODO: - Print out matrices and results to a file rather than the terminal.
+********************************************/ 
+{
+    unsigned short int m_iNumOfSuccDecomp = 0;
+    unsigned short int m_iNumOfUnsuccDecomp = 0;
+    unsigned short int m_iNumOfQubits = GetNumOfQubits(inSideLength, inSideLength, "Goal2Test()");
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Hermitian matrix entries, real and imaginary parts, bounded by the interval: " << "[" << -inBoundParam << ", " << inBoundParam << "]" << endl;
+    cout << "Using " << inSideLength << " x " << inSideLength << " matrices" << endl;
+
+
+    cout << "Performing Tests . . . " << endl;
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        cout << "Test " << i << ": " << endl;
+
+        CMatrix m_mInputMatrix = GenerateHermitianMatrix(inBoundParam, inSideLength);
+        if ( inWillPrintMatrix ) {
+            cout << "Input Hermitian Matrix: " << endl;
+            m_mInputMatrix.PrintMatrix();
+        }
+
+        // Decompose and compose in complex<double>, so large matrices only round once, back to CMatrix.
+        const CDenseMatrix<complex<double> > m_mWideMatrix = CDenseMatrix<complex<double> >(m_mInputMatrix);
+        vector<double> m_vecRealConst = m_mWideMatrix.PauliDecomposition();
+        if ( inWillPrintMatrix ) {
+            // For Example, on 1 qubit: (3I) + (4X) + (5Y) + (-1Z)
+            cout << "Output Decomposition: " << endl;
+            for ( size_t p = 0; p < m_vecRealConst.size(); p++ )
+                cout << (p > 0 ? " + " : "") << "(" << m_vecRealConst.at(p) << PauliStringFromIndex(p, m_iNumOfQubits) << ")";
+            cout << "\n" << endl;
+        }
+        
+        CMatrix m_mComposedMatrix = CDenseMatrix<complex<double> >::ComposeHermitian(m_vecRealConst).ToMatrix();
+        if (m_mInputMatrix == m_mComposedMatrix) {
+            m_iNumOfSuccDecomp++;
+            if ( inWillPrintMatrix ) {
+                cout << "Composed Hermitian Matrix from Decomposition" << endl;
+                m_mComposedMatrix.PrintMatrix();
+            }
+        }
+        else {
+            m_iNumOfUnsuccDecomp++;
+            cout << "Matrices do NOT match." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful Hermitian Matrix Decomposition: " << m_iNumOfSuccDecomp << endl;
+    cout << "  Total Number of UNSUCCESSFUL Hermitian Matrix Decomposition: " << m_iNumOfUnsuccDecomp << endl;
+    cout << "      Percentage of successful Hermitian Matrix Decomposition: " << ( m_iNumOfSuccDecomp / (m_iNumOfSuccDecomp + m_iNumOfUnsuccDecomp) ) * 100 << "%" << endl; 
+}
+
+
+CPauliString::CPauliString()
+/********************************************
+ *       Purpose: Default Pauli String Constructor creates an empty string with 0 qubits.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: N/A
+********************************************/ 
+{
+    m_iNumOfQubits = 0;
+    m_iPhaseExponent = 0;
+}
+
+
+CPauliString::CPauliString(size_t inNumOfQubits)
+/********************************************
+ *       Purpose: Creates the identity Pauli String I @ I @ ... @ I on inNumOfQubits qubits.
+ *  Precondition: N/A
+ * Postcondition: All X and Z bits are 0 and the phase is +1.
+ *          Note: N/A
+********************************************/ 
+{
+    m_iNumOfQubits = inNumOfQubits;
+    m_iPhaseExponent = 0;
+
+    size_t m_iNumOfWords = (inNumOfQubits + 63) / 64;
+    m_vecXWords = vector<uint64_t>(m_iNumOfWords, 0);
+    m_vecZWords = vector<uint64_t>(m_iNumOfWords, 0);
+}
+
+
+CPauliString::CPauliString(string inPauliGroupString)
+/********************************************
+ *       Purpose: Creates a Pauli String from a string of Pauli characters.
+ *                Accepts both "XYZ" and the CPauliAlgebraElement format "X @ Y @ Z".
+ *  Precondition: N/A
+ * Postcondition: Phase is +1.
+ *          Note: Pauli characters are not case sensitive.
+********************************************/ 
+{
+    // Go from "X @ Y @ Z" to "XYZ"
+    inPauliGroupString.erase(std::remove(inPauliGroupString.begin(), inPauliGroupString.end(), '@'), inPauliGroupString.end());
+    inPauliGroupString.erase(std::remove(inPauliGroupString.begin(), inPauliGroupString.end(), ' '), inPauliGroupString.end());
+
+    *this = CPauliString(inPauliGroupString.size());
+
+    for ( size_t q = 0; q < inPauliGroupString.size(); q++ ) {
+        char m_cPauliChar = inPauliGroupString.at(q);
+        if (PauliCharToIndex(m_cPauliChar) < 0) {
+            cout << "CPauliString(string inPauliGroupString) failed because " << "from your input string " << "\"" << inPauliGroupString << "\"" << "," << "\"" << m_cPauliChar << "\"" << " is not valid. " << "Replace " << "\"" << m_cPauliChar << "\"" << " with one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
+            cout << "Exiting Program . . . " << endl;
+            exit(1);
+        }
+        SetPauliAt(q, m_cPauliChar);
+    }
+}
+
+
+CPauliString::CPauliString(const CPauliLiteral &inPauliLiteral)
+/********************************************
+ *       Purpose: Creates a Pauli String from a compile time literal. For Example: CPauliString("XIZY"_pauli)
+ *  Precondition: N/A
+ * Postcondition: Same qubits and phase as inPauliLiteral.
+ *          Note: The literal is already packed, so only its two words are copied.
+********************************************/ 
+{
+    m_iNumOfQubits = inPauliLiteral.GetNumOfQubits();
+    m_iPhaseExponent = inPauliLiteral.GetPhaseExponent();
+
+    size_t m_iNumOfWords = m_iNumOfQubits > 0 ? 1 : 0;
+    m_vecXWords = vector<uint64_t>(m_iNumOfWords, inPauliLiteral.GetXWord());
+    m_vecZWords = vector<uint64_t>(m_iNumOfWords, inPauliLiteral.GetZWord());
+}
+
+
+complex<float> CPauliString::GetPhase() const
+/********************************************
+ *       Purpose: Return the phase i^k of the Pauli String.
+ *  Precondition: N/A
+ * Postcondition: Returns one of the following: { 1, i, -1, -i }
+********************************************/ 
+{
+    return PAULI_PHASES[m_iPhaseExponent];
+}
+
+
+char CPauliString::GetPauliAt(const size_t inQubitIndex) const
+/********************************************
+ *       Purpose: Return the Pauli character acting on qubit inQubitIndex.
+ *  Precondition: inQubitIndex < number of qubits.
+ * Postcondition: Returns one of the following: { 'I', 'X', 'Y', 'Z' }
+********************************************/ 
+{
+    if (inQubitIndex >= m_iNumOfQubits) {
+        cout << "ERROR: GetPauliAt() qubit index " << inQubitIndex << " is out of range for a " << m_iNumOfQubits << " qubit Pauli String." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    bool m_bXBit = (m_vecXWords[inQubitIndex / 64] >> (inQubitIndex % 64)) & 1;
+    bool m_bZBit = (m_vecZWords[inQubitIndex / 64] >> (inQubitIndex % 64)) & 1;
+
+    if (m_bXBit && m_bZBit)
+        return 'Y';
+    else if (m_bXBit)
+        return 'X';
+    else if (m_bZBit)
+        return 'Z';
+    return 'I';
+}
+
+
+void CPauliString::SetPauliAt(const size_t inQubitIndex, const char inPauliChar)
+/********************************************
+ *       Purpose: Replace the Pauli matrix acting on qubit inQubitIndex.
+ *  Precondition: inQubitIndex < number of qubits. 
+ *                inPauliChar is one of the following: { 'I', 'X', 'Y', 'Z' }
+ * Postcondition: Phase is not modified.
+********************************************/ 
+{
+    if (inQubitIndex >= m_iNumOfQubits) {
+        cout << "ERROR: SetPauliAt() qubit index " << inQubitIndex << " is out of range for a " << m_iNumOfQubits << " qubit Pauli String." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    uint64_t m_iBit = uint64_t(1) << (inQubitIndex % 64);
+    uint64_t &m_iXWord = m_vecXWords[inQubitIndex / 64];
+    uint64_t &m_iZWord = m_vecZWords[inQubitIndex / 64];
+    m_iXWord &= ~m_iBit;
+    m_iZWord &= ~m_iBit;
+
+    if (inPauliChar == 'X' || inPauliChar == 'x')
+        m_iXWord |= m_iBit;
+    else if (inPauliChar == 'Z' || inPauliChar == 'z')
+        m_iZWord |= m_iBit;
+    else if (inPauliChar == 'Y' || inPauliChar == 'y') {
+        m_iXWord |= m_iBit;
+        m_iZWord |= m_iBit;
+    }
+    else if (inPauliChar != 'I' && inPauliChar != 'i') {
+        cout << "SetPauliAt() failed because \"" << inPauliChar << "\" is not valid. Use one of the following: { \"I\", \"X\", \"Y\", \"Z\" }" << endl;
+        cout << "Exiting Program . . . " << endl;
+        exit(1);
+    }
+}
+
+
+size_t CPauliString::Weight() const
+/********************************************
+ *       Purpose: Return the number of qubits that are not acted on by I.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    size_t m_iWeight = 0;
+    for ( size_t w = 0; w < m_vecXWords.size(); w++ )
+        m_iWeight += PopCount64(m_vecXWords[w] | m_vecZWords[w]);
+
+    return m_iWeight;
+}
+
+
+bool CPauliString::CommutesWith(const CPauliString &inPauli2) const
+/********************************************
+ *       Purpose: Return true if both Pauli Strings commute.
+ *                Two Pauli Strings anticommute when an odd number of qubits 
+ *                hold anticommuting Pauli matrices, i.e. when the symplectic product 
+ *                popcount( (x1 & z2) ^ (z1 & x2) ) is odd.
+ *  Precondition: Both Pauli Strings act on the same number of qubits.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (m_iNumOfQubits != inPauli2.m_iNumOfQubits) {
+        cout << "ERROR: CommutesWith() Pauli Strings do not match in size: " << m_iNumOfQubits << " and " << inPauli2.m_iNumOfQubits << " qubits." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    unsigned int m_iSymplecticProduct = 0;
+    for ( size_t w = 0; w < m_vecXWords.size(); w++ )
+        m_iSymplecticProduct += PopCount64((m_vecXWords[w] & inPauli2.m_vecZWords[w]) ^ (m_vecZWords[w] & inPauli2.m_vecXWords[w]));
+
+    return (m_iSymplecticProduct & 1) == 0;
+}
+
+
+bool CPauliString::operator==(const CPauliString &inPauli2) const
+/********************************************
+ *       Purpose: Return true if both Pauli Strings have the same qubits, Pauli matrices and phase.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    return m_iNumOfQubits == inPauli2.m_iNumOfQubits && m_iPhaseExponent == inPauli2.m_iPhaseExponent &&
+           m_vecXWords == inPauli2.m_vecXWords && m_vecZWords == inPauli2.m_vecZWords;
+}
+
+
+CPauliString CPauliString::operator*(const CPauliString &inPauli2) const
+/********************************************
+ *       Purpose: Multiply two Pauli Strings then return the resulting Pauli String.
+ *                For Example, (Z @ X) * (Z @ Y) = i(I @ Z)
+ *  Precondition: Both Pauli Strings act on the same number of qubits.
+ * Postcondition: N/A
+ *          Note: See operator*=()
+********************************************/ 
+{
+    CPauliString m_psResult = *this;
+    m_psResult *= inPauli2;
+    return m_psResult;
+}
+
+
+void CPauliString::operator*=(const CPauliString &inPauli2)
+/********************************************
+ *       Purpose: Replace this Pauli String with the product between this 
+ *                Pauli String and the input Pauli String.
+ * 
+ *                Writing each qubit as P(x, z) = i^(x z) X^x Z^z gives
+ *                P(x1, z1) P(x2, z2) = i^(x1 z1 + x2 z2 + 2 z1 x2 - x3 z3) P(x3, z3)
+ *                where x3 = x1 ^ x2 and z3 = z1 ^ z2. 
+ *                Summing that exponent over all qubits is four popcounts per word.
+ * 
+ *  Precondition: Both Pauli Strings act on the same number of qubits.
+ * Postcondition: No matrix is allocated. Runs in O(n / 64).
+********************************************/ 
+{
+    if (m_iNumOfQubits != inPauli2.m_iNumOfQubits) {
+        cout << "Multiplying Pauli Strings Failed. Pauli Strings do not match in size: " << m_iNumOfQubits << " and " << inPauli2.m_iNumOfQubits << " qubits." << endl;
+        exit(1);
+    }
+
+    int64_t m_iExponent = int64_t(m_iPhaseExponent) + int64_t(inPauli2.m_iPhaseExponent);
+    for ( size_t w = 0; w < m_vecXWords.size(); w++ ) {
+        uint64_t m_iX1 = m_vecXWords[w];
+        uint64_t m_iZ1 = m_vecZWords[w];
+        uint64_t m_iX2 = inPauli2.m_vecXWords[w];
+        uint64_t m_iZ2 = inPauli2.m_vecZWords[w];
+        uint64_t m_iX3 = m_iX1 ^ m_iX2;
+        uint64_t m_iZ3 = m_iZ1 ^ m_iZ2;
+
+        m_iExponent += int64_t(PopCount64(m_iX1 & m_iZ1)) + int64_t(PopCount64(m_iX2 & m_iZ2)) 
+                     + 2 * int64_t(PopCount64(m_iZ1 & m_iX2)) - int64_t(PopCount64(m_iX3 & m_iZ3));
+
+        m_vecXWords[w] = m_iX3;
+        m_vecZWords[w] = m_iZ3;
+    }
+
+    // Two's complement keeps & 3 correct for negative exponents.
+    m_iPhaseExponent = (unsigned short int) (m_iExponent & 3);
+}
+
+
+CPauliString MultiplyPauliString(const CPauliString &inPauli1, const CPauliString &inPauli2)
+/********************************************
+ *       Purpose: Multiply first Pauli String with second Pauli String.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    return inPauli1 * inPauli2;
+}
+
+
+bool PauliStringsCommute(const CPauliString &inPauli1, const CPauliString &inPauli2)
+/********************************************
+ *       Purpose: Return true if first Pauli String commutes with second Pauli String.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    return inPauli1.CommutesWith(inPauli2);
+}
+
+
+uint64_t CPauliString::GetXMask() const
+/********************************************
+ *       Purpose: Return the X bits as a basis state mask.
+ *                X^x maps basis state |r> to |r ^ x>.
+ *  Precondition: At most 64 qubits.
+ * Postcondition: Bit n - 1 - q is the X bit of qubit q, matching the row index of ToPauliAlgebraElement().
+********************************************/ 
+{
+    if (m_iNumOfQubits > 64) {
+        cout << "ERROR: GetXMask() only supports up to 64 qubits, but the Pauli String has " << m_iNumOfQubits << " qubits." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    return m_iNumOfQubits == 0 ? 0 : ReverseLowBits(m_vecXWords[0], m_iNumOfQubits);
+}
+
+
+uint64_t CPauliString::GetZMask() const
+/********************************************
+ *       Purpose: Return the Z bits as a basis state mask.
+ *                Z^z maps basis state |r> to (-1)^popcount(r & z) |r>.
+ *  Precondition: At most 64 qubits.
+ * Postcondition: Bit n - 1 - q is the Z bit of qubit q, matching the row index of ToPauliAlgebraElement().
+********************************************/ 
+{
+    if (m_iNumOfQubits > 64) {
+        cout << "ERROR: GetZMask() only supports up to 64 qubits, but the Pauli String has " << m_iNumOfQubits << " qubits." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    return m_iNumOfQubits == 0 ? 0 : ReverseLowBits(m_vecZWords[0], m_iNumOfQubits);
+}
+
+
+string CPauliString::PauliStringToString() const
+/********************************************
+ *       Purpose: Returns Pauli String representation.
+ *                For Example, -i(X @ Y @ Z) returns "-iXYZ". 
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    const string m_arrsPhases[4] = { "", "i", "-", "-i" };
+    string m_sResult = m_arrsPhases[m_iPhaseExponent];
+
+    for ( size_t q = 0; q < m_iNumOfQubits; q++ )
+        m_sResult += GetPauliAt(q);
+
+    return m_sResult;
+}
+
+
+CPauliAlgebraElement CPauliString::ToPauliAlgebraElement() const
+/********************************************
+ *       Purpose: Returns the dense PauliAlgebraElement object for this Pauli String, 
+ *                including its phase.
+ *  Precondition: At least 1 qubit.
+ * Postcondition: N/A
+ *          Note: Allocates a 2^n x 2^n matrix. Only use for small n.
+********************************************/ 
+{
+    string m_sPauliGroupString = PauliStringToString();
+    m_sPauliGroupString.erase(0, m_sPauliGroupString.size() - m_iNumOfQubits); // Strip the phase.
+
+    CPauliAlgebraElement m_paeResult = MakePauliAlgebraElement(m_sPauliGroupString);
+    if (m_iPhaseExponent != 0)
+        MultiplyPauliAlgebraByScalar(GetPhase(), m_paeResult);
+
+    return m_paeResult;
+}
+
+
+void TestMultiplyPauliString(const string &inPauliString1, const string &inPauliString2)
+/********************************************
+ *       Purpose: Test CPauliString multiplication and commutation against 
+ *                the dense matrices of both Pauli Strings.
+ *  Precondition: Both input strings have the same number of Pauli characters.
+ * Postcondition: N/A
+********************************************/ 
+{
+    CPauliString m_psPauli1 = CPauliString(inPauliString1);
+    CPauliString m_psPauli2 = CPauliString(inPauliString2);
+    CPauliString m_psProduct = m_psPauli1 * m_psPauli2;
+    bool m_bCommutes = m_psPauli1.CommutesWith(m_psPauli2);
+
+    cout << m_psPauli1.PauliStringToString() << "   *   " << m_psPauli2.PauliStringToString() << " = " << m_psProduct.PauliStringToString() << endl;
+    cout << m_psPauli1.PauliStringToString() << " and " << m_psPauli2.PauliStringToString() << (m_bCommutes ? " commute." : " anticommute.") << endl;
+
+    // Dense reference: P1 * P2 and P2 * P1.
+    CMatrix m_mLeftRight = m_psPauli1.ToPauliAlgebraElement();
+    m_mLeftRight.MatrixMultiply(m_psPauli2.ToPauliAlgebraElement());
+    CMatrix m_mRightLeft = m_psPauli2.ToPauliAlgebraElement();
+    m_mRightLeft.MatrixMultiply(m_psPauli1.ToPauliAlgebraElement());
+
+    CMatrix m_mProduct = m_psProduct.ToPauliAlgebraElement();
+    if (m_mProduct == m_mLeftRight)
+        cout << "Product matches the dense matrix product." << endl;
+    else
+        cout << "Product does NOT match the dense matrix product." << endl;
+
+    if (m_bCommutes == (m_mLeftRight == m_mRightLeft))
+        cout << "Commutation matches the dense matrix products." << endl;
+    else
+        cout << "Commutation does NOT match the dense matrix products." << endl;
+}
+
+
+void TestPauliStringScaling(const size_t inNumOfQubits, const unsigned short int inNumOfTests)
+/********************************************
+ *       Purpose: Multiply random Pauli Strings on many qubits, far past what 
+ *                a dense 2^n x 2^n matrix could hold, and verify that 
+ *                (P1 * P2) * P2 = P1 and that P1 * P2 = +/- P2 * P1.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> pauli_distribution(0, 3);
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using " << inNumOfQubits << " qubit Pauli Strings" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        CPauliString m_psPauli1 = CPauliString(inNumOfQubits);
+        CPauliString m_psPauli2 = CPauliString(inNumOfQubits);
+        for ( size_t q = 0; q < inNumOfQubits; q++ ) {
+            m_psPauli1.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+            m_psPauli2.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+        }
+
+        // Pauli Strings with phase +1 are Hermitian, so P2 * P2 = I.
+        CPauliString m_psRoundTrip = (m_psPauli1 * m_psPauli2) * m_psPauli2;
+
+        // P1 * P2 and P2 * P1 share Pauli matrices. Their phases differ by -1 exactly when they anticommute.
+        CPauliString m_psLeftRight = m_psPauli1 * m_psPauli2;
+        CPauliString m_psRightLeft = m_psPauli2 * m_psPauli1;
+        unsigned short int m_iPhaseDifference = (m_psLeftRight.GetPhaseExponent() + 4 - m_psRightLeft.GetPhaseExponent()) & 3;
+        m_psRightLeft.SetPhaseExponent(m_psLeftRight.GetPhaseExponent());
+        bool m_bPhaseIsConsistent = m_psPauli1.CommutesWith(m_psPauli2) ? m_iPhaseDifference == 0 : m_iPhaseDifference == 2;
+
+        if (m_psRoundTrip == m_psPauli1 && m_psLeftRight == m_psRightLeft && m_bPhaseIsConsistent)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": Pauli String products do NOT match." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful Pauli String products: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL Pauli String products: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+static const size_t EMPTY_SLOT = (size_t) -1;
+
+
+static inline uint64_t HashPauliWords(const uint64_t *inXWords, const uint64_t *inZWords, const size_t inNumOfWords)
+/********************************************
+ *       Purpose: Hash the packed X and Z words of a Pauli String.
+ *  Precondition: N/A
+ * Postcondition: N/A
+ *          Note: Each word is mixed with the splitmix64 finalizer.
+********************************************/ 
+{
+    uint64_t m_iHash = 0x9E3779B97F4A7C15ULL ^ inNumOfWords;
+    for ( size_t w = 0; w < 2 * inNumOfWords; w++ ) {
+        uint64_t m_iWord = (w < inNumOfWords) ? inXWords[w] : inZWords[w - inNumOfWords];
+        m_iHash ^= m_iWord + 0x9E3779B97F4A7C15ULL + (m_iHash << 6) + (m_iHash >> 2);
+        m_iHash ^= m_iHash >> 30;
+        m_iHash *= 0xBF58476D1CE4E5B9ULL;
+        m_iHash ^= m_iHash >> 27;
+        m_iHash *= 0x94D049BB133111EBULL;
+        m_iHash ^= m_iHash >> 31;
+    }
+
+    return m_iHash;
+}
+
+
+CPauliSum::CPauliSum()
+/********************************************
+ *       Purpose: Default Pauli Sum Constructor creates an empty sum. 
+ *                The number of qubits is taken from the first term added.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    m_iNumOfQubits = 0;
+    m_iNumOfWords = 0;
+}
+
+
+CPauliSum::CPauliSum(size_t inNumOfQubits)
+/********************************************
+ *       Purpose: Creates an empty sum of inNumOfQubits qubit Pauli Strings.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    m_iNumOfQubits = inNumOfQubits;
+    m_iNumOfWords = (inNumOfQubits + 63) / 64;
+}
+
+
+CPauliSum::CPauliSum(const vector<CPauliString> &inPauliStrings, const vector<complex<float>> &inCoefficients) : CPauliSum()
+/********************************************
+ *       Purpose: Bulk construct a Pauli Sum from a term array. 
+ *                Term t is inCoefficients[t] * inPauliStrings[t]. Like terms are merged.
+ *  Precondition: Both input vectors have the same size. 
+ *                All Pauli Strings act on the same number of qubits.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (inPauliStrings.size() != inCoefficients.size()) {
+        cout << "ERROR: CPauliSum() was given " << inPauliStrings.size() << " Pauli Strings but " << inCoefficients.size() << " coefficients." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    if (!inPauliStrings.empty())
+        *this = CPauliSum(inPauliStrings.front().GetNumOfQubits());
+
+    Reserve(inPauliStrings.size());
+    for ( size_t t = 0; t < inPauliStrings.size(); t++ )
+        AddTerm(inPauliStrings[t], inCoefficients[t]);
+}
+
+
+CPauliSum::CPauliSum(size_t inNumOfQubits, const vector<uint64_t> &inXWords, const vector<uint64_t> &inZWords, const vector<complex<float>> &inCoefficients) : CPauliSum(inNumOfQubits)
+/********************************************
+ *       Purpose: Bulk construct a Pauli Sum from packed term arrays.
+ *                Term t owns words [t W, (t + 1) W) of inXWords and inZWords
+ *                where W = (inNumOfQubits + 63) / 64. Like terms are merged.
+ *  Precondition: inXWords and inZWords hold W words per coefficient. 
+ *                Bits past inNumOfQubits are 0.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (inXWords.size() != inCoefficients.size() * m_iNumOfWords || inZWords.size() != inCoefficients.size() * m_iNumOfWords) {
+        cout << "ERROR: CPauliSum() packed term arrays do not hold " << m_iNumOfWords << " words for each of the " << inCoefficients.size() << " coefficients." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    Reserve(inCoefficients.size());
+    for ( size_t t = 0; t < inCoefficients.size(); t++ )
+        AddPackedTerm(&inXWords[t * m_iNumOfWords], &inZWords[t * m_iNumOfWords], inCoefficients[t]);
+}
+
+
+CPauliString CPauliSum::GetPauliStringAt(const size_t inTermIndex) const
+/********************************************
+ *       Purpose: Return the Pauli String of term inTermIndex with phase +1.
+ *  Precondition: inTermIndex < number of terms.
+ * Postcondition: N/A
+********************************************/ 
+{
+    CPauliString m_psResult = CPauliString(m_iNumOfQubits);
+    const uint64_t *m_pXWords = GetXWordsAt(inTermIndex);
+    const uint64_t *m_pZWords = GetZWordsAt(inTermIndex);
+
+    for ( size_t q = 0; q < m_iNumOfQubits; q++ ) {
+        bool m_bXBit = (m_pXWords[q / 64] >> (q % 64)) & 1;
+        bool m_bZBit = (m_pZWords[q / 64] >> (q % 64)) & 1;
+        m_psResult.SetPauliAt(q, m_bXBit ? (m_bZBit ? 'Y' : 'X') : (m_bZBit ? 'Z' : 'I'));
+    }
+
+    return m_psResult;
+}
+
+
+complex<float> CPauliSum::GetCoefficient(const CPauliString &inPauli) const
+/********************************************
+ *       Purpose: Return the coefficient in front of the input Pauli String. 
+ *                Returns 0 if the Pauli String is not a term of the sum.
+ *  Precondition: N/A
+ * Postcondition: The phase of the input Pauli String is divided out.
+********************************************/ 
+{
+    if (inPauli.GetNumOfQubits() != m_iNumOfQubits || m_vecSlots.empty())
+        return complex<float>(0, 0);
+
+    const uint64_t *m_pXWords = inPauli.GetXWords().data();
+    const uint64_t *m_pZWords = inPauli.GetZWords().data();
+    size_t m_iSlot = FindSlot(m_pXWords, m_pZWords, HashPauliWords(m_pXWords, m_pZWords, m_iNumOfWords));
+    if (m_vecSlots[m_iSlot] == EMPTY_SLOT)
+        return complex<float>(0, 0);
+
+    // c i^k P = c' P  gives  c = c' i^-k = c' conj(i^k)
+    return m_vecCoefficients[m_vecSlots[m_iSlot]] * conj(inPauli.GetPhase());
+}
+
+
+void CPauliSum::Reserve(const size_t inNumOfTerms)
+/********************************************
+ *       Purpose: Make room for inNumOfTerms terms so bulk insertion never rehashes.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    m_vecTermWords.reserve(2 * inNumOfTerms * m_iNumOfWords);
+    m_vecCoefficients.reserve(inNumOfTerms);
+    m_vecTermHashes.reserve(inNumOfTerms);
+
+    // Keep the load factor at or below 1 / 2.
+    size_t m_iNumOfSlots = 16;
+    while (m_iNumOfSlots < 2 * inNumOfTerms)
+        m_iNumOfSlots *= 2;
+
+    if (m_iNumOfSlots > m_vecSlots.size())
+        Rehash(m_iNumOfSlots);
+}
+
+
+void CPauliSum::AddTerm(const CPauliString &inPauli, const complex<float> inCoefficient)
+/********************************************
+ *       Purpose: Add inCoefficient * inPauli to the sum. 
+ *                Merges with an existing like term in O(1) amortized.
+ *  Precondition: inPauli acts on the same number of qubits as the sum.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (m_iNumOfQubits == 0 && m_vecCoefficients.empty())
+        *this = CPauliSum(inPauli.GetNumOfQubits());
+
+    if (inPauli.GetNumOfQubits() != m_iNumOfQubits) {
+        cout << "Adding Pauli Sum term Failed. Pauli String has " << inPauli.GetNumOfQubits() << " qubits but the sum has " << m_iNumOfQubits << " qubits." << endl;
+        exit(1);
+    }
+
+    AddPackedTerm(inPauli.GetXWords().data(), inPauli.GetZWords().data(), inCoefficient * inPauli.GetPhase());
+}
+
+
+void CPauliSum::AddPackedTerm(const uint64_t *inXWords, const uint64_t *inZWords, const complex<float> inCoefficient)
+/********************************************
+ *       Purpose: Add inCoefficient * P(inXWords, inZWords) to the sum. 
+ *  Precondition: Both inputs hold m_iNumOfWords words.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (2 * (m_vecCoefficients.size() + 1) > m_vecSlots.size())
+        Rehash(m_vecSlots.empty() ? 16 : 2 * m_vecSlots.size());
+
+    uint64_t m_iHash = HashPauliWords(inXWords, inZWords, m_iNumOfWords);
+    size_t m_iSlot = FindSlot(inXWords, inZWords, m_iHash);
+
+    // Like term. For Example: 2XZ + 3XZ = 5XZ
+    if (m_vecSlots[m_iSlot] != EMPTY_SLOT) {
+        m_vecCoefficients[m_vecSlots[m_iSlot]] += inCoefficient;
+        return;
+    }
+
+    // New term.
+    m_vecSlots[m_iSlot] = m_vecCoefficients.size();
+    m_vecTermWords.insert(m_vecTermWords.end(), inXWords, inXWords + m_iNumOfWords);
+    m_vecTermWords.insert(m_vecTermWords.end(), inZWords, inZWords + m_iNumOfWords);
+    m_vecCoefficients.push_back(inCoefficient);
+    m_vecTermHashes.push_back(m_iHash);
+}
+
+
+size_t CPauliSum::FindSlot(const uint64_t *inXWords, const uint64_t *inZWords, const uint64_t inHash) const
+/********************************************
+ *       Purpose: Linear probe for the slot holding the input key, 
+ *                or the empty slot where it would be inserted.
+ *  Precondition: The table is not empty and has at least one empty slot.
+ * Postcondition: N/A
+********************************************/ 
+{
+    size_t m_iMask = m_vecSlots.size() - 1;
+    size_t m_iSlot = inHash & m_iMask;
+
+    while (m_vecSlots[m_iSlot] != EMPTY_SLOT) {
+        size_t m_iTerm = m_vecSlots[m_iSlot];
+        if (m_vecTermHashes[m_iTerm] == inHash &&
+            equal(inXWords, inXWords + m_iNumOfWords, GetXWordsAt(m_iTerm)) &&
+            equal(inZWords, inZWords + m_iNumOfWords, GetZWordsAt(m_iTerm)))
+            return m_iSlot;
+        m_iSlot = (m_iSlot + 1) & m_iMask;
+    }
+
+    return m_iSlot;
+}
+
+
+void CPauliSum::Rehash(const size_t inNumOfSlots)
+/********************************************
+ *       Purpose: Rebuild the hash table with inNumOfSlots slots from the stored term hashes.
+ *  Precondition: inNumOfSlots is a power of 2 larger than twice the number of terms.
+ * Postcondition: Terms and their order are not modified.
+********************************************/ 
+{
+    m_vecSlots.assign(inNumOfSlots, EMPTY_SLOT);
+
+    size_t m_iMask = inNumOfSlots - 1;
+    for ( size_t t = 0; t < m_vecTermHashes.size(); t++ ) {
+        size_t m_iSlot = m_vecTermHashes[t] & m_iMask;
+        while (m_vecSlots[m_iSlot] != EMPTY_SLOT)
+            m_iSlot = (m_iSlot + 1) & m_iMask;
+        m_vecSlots[m_iSlot] = t;
+    }
+}
+
+
+void CPauliSum::RemoveZeroTerms(const float inTolerance)
+/********************************************
+ *       Purpose: Remove terms whose coefficient magnitude is at most inTolerance. 
+ *                For Example: 2XZ - 2XZ leaves a 0XZ term until this is called.
+ *  Precondition: N/A
+ * Postcondition: Order of the remaining terms is not modified.
+********************************************/ 
+{
+    size_t m_iNumOfKeptTerms = 0;
+    for ( size_t t = 0; t < m_vecCoefficients.size(); t++ ) {
+        if (abs(m_vecCoefficients[t]) <= inTolerance)
+            continue;
+
+        if (m_iNumOfKeptTerms != t) {
+            copy(GetXWordsAt(t), GetXWordsAt(t) + 2 * m_iNumOfWords, m_vecTermWords.begin() + 2 * m_iNumOfKeptTerms * m_iNumOfWords);
+            m_vecCoefficients[m_iNumOfKeptTerms] = m_vecCoefficients[t];
+            m_vecTermHashes[m_iNumOfKeptTerms] = m_vecTermHashes[t];
+        }
+        m_iNumOfKeptTerms++;
+    }
+
+    m_vecTermWords.resize(2 * m_iNumOfKeptTerms * m_iNumOfWords);
+    m_vecCoefficients.resize(m_iNumOfKeptTerms);
+    m_vecTermHashes.resize(m_iNumOfKeptTerms);
+    Rehash(m_vecSlots.empty() ? 16 : m_vecSlots.size());
+}
+
+
+CPauliSum CPauliSum::operator+(const CPauliSum &inPauliSum2) const
+/********************************************
+ *       Purpose: Return the sum of two Pauli Sums. Like terms are merged.
+ *                For Example: (2XZ + YY) + (3XZ - ZZ) = 5XZ + YY - ZZ
+ *  Precondition: Both Pauli Sums act on the same number of qubits.
+ * Postcondition: N/A
+********************************************/ 
+{
+    CPauliSum m_psumResult = *this;
+    m_psumResult += inPauliSum2;
+    return m_psumResult;
+}
+
+
+CPauliSum CPauliSum::operator-(const CPauliSum &inPauliSum2) const
+/********************************************
+ *       Purpose: Return the difference of two Pauli Sums. Like terms are merged.
+ *  Precondition: Both Pauli Sums act on the same number of qubits.
+ * Postcondition: N/A
+********************************************/ 
+{
+    CPauliSum m_psumResult = *this;
+    m_psumResult -= inPauliSum2;
+    return m_psumResult;
+}
+
+
+CPauliSum CPauliSum::operator*(const complex<float> &inZ) const
+/********************************************
+ *       Purpose: Return the Pauli Sum with every coefficient multiplied by a scalar.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    CPauliSum m_psumResult = *this;
+    m_psumResult *= inZ;
+    return m_psumResult;
+}
+
+
+CPauliSum operator*(const complex<float> &inZ, const CPauliSum &inPauliSum)
+/********************************************
+ *       Purpose: Return the Pauli Sum with every coefficient multiplied by a scalar.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    return inPauliSum * inZ;
+}
+
+
+void CPauliSum::operator+=(const CPauliSum &inPauliSum2)
+/********************************************
+ *       Purpose: Add every term of the input Pauli Sum to this Pauli Sum.
+ *  Precondition: Both Pauli Sums act on the same number of qubits.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (m_iNumOfQubits == 0 && m_vecCoefficients.empty())
+        *this = CPauliSum(inPauliSum2.m_iNumOfQubits);
+
+    if (m_iNumOfQubits != inPauliSum2.m_iNumOfQubits) {
+        cout << "Adding Pauli Sums Failed. Pauli Sums do not match in size: " << m_iNumOfQubits << " and " << inPauliSum2.m_iNumOfQubits << " qubits." << endl;
+        exit(1);
+    }
+
+    Reserve(m_vecCoefficients.size() + inPauliSum2.GetNumOfTerms());
+    for ( size_t t = 0; t < inPauliSum2.GetNumOfTerms(); t++ )
+        AddPackedTerm(inPauliSum2.GetXWordsAt(t), inPauliSum2.GetZWordsAt(t), inPauliSum2.m_vecCoefficients[t]);
+}
+
+
+void CPauliSum::operator-=(const CPauliSum &inPauliSum2)
+/********************************************
+ *       Purpose: Subtract every term of the input Pauli Sum from this Pauli Sum.
+ *  Precondition: Both Pauli Sums act on the same number of qubits.
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (m_iNumOfQubits == 0 && m_vecCoefficients.empty())
+        *this = CPauliSum(inPauliSum2.m_iNumOfQubits);
+
+    if (m_iNumOfQubits != inPauliSum2.m_iNumOfQubits) {
+        cout << "Subtracting Pauli Sums Failed. Pauli Sums do not match in size: " << m_iNumOfQubits << " and " << inPauliSum2.m_iNumOfQubits << " qubits." << endl;
+        exit(1);
+    }
+
+    Reserve(m_vecCoefficients.size() + inPauliSum2.GetNumOfTerms());
+    for ( size_t t = 0; t < inPauliSum2.GetNumOfTerms(); t++ )
+        AddPackedTerm(inPauliSum2.GetXWordsAt(t), inPauliSum2.GetZWordsAt(t), -inPauliSum2.m_vecCoefficients[t]);
+}
+
+
+void CPauliSum::operator*=(const complex<float> &inZ)
+/********************************************
+ *       Purpose: Multiply every coefficient by a scalar. The scalar may be a complex number.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    for ( size_t t = 0; t < m_vecCoefficients.size(); t++ )
+        m_vecCoefficients[t] *= inZ;
+}
+
+
+string CPauliSum::PauliSumToString() const
+/********************************************
+ *       Purpose: Returns the Pauli Sum as a string. 
+ *                For Example "(0.5,0)XX + (0.5,0)YY + (-1,0)ZI"
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (m_vecCoefficients.empty())
+        return "0";
+
+    ostringstream m_ssResult;
+    for ( size_t t = 0; t < m_vecCoefficients.size(); t++ ) {
+        if (t > 0)
+            m_ssResult << " + ";
+        m_ssResult << m_vecCoefficients[t] << GetPauliStringAt(t).PauliStringToString();
+    }
+
+    return m_ssResult.str();
+}
+
+
+void TestPauliSum()
+/********************************************
+ *       Purpose: Test Pauli Sum addition, subtraction, scaling and like term merging.
+ *                H1 = 0.5XX + 0.5YY - ZI
+ *                H2 = -0.5XX + 2ZZ + iYY
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    CPauliSum m_psumH1 = CPauliSum(vector<CPauliString>{ CPauliString("XX"), CPauliString("YY"), CPauliString("ZI") }, 
+                                   vector<complex<float>>{ complex<float>(0.5, 0), complex<float>(0.5, 0), complex<float>(-1, 0) });
+    CPauliSum m_psumH2 = CPauliSum(vector<CPauliString>{ CPauliString("XX"), CPauliString("ZZ"), CPauliString("YY") }, 
+                                   vector<complex<float>>{ complex<float>(-0.5, 0), complex<float>(2, 0), complex<float>(0, 1) });
+    cout << "H1 = " << m_psumH1.PauliSumToString() << endl;
+    cout << "H2 = " << m_psumH2.PauliSumToString() << endl;
+
+    CPauliSum m_psumSum = m_psumH1 + m_psumH2;
+    cout << "H1 + H2 = " << m_psumSum.PauliSumToString() << endl;
+    m_psumSum.RemoveZeroTerms();
+    cout << "H1 + H2 without zero terms = " << m_psumSum.PauliSumToString() << endl;
+
+    CPauliSum m_psumDifference = m_psumH1 - m_psumH1;
+    m_psumDifference.RemoveZeroTerms();
+    cout << "H1 - H1 = " << m_psumDifference.PauliSumToString() << endl;
+
+    CPauliSum m_psumScaled = complex<float>(0, 2) * m_psumH1;
+    cout << "2i * H1 = " << m_psumScaled.PauliSumToString() << endl;
+
+    // The phase of -iZZ is folded into its coefficient: 3(-iZZ) = -3iZZ
+    CPauliString m_psPhasedZZ = CPauliString("ZZ");
+    m_psPhasedZZ.SetPhaseExponent(3);
+    m_psumH1.AddTerm(m_psPhasedZZ, complex<float>(3, 0));
+    cout << "H1 + 3(-iZZ) = " << m_psumH1.PauliSumToString() << endl;
+
+    bool m_bIsCorrect = m_psumSum.GetNumOfTerms() == 3 &&
+                        m_psumSum.GetCoefficient(CPauliString("XX")) == complex<float>(0, 0) &&
+                        m_psumSum.GetCoefficient(CPauliString("YY")) == complex<float>(0.5, 1) &&
+                        m_psumSum.GetCoefficient(CPauliString("ZZ")) == complex<float>(2, 0) &&
+                        m_psumDifference.GetNumOfTerms() == 0 &&
+                        m_psumScaled.GetCoefficient(CPauliString("ZI")) == complex<float>(0, -2) &&
+                        m_psumH1.GetCoefficient(CPauliString("ZZ")) == complex<float>(0, -3) &&
+                        m_psumH1.GetCoefficient(m_psPhasedZZ) == complex<float>(3, 0);
+
+    if (m_bIsCorrect)
+        cout << "All Pauli Sum coefficients are correct." << endl;
+    else
+        cout << "Pauli Sum coefficients are NOT correct." << endl;
+}
+
+
+void TestPauliSumMerging(const size_t inNumOfQubits, const size_t inNumOfTerms)
+/********************************************
+ *       Purpose: Bulk construct a large random Pauli Sum, then verify that 
+ *                H + H doubles every coefficient and H - H cancels every term.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<uint64_t> word_distribution;
+    uniform_int_distribution<int> coefficient_distribution(-10, 10);
+
+    size_t m_iNumOfWords = (inNumOfQubits + 63) / 64;
+    uint64_t m_iLastWordMask = (inNumOfQubits % 64 == 0) ? ~uint64_t(0) : (uint64_t(1) << (inNumOfQubits % 64)) - 1;
+
+    vector<uint64_t> m_vecXWords(inNumOfTerms * m_iNumOfWords);
+    vector<uint64_t> m_vecZWords(inNumOfTerms * m_iNumOfWords);
+    vector<complex<float>> m_vecCoefficients(inNumOfTerms);
+    for ( size_t t = 0; t < inNumOfTerms; t++ ) {
+        for ( size_t w = 0; w < m_iNumOfWords; w++ ) {
+            uint64_t m_iMask = (w + 1 == m_iNumOfWords) ? m_iLastWordMask : ~uint64_t(0);
+            m_vecXWords[t * m_iNumOfWords + w] = word_distribution(generator) & m_iMask;
+            m_vecZWords[t * m_iNumOfWords + w] = word_distribution(generator) & m_iMask;
+        }
+        m_vecCoefficients[t] = complex<float>(coefficient_distribution(generator), coefficient_distribution(generator));
+    }
+
+    cout << "Bulk constructing a Pauli Sum with " << inNumOfTerms << " random " << inNumOfQubits << " qubit terms . . ." << endl;
+    chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+    CPauliSum m_psumH = CPauliSum(inNumOfQubits, m_vecXWords, m_vecZWords, m_vecCoefficients);
+    CPauliSum m_psumDoubled = m_psumH + m_psumH;
+    CPauliSum m_psumCancelled = m_psumH - m_psumH;
+    m_psumCancelled.RemoveZeroTerms();
+    chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+
+    bool m_bIsCorrect = m_psumDoubled.GetNumOfTerms() == m_psumH.GetNumOfTerms() && m_psumCancelled.GetNumOfTerms() == 0;
+    for ( size_t t = 0; t < m_psumH.GetNumOfTerms() && m_bIsCorrect; t++ )
+        m_bIsCorrect = m_psumDoubled.GetCoefficientAt(t) == complex<float>(2, 0) * m_psumH.GetCoefficientAt(t);
+
+    cout << "Distinct terms: " << m_psumH.GetNumOfTerms() << endl;
+    cout << "Construction, H + H and H - H took " << m_tElapsed.count() << " seconds." << endl;
+    if (m_bIsCorrect)
+        cout << "H + H doubled every coefficient and H - H cancelled every term." << endl;
+    else
+        cout << "Pauli Sum merging is NOT correct." << endl;
+}
+
+
+void TestPauliDecomposition(const unsigned short int inNumOfQubits, const unsigned short int inNumOfTests, const unsigned short int inBoundParam)
+/********************************************
+ *       Purpose: Verify PauliCoefficients() against the trace formula 
+ *                c_P = (1 / 2^n) Tr(P M) for random Hermitian and random general matrices, 
+ *                verify that PauliDecompositionSparse() drops small coefficients, 
+ *                and verify that ComposePauliCoefficients() and ComposePauliSum() invert them.
+ *  Precondition: Keep inNumOfQubits small. The trace formula, through TraceWithPauli(), is O(8^n).
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> matrix_entry_distribution(-inBoundParam/2, inBoundParam/2);
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+    const unsigned short int m_iSideLength = 1 << inNumOfQubits;
+    const float m_fDropTolerance = inBoundParam / 4.0f;
+
+    unsigned short int m_iNumOfSuccDecomp = 0;
+    unsigned short int m_iNumOfUnsuccDecomp = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using " << m_iSideLength << " x " << m_iSideLength << " matrices" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        CMatrix m_mGeneralMatrix = CMatrix(m_iSideLength, m_iSideLength);
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                m_mGeneralMatrix.ModifyValueAt(r, c, complex<float>(matrix_entry_distribution(generator), matrix_entry_distribution(generator)));
+        }
+
+        CMatrix m_arrmInputs[2] = { GenerateHermitianMatrix(inBoundParam, m_iSideLength), m_mGeneralMatrix };
+        bool m_bIsCorrect = true;
+
+        for ( unsigned short int m = 0; m < 2; m++ ) {
+            vector<complex<float>> m_vecCoefficients = m_arrmInputs[m].PauliCoefficients();
+            size_t m_iNumOfLargeCoefficients = 0;
+
+            for ( size_t p = 0; p < m_vecCoefficients.size(); p++ ) {
+                string m_sPauliGroupString;
+                for ( unsigned short int q = 0; q < inNumOfQubits; q++ )
+                    m_sPauliGroupString += m_arrcPauliChars[(p >> (2 * (inNumOfQubits - 1 - q))) & 3];
+
+                complex<float> m_cxExpected = TraceWithPauli(m_arrmInputs[m], CPauliString(m_sPauliGroupString)) / float(m_iSideLength);
+
+                if (abs(m_cxExpected - m_vecCoefficients[p]) > 1e-4f * max(1.0f, abs(m_cxExpected)))
+                    m_bIsCorrect = false;
+                if (abs(m_vecCoefficients[p]) > m_fDropTolerance)
+                    m_iNumOfLargeCoefficients++;
+            }
+
+            if (m_arrmInputs[m].PauliDecompositionSparse(m_fDropTolerance).GetNumOfTerms() != m_iNumOfLargeCoefficients)
+                m_bIsCorrect = false;
+
+            // Both compose paths must give the input matrix back.
+            CMatrix m_mFromCoefficients = ComposePauliCoefficients(m_vecCoefficients, false);
+            CMatrix m_mFromPauliSum = ComposePauliSum(m_arrmInputs[m].PauliDecompositionSparse());
+            for ( unsigned short int r = 0; r < m_iSideLength; r++ ) {
+                for ( unsigned short int c = 0; c < m_iSideLength; c++ ) {
+                    if (abs(m_mFromCoefficients.GetValueAt(r, c) - m_arrmInputs[m].GetValueAt(r, c)) > 1e-4f ||
+                        abs(m_mFromPauliSum.GetValueAt(r, c) - m_arrmInputs[m].GetValueAt(r, c)) > 1e-4f)
+                        m_bIsCorrect = false;
+                }
+            }
+        }
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccDecomp++;
+        else {
+            m_iNumOfUnsuccDecomp++;
+            cout << "Test " << i << ": Pauli coefficients do NOT match the trace formula." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful Pauli Decompositions: " << m_iNumOfSuccDecomp << endl;
+    cout << "  Total Number of UNSUCCESSFUL Pauli Decompositions: " << m_iNumOfUnsuccDecomp << endl;
+
+    // Timing of the fast transform alone on a larger matrix.
+    const unsigned short int m_iLargeNumOfQubits = inNumOfQubits + 6;
+    CMatrix m_mLargeMatrix = GenerateHermitianMatrix(inBoundParam, 1 << m_iLargeNumOfQubits);
+    chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+    CPauliSum m_psumLarge = m_mLargeMatrix.PauliDecompositionSparse();
+    chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+    cout << "Decomposed a " << m_iLargeNumOfQubits << " qubit Hermitian matrix into " << m_psumLarge.GetNumOfTerms() 
+         << " nonzero Pauli Strings in " << m_tElapsed.count() << " seconds." << endl;
+}
+
+
+static const size_t STATE_CHUNK_SIZE = 1024;
+
+
+static inline void ScaleSignedChunk(complex<float> *outState, const complex<float> *inState, const size_t inLength, const complex<float> inZ, const float *inSigns)
+/********************************************
+ *       Purpose: outState[k] = inSigns[k] * inZ * inState[k] for k < inLength.
+ *  Precondition: outState and inState are equal or do not overlap.
+ * Postcondition: N/A
+ *          Note: Written on the real and imaginary floats so the compiler 
+ *                vectorizes it instead of calling the checked complex multiply.
+********************************************/ 
+{
+    const float *m_pIn = reinterpret_cast<const float*>(inState);
+    float *m_pOut = reinterpret_cast<float*>(outState);
+    const float m_fReal = inZ.real();
+    const float m_fImag = inZ.imag();
+
+    for ( size_t k = 0; k < inLength; k++ ) {
+        float m_fInReal = m_pIn[2 * k];
+        float m_fInImag = m_pIn[2 * k + 1];
+        m_pOut[2 * k]     = inSigns[k] * (m_fReal * m_fInReal - m_fImag * m_fInImag);
+        m_pOut[2 * k + 1] = inSigns[k] * (m_fReal * m_fInImag + m_fImag * m_fInReal);
+    }
+}
+
+
+static inline void SwapScaleSignedChunks(complex<float> *ioChunk1, complex<float> *ioChunk2, const size_t inLength, const complex<float> inZ1, const complex<float> inZ2, const float *inSigns)
+/********************************************
+ *       Purpose: Simultaneously set
+ *                ioChunk1[k] = inSigns[k] * inZ2 * ioChunk2[k]
+ *                ioChunk2[k] = inSigns[k] * inZ1 * ioChunk1[k]    for k < inLength.
+ *  Precondition: Chunks do not overlap.
+ * Postcondition: N/A
+********************************************/ 
+{
+    float *m_pChunk1 = reinterpret_cast<float*>(ioChunk1);
+    float *m_pChunk2 = reinterpret_cast<float*>(ioChunk2);
+
+    for ( size_t k = 0; k < inLength; k++ ) {
+        float m_fReal1 = m_pChunk1[2 * k];
+        float m_fImag1 = m_pChunk1[2 * k + 1];
+        float m_fReal2 = m_pChunk2[2 * k];
+        float m_fImag2 = m_pChunk2[2 * k + 1];
+        m_pChunk1[2 * k]     = inSigns[k] * (inZ2.real() * m_fReal2 - inZ2.imag() * m_fImag2);
+        m_pChunk1[2 * k + 1] = inSigns[k] * (inZ2.real() * m_fImag2 + inZ2.imag() * m_fReal2);
+        m_pChunk2[2 * k]     = inSigns[k] * (inZ1.real() * m_fReal1 - inZ1.imag() * m_fImag1);
+        m_pChunk2[2 * k + 1] = inSigns[k] * (inZ1.real() * m_fImag1 + inZ1.imag() * m_fReal1);
+    }
+}
+
+
+static void ApplyPauliMasks(const complex<float> *inState, complex<float> *outState, const size_t inLength, const uint64_t inXMask, const uint64_t inZMask, const unsigned short int inPhaseExponent)
+/********************************************
+ *       Purpose: Apply the Pauli String P = i^k P(x, z) to a state vector.
+ *                P(x, z) = i^popcount(x & z) X^x Z^z maps |r> to i^popcount(x & z) (-1)^popcount(r & z) |r ^ x>, so
+ *                out[r] = i^(k + popcount(x & z)) (-1)^popcount((r ^ x) & z) in[r ^ x]
+ * 
+ *                The state is walked in aligned chunks no longer than the lowest set bit of x. 
+ *                Within such a chunk r ^ x is a contiguous chunk too, and the sign splits into 
+ *                a sign per chunk times a small table shared by all chunks.
+ * 
+ *  Precondition: inLength is a power of 2 and x, z < inLength. 
+ *                inState and outState are equal (in place) or do not overlap.
+ * Postcondition: Runs in O(2^n). Chunks are split across threads.
+********************************************/ 
+{
+    const bool m_bIsInPlace = (inState == outState);
+    const uint64_t m_iLowestXBit = inXMask & (~inXMask + 1);
+    const uint64_t m_iHighestXBit = HighestSetBit(inXMask);
+    const size_t m_iChunkSize = min<size_t>(min<size_t>(inLength, STATE_CHUNK_SIZE), inXMask == 0 ? inLength : m_iLowestXBit);
+    const complex<float> m_cxPhase = MultiplyByPowerOfI(complex<float>(1, 0), inPhaseExponent + PopCount64(inXMask & inZMask));
+
+    // Signs of the offsets inside a chunk.
+    vector<float> m_vecSigns(m_iChunkSize);
+    for ( size_t k = 0; k < m_iChunkSize; k++ )
+        m_vecSigns[k] = (PopCount64(k & inZMask) & 1) ? -1.0f : 1.0f;
+    const float *m_pSigns = m_vecSigns.data();
+
+    ParallelFor(0, inLength / m_iChunkSize, max<size_t>(1, 65536 / m_iChunkSize), [&](size_t inChunkBegin, size_t inChunkEnd) {
+        for ( size_t ch = inChunkBegin; ch < inChunkEnd; ch++ ) {
+            size_t m_iTarget = ch * m_iChunkSize;
+            size_t m_iSource = m_iTarget ^ inXMask;
+            complex<float> m_cxSourceFactor = (PopCount64(m_iSource & inZMask) & 1) ? -m_cxPhase : m_cxPhase;
+
+            if (!m_bIsInPlace || inXMask == 0) {
+                ScaleSignedChunk(outState + m_iTarget, inState + m_iSource, m_iChunkSize, m_cxSourceFactor, m_pSigns);
+            }
+            // In place, each pair of chunks is swapped once by the chunk without the highest bit of x.
+            else if ((m_iTarget & m_iHighestXBit) == 0) {
+                complex<float> m_cxTargetFactor = (PopCount64(m_iTarget & inZMask) & 1) ? -m_cxPhase : m_cxPhase;
+                SwapScaleSignedChunks(outState + m_iTarget, outState + m_iSource, m_iChunkSize, m_cxTargetFactor, m_cxSourceFactor, m_pSigns);
+            }
+        }
+    });
+}
+
+
+static void CheckStateSize(const size_t inStateSize, const CPauliString &inPauli)
+/********************************************
+ *       Purpose: Exit unless a state vector has 2^n entries for an n qubit Pauli String.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    if (inPauli.GetNumOfQubits() > 62 || inStateSize != (size_t(1) << inPauli.GetNumOfQubits())) {
+        cout << "ERROR: A " << inPauli.GetNumOfQubits() << " qubit Pauli String can not act on a state vector with " << inStateSize << " entries." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+}
+
+
+void ApplyPauliString(vector<complex<float>> &ioState, const CPauliString &inPauli)
+/********************************************
+ *       Purpose: Replace the state vector |psi> with P |psi> without building the matrix of P.
+ *                Basis state |r> is entry r, where qubit q is bit n - 1 - q of r.
+ *  Precondition: ioState has 2^n entries for an n qubit Pauli String.
+ * Postcondition: Runs in O(2^n) with no allocation beyond a small sign table.
+********************************************/ 
+{
+    CheckStateSize(ioState.size(), inPauli);
+    ApplyPauliMasks(ioState.data(), ioState.data(), ioState.size(), inPauli.GetXMask(), inPauli.GetZMask(), inPauli.GetPhaseExponent());
+}
+
+
+void ApplyPauliString(const vector<complex<float>> &inState, const CPauliString &inPauli, vector<complex<float>> &outState)
+/********************************************
+ *       Purpose: Set outState to P |inState> without building the matrix of P.
+ *  Precondition: inState has 2^n entries for an n qubit Pauli String.
+ * Postcondition: outState is resized to 2^n entries. inState is not modified.
+********************************************/ 
+{
+    CheckStateSize(inState.size(), inPauli);
+    if (&inState == &outState) {
+        ApplyPauliString(outState, inPauli);
+        return;
+    }
+
+    outState.resize(inState.size());
+    ApplyPauliMasks(inState.data(), outState.data(), inState.size(), inPauli.GetXMask(), inPauli.GetZMask(), inPauli.GetPhaseExponent());
+}
+
+
+static unsigned short int CheckPauliMatrixSize(const CMatrix &inMatrix, const CPauliString &inPauli, const char *inCaller)
+/********************************************
+ *       Purpose: Exit unless inMatrix is 2^n x 2^n for an n qubit Pauli String. Return n.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    const unsigned short int m_iNumOfQubits = GetNumOfQubits(inMatrix.GetRowSize(), inMatrix.GetColSize(), inCaller);
+    if ( inPauli.GetNumOfQubits() != m_iNumOfQubits ) {
+        cout << "ERROR: " << inCaller << " can not multiply a " << inPauli.GetNumOfQubits() << " qubit Pauli String with a " 
+             << inMatrix.GetRowSize() << " x " << inMatrix.GetColSize() << " matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+    return m_iNumOfQubits;
+}
+
+
+static inline void SwapScaledRuns(float *ioRe1, float *ioIm1, float *ioRe2, float *ioIm2, const size_t inStride, const size_t inLength, 
+                                  const complex<float> inFactor1, const complex<float> inFactor2, const float *inSigns)
+/********************************************
+ *       Purpose: Swap two runs of inLength complex entries and scale them:
+ *                    run1[k] <- inFactor1 inSigns[k] run2[k]
+ *                    run2[k] <- inFactor2 inSigns[k] run1[k]
+ *                Consecutive entries of a run are inStride floats apart. 
+ *  Precondition: The factors are powers of i, so every product is exact. inSigns is NULL for all +1's.
+ *                The runs are the same run or do not overlap. When they are the same, the factors are equal.
+ * Postcondition: N/A
+********************************************/ 
+{
+    const float m_fRe1 = inFactor1.real();
+    const float m_fIm1 = inFactor1.imag();
+    const float m_fRe2 = inFactor2.real();
+    const float m_fIm2 = inFactor2.imag();
+    for ( size_t k = 0; k < inLength; k++ ) {
+        const float m_fSign = (inSigns == NULL) ? 1.0f : inSigns[k];
+        const float m_fOldRe1 = ioRe1[k * inStride];
+        const float m_fOldIm1 = ioIm1[k * inStride];
+        const float m_fOldRe2 = ioRe2[k * inStride];
+        const float m_fOldIm2 = ioIm2[k * inStride];
+        ioRe1[k * inStride] = m_fSign * (m_fRe1 * m_fOldRe2 - m_fIm1 * m_fOldIm2);
+        ioIm1[k * inStride] = m_fSign * (m_fRe1 * m_fOldIm2 + m_fIm1 * m_fOldRe2);
+        ioRe2[k * inStride] = m_fSign * (m_fRe2 * m_fOldRe1 - m_fIm2 * m_fOldIm1);
+        ioIm2[k * inStride] = m_fSign * (m_fRe2 * m_fOldIm1 + m_fIm2 * m_fOldRe1);
+    }
+}
+
+
+void LeftMultiplyPauli(CMatrix &ioMatrix, const CPauliString &inPauli)
+/********************************************
+ *       Purpose: Replace M with P M in place, where P = i^k P(x, z). 
+ *                Row r of P M is row r ^ x of M times i^(k + popcount(x & z)) (-1)^popcount((r ^ x) & z), 
+ *                so each pair of rows r, r ^ x is swapped and scaled once, in one contiguous pass over both rows.
+ *  Precondition: ioMatrix is 2^n x 2^n for an n qubit Pauli String.
+ * Postcondition: Runs in O(4^n) without allocating. Row pairs are split across threads.
+********************************************/ 
+{
+    CheckPauliMatrixSize(ioMatrix, inPauli, "LeftMultiplyPauli()");
+    const size_t m_iSideLength = ioMatrix.m_iRowSize;
+    const uint64_t m_iXMask = inPauli.GetXMask();
+    const uint64_t m_iZMask = inPauli.GetZMask();
+    const uint64_t m_iHighestXBit = HighestSetBit(m_iXMask);
+    const complex<float> m_cxPhase = MultiplyByPowerOfI(complex<float>(1, 0), inPauli.GetPhaseExponent() + PopCount64(m_iXMask & m_iZMask));
+    const CStridedComplex m_scEntries = StridedEntries(ioMatrix, ioMatrix.m_vecMatrix, ioMatrix.m_vecSplitMatrix);
+
+    ParallelFor(0, m_iSideLength, max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, m_iSideLength)), [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            // Each pair of rows is handled by the row without the highest bit of x.
+            if ( (r & m_iHighestXBit) != 0 )
+                continue;
+            const size_t m_iPartner = r ^ m_iXMask;
+            const complex<float> m_cxFactor1 = (PopCount64(m_iPartner & m_iZMask) & 1) ? -m_cxPhase : m_cxPhase;
+            const complex<float> m_cxFactor2 = (PopCount64(r & m_iZMask) & 1) ? -m_cxPhase : m_cxPhase;
+            SwapScaledRuns(m_scEntries.m_pRe + r * m_scEntries.m_iRowStride, m_scEntries.m_pIm + r * m_scEntries.m_iRowStride, 
+                           m_scEntries.m_pRe + m_iPartner * m_scEntries.m_iRowStride, m_scEntries.m_pIm + m_iPartner * m_scEntries.m_iRowStride, 
+                           m_scEntries.m_iColStride, m_iSideLength, m_cxFactor1, m_cxFactor2, NULL);
+        }
+    });
+}
+
+
+void RightMultiplyPauli(CMatrix &ioMatrix, const CPauliString &inPauli)
+/********************************************
+ *       Purpose: Replace M with M P in place, where P = i^k P(x, z). 
+ *                Column c of M P is column c ^ x of M times i^(k + popcount(x & z)) (-1)^popcount(c & z).
+ *                Each row is walked in aligned chunks no longer than the lowest set bit of x, as in 
+ *                ApplyPauliString(). Within such a chunk c ^ x is a contiguous chunk too, and the sign 
+ *                splits into a sign per chunk times a small table shared by all chunks.
+ *  Precondition: ioMatrix is 2^n x 2^n for an n qubit Pauli String.
+ * Postcondition: Runs in O(4^n) with no allocation beyond the sign table. Rows are split across threads.
+********************************************/ 
+{
+    CheckPauliMatrixSize(ioMatrix, inPauli, "RightMultiplyPauli()");
+    const size_t m_iSideLength = ioMatrix.m_iRowSize;
+    const uint64_t m_iXMask = inPauli.GetXMask();
+    const uint64_t m_iZMask = inPauli.GetZMask();
+    const uint64_t m_iHighestXBit = HighestSetBit(m_iXMask);
+    const size_t m_iChunkSize = (m_iXMask == 0) ? m_iSideLength : min<size_t>(m_iSideLength, m_iXMask & (~m_iXMask + 1));
+    const complex<float> m_cxPhase = MultiplyByPowerOfI(complex<float>(1, 0), inPauli.GetPhaseExponent() + PopCount64(m_iXMask & m_iZMask));
+    const CStridedComplex m_scEntries = StridedEntries(ioMatrix, ioMatrix.m_vecMatrix, ioMatrix.m_vecSplitMatrix);
+
+    thread_local vector<float> t_vecSigns;
+    t_vecSigns.resize(m_iChunkSize);
+    for ( size_t k = 0; k < m_iChunkSize; k++ )
+        t_vecSigns[k] = (PopCount64(k & m_iZMask) & 1) ? -1.0f : 1.0f;
+    const float *m_pSigns = t_vecSigns.data();
+
+    ParallelFor(0, m_iSideLength, max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, m_iSideLength)), [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            float *m_pRowRe = m_scEntries.m_pRe + r * m_scEntries.m_iRowStride;
+            float *m_pRowIm = m_scEntries.m_pIm + r * m_scEntries.m_iRowStride;
+            for ( size_t c = 0; c < m_iSideLength; c += m_iChunkSize ) {
+                if ( (c & m_iHighestXBit) != 0 )
+                    continue;
+                const size_t m_iPartner = c ^ m_iXMask;
+                const complex<float> m_cxFactor1 = (PopCount64(c & m_iZMask) & 1) ? -m_cxPhase : m_cxPhase;
+                const complex<float> m_cxFactor2 = (PopCount64(m_iPartner & m_iZMask) & 1) ? -m_cxPhase : m_cxPhase;
+                SwapScaledRuns(m_pRowRe + c * m_scEntries.m_iColStride, m_pRowIm + c * m_scEntries.m_iColStride, 
+                               m_pRowRe + m_iPartner * m_scEntries.m_iColStride, m_pRowIm + m_iPartner * m_scEntries.m_iColStride, 
+                               m_scEntries.m_iColStride, m_iChunkSize, m_cxFactor1, m_cxFactor2, m_pSigns);
+            }
+        }
+    });
+}
+
+
+complex<float> TraceWithPauli(const CMatrix &inMatrix, const CPauliString &inPauli)
+/********************************************
+ *       Purpose: Return Tr(M P) = Tr(P M) without forming the product. 
+ *                Only entry (r, r ^ x) of row r meets the diagonal, so 
+ *                    Tr(M P) = i^(k + popcount(x & z)) sum over r of (-1)^popcount(r & z) M[r][r ^ x]
+ *  Precondition: inMatrix is 2^n x 2^n for an n qubit Pauli String.
+ * Postcondition: Reads 2^n entries. Sums in double over fixed blocks, as Trace() does.
+********************************************/ 
+{
+    CheckPauliMatrixSize(inMatrix, inPauli, "TraceWithPauli()");
+    const uint64_t m_iXMask = inPauli.GetXMask();
+    const uint64_t m_iZMask = inPauli.GetZMask();
+    const complex<double> m_cxSum = ParallelSum(0, inMatrix.GetRowSize(), PARALLEL_GRAIN_SIZE, [&](size_t inBegin, size_t inEnd) {
+        complex<double> m_cxBlockSum = 0;
+        for ( size_t r = inBegin; r < inEnd; r++ ) {
+            const complex<double> m_cxEntry = complex<double>(inMatrix.EntryAt(r, r ^ m_iXMask));
+            m_cxBlockSum += (PopCount64(r & m_iZMask) & 1) ? -m_cxEntry : m_cxEntry;
+        }
+        return m_cxBlockSum;
+    });
+    return MultiplyByPowerOfI(complex<float>(m_cxSum), inPauli.GetPhaseExponent() + PopCount64(m_iXMask & m_iZMask));
+}
+
+
+void TestApplyPauliString(const unsigned short int inNumOfQubits, const unsigned short int inNumOfTests, const unsigned short int inLargeNumOfQubits)
+/********************************************
+ *       Purpose: Verify ApplyPauliString() against the dense matrix of random Pauli Strings 
+ *                and random phases, in place and out of place. Then time it on a state 
+ *                vector far larger than a dense matrix could act on.
+ *  Precondition: Keep inNumOfQubits small. The dense check is O(4^n).
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> pauli_distribution(0, 3);
+    uniform_real_distribution<float> amplitude_distribution(-1, 1);
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+    const size_t m_iSideLength = size_t(1) << inNumOfQubits;
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using " << inNumOfQubits << " qubit state vectors" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        CPauliString m_psPauli = CPauliString(inNumOfQubits);
+        for ( unsigned short int q = 0; q < inNumOfQubits; q++ )
+            m_psPauli.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+        m_psPauli.SetPhaseExponent(pauli_distribution(generator));
+
+        vector<complex<float>> m_vecState(m_iSideLength);
+        for ( size_t r = 0; r < m_iSideLength; r++ )
+            m_vecState[r] = complex<float>(amplitude_distribution(generator), amplitude_distribution(generator));
+
+        vector<complex<float>> m_vecOutOfPlace;
+        ApplyPauliString(m_vecState, m_psPauli, m_vecOutOfPlace);
+        vector<complex<float>> m_vecInPlace = m_vecState;
+        ApplyPauliString(m_vecInPlace, m_psPauli);
+
+        // Dense reference.
+        CPauliAlgebraElement m_paeDense = m_psPauli.ToPauliAlgebraElement();
+        bool m_bIsCorrect = true;
+        for ( size_t r = 0; r < m_iSideLength; r++ ) {
+            complex<float> m_cxExpected = 0;
+            for ( size_t c = 0; c < m_iSideLength; c++ )
+                m_cxExpected += m_paeDense.GetValueAt(r, c) * m_vecState[c];
+
+            if (abs(m_cxExpected - m_vecOutOfPlace[r]) > 1e-5f || abs(m_cxExpected - m_vecInPlace[r]) > 1e-5f)
+                m_bIsCorrect = false;
+        }
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": " << m_psPauli.PauliStringToString() << " |psi> does NOT match the dense matrix." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful Pauli String applications: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL Pauli String applications: " << m_iNumOfUnsuccTests << endl;
+
+    // Timing on a large state vector.
+    CPauliString m_psLargePauli = CPauliString(inLargeNumOfQubits);
+    for ( unsigned short int q = 0; q < inLargeNumOfQubits; q++ )
+        m_psLargePauli.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+
+    vector<complex<float>> m_vecLargeState(size_t(1) << inLargeNumOfQubits, complex<float>(1, 0));
+    chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+    ApplyPauliString(m_vecLargeState, m_psLargePauli);
+    chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+    cout << "Applied " << m_psLargePauli.PauliStringToString().substr(0, 16) << (inLargeNumOfQubits > 16 ? ". . ." : "") 
+         << " to a " << inLargeNumOfQubits << " qubit state vector in place in " << m_tElapsed.count() << " seconds." << endl;
+}
+
+
+static const size_t EXPECTATION_CHUNK_SIZE = 256;
+static const size_t EXPECTATION_BATCH_SIZE = 64;
+static const size_t EXPECTATION_MAX_TRANSFORM_SIZE = size_t(1) << 24;
+
+
+static void BatchedExpectationValues(const vector<complex<float>> &inState, const vector<uint64_t> &inXMasks, const vector<uint64_t> &inZMasks, 
+                                     const vector<unsigned short int> &inPhaseExponents, vector<complex<float>> &outValues)
+/********************************************
+ *       Purpose: Set outValues[t] = <psi| P_t |psi> for every Pauli String P_t = i^k P(x, z).
+ *                <psi| P |psi> = i^(k + popcount(x & z)) sum over r of (-1)^popcount((r ^ x) & z) conj(psi[r]) psi[r ^ x]
+ * 
+ *                Terms are grouped by X mask. Each group is one sweep over the state that forms 
+ *                w[r] = conj(psi[r]) psi[r ^ x] once per chunk, then every Z mask of the group 
+ *                only adds up signed copies of those chunk products. Groups with more than 2n 
+ *                Z masks use one O(n 2^n) Walsh-Hadamard transform for all of their Z masks instead.
+ * 
+ *  Precondition: inState has 2^n entries and every mask is below 2^n.
+ * Postcondition: Results do not depend on the number of threads. The state is cut into 
+ *                a fixed number of blocks that only depends on its size, every block sums in double, 
+ *                and the block sums are added in block order.
+********************************************/ 
+{
+    const size_t m_iStateSize = inState.size();
+    const size_t m_iNumOfTerms = inXMasks.size();
+    const size_t m_iBlockSize = min(m_iStateSize, max<size_t>(16384, m_iStateSize / 1024));
+    const size_t m_iNumOfBlocks = m_iStateSize / m_iBlockSize;
+    const complex<float> *m_pState = inState.data();
+    outValues.assign(m_iNumOfTerms, complex<float>(0, 0));
+
+    // Group terms that share an X mask.
+    vector<size_t> m_vecOrder(m_iNumOfTerms);
+    for ( size_t t = 0; t < m_iNumOfTerms; t++ )
+        m_vecOrder[t] = t;
+    stable_sort(m_vecOrder.begin(), m_vecOrder.end(), [&](size_t inTerm1, size_t inTerm2) { return inXMasks[inTerm1] < inXMasks[inTerm2]; });
+
+    vector<complex<double>> m_vecBlockSums;
+    vector<float> m_vecSigns;
+
+    for ( size_t g = 0; g < m_iNumOfTerms; ) {
+        const uint64_t m_iXMask = inXMasks[m_vecOrder[g]];
+        size_t m_iGroupEnd = g;
+        while (m_iGroupEnd < m_iNumOfTerms && inXMasks[m_vecOrder[m_iGroupEnd]] == m_iXMask)
+            m_iGroupEnd++;
+
+        // Large groups: one Walsh-Hadamard transform of f[s] = conj(psi[s ^ x]) psi[s] gives 
+        // sum over r of (-1)^popcount((r ^ x) & z) conj(psi[r]) psi[r ^ x] for every Z mask at once.
+        if (m_iGroupEnd - g > 2 * size_t(PopCount64(m_iStateSize - 1)) && m_iStateSize <= EXPECTATION_MAX_TRANSFORM_SIZE) {
+            vector<complex<double>> m_vecTransform(m_iStateSize);
+            for ( size_t r = 0; r < m_iStateSize; r++ )
+                m_vecTransform[r] = complex<double>(conj(m_pState[r ^ m_iXMask])) * complex<double>(m_pState[r]);
+
+            WalshHadamardTransform(m_vecTransform.data(), m_iStateSize);
+
+            for ( size_t j = g; j < m_iGroupEnd; j++ ) {
+                size_t m_iTerm = m_vecOrder[j];
+                unsigned int m_iExponent = inPhaseExponents[m_iTerm] + PopCount64(m_iXMask & inZMasks[m_iTerm]);
+                outValues[m_iTerm] = MultiplyByPowerOfI(complex<float>(m_vecTransform[inZMasks[m_iTerm]]), m_iExponent);
+            }
+
+            g = m_iGroupEnd;
+            continue;
+        }
+
+        const size_t m_iChunkSize = min(min(m_iBlockSize, EXPECTATION_CHUNK_SIZE), m_iXMask == 0 ? m_iStateSize : size_t(m_iXMask & (~m_iXMask + 1)));
+
+        // Z masks of a group are handled in batches to bound the sign tables.
+        for ( size_t b = g; b < m_iGroupEnd; b += EXPECTATION_BATCH_SIZE ) {
+            const size_t m_iBatchSize = min(EXPECTATION_BATCH_SIZE, m_iGroupEnd - b);
+
+            // Signs of the offsets inside a chunk, one table per Z mask.
+            m_vecSigns.resize(m_iBatchSize * m_iChunkSize);
+            for ( size_t j = 0; j < m_iBatchSize; j++ ) {
+                uint64_t m_iZMask = inZMasks[m_vecOrder[b + j]];
+                for ( size_t k = 0; k < m_iChunkSize; k++ )
+                    m_vecSigns[j * m_iChunkSize + k] = (PopCount64(k & m_iZMask) & 1) ? -1.0f : 1.0f;
+            }
+
+            m_vecBlockSums.assign(m_iNumOfBlocks * m_iBatchSize, complex<double>(0, 0));
+            ParallelFor(0, m_iNumOfBlocks, 1, [&](size_t inBlockBegin, size_t inBlockEnd) {
+                vector<float> m_vecProducts(2 * m_iChunkSize);
+
+                for ( size_t blk = inBlockBegin; blk < inBlockEnd; blk++ ) {
+                    for ( size_t r0 = blk * m_iBlockSize; r0 < (blk + 1) * m_iBlockSize; r0 += m_iChunkSize ) {
+                        const size_t s0 = r0 ^ m_iXMask;
+                        const float *m_pLeft = reinterpret_cast<const float*>(m_pState + r0);
+                        const float *m_pRight = reinterpret_cast<const float*>(m_pState + s0);
+
+                        // w[k] = conj(psi[r0 + k]) psi[s0 + k]
+                        for ( size_t k = 0; k < m_iChunkSize; k++ ) {
+                            m_vecProducts[2 * k]     = m_pLeft[2 * k] * m_pRight[2 * k]     + m_pLeft[2 * k + 1] * m_pRight[2 * k + 1];
+                            m_vecProducts[2 * k + 1] = m_pLeft[2 * k] * m_pRight[2 * k + 1] - m_pLeft[2 * k + 1] * m_pRight[2 * k];
+                        }
+
+                        for ( size_t j = 0; j < m_iBatchSize; j++ ) {
+                            const uint64_t m_iZMask = inZMasks[m_vecOrder[b + j]];
+                            const float *m_pSigns = &m_vecSigns[j * m_iChunkSize];
+                            float m_fReal = 0;
+                            float m_fImag = 0;
+                            for ( size_t k = 0; k < m_iChunkSize; k++ ) {
+                                m_fReal += m_pSigns[k] * m_vecProducts[2 * k];
+                                m_fImag += m_pSigns[k] * m_vecProducts[2 * k + 1];
+                            }
+
+                            double m_dChunkSign = (PopCount64(s0 & m_iZMask) & 1) ? -1.0 : 1.0;
+                            m_vecBlockSums[blk * m_iBatchSize + j] += complex<double>(m_dChunkSign * m_fReal, m_dChunkSign * m_fImag);
+                        }
+                    }
+                }
+            });
+
+            for ( size_t j = 0; j < m_iBatchSize; j++ ) {
+                complex<double> m_cxSum = 0;
+                for ( size_t blk = 0; blk < m_iNumOfBlocks; blk++ )
+                    m_cxSum += m_vecBlockSums[blk * m_iBatchSize + j];
+
+                size_t m_iTerm = m_vecOrder[b + j];
+                unsigned int m_iExponent = inPhaseExponents[m_iTerm] + PopCount64(m_iXMask & inZMasks[m_iTerm]);
+                outValues[m_iTerm] = MultiplyByPowerOfI(complex<float>(m_cxSum), m_iExponent);
+            }
+        }
+
+        g = m_iGroupEnd;
+    }
+}
+
+
+vector<complex<float>> ExpectationValues(const vector<complex<float>> &inState, const vector<CPauliString> &inPauliStrings)
+/********************************************
+ *       Purpose: Return <psi| P |psi> for every Pauli String P in one pass per X mask. 
+ *  Precondition: inState has 2^n entries and every Pauli String acts on n qubits.
+ * Postcondition: Phases of the Pauli Strings are included. 
+ *          Note: See BatchedExpectationValues().
+********************************************/ 
+{
+    vector<uint64_t> m_vecXMasks(inPauliStrings.size());
+    vector<uint64_t> m_vecZMasks(inPauliStrings.size());
+    vector<unsigned short int> m_vecPhaseExponents(inPauliStrings.size());
+
+    for ( size_t t = 0; t < inPauliStrings.size(); t++ ) {
+        CheckStateSize(inState.size(), inPauliStrings[t]);
+        m_vecXMasks[t] = inPauliStrings[t].GetXMask();
+        m_vecZMasks[t] = inPauliStrings[t].GetZMask();
+        m_vecPhaseExponents[t] = inPauliStrings[t].GetPhaseExponent();
+    }
+
+    vector<complex<float>> m_vecValues;
+    BatchedExpectationValues(inState, m_vecXMasks, m_vecZMasks, m_vecPhaseExponents, m_vecValues);
+    return m_vecValues;
+}
+
+
+vector<complex<float>> ExpectationValues(const vector<complex<float>> &inState, const CPauliSum &inPauliSum)
+/********************************************
+ *       Purpose: Return <psi| P_t |psi> for every term P_t of a Pauli Sum, in term order. 
+ *  Precondition: inState has 2^n entries and the Pauli Sum acts on n qubits.
+ * Postcondition: Coefficients are NOT included. See ExpectationValue() for the weighted sum.
+********************************************/ 
+{
+    const size_t m_iNumOfQubits = inPauliSum.GetNumOfQubits();
+    CheckStateSize(inState.size(), CPauliString(m_iNumOfQubits));
+
+    vector<uint64_t> m_vecXMasks(inPauliSum.GetNumOfTerms(), 0);
+    vector<uint64_t> m_vecZMasks(inPauliSum.GetNumOfTerms(), 0);
+    vector<unsigned short int> m_vecPhaseExponents(inPauliSum.GetNumOfTerms(), 0);
+
+    for ( size_t t = 0; t < inPauliSum.GetNumOfTerms() && m_iNumOfQubits > 0; t++ ) {
+        m_vecXMasks[t] = ReverseLowBits(inPauliSum.GetXWordsAt(t)[0], m_iNumOfQubits);
+        m_vecZMasks[t] = ReverseLowBits(inPauliSum.GetZWordsAt(t)[0], m_iNumOfQubits);
+    }
+
+    vector<complex<float>> m_vecValues;
+    BatchedExpectationValues(inState, m_vecXMasks, m_vecZMasks, m_vecPhaseExponents, m_vecValues);
+    return m_vecValues;
+}
+
+
+complex<float> ExpectationValue(const vector<complex<float>> &inState, const CPauliSum &inPauliSum)
+/********************************************
+ *       Purpose: Return <psi| H |psi> for a Pauli Sum H = sum over t of c_t P_t.
+ *  Precondition: inState has 2^n entries and the Pauli Sum acts on n qubits.
+ * Postcondition: Terms are added in term order in double.
+********************************************/ 
+{
+    vector<complex<float>> m_vecValues = ExpectationValues(inState, inPauliSum);
+
+    complex<double> m_cxSum = 0;
+    for ( size_t t = 0; t < m_vecValues.size(); t++ )
+        m_cxSum += complex<double>(inPauliSum.GetCoefficientAt(t)) * complex<double>(m_vecValues[t]);
+
+    return complex<float>(m_cxSum);
+}
+
+
+void TestExpectationValues(const unsigned short int inNumOfQubits, const size_t inNumOfTerms)
+/********************************************
+ *       Purpose: Verify ExpectationValues() and ExpectationValue() against 
+ *                one ApplyPauliString() and inner product per term.
+ *                Half of the random terms only hold I and Z, so many terms share an X mask.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> pauli_distribution(0, 3);
+    uniform_int_distribution<int> coefficient_distribution(-10, 10);
+    uniform_real_distribution<float> amplitude_distribution(-1, 1);
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+    const size_t m_iStateSize = size_t(1) << inNumOfQubits;
+
+    // Random normalized state.
+    vector<complex<float>> m_vecState(m_iStateSize);
+    double m_dNorm = 0;
+    for ( size_t r = 0; r < m_iStateSize; r++ ) {
+        m_vecState[r] = complex<float>(amplitude_distribution(generator), amplitude_distribution(generator));
+        m_dNorm += norm(m_vecState[r]);
+    }
+    for ( size_t r = 0; r < m_iStateSize; r++ )
+        m_vecState[r] /= float(sqrt(m_dNorm));
+
+    vector<CPauliString> m_vecPauliStrings;
+    vector<complex<float>> m_vecCoefficients;
+    for ( size_t t = 0; t < inNumOfTerms; t++ ) {
+        CPauliString m_psPauli = CPauliString(inNumOfQubits);
+        for ( unsigned short int q = 0; q < inNumOfQubits; q++ )
+            m_psPauli.SetPauliAt(q, (t % 2 == 0) ? m_arrcPauliChars[3 * (pauli_distribution(generator) % 2)] : m_arrcPauliChars[pauli_distribution(generator)]);
+        m_vecPauliStrings.push_back(m_psPauli);
+        m_vecCoefficients.push_back(complex<float>(coefficient_distribution(generator), 0));
+    }
+    CPauliSum m_psumH = CPauliSum(m_vecPauliStrings, m_vecCoefficients);
+
+    cout << "Evaluating " << inNumOfTerms << " Pauli String expectation values on a " << inNumOfQubits << " qubit state . . ." << endl;
+    chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+    vector<complex<float>> m_vecValues = ExpectationValues(m_vecState, m_vecPauliStrings);
+    chrono::duration<double> m_tBatched = chrono::steady_clock::now() - m_tStart;
+
+    // Reference: one ApplyPauliString() per term.
+    m_tStart = chrono::steady_clock::now();
+    bool m_bIsCorrect = true;
+    vector<complex<float>> m_vecApplied;
+    for ( size_t t = 0; t < inNumOfTerms; t++ ) {
+        ApplyPauliString(m_vecState, m_vecPauliStrings[t], m_vecApplied);
+        complex<double> m_cxExpected = 0;
+        for ( size_t r = 0; r < m_iStateSize; r++ )
+            m_cxExpected += complex<double>(conj(m_vecState[r]) * m_vecApplied[r]);
+
+        if (abs(m_cxExpected - complex<double>(m_vecValues[t])) > 1e-4)
+            m_bIsCorrect = false;
+    }
+    chrono::duration<double> m_tReference = chrono::steady_clock::now() - m_tStart;
+
+    // Pauli Sum terms are merged, so compare the weighted sums.
+    complex<double> m_cxExpectedEnergy = 0;
+    for ( size_t t = 0; t < inNumOfTerms; t++ )
+        m_cxExpectedEnergy += complex<double>(m_vecCoefficients[t]) * complex<double>(m_vecValues[t]);
+    complex<float> m_cxEnergy = ExpectationValue(m_vecState, m_psumH);
+    if (abs(m_cxExpectedEnergy - complex<double>(m_cxEnergy)) > 1e-3 * max(1.0, abs(m_cxExpectedEnergy)))
+        m_bIsCorrect = false;
+
+    cout << "<psi| H |psi> = " << m_cxEnergy << " for a Pauli Sum with " << m_psumH.GetNumOfTerms() << " distinct terms." << endl;
+    cout << "Batched expectation values took " << m_tBatched.count() << " seconds. One ApplyPauliString() per term took " << m_tReference.count() << " seconds." << endl;
+    if (m_bIsCorrect)
+        cout << "All expectation values match." << endl;
+    else
+        cout << "Expectation values do NOT match." << endl;
+}
+
+
+void TestMultiplyPauli(const unsigned short int inNumOfQubits, const unsigned short int inNumOfTests)
+/********************************************
+ *       Purpose: Check LeftMultiplyPauli(), RightMultiplyPauli() and TraceWithPauli() of random 
+ *                Pauli Strings and phases against dense products with the matrix of the Pauli String, 
+ *                for random matrices in both layouts.
+ *  Precondition: 1 <= inNumOfQubits and keep it small, the dense products are O(8^n).
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> pauli_distribution(0, 3);
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+    const unsigned short int m_iSideLength = (unsigned short int) (1 << inNumOfQubits);
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using " << m_iSideLength << " x " << m_iSideLength << " matrices" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        CPauliString m_psPauli = CPauliString(inNumOfQubits);
+        for ( unsigned short int q = 0; q < inNumOfQubits; q++ )
+            m_psPauli.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+        m_psPauli.SetPhaseExponent(pauli_distribution(generator));
+
+        CMatrix m_mMatrix = CMatrix(m_iSideLength, m_iSideLength, (i % 2 == 0) ? INTERLEAVED_LAYOUT : SPLIT_LAYOUT);
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ )
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                m_mMatrix.ModifyValueAt(r, c, complex<float>(entry_distribution(generator), entry_distribution(generator)));
+
+        const CMatrix m_mDensePauli = m_psPauli.ToPauliAlgebraElement();
+        const CMatrix m_mLeftExpected = m_mDensePauli * m_mMatrix;
+        const CMatrix m_mRightExpected = m_mMatrix * m_mDensePauli;
+        CMatrix m_mLeft = m_mMatrix;
+        LeftMultiplyPauli(m_mLeft, m_psPauli);
+        CMatrix m_mRight = m_mMatrix;
+        RightMultiplyPauli(m_mRight, m_psPauli);
+
+        bool m_bIsCorrect = (m_mLeft.GetLayout() == m_mMatrix.GetLayout() && m_mRight.GetLayout() == m_mMatrix.GetLayout());
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ )
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                if ( abs(m_mLeft.GetValueAt(r, c) - m_mLeftExpected.GetValueAt(r, c)) > 1e-5f 
+                     || abs(m_mRight.GetValueAt(r, c) - m_mRightExpected.GetValueAt(r, c)) > 1e-5f )
+                    m_bIsCorrect = false;
+
+        // Permuting and phasing entries is exact, so both must match the monomial products bit for bit.
+        const CMonomialMatrix m_mmPauli = CMonomialMatrix(m_psPauli);
+        if ( m_mLeft.GetMatrix() != (m_mmPauli * m_mMatrix).GetMatrix() || m_mRight.GetMatrix() != (m_mMatrix * m_mmPauli).GetMatrix() )
+            m_bIsCorrect = false;
+
+        const complex<float> m_cxExpectedTrace = m_mLeftExpected.Trace();
+        if ( abs(TraceWithPauli(m_mMatrix, m_psPauli) - m_cxExpectedTrace) > 1e-4f * max(1.0f, abs(m_cxExpectedTrace)) )
+            m_bIsCorrect = false;
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": Multiplying by " << m_psPauli.PauliStringToString() << " does NOT match the dense matrix." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful Pauli multiplication tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL Pauli multiplication tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void TestPauliLiterals(const unsigned short int inNumOfTests)
+/********************************************
+ *       Purpose: Check PAULI_PRODUCT_TABLE against the 2 x 2 Pauli matrices, the _pauli literals against 
+ *                CPauliString(string), and products of random literals of 1 to 64 qubits against 
+ *                products of Pauli Strings. The static_asserts below are checked when the file compiles.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    static_assert(PAULI_PRODUCT_TABLE[1][2].m_iPauliIndex == 3 && PAULI_PRODUCT_TABLE[1][2].m_iPhaseExponent == 1, "XY = iZ");
+    static_assert(PAULI_PRODUCT_TABLE[3][2].m_iPauliIndex == 1 && PAULI_PRODUCT_TABLE[3][2].m_iPhaseExponent == 3, "ZY = -iX");
+    static_assert("XIZY"_pauli.GetNumOfQubits() == 4 && "XIZY"_pauli.GetPauliAt(0) == 'X' && "XIZY"_pauli.GetPauliAt(3) == 'Y', "XIZY");
+    static_assert("XIZY"_pauli.GetXWord() == 0x9 && "XIZY"_pauli.GetZWord() == 0xC, "Qubit q is bit q");
+    static_assert("xyz"_pauli == "XYZ"_pauli, "Pauli characters are not case sensitive");
+    static_assert("X"_pauli * "Y"_pauli == CPauliLiteral(0, 1, 1, 1), "XY = iZ");
+    static_assert("XY"_pauli * "YX"_pauli == "ZZ"_pauli, "(X @ Y)(Y @ X) = Z @ Z");
+
+    static default_random_engine generator;
+    uniform_int_distribution<int> qubit_distribution(1, 64);
+    uniform_int_distribution<int> phase_distribution(0, 3);
+    uniform_int_distribution<uint64_t> word_distribution;
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << " plus 16 table entries and 4 literals" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( int a = 0; a < 4; a++ ) {
+        for ( int b = 0; b < 4; b++ ) {
+            const CPauliProduct m_ppProduct = PAULI_PRODUCT_TABLE[a][b];
+            const CMatrix m_mExpected = CPauliMatrix(string(1, PAULI_CHARS[m_ppProduct.m_iPauliIndex])) * PAULI_PHASES[m_ppProduct.m_iPhaseExponent];
+            const CMatrix m_mProduct = CPauliMatrix(string(1, PAULI_CHARS[a])) * CPauliMatrix(string(1, PAULI_CHARS[b]));
+            if (m_mProduct.GetMatrix() == m_mExpected.GetMatrix())
+                m_iNumOfSuccTests++;
+            else {
+                m_iNumOfUnsuccTests++;
+                cout << "Table entry " << PAULI_CHARS[a] << PAULI_CHARS[b] << " does NOT match the product of the Pauli matrices." << endl;
+            }
+        }
+    }
+
+    const CPauliLiteral m_arrplLiterals[4] = { "XIZY"_pauli, "I"_pauli, "zzyx"_pauli, "XYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZI"_pauli };
+    const string m_arrsStrings[4] = { "XIZY", "I", "ZZYX", "XYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZIXYZI" };
+    for ( int l = 0; l < 4; l++ ) {
+        if (CPauliString(m_arrplLiterals[l]) == CPauliString(m_arrsStrings[l]))
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Literal " << m_arrsStrings[l] << " does NOT match CPauliString(\"" << m_arrsStrings[l] << "\")." << endl;
+        }
+    }
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        const size_t m_iNumOfQubits = qubit_distribution(generator);
+        const uint64_t m_iMask = m_iNumOfQubits == 64 ? ~uint64_t(0) : (uint64_t(1) << m_iNumOfQubits) - 1;
+        const CPauliLiteral m_plPauli1 = CPauliLiteral(word_distribution(generator) & m_iMask, word_distribution(generator) & m_iMask, m_iNumOfQubits, phase_distribution(generator));
+        const CPauliLiteral m_plPauli2 = CPauliLiteral(word_distribution(generator) & m_iMask, word_distribution(generator) & m_iMask, m_iNumOfQubits, phase_distribution(generator));
+
+        if (CPauliString(m_plPauli1 * m_plPauli2) == CPauliString(m_plPauli1) * CPauliString(m_plPauli2))
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": " << CPauliString(m_plPauli1).PauliStringToString() << " * " << CPauliString(m_plPauli2).PauliStringToString() 
+                 << " does NOT match the Pauli String product." << endl;
+        }
+    }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful Pauli literal tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL Pauli literal tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+static bool IsIdentityMatrix(const CMatrix &inMatrix)
+/********************************************
+ *       Purpose: Return true when inMatrix is exactly the identity matrix.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    if ( inMatrix.GetRowSize() != inMatrix.GetColSize() )
+        return false;
+    for ( size_t r = 0; r < inMatrix.GetRowSize(); r++ )
+        for ( size_t c = 0; c < inMatrix.GetColSize(); c++ )
+            if ( inMatrix.EntryAt(r, c) != complex<float>((r == c) ? 1.0f : 0.0f, 0) )
+                return false;
+    return true;
+}
+
+
+CKroneckerOperator::CKroneckerOperator() : m_iRowSize(1), m_iColSize(1)
+/********************************************
+ *       Purpose: Initialize the 1 x 1 identity, the Kronecker product of no factors.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+}
+
+
+CKroneckerOperator::CKroneckerOperator(const vector<CMatrix> &inFactors) 
+    : m_vecFactors(inFactors), m_vecIsIdentity(inFactors.size()), m_iRowSize(1), m_iColSize(1)
+/********************************************
+ *       Purpose: Initialize F_0 @ F_1 @ ... @ F_{k-1} without forming the product.
+ *  Precondition: The product of the factor sizes fits in a size_t.
+ * Postcondition: The factors are copied and keep their layouts.
+********************************************/ 
+{
+    for ( size_t f = 0; f < m_vecFactors.size(); f++ ) {
+        m_iRowSize *= m_vecFactors[f].GetRowSize();
+        m_iColSize *= m_vecFactors[f].GetColSize();
+        m_vecIsIdentity[f] = IsIdentityMatrix(m_vecFactors[f]);
+    }
+}
+
+
+CKroneckerOperator::CKroneckerOperator(const CPauliString &inPauli) : m_iRowSize(1), m_iColSize(1)
+/********************************************
+ *       Purpose: Initialize i^k P_0 @ P_1 @ ... @ P_(n-1) as n Pauli Matrix factors.
+ *  Precondition: N/A
+ * Postcondition: The phase i^k scales the first factor. A 0 qubit Pauli String is the 1 x 1 matrix [i^k].
+********************************************/ 
+{
+    vector<CMatrix> m_vecPauliFactors;
+    for ( size_t q = 0; q < inPauli.GetNumOfQubits(); q++ )
+        m_vecPauliFactors.push_back(CMatrix(string(1, inPauli.GetPauliAt(q))));
+    if ( m_vecPauliFactors.empty() ) {
+        m_vecPauliFactors.push_back(CMatrix(1, 1));
+        m_vecPauliFactors[0](0, 0) = inPauli.GetPhase();
+    }
+    else if ( inPauli.GetPhaseExponent() != 0 )
+        m_vecPauliFactors[0] = inPauli.GetPhase() * m_vecPauliFactors[0];
+    *this = CKroneckerOperator(m_vecPauliFactors);
+}
+
+
+complex<float> CKroneckerOperator::Trace() const
+/********************************************
+ *       Purpose: Return Tr(F_0 @ ... @ F_{k-1}) = Tr(F_0) Tr(F_1) ... Tr(F_{k-1}).
+ *  Precondition: Every factor is square.
+ * Postcondition: The factor traces are multiplied in double.
+********************************************/ 
+{
+    complex<double> m_cxTrace = 1;
+    for ( size_t f = 0; f < m_vecFactors.size(); f++ )
+        m_cxTrace *= complex<double>(m_vecFactors[f].Trace());
+    return complex<float>(m_cxTrace);
+}
+
+
+CKroneckerOperator CKroneckerOperator::operator*(const CKroneckerOperator &inOperator2) const
+/********************************************
+ *       Purpose: Return (A_0 @ ... @ A_{k-1}) (B_0 @ ... @ B_{k-1}) = (A_0 B_0) @ ... @ (A_{k-1} B_{k-1}).
+ *  Precondition: Both operators have k factors and factor f of the first has as many 
+ *                columns as factor f of the second has rows.
+ * Postcondition: Neither operator is modified. The result has k factors.
+********************************************/ 
+{
+    bool m_bIsCompatible = (m_vecFactors.size() == inOperator2.m_vecFactors.size());
+    for ( size_t f = 0; m_bIsCompatible && f < m_vecFactors.size(); f++ )
+        m_bIsCompatible = (m_vecFactors[f].GetColSize() == inOperator2.m_vecFactors[f].GetRowSize());
+    if ( !m_bIsCompatible ) {
+        cout << "ERROR: Unable to multiply Kronecker operators of " << m_vecFactors.size() << " and " << inOperator2.m_vecFactors.size() 
+             << " factors whose factor sizes do not match." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    vector<CMatrix> m_vecProducts;
+    for ( size_t f = 0; f < m_vecFactors.size(); f++ )
+        m_vecProducts.push_back(m_vecFactors[f] * inOperator2.m_vecFactors[f]);
+    return CKroneckerOperator(m_vecProducts);
+}
+
+
+vector<complex<float>> CKroneckerOperator::operator*(const vector<complex<float>> &inVector) const
+/********************************************
+ *       Purpose: Return the Kronecker operator applied to inVector.
+ *  Precondition: inVector has GetColSize() entries.
+ * Postcondition: inVector is not modified.
+ *         Notes: See MultiplyInto() to reuse the storage of an existing result.
+********************************************/ 
+{
+    vector<complex<float>> m_vecResult(m_iRowSize);
+    MultiplyInto(m_vecResult, *this, inVector);
+    return m_vecResult;
+}
+
+
+CMatrix CKroneckerOperator::ToMatrix() const
+/********************************************
+ *       Purpose: Return the dense Kronecker product of the factors.
+ *  Precondition: The product must fit in MAX_SIDE_LENGTH x MAX_SIDE_LENGTH.
+ * Postcondition: The result uses INTERLEAVED_LAYOUT.
+********************************************/ 
+{
+    return KroneckerProduct(m_vecFactors);
+}
+
+
+static void ApplyKroneckerFactor(const complex<float> *inSource, complex<float> *outTarget, const CConstMatrixView &inFactor, 
+                                 const size_t inLeftSize, const size_t inRightSize)
+/********************************************
+ *       Purpose: Mode product with one factor A. The source is an inLeftSize x inColSize x inRightSize array, 
+ *                the target an inLeftSize x inRowSize x inRightSize array, and 
+ *                    outTarget[l][i][r] = sum over j of A[i][j] inSource[l][j][r]
+ *                Each term scales a contiguous run of r, and zero entries of A are skipped. 
+ *                A 2 x 2 factor, a single qubit gate, is held in a CFixedMatrix2 and applied to 
+ *                both runs of r in one pass instead. (l, block of r) pairs are split across threads.
+ *  Precondition: inSource and outTarget do not overlap. inFactor is A in either layout.
+ * Postcondition: Every entry of the target is written.
+********************************************/ 
+{
+    const size_t inRowSize = inFactor.GetRowSize();
+    const size_t inColSize = inFactor.GetColSize();
+    const size_t m_iBlockSize = min<size_t>(inRightSize, 1024);
+    const size_t m_iNumOfBlocks = (inRightSize + m_iBlockSize - 1) / m_iBlockSize;
+    const size_t m_iWorkPerItem = max<size_t>(1, m_iBlockSize * inRowSize * inColSize);
+    const bool m_bIsSingleQubit = (inRowSize == 2 && inColSize == 2);
+    const CFixedMatrix2 m_fmGate = m_bIsSingleQubit 
+        ? CFixedMatrix2(CFixedMatrix2::CEntries{{ inFactor.EntryAt(0, 0), inFactor.EntryAt(0, 1), inFactor.EntryAt(1, 0), inFactor.EntryAt(1, 1) }}) 
+        : CFixedMatrix2();
+    ParallelFor(0, inLeftSize * m_iNumOfBlocks, max<size_t>(1, PARALLEL_GRAIN_SIZE / m_iWorkPerItem), [&](size_t inItemBegin, size_t inItemEnd) {
+        for ( size_t m_iItem = inItemBegin; m_iItem < inItemEnd; m_iItem++ ) {
+            const size_t l = m_iItem / m_iNumOfBlocks;
+            const size_t m_iRightBegin = (m_iItem % m_iNumOfBlocks) * m_iBlockSize;
+            const size_t m_iLength = min(m_iBlockSize, inRightSize - m_iRightBegin);
+            if ( m_bIsSingleQubit ) {
+                const complex<float> *m_pSource0 = inSource + 2 * l * inRightSize + m_iRightBegin;
+                const complex<float> *m_pSource1 = m_pSource0 + inRightSize;
+                complex<float> *m_pTarget0 = outTarget + 2 * l * inRightSize + m_iRightBegin;
+                complex<float> *m_pTarget1 = m_pTarget0 + inRightSize;
+                for ( size_t s = 0; s < m_iLength; s++ ) {
+                    const complex<float> m_cxSource0 = m_pSource0[s];
+                    const complex<float> m_cxSource1 = m_pSource1[s];
+                    m_pTarget0[s] = CElementwiseMultiplyOperation::Apply(m_fmGate(0, 0), m_cxSource0) + CElementwiseMultiplyOperation::Apply(m_fmGate(0, 1), m_cxSource1);
+                    m_pTarget1[s] = CElementwiseMultiplyOperation::Apply(m_fmGate(1, 0), m_cxSource0) + CElementwiseMultiplyOperation::Apply(m_fmGate(1, 1), m_cxSource1);
+                }
+                continue;
+            }
+            for ( size_t i = 0; i < inRowSize; i++ ) {
+                complex<float> *m_pTarget = outTarget + (l * inRowSize + i) * inRightSize + m_iRightBegin;
+                bool m_bIsWritten = false;
+                for ( size_t j = 0; j < inColSize; j++ ) {
+                    const complex<float> m_cxEntry = inFactor.EntryAt(i, j);
+                    if ( m_cxEntry == complex<float>(0, 0) )
+                        continue;
+                    const complex<float> *m_pSource = inSource + (l * inColSize + j) * inRightSize + m_iRightBegin;
+                    if ( m_bIsWritten )
+                        for ( size_t s = 0; s < m_iLength; s++ )
+                            m_pTarget[s] += CElementwiseMultiplyOperation::Apply(m_cxEntry, m_pSource[s]);
+                    else
+                        for ( size_t s = 0; s < m_iLength; s++ )
+                            m_pTarget[s] = CElementwiseMultiplyOperation::Apply(m_cxEntry, m_pSource[s]);
+                    m_bIsWritten = true;
+                }
+                if ( !m_bIsWritten )
+                    fill(m_pTarget, m_pTarget + m_iLength, complex<float>(0, 0));
+            }
+        }
+    });
+}
+
+
+void MultiplyInto(vector<complex<float>> &outVector, const CKroneckerOperator &inOperator, const vector<complex<float>> &inVector)
+/********************************************
+ *       Purpose: outVector = (F_0 @ F_1 @ ... @ F_{k-1}) inVector without forming the product.
+ *                The factors are applied one at a time, F_0 first. Before factor f is applied the vector is 
+ *                an L x cols(F_f) x R array, with L the product of the rows of F_0 .. F_{f-1} and R the 
+ *                product of the columns of F_{f+1} .. F_{k-1}. Applying F_f turns the middle index into rows(F_f).
+ *                For n factors of size d that is O(n d 2^n) work for a length 2^n vector.
+ *  Precondition: inVector has inOperator.GetColSize() entries.
+ * Postcondition: outVector is resized to inOperator.GetRowSize() entries. Identity factors are skipped. 
+ *                A per thread scratch vector holds every other intermediate, so repeated calls do not allocate.
+********************************************/ 
+{
+    if ( inVector.size() != inOperator.m_iColSize ) {
+        cout << "ERROR: Unable to multiply a " << inOperator.m_iRowSize << " x " << inOperator.m_iColSize << " Kronecker operator with a vector of " 
+             << inVector.size() << " entries." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    if ( &outVector == &inVector ) {
+        vector<complex<float>> m_vecResult(inOperator.m_iRowSize);
+        MultiplyInto(m_vecResult, inOperator, inVector);
+        outVector.swap(m_vecResult);
+        return;
+    }
+
+    thread_local vector<size_t> t_vecSteps;
+    vector<size_t> &m_vecSteps = t_vecSteps;
+    m_vecSteps.clear();
+    size_t m_iMaxLength = max(inOperator.m_iRowSize, inOperator.m_iColSize);
+    size_t m_iLength = inOperator.m_iColSize;
+    for ( size_t f = 0; f < inOperator.m_vecFactors.size(); f++ ) {
+        if ( inOperator.m_vecIsIdentity[f] )
+            continue;
+        m_vecSteps.push_back(f);
+        if ( inOperator.m_vecFactors[f].GetColSize() != 0 )
+            m_iLength = m_iLength / inOperator.m_vecFactors[f].GetColSize() * inOperator.m_vecFactors[f].GetRowSize();
+        m_iMaxLength = max(m_iMaxLength, m_iLength);
+    }
+    if ( m_vecSteps.empty() ) {
+        outVector.assign(inVector.begin(), inVector.end());
+        return;
+    }
+
+    // The last step must write into outVector, so the steps alternate backwards from it.
+    thread_local vector<complex<float>> t_vecScratch;
+    if ( m_vecSteps.size() > 1 && t_vecScratch.size() < m_iMaxLength )
+        t_vecScratch.resize(m_iMaxLength);
+    outVector.resize(m_iMaxLength);
+
+    const complex<float> *m_pSource = inVector.data();
+    size_t m_iLeftSize = 1;
+    size_t m_iRightSize = inOperator.m_iColSize;
+    size_t m_iNextFactor = 0;
+    for ( size_t t = 0; t < m_vecSteps.size(); t++ ) {
+        const size_t f = m_vecSteps[t];
+        // Skipped identity factors keep their size, so they only move from the right block to the left block.
+        for ( ; m_iNextFactor < f; m_iNextFactor++ ) {
+            m_iLeftSize *= inOperator.m_vecFactors[m_iNextFactor].GetRowSize();
+            m_iRightSize /= max<size_t>(1, inOperator.m_vecFactors[m_iNextFactor].GetColSize());
+        }
+        const CMatrix &m_mFactor = inOperator.m_vecFactors[f];
+        m_iRightSize /= max<size_t>(1, m_mFactor.GetColSize());
+
+        complex<float> *m_pTarget = ((m_vecSteps.size() - 1 - t) % 2 == 0) ? outVector.data() : t_vecScratch.data();
+        ApplyKroneckerFactor(m_pSource, m_pTarget, m_mFactor.View(), m_iLeftSize, m_iRightSize);
+
+        m_pSource = m_pTarget;
+        m_iLeftSize *= m_mFactor.GetRowSize();
+        m_iNextFactor = f + 1;
+    }
+    outVector.resize(inOperator.m_iRowSize);
+}
+
+
+void TestKroneckerOperator(const unsigned short int inNumOfTests, const unsigned short int inMaxNumOfFactors, const unsigned short int inLargeNumOfQubits)
+/********************************************
+ *       Purpose: Check CKroneckerOperator application, product and trace of random factors 
+ *                of different sizes and layouts, some of them identities, against the dense Kronecker product.
+ *                Then apply a random Pauli String to a state vector too large for a dense 
+ *                matrix and check it against ApplyPauliString().
+ *  Precondition: inMaxNumOfFactors >= 1. Keep inLargeNumOfQubits below 30.
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> factor_count_distribution(1, inMaxNumOfFactors);
+    uniform_int_distribution<int> factor_size_distribution(1, 3);
+    uniform_int_distribution<int> pauli_distribution(0, 3);
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using up to " << inMaxNumOfFactors << " factors" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        const int m_iNumOfFactors = factor_count_distribution(generator);
+        vector<CMatrix> m_vecFactors1;
+        vector<CMatrix> m_vecFactors2;
+        for ( int f = 0; f < m_iNumOfFactors; f++ ) {
+            const unsigned short int m_iFactorSize = factor_size_distribution(generator);
+            CMatrix m_mFactor1 = CMatrix(m_iFactorSize, m_iFactorSize, (f % 2 == 0) ? INTERLEAVED_LAYOUT : SPLIT_LAYOUT);
+            CMatrix m_mFactor2 = CMatrix(m_iFactorSize, m_iFactorSize);
+            for ( unsigned short int r = 0; r < m_iFactorSize; r++ )
+                for ( unsigned short int c = 0; c < m_iFactorSize; c++ ) {
+                    m_mFactor1.ModifyValueAt(r, c, (f % 3 == 1) ? complex<float>((r == c) ? 1.0f : 0.0f, 0) 
+                                                                : complex<float>(entry_distribution(generator), entry_distribution(generator)));
+                    m_mFactor2.ModifyValueAt(r, c, complex<float>(entry_distribution(generator), entry_distribution(generator)));
+                }
+            m_vecFactors1.push_back(m_mFactor1);
+            m_vecFactors2.push_back(m_mFactor2);
+        }
+        const CKroneckerOperator m_koOperator1 = CKroneckerOperator(m_vecFactors1);
+        const CKroneckerOperator m_koOperator2 = CKroneckerOperator(m_vecFactors2);
+        const CMatrix m_mDense1 = m_koOperator1.ToMatrix();
+        const CMatrix m_mDense2 = m_koOperator2.ToMatrix();
+
+        vector<complex<float>> m_vecVector(m_koOperator1.GetColSize());
+        for ( size_t r = 0; r < m_vecVector.size(); r++ )
+            m_vecVector[r] = complex<float>(entry_distribution(generator), entry_distribution(generator));
+
+        // Application, out of place and in place.
+        const vector<complex<float>> m_vecExpected = m_mDense1 * m_vecVector;
+        const vector<complex<float>> m_vecResult = m_koOperator1 * m_vecVector;
+        vector<complex<float>> m_vecInPlace = m_vecVector;
+        MultiplyInto(m_vecInPlace, m_koOperator1, m_vecInPlace);
+        bool m_bIsCorrect = (m_vecResult.size() == m_vecExpected.size() && m_vecInPlace == m_vecResult);
+        for ( size_t r = 0; m_bIsCorrect && r < m_vecExpected.size(); r++ )
+            if ( abs(m_vecResult[r] - m_vecExpected[r]) > 1e-4f * (1 + abs(m_vecExpected[r])) )
+                m_bIsCorrect = false;
+
+        // Factor by factor product.
+        const CMatrix m_mExpectedProduct = m_mDense1 * m_mDense2;
+        const CMatrix m_mProduct = (m_koOperator1 * m_koOperator2).ToMatrix();
+        for ( unsigned short int r = 0; r < m_mProduct.GetRowSize(); r++ )
+            for ( unsigned short int c = 0; c < m_mProduct.GetColSize(); c++ )
+                if ( abs(m_mProduct.GetValueAt(r, c) - m_mExpectedProduct.GetValueAt(r, c)) > 1e-4f * (1 + abs(m_mExpectedProduct.GetValueAt(r, c))) )
+                    m_bIsCorrect = false;
+
+        // Trace as a product of factor traces.
+        const complex<float> m_cxExpectedTrace = m_mDense2.Trace();
+        if ( abs(m_koOperator2.Trace() - m_cxExpectedTrace) > 1e-4f * (1 + abs(m_cxExpectedTrace)) )
+            m_bIsCorrect = false;
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": Kronecker operator of " << m_iNumOfFactors << " factors does NOT match the dense Kronecker product." << endl;
+        }
+    }
+
+    // A random Pauli String on a state vector far larger than a dense matrix could act on.
+    CPauliString m_psLargePauli = CPauliString(inLargeNumOfQubits);
+    for ( unsigned short int q = 0; q < inLargeNumOfQubits; q++ )
+        m_psLargePauli.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+    m_psLargePauli.SetPhaseExponent(pauli_distribution(generator));
+
+    vector<complex<float>> m_vecLargeState(size_t(1) << inLargeNumOfQubits);
+    for ( size_t r = 0; r < m_vecLargeState.size(); r++ )
+        m_vecLargeState[r] = complex<float>(entry_distribution(generator), entry_distribution(generator));
+    vector<complex<float>> m_vecExpectedState;
+    ApplyPauliString(m_vecLargeState, m_psLargePauli, m_vecExpectedState);
+
+    const CKroneckerOperator m_koLargeOperator = CKroneckerOperator(m_psLargePauli);
+    vector<complex<float>> m_vecLargeResult;
+    chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+    MultiplyInto(m_vecLargeResult, m_koLargeOperator, m_vecLargeState);
+    chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+
+    const complex<float> m_cxExpectedTrace = (m_psLargePauli.Weight() == 0) ? m_psLargePauli.GetPhase() * float(size_t(1) << inLargeNumOfQubits) : complex<float>(0, 0);
+    if ( m_vecLargeResult == m_vecExpectedState && m_koLargeOperator.Trace() == m_cxExpectedTrace )
+        m_iNumOfSuccTests++;
+    else {
+        m_iNumOfUnsuccTests++;
+        cout << "Test " << inNumOfTests + 1 << ": The Kronecker operator of " << m_psLargePauli.PauliStringToString().substr(0, 16) 
+             << (inLargeNumOfQubits > 16 ? ". . ." : "") << " does NOT match ApplyPauliString()." << endl;
+    }
+    cout << "Applied a " << inLargeNumOfQubits << " factor Kronecker operator to a " << m_vecLargeState.size() 
+         << " entry vector in " << m_tElapsed.count() << " seconds." << endl;
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful Kronecker operator tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL Kronecker operator tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void BenchmarkKroneckerOperator(const vector<unsigned short int> &inNumOfQubits, const unsigned short int inNumOfRepeats)
+/********************************************
+ *       Purpose: Print the time of applying n random 2 x 2 factors as a CKroneckerOperator 
+ *                against building their dense Kronecker product and applying that, for every qubit count in inNumOfQubits.
+ *  Precondition: inNumOfRepeats >= 1. Qubit counts are at most 13, the dense matrix takes 8 * 4^n bytes.
+ * Postcondition: The best of inNumOfRepeats runs is reported for each.
+********************************************/ 
+{
+    default_random_engine generator;
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+
+    for ( size_t i = 0; i < inNumOfQubits.size(); i++ ) {
+        vector<CMatrix> m_vecFactors;
+        for ( unsigned short int q = 0; q < inNumOfQubits[i]; q++ )
+            m_vecFactors.push_back(GenerateRandomMatrix(2, generator));
+        const CKroneckerOperator m_koOperator = CKroneckerOperator(m_vecFactors);
+        const vector<complex<float>> m_vecVector(m_koOperator.GetColSize(), complex<float>(1, 0));
+        vector<complex<float>> m_vecResult;
+
+        double m_dBestFactoredTime = 0;
+        double m_dBestDenseTime = 0;
+        double m_dBestDenseApplyTime = 0;
+        for ( unsigned short int t = 0; t < inNumOfRepeats; t++ ) {
+            chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+            MultiplyInto(m_vecResult, m_koOperator, m_vecVector);
+            chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            if ( t == 0 || m_tElapsed.count() < m_dBestFactoredTime )
+                m_dBestFactoredTime = m_tElapsed.count();
+
+            m_tStart = chrono::steady_clock::now();
+            const CMatrix m_mDense = m_koOperator.ToMatrix();
+            chrono::steady_clock::time_point m_tBuilt = chrono::steady_clock::now();
+            MultiplyInto(m_vecResult, m_mDense, m_vecVector);
+            chrono::steady_clock::time_point m_tEnd = chrono::steady_clock::now();
+            m_tElapsed = m_tEnd - m_tStart;
+            if ( t == 0 || m_tElapsed.count() < m_dBestDenseTime )
+                m_dBestDenseTime = m_tElapsed.count();
+            m_tElapsed = m_tEnd - m_tBuilt;
+            if ( t == 0 || m_tElapsed.count() < m_dBestDenseApplyTime )
+                m_dBestDenseApplyTime = m_tElapsed.count();
+        }
+        cout << inNumOfQubits[i] << " qubits Kronecker operator apply: " << m_dBestFactoredTime << " seconds" << endl;
+        cout << inNumOfQubits[i] << " qubits   Dense build and apply: " << m_dBestDenseTime << " seconds (apply alone " << m_dBestDenseApplyTime << " seconds)" << endl;
+    }
+}
+
+
+CMonomialMatrix::CMonomialMatrix()
+/********************************************
+ *       Purpose: Initialize a 0 x 0 monomial matrix.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+}
+
+
+CMonomialMatrix::CMonomialMatrix(const size_t inSize) : m_vecColumns(inSize), m_vecValues(inSize, complex<float>(1, 0))
+/********************************************
+ *       Purpose: Initialize the inSize x inSize identity matrix.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    for ( size_t r = 0; r < inSize; r++ )
+        m_vecColumns[r] = r;
+}
+
+
+CMonomialMatrix::CMonomialMatrix(const vector<size_t> &inColumns, const vector<complex<float>> &inValues) 
+    : m_vecColumns(inColumns), m_vecValues(inValues)
+/********************************************
+ *       Purpose: Initialize the matrix whose row r holds inValues[r] in column inColumns[r].
+ *  Precondition: Both vectors have the same length N and every column is below N.
+ * Postcondition: Columns may repeat, so the matrix need not be invertible.
+********************************************/ 
+{
+    bool m_bIsValid = (inColumns.size() == inValues.size());
+    for ( size_t r = 0; m_bIsValid && r < inColumns.size(); r++ )
+        m_bIsValid = (inColumns[r] < inColumns.size());
+    if ( !m_bIsValid ) {
+        cout << "ERROR: A monomial matrix needs one value per row and columns below " << inColumns.size() << ", but it has " 
+             << inValues.size() << " values." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+}
+
+
+CMonomialMatrix::CMonomialMatrix(const CPauliString &inPauli)
+/********************************************
+ *       Purpose: Initialize the 2^n x 2^n matrix of the Pauli String i^k P(x, z) in O(2^n).
+ *                Row r has its entry in column c = r ^ x, with value i^(k + popcount(x & z)) (-1)^popcount(c & z).
+ *                Qubit q is bit n - 1 - q of r, as in ApplyPauliString().
+ *  Precondition: At most 62 qubits.
+ * Postcondition: Rows are split across threads.
+********************************************/ 
+{
+    if ( inPauli.GetNumOfQubits() > 62 ) {
+        cout << "ERROR: A " << inPauli.GetNumOfQubits() << " qubit Pauli String has too many rows for a monomial matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    const size_t m_iSize = size_t(1) << inPauli.GetNumOfQubits();
+    const uint64_t m_iXMask = inPauli.GetXMask();
+    const uint64_t m_iZMask = inPauli.GetZMask();
+    const complex<float> m_cxPhase = MultiplyByPowerOfI(complex<float>(1, 0), inPauli.GetPhaseExponent() + PopCount64(m_iXMask & m_iZMask));
+    m_vecColumns.resize(m_iSize);
+    m_vecValues.resize(m_iSize);
+    ParallelFor(0, m_iSize, PARALLEL_GRAIN_SIZE, [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            const size_t c = r ^ m_iXMask;
+            m_vecColumns[r] = c;
+            m_vecValues[r] = (PopCount64(c & m_iZMask) & 1) ? -m_cxPhase : m_cxPhase;
+        }
+    });
+}
+
+
+CMonomialMatrix CMonomialMatrix::operator*(const CMonomialMatrix &inMonomial2) const
+/********************************************
+ *       Purpose: Return the product of two monomial matrices, which is monomial again.
+ *                Row r of A B is A[r] times row c = A.column[r] of B, so it sits in column B.column[c].
+ *  Precondition: Both matrices are the same size.
+ * Postcondition: Runs in O(N). Neither matrix is modified.
+********************************************/ 
+{
+    if ( GetSize() != inMonomial2.GetSize() ) {
+        cout << "ERROR: Unable to multiply monomial matrices of sizes " << GetSize() << " and " << inMonomial2.GetSize() << "." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    CMonomialMatrix m_mmResult;
+    m_mmResult.m_vecColumns.resize(GetSize());
+    m_mmResult.m_vecValues.resize(GetSize());
+    ParallelFor(0, GetSize(), PARALLEL_GRAIN_SIZE, [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            const size_t c = m_vecColumns[r];
+            m_mmResult.m_vecColumns[r] = inMonomial2.m_vecColumns[c];
+            m_mmResult.m_vecValues[r] = CElementwiseMultiplyOperation::Apply(m_vecValues[r], inMonomial2.m_vecValues[c]);
+        }
+    });
+    return m_mmResult;
+}
+
+
+CMatrix CMonomialMatrix::operator*(const CMatrix &inMatrix) const
+/********************************************
+ *       Purpose: Return this monomial matrix times a dense CMatrix.
+ *  Precondition: Both matrices are the same size.
+ * Postcondition: The result uses the layout of inMatrix. See MultiplyInto().
+********************************************/ 
+{
+    CMatrix m_mResult = CMatrix(0, 0, inMatrix.GetLayout());
+    MultiplyInto(m_mResult, *this, inMatrix);
+    return m_mResult;
+}
+
+
+CMatrix operator*(const CMatrix &inMatrix, const CMonomialMatrix &inMonomial)
+/********************************************
+ *       Purpose: Return a dense CMatrix times a monomial matrix.
+ *  Precondition: Both matrices are the same size.
+ * Postcondition: The result uses the layout of inMatrix. See MultiplyInto().
+********************************************/ 
+{
+    CMatrix m_mResult = CMatrix(0, 0, inMatrix.GetLayout());
+    MultiplyInto(m_mResult, inMatrix, inMonomial);
+    return m_mResult;
+}
+
+
+vector<complex<float>> CMonomialMatrix::operator*(const vector<complex<float>> &inVector) const
+/********************************************
+ *       Purpose: Return this monomial matrix times inVector.
+ *  Precondition: inVector has GetSize() entries.
+ * Postcondition: inVector is not modified. See MultiplyInto().
+********************************************/ 
+{
+    vector<complex<float>> m_vecResult(GetSize());
+    MultiplyInto(m_vecResult, *this, inVector);
+    return m_vecResult;
+}
+
+
+CMatrix CMonomialMatrix::ToMatrix(const EMatrixLayout inLayout) const
+/********************************************
+ *       Purpose: Return the dense matrix, 0 outside of the stored entries.
+ *  Precondition: GetSize() is at most MAX_SIDE_LENGTH.
+ * Postcondition: The result uses inLayout.
+********************************************/ 
+{
+    if ( GetSize() > MAX_SIDE_LENGTH ) {
+        cout << "ERROR: A " << GetSize() << " x " << GetSize() << " monomial matrix is too large for a dense CMatrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    CMatrix m_mResult = CMatrix(GetSize(), GetSize(), inLayout);
+    for ( size_t r = 0; r < GetSize(); r++ )
+        m_mResult(r, m_vecColumns[r]) = m_vecValues[r];
+    return m_mResult;
+}
+
+
+void CMonomialMatrix::ToCSR(vector<size_t> &outRowPointers, vector<size_t> &outColIndices, vector<complex<float>> &outValues) const
+/********************************************
+ *       Purpose: Write the matrix in compressed sparse row format. The entries of row r are 
+ *                outColIndices[k] and outValues[k] for outRowPointers[r] <= k < outRowPointers[r + 1].
+ *  Precondition: N/A
+ * Postcondition: outRowPointers has GetSize() + 1 entries. Stored 0's are left out, so a row holds 0 or 1 entries.
+********************************************/ 
+{
+    outRowPointers.assign(1, 0);
+    outRowPointers.reserve(GetSize() + 1);
+    outColIndices.clear();
+    outValues.clear();
+    for ( size_t r = 0; r < GetSize(); r++ ) {
+        if ( m_vecValues[r] != complex<float>(0, 0) ) {
+            outColIndices.push_back(m_vecColumns[r]);
+            outValues.push_back(m_vecValues[r]);
+        }
+        outRowPointers.push_back(outValues.size());
+    }
+}
+
+
+void MultiplyInto(vector<complex<float>> &outVector, const CMonomialMatrix &inMonomial, const vector<complex<float>> &inVector)
+/********************************************
+ *       Purpose: outVector[r] = value[r] inVector[column[r]], in O(N).
+ *  Precondition: inVector has inMonomial.GetSize() entries.
+ * Postcondition: outVector is resized to inMonomial.GetSize() entries. 
+ *                When outVector is inVector the product is formed in a temporary first.
+********************************************/ 
+{
+    if ( inVector.size() != inMonomial.GetSize() ) {
+        cout << "ERROR: Unable to multiply a " << inMonomial.GetSize() << " x " << inMonomial.GetSize() << " monomial matrix with a vector of " 
+             << inVector.size() << " entries." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+
+    if ( &outVector == &inVector ) {
+        vector<complex<float>> m_vecResult(inMonomial.GetSize());
+        MultiplyInto(m_vecResult, inMonomial, inVector);
+        outVector.swap(m_vecResult);
+        return;
+    }
+
+    outVector.resize(inMonomial.GetSize());
+    ParallelFor(0, inMonomial.GetSize(), PARALLEL_GRAIN_SIZE, [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ )
+            outVector[r] = CElementwiseMultiplyOperation::Apply(inMonomial.GetValueOfRow(r), inVector[inMonomial.GetColumnOfRow(r)]);
+    });
+}
+
+
+static void CheckMonomialProductSize(const CMonomialMatrix &inMonomial, const CMatrix &inMatrix)
+/********************************************
+ *       Purpose: Exit unless a monomial matrix and a dense CMatrix are the same size.
+ *  Precondition: N/A
+ * Postcondition: N/A
+********************************************/ 
+{
+    if ( inMonomial.GetSize() != inMatrix.GetRowSize() || inMonomial.GetSize() != inMatrix.GetColSize() ) {
+        cout << "ERROR: Unable to multiply a " << inMonomial.GetSize() << " x " << inMonomial.GetSize() << " monomial matrix with a " 
+             << inMatrix.GetRowSize() << " x " << inMatrix.GetColSize() << " matrix." << '\n'
+             << "EXITING PROGRAM . . ." << endl;
+        exit(1);
+    }
+}
+
+
+void MultiplyInto(CMatrix &outMatrix, const CMonomialMatrix &inMonomial, const CMatrix &inMatrix)
+/********************************************
+ *       Purpose: outMatrix = M inMatrix. Row r of the product is row column[r] of inMatrix scaled by value[r], 
+ *                so it costs O(N^2) instead of the O(N^3) of a dense product.
+ *  Precondition: Both matrices are the same size.
+ * Postcondition: outMatrix keeps its layout. When outMatrix is inMatrix the product is formed in a temporary first.
+********************************************/ 
+{
+    CheckMonomialProductSize(inMonomial, inMatrix);
+    if ( &outMatrix == &inMatrix ) {
+        CMatrix m_mResult = CMatrix(0, 0, outMatrix.m_eLayout);
+        MultiplyInto(m_mResult, inMonomial, inMatrix);
+        outMatrix = std::move(m_mResult);
+        return;
+    }
+
+    const size_t m_iSize = inMonomial.GetSize();
+    outMatrix.Resize(inMatrix.m_iRowSize, inMatrix.m_iColSize);
+    const bool m_bIsInterleaved = (outMatrix.m_eLayout == INTERLEAVED_LAYOUT && inMatrix.m_eLayout == INTERLEAVED_LAYOUT);
+    const size_t m_iPlaneSize = outMatrix.GetPlaneSize();
+    ParallelFor(0, m_iSize, max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, m_iSize)), [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            const size_t m_iSourceRow = inMonomial.GetColumnOfRow(r);
+            const complex<float> m_cxValue = inMonomial.GetValueOfRow(r);
+            if ( m_bIsInterleaved ) {
+                const complex<float> *m_pSource = inMatrix.m_vecMatrix.data() + m_iSourceRow * m_iSize;
+                complex<float> *m_pTarget = outMatrix.m_vecMatrix.data() + r * m_iSize;
+                for ( size_t c = 0; c < m_iSize; c++ )
+                    m_pTarget[c] = CElementwiseMultiplyOperation::Apply(m_cxValue, m_pSource[c]);
+                continue;
+            }
+            for ( size_t c = 0; c < m_iSize; c++ ) {
+                const complex<float> m_cxEntry = CElementwiseMultiplyOperation::Apply(m_cxValue, inMatrix.EntryAt(m_iSourceRow, c));
+                if ( outMatrix.m_eLayout == INTERLEAVED_LAYOUT )
+                    outMatrix.m_vecMatrix[r * m_iSize + c] = m_cxEntry;
+                else {
+                    outMatrix.m_vecSplitMatrix[r * m_iSize + c] = m_cxEntry.real();
+                    outMatrix.m_vecSplitMatrix[m_iPlaneSize + r * m_iSize + c] = m_cxEntry.imag();
+                }
+            }
+        }
+    });
+}
+
+
+void MultiplyInto(CMatrix &outMatrix, const CMatrix &inMatrix, const CMonomialMatrix &inMonomial)
+/********************************************
+ *       Purpose: outMatrix = inMatrix M. Column k of inMatrix, scaled by value[k], becomes column column[k] 
+ *                of the product, so it costs O(N^2) instead of the O(N^3) of a dense product.
+ *  Precondition: Both matrices are the same size.
+ * Postcondition: outMatrix keeps its layout. Columns that no row of M maps to are 0. 
+ *                When outMatrix is inMatrix the product is formed in a temporary first.
+********************************************/ 
+{
+    CheckMonomialProductSize(inMonomial, inMatrix);
+    if ( &outMatrix == &inMatrix ) {
+        CMatrix m_mResult = CMatrix(0, 0, outMatrix.m_eLayout);
+        MultiplyInto(m_mResult, inMatrix, inMonomial);
+        outMatrix = std::move(m_mResult);
+        return;
+    }
+
+    const size_t m_iSize = inMonomial.GetSize();
+    outMatrix.Resize(inMatrix.m_iRowSize, inMatrix.m_iColSize);
+    const size_t m_iPlaneSize = outMatrix.GetPlaneSize();
+    ParallelFor(0, m_iSize, max<size_t>(1, PARALLEL_GRAIN_SIZE / max<size_t>(1, m_iSize)), [&](size_t inRowBegin, size_t inRowEnd) {
+        for ( size_t r = inRowBegin; r < inRowEnd; r++ ) {
+            // Several rows of M may share a column, so each row of the product is cleared and accumulated.
+            if ( outMatrix.m_eLayout == INTERLEAVED_LAYOUT )
+                fill(outMatrix.m_vecMatrix.begin() + r * m_iSize, outMatrix.m_vecMatrix.begin() + (r + 1) * m_iSize, complex<float>(0, 0));
+            else {
+                fill(outMatrix.m_vecSplitMatrix.begin() + r * m_iSize, outMatrix.m_vecSplitMatrix.begin() + (r + 1) * m_iSize, 0.0f);
+                fill(outMatrix.m_vecSplitMatrix.begin() + m_iPlaneSize + r * m_iSize, outMatrix.m_vecSplitMatrix.begin() + m_iPlaneSize + (r + 1) * m_iSize, 0.0f);
+            }
+            for ( size_t k = 0; k < m_iSize; k++ ) {
+                const complex<float> m_cxEntry = CElementwiseMultiplyOperation::Apply(inMatrix.EntryAt(r, k), inMonomial.GetValueOfRow(k));
+                const size_t m_iIndex = r * m_iSize + inMonomial.GetColumnOfRow(k);
+                if ( outMatrix.m_eLayout == INTERLEAVED_LAYOUT )
+                    outMatrix.m_vecMatrix[m_iIndex] += m_cxEntry;
+                else {
+                    outMatrix.m_vecSplitMatrix[m_iIndex] += m_cxEntry.real();
+                    outMatrix.m_vecSplitMatrix[m_iPlaneSize + m_iIndex] += m_cxEntry.imag();
+                }
+            }
+        }
+    });
+}
+
+
+void TestMonomialMatrix(const unsigned short int inNumOfQubits, const unsigned short int inNumOfTests, const unsigned short int inLargeNumOfQubits)
+/********************************************
+ *       Purpose: Check CMonomialMatrix of random Pauli Strings and phases against the dense matrix: 
+ *                every entry, the dense and CSR conversions, products with vectors, with dense 
+ *                matrices of both layouts on either side, and with another Pauli String. 
+ *                Then build and apply one for a Pauli String far too large for a dense matrix.
+ *  Precondition: 1 <= inNumOfQubits and keep it small, the dense check is O(8^n). Keep inLargeNumOfQubits below 30.
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> pauli_distribution(0, 3);
+    uniform_real_distribution<float> entry_distribution(-1, 1);
+    const char m_arrcPauliChars[4] = { 'I', 'X', 'Y', 'Z' };
+    const unsigned short int m_iSideLength = (unsigned short int) (1 << inNumOfQubits);
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using " << inNumOfQubits << " qubit Pauli Strings" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        CPauliString m_psPauli1 = CPauliString(inNumOfQubits);
+        CPauliString m_psPauli2 = CPauliString(inNumOfQubits);
+        for ( unsigned short int q = 0; q < inNumOfQubits; q++ ) {
+            m_psPauli1.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+            m_psPauli2.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+        }
+        m_psPauli1.SetPhaseExponent(pauli_distribution(generator));
+        m_psPauli2.SetPhaseExponent(pauli_distribution(generator));
+
+        const CMonomialMatrix m_mmPauli1 = CMonomialMatrix(m_psPauli1);
+        const CMonomialMatrix m_mmPauli2 = CMonomialMatrix(m_psPauli2);
+        const CMatrix m_mDense1 = m_psPauli1.ToPauliAlgebraElement();
+        const CMatrix m_mDense2 = m_psPauli2.ToPauliAlgebraElement();
+
+        // Every entry, and the dense and CSR conversions.
+        bool m_bIsCorrect = (m_mmPauli1.GetSize() == m_iSideLength && m_mmPauli1.ToMatrix().GetMatrix() == m_mDense1.GetMatrix() 
+                             && m_mmPauli1.ToMatrix(SPLIT_LAYOUT).GetMatrix() == m_mDense1.GetMatrix());
+        vector<size_t> m_vecRowPointers;
+        vector<size_t> m_vecColIndices;
+        vector<complex<float>> m_vecValues;
+        m_mmPauli1.ToCSR(m_vecRowPointers, m_vecColIndices, m_vecValues);
+        if ( m_vecRowPointers.size() != size_t(m_iSideLength) + 1 || m_vecValues.size() != m_iSideLength )
+            m_bIsCorrect = false;
+        for ( unsigned short int r = 0; m_bIsCorrect && r < m_iSideLength; r++ ) {
+            if ( m_vecRowPointers[r] != r || m_mDense1.GetValueAt(r, (unsigned short int) m_vecColIndices[r]) != m_vecValues[r] )
+                m_bIsCorrect = false;
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                if ( m_mmPauli1.GetValueAt(r, c) != m_mDense1.GetValueAt(r, c) )
+                    m_bIsCorrect = false;
+        }
+
+        // Products with a vector, with dense matrices on either side, and with another Pauli String.
+        vector<complex<float>> m_vecVector(m_iSideLength);
+        for ( size_t r = 0; r < m_vecVector.size(); r++ )
+            m_vecVector[r] = complex<float>(entry_distribution(generator), entry_distribution(generator));
+        vector<complex<float>> m_vecExpected;
+        ApplyPauliString(m_vecVector, m_psPauli1, m_vecExpected);
+        vector<complex<float>> m_vecInPlace = m_vecVector;
+        MultiplyInto(m_vecInPlace, m_mmPauli1, m_vecInPlace);
+        if ( m_mmPauli1 * m_vecVector != m_vecExpected || m_vecInPlace != m_vecExpected )
+            m_bIsCorrect = false;
+
+        CMatrix m_mDense = CMatrix(m_iSideLength, m_iSideLength, (i % 2 == 0) ? INTERLEAVED_LAYOUT : SPLIT_LAYOUT);
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ )
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                m_mDense.ModifyValueAt(r, c, complex<float>(entry_distribution(generator), entry_distribution(generator)));
+        const CMatrix m_mLeftExpected = m_mDense1 * m_mDense;
+        const CMatrix m_mRightExpected = m_mDense * m_mDense1;
+        const CMatrix m_mLeft = m_mmPauli1 * m_mDense;
+        const CMatrix m_mRight = m_mDense * m_mmPauli1;
+        for ( unsigned short int r = 0; r < m_iSideLength; r++ )
+            for ( unsigned short int c = 0; c < m_iSideLength; c++ )
+                if ( abs(m_mLeft.GetValueAt(r, c) - m_mLeftExpected.GetValueAt(r, c)) > 1e-5f 
+                     || abs(m_mRight.GetValueAt(r, c) - m_mRightExpected.GetValueAt(r, c)) > 1e-5f )
+                    m_bIsCorrect = false;
+
+        if ( (m_mmPauli1 * m_mmPauli2).ToMatrix().GetMatrix() != CMonomialMatrix(m_psPauli1 * m_psPauli2).ToMatrix().GetMatrix() 
+             || (m_mmPauli1 * m_mmPauli2).ToMatrix().GetMatrix() != (m_mDense1 * m_mDense2).GetMatrix() )
+            m_bIsCorrect = false;
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": Monomial matrix of " << m_psPauli1.PauliStringToString() << " does NOT match the dense matrix." << endl;
+        }
+    }
+
+    // A Pauli String far too large for a dense matrix.
+    CPauliString m_psLargePauli = CPauliString(inLargeNumOfQubits);
+    for ( unsigned short int q = 0; q < inLargeNumOfQubits; q++ )
+        m_psLargePauli.SetPauliAt(q, m_arrcPauliChars[pauli_distribution(generator)]);
+    m_psLargePauli.SetPhaseExponent(pauli_distribution(generator));
+
+    chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+    const CMonomialMatrix m_mmLargePauli = CMonomialMatrix(m_psLargePauli);
+    chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+
+    vector<complex<float>> m_vecLargeState(m_mmLargePauli.GetSize());
+    for ( size_t r = 0; r < m_vecLargeState.size(); r++ )
+        m_vecLargeState[r] = complex<float>(entry_distribution(generator), entry_distribution(generator));
+    vector<complex<float>> m_vecLargeExpected;
+    ApplyPauliString(m_vecLargeState, m_psLargePauli, m_vecLargeExpected);
+    if ( m_mmLargePauli * m_vecLargeState == m_vecLargeExpected )
+        m_iNumOfSuccTests++;
+    else {
+        m_iNumOfUnsuccTests++;
+        cout << "Test " << inNumOfTests + 1 << ": The " << inLargeNumOfQubits << " qubit monomial matrix does NOT match ApplyPauliString()." << endl;
+    }
+    cout << "Built a " << inLargeNumOfQubits << " qubit monomial matrix in " << m_tElapsed.count() << " seconds." << endl;
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful monomial matrix tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL monomial matrix tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void TestSteadyStateAllocations(const unsigned short int inSideLength, const unsigned short int inNumOfRepeats)
+/********************************************
+ *       Purpose: Check that the *Into(), in place, view and move operations do no heap allocations once 
+ *                their outputs and scratch buffers have the right size. Each operation runs once to warm up, 
+ *                then inNumOfRepeats more times while GetNumOfAllocations() must stay the same.
+ *  Precondition: inSideLength is a power of 2 of at least 4. Pauli_Matrix_Library.cc is compiled with 
+ *                PML_COUNT_ALLOCATIONS, otherwise nothing is tested.
+ * Postcondition: The tests run on one thread, since every worker allocates its own scratch buffers the first 
+ *                time it runs an operation. The number of threads is restored afterwards.
+********************************************/ 
+{
+#if !defined(PML_COUNT_ALLOCATIONS)
+    cout << "Allocations are not counted. Compile with -DPML_COUNT_ALLOCATIONS to run these tests." << endl;
+    (void) inSideLength;
+    (void) inNumOfRepeats;
+#else
+    static default_random_engine generator;
+    const unsigned short int m_iNumOfQubits = (unsigned short int) PopCount64(HighestSetBit(inSideLength) - 1);
+    const string m_sPauli1 = string("XYZI").substr(0, min<size_t>(4, m_iNumOfQubits)) + string(m_iNumOfQubits - min<size_t>(4, m_iNumOfQubits), 'Y');
+    const string m_sPauli2 = string(m_iNumOfQubits, 'Z');
+
+    CMatrix m_mMatrix1 = GenerateRandomMatrix(inSideLength, generator);
+    CMatrix m_mMatrix2 = GenerateRandomMatrix(inSideLength, generator);
+    CMatrix m_mResult = CMatrix(inSideLength, inSideLength);
+    CMatrix m_mSplit1 = m_mMatrix1;
+    CMatrix m_mSplit2 = m_mMatrix2;
+    CMatrix m_mSplitResult = CMatrix(inSideLength, inSideLength, SPLIT_LAYOUT);
+    m_mSplit1.SetLayout(SPLIT_LAYOUT);
+    m_mSplit2.SetLayout(SPLIT_LAYOUT);
+    vector<complex<float>> m_vecVector(inSideLength, complex<float>(1, -1));
+    vector<complex<float>> m_vecResult(inSideLength);
+    const vector<CMatrix> m_vecFactors = { GenerateRandomMatrix(2, generator), GenerateRandomMatrix(inSideLength / 2, generator) };
+    CMatrix m_mKronecker = CMatrix(inSideLength, inSideLength, SPLIT_LAYOUT);
+    const CPauliString m_psPauli = CPauliString(m_sPauli1);
+    const CMonomialMatrix m_mmPauli = CMonomialMatrix(m_psPauli);
+    const CKroneckerOperator m_koPauli = CKroneckerOperator(m_psPauli);
+    CPauliAlgebraElement m_paeElement1 = MakePauliAlgebraElement(m_sPauli1);
+    const CPauliAlgebraElement m_paeElement2 = MakePauliAlgebraElement(m_sPauli2);
+    const CPauliAlgebraElement m_paeScaled1 = m_paeElement1 * complex<float>(2, -1);
+    CPauliAlgebraElement m_paeSum = CPauliAlgebraElement(0, 0);
+    CPauliAlgebraElement m_paeProduct = CPauliAlgebraElement(0, 0);
+    complex<float> m_cxSink = 0;
+
+    const char *m_arrsOperations[] = { 
+        "MultiplyInto(C, A, B)", "MultiplyInto(C, A, B) with split layouts", "MultiplyInto(w, A, v)", 
+        "C = A + B.Adjoint()", "C = A - z * B with split layouts", "Copy assignment", "Move construction and move assignment", 
+        "C.Row(0) = A.Column(1).Adjoint()", "KroneckerProductInto(K, F1, F2)", "KroneckerProductInto(K, {F1, F2})", 
+        "AddPauliAlgebraInto()", "MultiplyPauliAlgebraInto()", "CPauliAlgebraElement *= z", 
+        "LeftMultiplyPauli() and RightMultiplyPauli()", "Matrix reductions", "MultiplyInto() with a CMonomialMatrix", 
+        "MultiplyInto() with a CKroneckerOperator" 
+    };
+    const size_t m_iNumOfOperations = sizeof(m_arrsOperations) / sizeof(m_arrsOperations[0]);
+    auto RunOperation = [&](const size_t inOperation) {
+        switch ( inOperation ) {
+            case 0:  MultiplyInto(m_mResult, m_mMatrix1, m_mMatrix2); break;
+            case 1:  MultiplyInto(m_mSplitResult, m_mSplit1, m_mMatrix2); break;
+            case 2:  MultiplyInto(m_vecResult, m_mMatrix1, m_vecVector); break;
+            case 3:  m_mResult = m_mMatrix1 + m_mMatrix2.Adjoint(); break;
+            case 4:  m_mSplitResult = m_mSplit1 - complex<float>(0.5f, 1) * m_mSplit2; break;
+            case 5:  m_mResult = m_mMatrix2; break;
+            case 6:  { CMatrix m_mMoved = std::move(m_mMatrix1); m_mMatrix1 = std::move(m_mMoved); } break;
+            case 7:  m_mResult.Row(0) = m_mMatrix1.Column(1).Adjoint(); break;
+            case 8:  KroneckerProductInto(m_mKronecker, m_vecFactors[0], m_vecFactors[1]); break;
+            case 9:  KroneckerProductInto(m_mKronecker, m_vecFactors); break;
+            case 10: AddPauliAlgebraInto(m_paeSum, m_paeElement1, m_paeScaled1); break;
+            case 11: MultiplyPauliAlgebraInto(m_paeProduct, m_paeElement1, m_paeElement2); break;
+            case 12: m_paeElement1 *= complex<float>(0, 1); break;
+            case 13: LeftMultiplyPauli(m_mResult, m_psPauli); RightMultiplyPauli(m_mResult, m_psPauli); break;
+            case 14: m_cxSink += TraceWithPauli(m_mMatrix1, m_psPauli) + TraceOfProduct(m_mMatrix1, m_mMatrix2) 
+                                 + HilbertSchmidtInner(m_mSplit1, m_mSplit2) + FrobeniusNorm(m_mMatrix1); break;
+            case 15: MultiplyInto(m_vecResult, m_mmPauli, m_vecVector); MultiplyInto(m_mResult, m_mmPauli, m_mMatrix1); 
+                     MultiplyInto(m_mResult, m_mMatrix1, m_mmPauli); break;
+            case 16: MultiplyInto(m_vecResult, m_koPauli, m_vecVector); break;
+        }
+    };
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << m_iNumOfOperations << " operations, " << inNumOfRepeats << " repeats each" << endl;
+    cout << "Using " << inSideLength << " x " << inSideLength << " matrices" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    const size_t m_iInitialNumOfThreads = GetNumOfThreads();
+    SetNumOfThreads(1);
+    for ( size_t op = 0; op < m_iNumOfOperations; op++ ) {
+        RunOperation(op);
+        const size_t m_iAllocationsBefore = GetNumOfAllocations();
+        for ( unsigned short int i = 0; i < inNumOfRepeats; i++ )
+            RunOperation(op);
+        const size_t m_iNumOfAllocations = GetNumOfAllocations() - m_iAllocationsBefore;
+        if ( m_iNumOfAllocations == 0 )
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << op + 1 << ": " << m_arrsOperations[op] << " made " << m_iNumOfAllocations << " allocations in " 
+                 << inNumOfRepeats << " repeats." << endl;
+        }
+    }
+    SetNumOfThreads(m_iInitialNumOfThreads);
+
+    // The results must still be right, with the moved matrix back in place.
+    CMatrix m_mExpected = CMatrix(inSideLength, inSideLength);
+    MultiplyInto(m_mExpected, m_mMatrix1, m_mMatrix2);
+    MultiplyInto(m_mResult, m_mMatrix1, m_mMatrix2);
+    const CPauliAlgebraElement m_paeExpectedProduct = MakePauliAlgebraElement(m_sPauli1) % m_paeElement2;
+    if ( m_mResult.GetMatrix() == m_mExpected.GetMatrix() && m_mKronecker.GetMatrix() == KroneckerProduct(m_vecFactors).GetMatrix() 
+         && m_paeProduct.GetMatrix() == m_paeExpectedProduct.GetMatrix() )
+        m_iNumOfSuccTests++;
+    else {
+        m_iNumOfUnsuccTests++;
+        cout << "Test " << m_iNumOfOperations + 1 << ": Results of the allocation free operations are NOT correct." << endl;
+    }
+    if ( m_cxSink != m_cxSink ) cout << "Sink: " << m_cxSink << endl;
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful steady state allocation tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL steady state allocation tests: " << m_iNumOfUnsuccTests << endl;
+#endif
+}
+
 
-void CMatrix::ConjugateTranspose()
+static bool IsAligned(const void *inAddress, const size_t inAlignment)
 /********************************************
- *       Purpose: Take the complex conjugate and transpose of a matrix.
+ *       Purpose: Return whether inAddress is a multiple of inAlignment.
  *  Precondition: N/A
- * Postcondition: Matrix data member must have changed to its conjugate transpose.
- *          TODO: N/A
+ * Postcondition: N/A
 ********************************************/ 
 {
-    for ( unsigned short int r = 0; r < m_iRowSize; r++ ){
-        for ( unsigned short int c = r; c < m_iColSize; c++ ){
-            complex<float> m_cxEntry1 = GetValueAt(r, c);
-
-            if (m_cxEntry1.imag() != 0)
-                m_cxEntry1 = conj(m_cxEntry1);
-
-            complex<float> m_cxEntry2 = GetValueAt(c, r);
-
-            if (m_cxEntry2.imag() != 0)
-                m_cxEntry2 = conj(m_cxEntry2);            
-            
-            ModifyValueAt(r, c, m_cxEntry2);
-            ModifyValueAt(c, r, m_cxEntry1);
-        }
-    }
+    return reinterpret_cast<uintptr_t>(inAddress) % inAlignment == 0;
 }
 
 
-CMatrix GenerateHermitianMatrix(const unsigned short int inBoundParam, unsigned short int inSideLength)
+void TestSmallMatrixStorage(const unsigned short int inNumOfRepeats)
 /********************************************
- *       Purpose: Return a random Hermitian Matrix.
- *  Precondition: boundParam must be a positive real number.
- * Postcondition: Random Hermitian Matrix entries (both real and complex) 
- *                are bounded by the interval [-boundParam, boundParam]
- *          Note: N/A
- *          TODO: - In body, change matrix variable to be a Matrix object type. 
- *                  Update function body accordingly.
+ *       Purpose: Check CSmallVector as its elements move between the inline buffer and the heap, and check that 
+ *                CMatrix products, copies, moves and Pauli algebra on matrices of up to SMALL_MATRIX_NUM_OF_ENTRIES 
+ *                entries give the same entries as before and, when allocations are counted, never allocate.
+ *  Precondition: inNumOfRepeats >= 1
+ * Postcondition: Allocations are only checked when Pauli_Matrix_Library.cc is compiled with PML_COUNT_ALLOCATIONS. 
+ *                The tests run on one thread and the number of threads is restored afterwards.
 ********************************************/ 
 {
-    // Generate a random N for an N x N matrix.
-    // TODO: Generate random numbers across EVERY program invocation using std::random_device.
     static default_random_engine generator;
-    uniform_int_distribution<int> matrix_length_distribution(1,10); 
-    if (inSideLength == 0)
-        inSideLength = matrix_length_distribution(generator);
-    // cout << matrix_side_length << endl;
-    uniform_int_distribution<int> matrix_entry_distribution(-inBoundParam/2, inBoundParam/2);
-
-
-    CMatrix m_mInitMatrix(inSideLength, inSideLength);
-
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+    auto Record = [&](const bool inIsCorrect, const string &inDescription) {
+        if (inIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << inDescription << " FAILED." << endl;
+        }
+    };
 
-    // Create random complex entries for the N x N matrix.
-    for ( int r = 0; r < m_mInitMatrix.GetRowSize(); r++ ){
-        for ( int c = 0; c < m_mInitMatrix.GetColSize(); c++ ){
-            int real_value = matrix_entry_distribution(generator);
-            int imag_value = matrix_entry_distribution(generator);
-            complex<float> complex_value = complex<float>(real_value, imag_value);
-            m_mInitMatrix.ModifyValueAt(r, c, complex_value);
+    cout << "Number of Repeats: " << inNumOfRepeats << endl;
+    cout << "Performing Tests . . . " << endl;
 
-            // For Debugging. Can Delete.
-            // cout << "     real_value: " <<  real_value << endl;
-            // cout << "     imag_value: " << imag_value << endl;
-            // cout << "  complex_value: " << complex<double>(real_value, imag_value) << endl;
+    // Grow past the inline buffer, swap a heap vector with an inline one, then shrink back into the buffer.
+    typedef CSmallVector<complex<float>, 4> CSmall;
+    CSmall m_vecSmall = CSmall(3, complex<float>(1, 2));
+    const bool m_bStartsInline = m_vecSmall.IsInline() && uintptr_t(m_vecSmall.data()) % 64 == 0;
+    CSmall m_vecLarge = m_vecSmall;
+    m_vecLarge.resize(9, complex<float>(-1, 0));
+    Record(m_bStartsInline && !m_vecLarge.IsInline() && m_vecLarge.size() == 9 && m_vecLarge[2] == complex<float>(1, 2) 
+           && m_vecLarge[8] == complex<float>(-1, 0), "Growing a CSmallVector out of its inline buffer");
+    m_vecSmall.swap(m_vecLarge);
+    Record(!m_vecSmall.IsInline() && m_vecSmall.size() == 9 && m_vecLarge.IsInline() && m_vecLarge.size() == 3 
+           && m_vecLarge[0] == complex<float>(1, 2), "Swapping inline and heap CSmallVectors");
+    CSmall m_vecMoved = std::move(m_vecSmall);
+    m_vecMoved.resize(2);
+    m_vecMoved.shrink_to_fit();
+    Record(m_vecSmall.empty() && m_vecSmall.IsInline() && m_vecMoved.IsInline() && m_vecMoved.size() == 2 
+           && m_vecMoved[1] == complex<float>(1, 2), "Moving and shrinking a CSmallVector");
+
+    // Moves and swaps between inline and heap matrices keep every entry.
+    const CMatrix m_mTiny = GenerateRandomMatrix(2, generator);
+    const CMatrix m_mLarge = GenerateRandomMatrix(8, generator);
+    CMatrix m_mMatrix1 = m_mTiny;
+    CMatrix m_mMatrix2 = m_mLarge;
+    m_mMatrix1 = std::move(m_mMatrix2);
+    m_mMatrix2 = std::move(m_mMatrix1);
+    m_mMatrix1 = m_mTiny;
+    CMatrix m_mSplit = GenerateRandomMatrix(4, generator);
+    const vector<complex<float>> m_vecEntries = m_mSplit.GetMatrix();
+    m_mSplit.SetLayout(SPLIT_LAYOUT);
+    m_mSplit.SetLayout(INTERLEAVED_LAYOUT);
+    Record(m_mMatrix1.GetMatrix() == m_mTiny.GetMatrix() && m_mMatrix2.GetMatrix() == m_mLarge.GetMatrix() && m_mSplit.GetMatrix() == m_vecEntries, 
+           "Moving inline and heap matrices");
+
+#if !defined(PML_COUNT_ALLOCATIONS)
+    cout << "Allocations are not counted. Compile with -DPML_COUNT_ALLOCATIONS to check them." << endl;
+#else
+    const size_t m_iNumOfThreads = GetNumOfThreads();
+    SetNumOfThreads(1);
+
+    const CMatrix m_mMatrix4 = GenerateRandomMatrix(4, generator);
+    const CMatrix m_mColumn = GenerateRandomMatrix(16, 1, generator);
+    const CPauliAlgebraElement m_paeX = CPauliAlgebraElement("X");
+    const CPauliAlgebraElement m_paeXY = MakePauliAlgebraElement("XY");
+    const vector<float> m_vecRealConst = { 1, 2, 3, 4 };
+    complex<float> m_cxSink = 0;
+
+    const char *m_arrsOperations[] = { 
+        "2 x 2 and 4 x 4 CMatrix construction, copies and moves", "2 x 2 and 4 x 4 products and expressions", 
+        "16 x 1 CMatrix copies and products", "CPauliAlgebraElement(\"X\") and MakePauliAlgebraElement(\"XY\")", 
+        "CPauliAlgebraElement operator % and operator *", "CPauliMatrix products", "ComposeHermitian() of 2 x 2 matrices"
+    };
+    const size_t m_iNumOfOperations = sizeof(m_arrsOperations) / sizeof(m_arrsOperations[0]);
+    auto RunOperation = [&](const size_t inOperation) {
+        switch ( inOperation ) {
+            case 0: { CMatrix m_mCopy = m_mTiny; CMatrix m_mMoved = std::move(m_mCopy); m_mCopy = m_mMatrix4; m_cxSink += m_mMoved.Trace() + m_mCopy.Trace(); } break;
+            case 1: { CMatrix m_mProduct = m_mTiny * m_mTiny; CMatrix m_mSum = m_mMatrix4 + m_mMatrix4.Adjoint() * complex<float>(0, 1); 
+                      m_cxSink += m_mProduct.Trace() + (m_mMatrix4 * m_mSum).Trace(); } break;
+            case 2: { CMatrix m_mCopy = m_mColumn; CMatrix m_mOuter = m_mTiny * CMatrix(2, 1); m_cxSink += m_mCopy.GetValueAt(15, 0) + m_mOuter.GetValueAt(1, 0); } break;
+            case 3: { CPauliAlgebraElement m_paeY = CPauliAlgebraElement("Y"); CPauliAlgebraElement m_paeZY = MakePauliAlgebraElement("ZY"); 
+                      m_cxSink += m_paeY.Trace() + m_paeZY.Trace(); } break;
+            case 4: m_cxSink += (m_paeXY % m_paeXY).Trace() + (m_paeX * m_paeX).Trace(); break;
+            case 5: m_cxSink += (CPauliMatrix("X") * CPauliMatrix("Y")).Trace(); break;
+            case 6: m_cxSink += ComposeHermitian(m_vecRealConst).Trace(); break;
         }
+    };
+
+    for ( size_t o = 0; o < m_iNumOfOperations; o++ ) {
+        RunOperation(o);
+        const size_t m_iNumOfAllocations = GetNumOfAllocations();
+        for ( unsigned short int r = 0; r < inNumOfRepeats; r++ )
+            RunOperation(o);
+        const size_t m_iNumOfNewAllocations = GetNumOfAllocations() - m_iNumOfAllocations;
+        Record(m_iNumOfNewAllocations == 0, string(m_arrsOperations[o]) + " with " + to_string(m_iNumOfNewAllocations) + " allocations");
     }
+    if ( m_cxSink != m_cxSink )
+        cout << "Sink: " << m_cxSink << endl;
 
+    SetNumOfThreads(m_iNumOfThreads);
+#endif
 
-    CMatrix matrix_dagger = m_mInitMatrix;
-
-    // For Debugging. Can Delete.
-    // cout << "Random Matrix" << endl;
-    // HelperPrintMatrix(matrix);
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful small matrix storage tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL small matrix storage tests: " << m_iNumOfUnsuccTests << endl;
+}
 
 
-    // Conjugate Transpose of Matrix
-    matrix_dagger.ConjugateTranspose();
+void TestLargeMatrixStorage(const size_t inSideLength)
+/********************************************
+ *       Purpose: Check that the entries of an inSideLength x inSideLength matrix start on a 64 byte boundary, or on a 
+ *                HUGE_PAGE_SIZE boundary when they take at least HUGE_PAGE_SIZE bytes and huge pages are on, and 
+ *                that every entry, including those past 1D index 65535, is written and read back in either layout.
+ *  Precondition: inSideLength * inSideLength < 2^24, so every 1D index is exact in a float.
+ * Postcondition: The huge page setting is restored afterwards.
+********************************************/ 
+{
+    const bool m_bWereHugePagesOn = GetHugePages();
+    const bool m_bIsLarge = inSideLength * inSideLength * sizeof(complex<float>) >= HUGE_PAGE_SIZE;
 
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
 
-    // For Debugging. Can Delete.
-    // cout << "Matrix After Conjugate Transpose" << endl;
-    // HelperPrintMatrix(matrix_dagger);
+    cout << "Using a " << inSideLength << " x " << inSideLength << " matrix, " 
+         << inSideLength * inSideLength * sizeof(complex<float>) << " bytes in the interleaved layout" << endl;
+    cout << "Performing Tests . . . " << endl;
 
+    for ( int m_iAreHugePagesOn = 1; m_iAreHugePagesOn >= 0; m_iAreHugePagesOn-- ) {
+        SetHugePages(m_iAreHugePagesOn != 0);
+        for ( int m_iIsSplit = 0; m_iIsSplit <= 1; m_iIsSplit++ ) {
+            const EMatrixLayout m_eLayout = m_iIsSplit ? SPLIT_LAYOUT : INTERLEAVED_LAYOUT;
+            CMatrix m_mMatrix = CMatrix(inSideLength, inSideLength, m_eLayout);
+            const float *m_pEntries = m_iIsSplit ? m_mMatrix.GetRealPlane() : reinterpret_cast<const float *>(m_mMatrix.Data().data());
+            const size_t m_iAlignment = (m_iAreHugePagesOn && m_bIsLarge) ? HUGE_PAGE_SIZE : 64;
+            bool m_bIsCorrect = IsAligned(m_pEntries, m_iAlignment) && (!m_iIsSplit || IsAligned(m_mMatrix.GetImagPlane(), 64));
+
+            // Entry (r, c) holds its own 1D index and its row, then the layout is switched and switched back.
+            for ( size_t r = 0; r < inSideLength; r++ )
+                for ( size_t c = 0; c < inSideLength; c++ )
+                    m_mMatrix.ModifyValueAt(r, c, complex<float>(float(r * inSideLength + c), float(r)));
+            for ( int m_iSwitch = 0; m_iSwitch < 3; m_iSwitch++ ) {
+                for ( size_t r = 0; m_bIsCorrect && r < inSideLength; r++ )
+                    for ( size_t c = 0; c < inSideLength; c++ )
+                        m_bIsCorrect = m_bIsCorrect && m_mMatrix.GetValueAt(r, c) == complex<float>(float(r * inSideLength + c), float(r))
+                                       && m_mMatrix(r, c).Value() == m_mMatrix.GetValueAt(r, c);
+                m_mMatrix.SetLayout(m_mMatrix.GetLayout() == SPLIT_LAYOUT ? INTERLEAVED_LAYOUT : SPLIT_LAYOUT);
+            }
 
-    // Hermitian Matrix 
-    for ( unsigned short int r = 0; r < matrix_dagger.GetRowSize(); r++ ){
-        for ( unsigned short int c = 0; c < matrix_dagger.GetColSize(); c++ ){
-            // matrix_dagger.at(k).at(p).real() = matrix_dagger.at(k).at(p).real() + matrix.at(k).at(p).real();
-            // complex<double> imag_value = matrix_dagger.at(k).at(p).imag() + matrix.at(k).at(p).imag();
-            complex<float> m_cxEntry1 = matrix_dagger.GetValueAt(r, c) + m_mInitMatrix.GetValueAt(r, c); 
-            matrix_dagger.ModifyValueAt(r, c, m_cxEntry1);
+            if (m_bIsCorrect)
+                m_iNumOfSuccTests++;
+            else {
+                m_iNumOfUnsuccTests++;
+                cout << "Test " << (m_iIsSplit ? "split" : "interleaved") << " layout with huge pages " << (m_iAreHugePagesOn ? "on" : "off") 
+                     << ": the entries are misaligned or do NOT read back what was written." << endl;
+            }
         }
     }
+    SetHugePages(m_bWereHugePagesOn);
 
-    // For Debugging. Can Delete.
-    // cout << "Hermitian Matrix" << endl;
-    // HelperPrintMatrix(matrix_dagger);
-
-    // For Debugging. Can Delete.
-    // Inverse of Hermitian Matrix is the conjugate transpose. Which should remain the same.
-    // HelperConjugateTranspose(matrix_dagger);
-
-    // For Debugging. Can Delete.
-    // cout << "Inverse of Hermitian Matrix" << endl;
-    // HelperPrintMatrix(matrix_dagger);
-
-
-    return matrix_dagger;
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful large matrix storage tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL large matrix storage tests: " << m_iNumOfUnsuccTests << endl;
 }
 
 
-bool CMatrix::operator==(const CMatrix& inMatrix2)
+static bool IsNearlyEqual(const CMatrix &inMatrix, const CMatrix &inExpected, const float inTolerance)
 /********************************************
- *       Purpose: Return true if the data members between both matrices are equal.
- *                   
+ *       Purpose: Return true if both matrices have the same shape and every entry is within inTolerance.
  *  Precondition: N/A
  * Postcondition: N/A
- *          Note: N/A
- *          TODO: N/A
-********************************************/
+********************************************/ 
 {
-    if (this->m_iRowSize != inMatrix2.m_iRowSize || this->m_iColSize != inMatrix2.m_iColSize)
+    if ( inMatrix.GetRowSize() != inExpected.GetRowSize() || inMatrix.GetColSize() != inExpected.GetColSize() )
         return false;
-    
-    for (unsigned short int r = 0; r < this->m_iRowSize; r++) {
-        for (unsigned short int c = 0; c < this->m_iColSize; c++) {
-            if (this->GetValueAt(r, c) != inMatrix2.GetValueAt(r, c))
+    for ( size_t r = 0; r < inExpected.GetRowSize(); r++ )
+        for ( size_t c = 0; c < inExpected.GetColSize(); c++ )
+            if ( abs(inMatrix(r, c) - inExpected(r, c)) > inTolerance )
                 return false;
-        }
-    }
-
     return true;
-} 
+}
 
-void Goal1Test(unsigned short int inNumOfTests, unsigned short int inBoundParam, bool inWillPrintMatrix)
+
+void TestRectangularMatrices(const unsigned short int inNumOfTests, const unsigned short int inMaxSideLength)
 /********************************************
- *       Purpose: Verify that all random matrices generated, are hermitian.
- *                (R + R_dagger) == (R + R_dagger)_dagger 
- *                      H        ==       H_dagger
- * 
- *                           Random Matrix = R
- *                Conjugate Transpose of R = R_dagger
- *                        Hermitian Matrix = H
- *                   
- *  Precondition: N/A
+ *       Purpose: Check the M x K times K x N matrix multiplication, matrix vector product, conjugate transpose 
+ *                and trace of a product on random rectangular matrices in both layouts, and the view 
+ *                matrix multiplication on column major buffers with padded leading dimensions and on 
+ *                overlapping submatrices of one CMatrix, against the reference triple loop.
+ *  Precondition: inMaxSideLength >= 1
  * Postcondition: N/A
- *          Note: Only set print_matrices to true if num_of_tests
- *                is less than 11. Matrices will be print to terminal.
- *          TODO: - Print out matrices and results to a file rather 
- *                  than the terminal.
 ********************************************/ 
 {
-    int hermitian_count = 0;
-    int not_hermitian_count = 0;
-    cout << "Number of Tests: " << inNumOfTests << endl;
-    cout << "Hermitian matrix entries, real and imaginary parts, bounded by the interval: " << "[" << -inBoundParam << ", " << inBoundParam << "]" << endl;
+    static default_random_engine generator;
+    uniform_int_distribution<int> side_length_distribution(1, inMaxSideLength);
+    uniform_int_distribution<int> padding_distribution(0, 3);
 
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
 
+    cout << "Number of Tests: " << inNumOfTests << endl;
+    cout << "Using side lengths up to " << inMaxSideLength << endl;
     cout << "Performing Tests . . . " << endl;
-    for ( int i = 1; i <= inNumOfTests; i++ ) {
-
-        if ( inWillPrintMatrix )
-            cout << "Test " << i << ": " << endl;
 
-        CMatrix m_mMatrix = GenerateHermitianMatrix(inBoundParam);
-        CMatrix m_mMatrixDagger = m_mMatrix;
-        m_mMatrixDagger.ConjugateTranspose();
-        
-        if ( m_mMatrix == m_mMatrixDagger ) {
-            hermitian_count++;
-            if ( inWillPrintMatrix ) {
-                cout << "Matrix is Hermitian!" << endl;
-                m_mMatrix.PrintMatrix();
-            }
-        }
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        const size_t M = side_length_distribution(generator);
+        const size_t K = side_length_distribution(generator);
+        const size_t N = side_length_distribution(generator);
+        const EMatrixLayout m_eLayout = (i % 2 == 0) ? SPLIT_LAYOUT : INTERLEAVED_LAYOUT;
+        CMatrix m_mMatrix1 = GenerateRandomMatrix(M, K, generator);
+        CMatrix m_mMatrix2 = GenerateRandomMatrix(K, N, generator);
+        m_mMatrix1.SetLayout(m_eLayout);
+        const CMatrix m_mExpected = NaiveMatrixMultiply(m_mMatrix1, m_mMatrix2);
+
+        // Each entry is a sum of K products bounded by 2.
+        const float m_fTolerance = 1e-5f * 2 * K;
+        CMatrix m_mInto = CMatrix(1, 1, SPLIT_LAYOUT);
+        MultiplyInto(m_mInto, m_mMatrix1, m_mMatrix2);
+        bool m_bIsCorrect = IsNearlyEqual(m_mMatrix1 * m_mMatrix2, m_mExpected, m_fTolerance) && IsNearlyEqual(m_mInto, m_mExpected, m_fTolerance);
+
+        // Matrix vector product with the first column of the second matrix.
+        vector<complex<float>> m_vecColumn(K);
+        for ( size_t k = 0; k < K; k++ )
+            m_vecColumn[k] = m_mMatrix2(k, 0);
+        const vector<complex<float>> m_vecProduct = m_mMatrix1 * m_vecColumn;
+        vector<complex<float>> m_vecViewProduct(M);
+        MultiplyInto(MakeMatrixView(m_vecViewProduct.data(), M, 1, 1), m_mMatrix1.View(), MakeMatrixView(m_vecColumn.data(), K, 1, 1));
+        for ( size_t r = 0; r < M; r++ )
+            m_bIsCorrect = m_bIsCorrect && abs(m_vecProduct[r] - m_mExpected(r, 0)) <= m_fTolerance && abs(m_vecViewProduct[r] - m_mExpected(r, 0)) <= m_fTolerance;
+
+        // The K x M adjoint, and Tr(A A^dagger) = ||A||^2.
+        CMatrix m_mAdjoint = m_mMatrix1;
+        m_mAdjoint.ConjugateTranspose();
+        m_bIsCorrect = m_bIsCorrect && m_mAdjoint.GetRowSize() == K && m_mAdjoint.GetColSize() == M && m_mAdjoint.GetLayout() == m_eLayout;
+        for ( size_t r = 0; m_bIsCorrect && r < M; r++ )
+            for ( size_t k = 0; k < K; k++ )
+                m_bIsCorrect = m_bIsCorrect && m_mAdjoint.GetValueAt(k, r) == conj(m_mMatrix1.GetValueAt(r, k));
+        const float m_fNorm = FrobeniusNorm(m_mMatrix1);
+        m_bIsCorrect = m_bIsCorrect && abs(TraceOfProduct(m_mMatrix1, m_mAdjoint) - m_fNorm * m_fNorm) <= 1e-5f * m_fNorm * m_fNorm;
+
+        // Column major buffers with padded leading dimensions, as passed to BLAS.
+        const size_t m_iLd1 = M + padding_distribution(generator);
+        const size_t m_iLd2 = K + padding_distribution(generator);
+        const size_t m_iLdOut = M + padding_distribution(generator);
+        vector<complex<float>> m_vecBuffer1(m_iLd1 * K), m_vecBuffer2(m_iLd2 * N), m_vecBufferOut(m_iLdOut * N);
+        CMatrixView m_vView1 = MakeMatrixView(m_vecBuffer1.data(), M, K, m_iLd1, COLUMN_MAJOR);
+        CMatrixView m_vView2 = MakeMatrixView(m_vecBuffer2.data(), K, N, m_iLd2, COLUMN_MAJOR);
+        const CMatrixView m_vViewOut = MakeMatrixView(m_vecBufferOut.data(), M, N, m_iLdOut, COLUMN_MAJOR);
+        m_vView1 = m_mMatrix1;
+        m_vView2 = m_mMatrix2;
+        MultiplyInto(m_vViewOut, m_vView1, m_vView2);
+        m_bIsCorrect = m_bIsCorrect && IsNearlyEqual(CMatrix(m_vViewOut), m_mExpected, m_fTolerance);
+        MultiplyInto(m_vViewOut.Column(0), m_vView1, m_vView2.Column(0));
+        MultiplyInto(m_vViewOut.Column(N - 1), m_mMatrix1.View(), m_mMatrix2.Column(N - 1));
+        m_bIsCorrect = m_bIsCorrect && IsNearlyEqual(CMatrix(m_vViewOut), m_mExpected, m_fTolerance);
+
+        // The M x N product written over the M x K block of the same CMatrix it reads.
+        CMatrix m_mPanel = GenerateRandomMatrix(M, max(K, N), generator);
+        m_mPanel.SetLayout(m_eLayout);
+        const CMatrix m_mPanelExpected = NaiveMatrixMultiply(CMatrix(m_mPanel.Submatrix(0, 0, M, K)), m_mMatrix2);
+        MultiplyInto(m_mPanel.Submatrix(0, 0, M, N), m_mPanel.Submatrix(0, 0, M, K), m_mMatrix2.View());
+        m_bIsCorrect = m_bIsCorrect && IsNearlyEqual(CMatrix(m_mPanel.Submatrix(0, 0, M, N)), m_mPanelExpected, m_fTolerance);
+
+        if (m_bIsCorrect)
+            m_iNumOfSuccTests++;
         else {
-            not_hermitian_count++;
-            if ( inWillPrintMatrix ) {
-                cout << "Matrix is NOT Hermitian!" << endl;
-                m_mMatrix.PrintMatrix();
-            }
+            m_iNumOfUnsuccTests++;
+            cout << "Test " << i << ": " << M << " x " << K << " times " << K << " x " << N 
+                 << " products do NOT match the reference." << endl;
         }
     }
 
     cout << "Finished Tests. " << endl;
-    cout << "    Total Number of Random Matrices that are Hermitian: " << hermitian_count << endl;
-    cout << "Total Number of Random Matrices that are NOT Hermitian: " << not_hermitian_count << endl;
-    cout << "      Percentage of Random Matrices that are Hermitian: " << ( hermitian_count / (hermitian_count + not_hermitian_count) ) * 100 << "%" << endl;        
+    cout << "    Total Number of successful rectangular matrix tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL rectangular matrix tests: " << m_iNumOfUnsuccTests << endl;
 }
 
 
-complex<float> CMatrix::Trace() const
+template <size_t N>
+static bool IsFixedMatrixCorrect(default_random_engine &ioGenerator)
 /********************************************
- *       Purpose: Return the Trace of a matrix
+ *       Purpose: Return true if the product, sum, difference, scaling, adjoint and trace of two random 
+ *                CFixedMatrix<N> match the CMatrix reference, and MultiplyInto() matches the triple loop.
  *  Precondition: N/A
- * Postcondition: Input matrix must not be modified.
- *         Notes: N/A
- *          TODO: - Change parameter type to Matrix object. Update function body accordingly.
+ * Postcondition: N/A
 ********************************************/ 
 {
-    complex<float> m_cxTrace = 0;
-    for ( unsigned short int r = 0; r < this->m_iRowSize; r++ ) {
-        for ( unsigned short int c = r; c < r+1; c++ ) {
-            m_cxTrace += this->GetValueAt(r, c);
-        }
-    }
-
-    return m_cxTrace;
+    const CMatrix m_mMatrix1 = GenerateRandomMatrix(N, ioGenerator);
+    const CMatrix m_mMatrix2 = GenerateRandomMatrix(N, ioGenerator);
+    const CFixedMatrix<N> m_fmMatrix1 = CFixedMatrix<N>(m_mMatrix1);
+    const CFixedMatrix<N> m_fmMatrix2 = CFixedMatrix<N>(m_mMatrix2);
+    const complex<float> m_cxZ = complex<float>(0.5f, -2.0f);
+    const CMatrix m_mExpected = NaiveMatrixMultiply(m_mMatrix1, m_mMatrix2);
+
+    // Each entry is a sum of N products bounded by 2.
+    const float m_fTolerance = 1e-5f * 2 * N;
+    CMatrix m_mInto = CMatrix(N, N, SPLIT_LAYOUT);
+    MultiplyInto(m_mInto, m_mMatrix1, m_mMatrix2);
+    return IsNearlyEqual(CMatrix(m_fmMatrix1 * m_fmMatrix2), m_mExpected, m_fTolerance) && IsNearlyEqual(m_mInto, m_mExpected, m_fTolerance)
+           && IsNearlyEqual(CMatrix(m_fmMatrix1 + m_fmMatrix2), CMatrix(m_mMatrix1 + m_mMatrix2), 0)
+           && IsNearlyEqual(CMatrix(m_fmMatrix1 - m_fmMatrix2), CMatrix(m_mMatrix1 - m_mMatrix2), 0)
+           && IsNearlyEqual(CMatrix(m_cxZ * m_fmMatrix1), CMatrix(m_cxZ * m_mMatrix1), 0)
+           && IsNearlyEqual(CMatrix(m_fmMatrix1.Adjoint()), CMatrix(m_mMatrix1.Adjoint()), 0)
+           && abs(m_fmMatrix1.Trace() - m_mMatrix1.Trace()) <= m_fTolerance
+           && m_fmMatrix1 * CFixedMatrix<N>::Identity() == m_fmMatrix1;
 }
 
 
-void CMatrix::operator*(const CMatrix &inMatrix2)
+void TestFixedMatrices(const unsigned short int inNumOfTests)
 /********************************************
- *       Purpose: Replace each entry of the first CMatrix with each entry of the
- *                resulting matrix multiplication between the firt CMatrix and second CMatrix.
- *  Precondition: Both input matrices are square matrices.
- * Postcondition: First CMatric must be modified.
- *                Input CMatrix parameter must not be modified.
- *         Notes: N/A
- *          TODO: Support matrix multiplication between non-square matrices.
- *                i.e. First CMatrix is M X N, whereas second CMatrix is N x P.
+ *       Purpose: Check the Pauli products at compile time with static_assert, then check CFixedMatrix 2 x 2, 4 x 4 
+ *                and 8 x 8 kernels and the small CMatrix products that use them against the CMatrix reference, 
+ *                and every product of two 2 x 2 Pauli matrices against the triple loop.
+ *  Precondition: N/A
+ * Postcondition: N/A
 ********************************************/ 
 {
-    if( this->m_iRowSize != inMatrix2.m_iRowSize || this->m_iColSize != inMatrix2.m_iColSize )
-        cout << "ERROR: Unable to matrixmultiply. Currently only supports square matrices." << endl;
-    else {
-        // Create new matrix to store new entries.
-        CMatrix m_mResult = CMatrix(m_iRowSize, m_iColSize);
-
-        // Matrix Multiplication between first and second matrix.
-        for ( unsigned short int r = 0; r < this->m_iRowSize; r++ ) {
-            for ( unsigned short int c = 0; c < this->m_iColSize; c++) {
-                complex<float> m_cxResult = complex<float>(0, 0);
-                for ( unsigned short int s = 0; s < this->m_iRowSize; s++ ) {
-                    complex<float> m_cxEntry1 = this->GetValueAt(r, s);
-                    complex<float> m_cxEntry2 = inMatrix2.GetValueAt(s, c);
-                    m_cxResult += (m_cxEntry1 * m_cxEntry2);
-                }
-                m_mResult.ModifyValueAt(r, c, m_cxResult);
+    constexpr CFixedMatrix2 m_fmX = CFixedMatrix2(CFixedMatrix2::CEntries{{ {0, 0}, {1, 0}, {1, 0}, {0, 0} }});
+    constexpr CFixedMatrix2 m_fmY = CFixedMatrix2(CFixedMatrix2::CEntries{{ {0, 0}, {0, -1}, {0, 1}, {0, 0} }});
+    constexpr CFixedMatrix2 m_fmZ = CFixedMatrix2(CFixedMatrix2::CEntries{{ {1, 0}, {0, 0}, {0, 0}, {-1, 0} }});
+    static_assert(m_fmX * m_fmY == complex<float>(0, 1) * m_fmZ && m_fmY * m_fmZ == complex<float>(0, 1) * m_fmX 
+                  && m_fmZ * m_fmX == complex<float>(0, 1) * m_fmY, "XY = iZ, YZ = iX and ZX = iY");
+    static_assert(m_fmX * m_fmX == CFixedMatrix2::Identity() && m_fmY * m_fmY == CFixedMatrix2::Identity() 
+                  && m_fmZ * m_fmZ == CFixedMatrix2::Identity(), "Pauli matrices square to I");
+    static_assert(m_fmY.Adjoint() == m_fmY && (m_fmX + m_fmY + m_fmZ).Trace() == complex<float>(0, 0) 
+                  && CFixedMatrix2::Identity().Trace() == complex<float>(2, 0), "Pauli matrices are Hermitian and traceless");
+
+    static default_random_engine generator;
+
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+
+    cout << "Number of Tests: " << inNumOfTests << " for each of 2 x 2, 4 x 4 and 8 x 8" << endl;
+    cout << "Performing Tests . . . " << endl;
+
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        const bool m_bIsCorrect[] = { IsFixedMatrixCorrect<2>(generator), IsFixedMatrixCorrect<4>(generator), IsFixedMatrixCorrect<8>(generator) };
+        for ( int n = 0; n < 3; n++ ) {
+            if (m_bIsCorrect[n])
+                m_iNumOfSuccTests++;
+            else {
+                m_iNumOfUnsuccTests++;
+                cout << "Test " << i << ": " << (2 << n) << " x " << (2 << n) << " fixed size matrix operations do NOT match the reference." << endl;
+            }
+        }
+    }
+
+    const string m_arrsPauliIDs[] = { "I", "X", "Y", "Z" };
+    for ( const string &m_sPauliID1 : m_arrsPauliIDs ) {
+        for ( const string &m_sPauliID2 : m_arrsPauliIDs ) {
+            const CPauliMatrix m_pmProduct = CPauliMatrix(m_sPauliID1) * CPauliMatrix(m_sPauliID2);
+            if ( IsNearlyEqual(m_pmProduct, NaiveMatrixMultiply(CMatrix(m_sPauliID1), CMatrix(m_sPauliID2)), 0) )
+                m_iNumOfSuccTests++;
+            else {
+                m_iNumOfUnsuccTests++;
+                cout << "Test " << m_sPauliID1 << m_sPauliID2 << ": Pauli product " << m_pmProduct.PauliToString() << " does NOT match the reference." << endl;
             }
         }
-        // Use copy constructor to copy entries of new matrix to the original matrix.
-        *this = CMatrix(m_mResult);
     }
+
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful fixed size matrix tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL fixed size matrix tests: " << m_iNumOfUnsuccTests << endl;
 }
 
-void CMatrix::MatrixMultiply(const CMatrix &inMatrix2)
+
+template <class T>
+static double MaxAbsDifference(const CDenseMatrix<T> &inMatrix1, const CDenseMatrix<T> &inMatrix2)
 /********************************************
- *       Purpose: Replace each entry of the first CMatrix with each entry of the
- *                resulting matrix multiplication between the firt CMatrix and second CMatrix.
- *  Precondition: Both input matrices are square matrices.
- * Postcondition: First CMatric must be modified.
- *                Input CMatrix parameter must not be modified.
- *         Notes: N/A
- *          TODO: N/A
+ *       Purpose: Return the largest |a - b| over every pair of entries, or infinity when the sizes differ.
+ *  Precondition: N/A
+ * Postcondition: N/A
 ********************************************/ 
 {
-    (*this) * inMatrix2;
+    if ( inMatrix1.GetRowSize() != inMatrix2.GetRowSize() || inMatrix1.GetColSize() != inMatrix2.GetColSize() )
+        return numeric_limits<double>::infinity();
+    double m_dDifference = 0;
+    for ( size_t i = 0; i < inMatrix1.Data().size(); i++ )
+        m_dDifference = max(m_dDifference, double(abs(typename CScalarTraits<T>::WideType(inMatrix1.Data()[i]) - typename CScalarTraits<T>::WideType(inMatrix2.Data()[i]))));
+    return m_dDifference;
 }
 
 
-CMatrix ComposeHermitian(const vector<float> inRealConst)
+template <class T>
+static bool IsDenseMatrixCorrect(const CMatrix &inMatrix, const float inEpsilon, const double inRoundTripTolerance)
 /********************************************
- *       Purpose: Compose a 2 x 2 Hermitian matrix using 
- *                the input real constants, and the Pauli matrices.
- *                Return the resulting Hermitian matrix.
- *                   
- *  Precondition: Parameter containing the constants must be real numbers. 
+ *       Purpose: Return true if the product, adjoint, trace, Pauli coefficients and Pauli composition of 
+ *                CDenseMatrix<T>(inMatrix) match the CMatrix reference to within inEpsilon per term, 
+ *                and composing its own Pauli coefficients gives it back to within inRoundTripTolerance.
+ *  Precondition: inMatrix is 2^n x 2^n with entries bounded by 1, and real when T is real.
  * Postcondition: N/A
- *          Note: N/A
- *          TODO: - Generalize for an N x N matrix. Currently can only make 2 x 2 Hermitian matrix.
- *                - Change return type to a Matrix object. Update function body accordingly. 
- *                - Use PauliMatrix object for Pauli I, X, Y, Z matrices.
 ********************************************/ 
 {
-    // Initialize an a 2 * 2 matrix with all 0 entries.
-    CMatrix m_mResult = CMatrix(2, 2);
+    const size_t m_iSideLength = inMatrix.GetRowSize();
+    const CDenseMatrix<T> m_mMatrix = CDenseMatrix<T>(inMatrix);
+    const vector<complex<typename CDenseMatrix<T>::RealType> > m_vecCoefficients = m_mMatrix.PauliCoefficients();
+    const vector<complex<float> > m_vecExpectedCoefficients = inMatrix.PauliCoefficients();
+
+    // Each entry of the product is a sum of N products bounded by 2.
+    bool m_bIsCorrect = IsNearlyEqual((m_mMatrix * m_mMatrix).ToMatrix(), NaiveMatrixMultiply(inMatrix, inMatrix), inEpsilon * 2 * m_iSideLength)
+                        && IsNearlyEqual(m_mMatrix.Adjoint().ToMatrix(), CMatrix(inMatrix.Adjoint()), 0)
+                        && abs(complex<float>(m_mMatrix.Trace()) - inMatrix.Trace()) <= inEpsilon * m_iSideLength
+                        && MaxAbsDifference(CDenseMatrix<T>::ComposePauliCoefficients(m_vecCoefficients), m_mMatrix) <= inRoundTripTolerance
+                        && IsNearlyEqual(CDenseMatrix<T>::ComposePauliSum(inMatrix.PauliDecompositionSparse()).ToMatrix(), inMatrix, inEpsilon * m_iSideLength);
+    for ( size_t i = 0; i < m_vecCoefficients.size(); i++ )
+        m_bIsCorrect = m_bIsCorrect && abs(complex<float>(m_vecCoefficients[i]) - m_vecExpectedCoefficients[i]) <= inEpsilon;
+    return m_bIsCorrect;
+}
 
-    CPauliAlgebraElement I = CPauliAlgebraElement("I");
-    CPauliAlgebraElement X = CPauliAlgebraElement("X");
-    CPauliAlgebraElement Y = CPauliAlgebraElement("Y");
-    CPauliAlgebraElement Z = CPauliAlgebraElement("Z");
 
-    // Construct the Hermitian matrix from constants and the pauli matrices.
-    for ( unsigned short int r = 0; r < m_mResult.GetRowSize(); r++ ) {
-        for ( unsigned short int c = 0; c < m_mResult.GetColSize(); c++ ) {
-            int m_cxRealVal = 0;
-            int m_cxCompVal = 0;
+void TestDenseMatrices(const unsigned short int inNumOfTests, const unsigned short int inMaxNumOfQubits)
+/********************************************
+ *       Purpose: Check CDenseMatrix for all four scalar types against CMatrix on random 2^n x 2^n matrices: 
+ *                complex matrices for complex<float> and complex<double>, and real symmetric matrices for 
+ *                every type. The complex<double> Pauli round trip must be accurate to double precision.
+ *  Precondition: 1 <= inMaxNumOfQubits <= 10
+ * Postcondition: N/A
+********************************************/ 
+{
+    static default_random_engine generator;
+    uniform_int_distribution<int> qubit_distribution(1, inMaxNumOfQubits);
 
-            m_cxRealVal = inRealConst.at(0) * I.GetValueAt(r, c).real() + 
-                          inRealConst.at(1) * X.GetValueAt(r, c).real() + 
-                          inRealConst.at(2) * Y.GetValueAt(r, c).real() + 
-                          inRealConst.at(3) * Z.GetValueAt(r, c).real();
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
 
-            m_cxCompVal = inRealConst.at(0) * I.GetValueAt(r, c).imag() + 
-                          inRealConst.at(1) * X.GetValueAt(r, c).imag() + 
-                          inRealConst.at(2) * Y.GetValueAt(r, c).imag() + 
-                          inRealConst.at(3) * Z.GetValueAt(r, c).imag();
+    cout << "Number of Tests: " << inNumOfTests << " for each scalar type" << endl;
+    cout << "Using up to " << inMaxNumOfQubits << " qubits" << endl;
+    cout << "Performing Tests . . . " << endl;
 
-            m_mResult.ModifyValueAt(r, c, complex<float>(m_cxRealVal, m_cxCompVal));
+    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
+        const size_t m_iSideLength = size_t(1) << qubit_distribution(generator);
+        const CMatrix m_mComplex = GenerateRandomMatrix(m_iSideLength, generator);
+        CMatrix m_mSymmetric = CMatrix(m_iSideLength, m_iSideLength);
+        for ( size_t r = 0; r < m_iSideLength; r++ )
+            for ( size_t c = 0; c < m_iSideLength; c++ )
+                m_mSymmetric(r, c) = complex<float>(0.5f * (m_mComplex(r, c).real() + m_mComplex(c, r).real()), 0);
+
+        const string m_arrsTypeNames[] = { "complex<float>", "complex<double>", "float", "double" };
+        const bool m_bIsCorrect[] = { IsDenseMatrixCorrect<complex<float> >(m_mComplex, 1e-5f, 1e-5 * m_iSideLength), 
+                                      IsDenseMatrixCorrect<complex<double> >(m_mComplex, 1e-6f, 1e-13 * m_iSideLength), 
+                                      IsDenseMatrixCorrect<float>(m_mSymmetric, 1e-5f, 1e-5 * m_iSideLength), 
+                                      IsDenseMatrixCorrect<double>(m_mSymmetric, 1e-6f, 1e-13 * m_iSideLength) };
+        for ( int t = 0; t < 4; t++ ) {
+            if (m_bIsCorrect[t])
+                m_iNumOfSuccTests++;
+            else {
+                m_iNumOfUnsuccTests++;
+                cout << "Test " << i << ": " << m_iSideLength << " x " << m_iSideLength << " CDenseMatrix<" << m_arrsTypeNames[t] 
+                     << "> does NOT match the reference." << endl;
+            }
         }
     }
 
-    return m_mResult;
+    cout << "Finished Tests. " << endl;
+    cout << "    Total Number of successful dense matrix tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL dense matrix tests: " << m_iNumOfUnsuccTests << endl;
 }
 
 
-vector<float> CMatrix::PauliDecomposition() const
+template <class T>
+static double BestDenseProductTime(const size_t inSideLength, const unsigned short int inNumOfRepeats)
 /********************************************
- *       Purpose: Decompose  a 2 x 2 Hermitian matrix into 
- *                the pauli matrices using the following formula:
- *                H = r0 * I + r1 * X + r2 * Y + r3 * Z
- *                where
- *                r0 = (1/2)Tr(H)
- *                r1 = (1/2)Tr(HX)
- *                r2 = (1/2)Tr(HY)
- *                r3 = (1/2)Tr(HZ)
- * 
- *  Precondition: Must be a 2 x 2 Hermitian Matrix.
- * Postcondition: Input matrix must not be modified. 
- *                Return at list containing the constants r0, r1, r2, r3. 
- *          Note: N/A
- *          TODO: - Generalize deomposition for any N x N Hermitian matrix. Currently can only decompose 2 x 2 Hermitian Matrix.
- *                - Change parameter type and matrix variable in body to a Matrix object. Update function body accordingly.
+ *       Purpose: Return the best time of inNumOfRepeats products of two inSideLength x inSideLength CDenseMatrix<T>.
+ *  Precondition: inNumOfRepeats >= 1
+ * Postcondition: N/A
 ********************************************/ 
 {
-    CMatrix m_mMatrix = *this;
-
-    // I
-    float r0 = 0.5 * m_mMatrix.Trace().real();
-
-    // X
-    CPauliMatrix m_pmX = CPauliMatrix("X");
-    m_mMatrix.MatrixMultiply(m_pmX);
-    float r1 = 0.5 * m_mMatrix.Trace().real();
-    m_mMatrix.MatrixMultiply(m_pmX); // Get the original matrix back.
+    CDenseMatrix<T> m_mMatrix = CDenseMatrix<T>(inSideLength, inSideLength);
+    CDenseMatrix<T> m_mResult = CDenseMatrix<T>(inSideLength, inSideLength);
+    for ( size_t r = 0; r < inSideLength; r++ )
+        for ( size_t c = 0; c < inSideLength; c++ )
+            m_mMatrix(r, c) = T(1.0f / (1 + r + c));
+
+    double m_dBestTime = 0;
+    for ( unsigned short int t = 0; t < inNumOfRepeats; t++ ) {
+        chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+        MultiplyInto(m_mResult, m_mMatrix, m_mMatrix);
+        chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+        if ( t == 0 || m_tElapsed.count() < m_dBestTime )
+            m_dBestTime = m_tElapsed.count();
+    }
+    return m_dBestTime;
+}
 
-    // Y
-    CPauliMatrix m_pmY = CPauliMatrix("Y");
-    m_mMatrix.MatrixMultiply(m_pmY);
-    float r2 = 0.5 * m_mMatrix.Trace().real();
-    m_mMatrix.MatrixMultiply(m_pmY); // Get the original matrix back.
 
-    // Z
-    CPauliMatrix m_pmZ = CPauliMatrix("Z");
-    m_mMatrix.MatrixMultiply(m_pmZ);
-    float r3 = 0.5 * m_mMatrix.Trace().real();
-    m_mMatrix.MatrixMultiply(m_pmZ); // Get the original matrix back.
+void BenchmarkDenseMatrices(const vector<size_t> &inSideLengths, const unsigned short int inNumOfRepeats, const unsigned short int inNumOfQubits)
+/********************************************
+ *       Purpose: Print the time of a CDenseMatrix product for each scalar type and side length, and the error of 
+ *                composing the Pauli coefficients of an inNumOfQubits qubit matrix back into it in complex<float> and complex<double>.
+ *  Precondition: inNumOfRepeats >= 1
+ * Postcondition: The best of inNumOfRepeats runs is reported.
+ *          Note: A real product is 2 N^3 flops and a complex product 8 N^3 flops.
+********************************************/ 
+{
+    cout << GetNumOfThreads() << " thread(s)" << endl;
+    for ( size_t n : inSideLengths ) {
+        const double m_dNumOfFlops = double(n) * n * n;
+        const double m_arrdTimes[] = { BestDenseProductTime<float>(n, inNumOfRepeats), BestDenseProductTime<double>(n, inNumOfRepeats), 
+                                       BestDenseProductTime<complex<float> >(n, inNumOfRepeats), BestDenseProductTime<complex<double> >(n, inNumOfRepeats) };
+        cout << n << " x " << n << " products:  float " << m_arrdTimes[0] << " s (" << 2 * m_dNumOfFlops / m_arrdTimes[0] * 1e-9 << " GFLOP/s), "
+             << "double " << m_arrdTimes[1] << " s (" << 2 * m_dNumOfFlops / m_arrdTimes[1] * 1e-9 << " GFLOP/s), "
+             << "complex<float> " << m_arrdTimes[2] << " s (" << 8 * m_dNumOfFlops / m_arrdTimes[2] * 1e-9 << " GFLOP/s), "
+             << "complex<double> " << m_arrdTimes[3] << " s (" << 8 * m_dNumOfFlops / m_arrdTimes[3] * 1e-9 << " GFLOP/s)" << endl;
+    }
 
+    default_random_engine generator;
+    const CMatrix m_mMatrix = GenerateRandomMatrix(size_t(1) << inNumOfQubits, generator);
+    const CDenseMatrix<complex<float> > m_mSingle = CDenseMatrix<complex<float> >(m_mMatrix);
+    const CDenseMatrix<complex<double> > m_mDouble = CDenseMatrix<complex<double> >(m_mMatrix);
+    cout << inNumOfQubits << " qubit Pauli decomposition round trip error:  complex<float> " 
+         << MaxAbsDifference(CDenseMatrix<complex<float> >::ComposePauliCoefficients(m_mSingle.PauliCoefficients()), m_mSingle) 
+         << ", complex<double> " << MaxAbsDifference(CDenseMatrix<complex<double> >::ComposePauliCoefficients(m_mDouble.PauliCoefficients()), m_mDouble) << endl;
+}
 
-    vector<float> m_vecRealConst;
-    m_vecRealConst.push_back(r0);
-    m_vecRealConst.push_back(r1);
-    m_vecRealConst.push_back(r2);
-    m_vecRealConst.push_back(r3);
 
-    return m_vecRealConst;
+static vector<complex<float>> RunAllocatorPipeline(const CMatrix &inMatrix1, const CMatrix &inMatrix2, const string &inPauliString1, const string &inPauliString2)
+/********************************************
+ *       Purpose: One iteration of a Goal2Test() style algebra loop: make two Pauli algebra elements, multiply them with 
+ *                operator %, add the product to inMatrix1 * inMatrix2, move the sum to SPLIT_LAYOUT and multiply it again. 
+ *                Every temporary takes its storage from the matrix allocator of the calling thread.
+ *  Precondition: inMatrix1 and inMatrix2 are 2^n x 2^n, and both Pauli Strings have n characters.
+ * Postcondition: Returns the entries of the final matrix.
+********************************************/ 
+{
+    const CPauliAlgebraElement m_paeElement1 = MakePauliAlgebraElement(inPauliString1) * complex<float>(0, 1);
+    const CPauliAlgebraElement m_paeElement2 = MakePauliAlgebraElement(inPauliString2);
+    const CPauliAlgebraElement m_paeProduct = m_paeElement1 % m_paeElement2;
+    CMatrix m_mSum = inMatrix1 * inMatrix2 + m_paeProduct;
+    m_mSum.SetLayout(SPLIT_LAYOUT);
+    const CMatrix m_mResult = m_mSum * inMatrix1;
+    return m_mResult.GetMatrix();
 }
 
-void Goal2Test(unsigned short int inNumOfTests, unsigned short int inBoundParam, unsigned short int inSideLength)
+
+void TestMatrixAllocators(const unsigned short int inNumOfIterations, const unsigned short int inNumOfQubits)
 /********************************************
- *       Purpose: Verify that any 2 x 2 Hermitian matrix can be 
- *                decomposed into the Pauli Matrices.
- *                   
- *  Precondition: N/A
+ *       Purpose: Run the same algebra loop with the default allocator, a CMatrixArena reset after every iteration and a 
+ *                CMatrixPool. The results must match exactly, and once the first iteration has warmed them up the arena 
+ *                and pool must take no more blocks from AllocateAligned(). Also checks scopes, matrices that outlive their 
+ *                scope, and giving back the most recent arena allocation.
+ *  Precondition: inNumOfIterations >= 2. 1 <= inNumOfQubits <= 8
  * Postcondition: N/A
- *          Note: Only set print_matrices to true if num_of_tests
- *                is less than 11. Matrices will be print to terminal.
- *          TODO: - Print out matrices and results to a file rather than the terminal.
- *                - Use PauliMatrix object for Pauli I, X, Y, Z matrices.
 ********************************************/ 
 {
-    unsigned short int m_iNumOfSuccDecomp = 0;
-    unsigned short int m_iNumOfUnsuccDecomp = 0;
-
-    cout << "Number of Tests: " << inNumOfTests << endl;
-    cout << "Hermitian matrix entries, real and imaginary parts, bounded by the interval: " << "[" << -inBoundParam << ", " << inBoundParam << "]" << endl;
-    cout << "Using " << inSideLength << " x " << inSideLength << " matrices" << endl;
+    static default_random_engine generator;
+    const size_t m_iSideLength = size_t(1) << inNumOfQubits;
+    const CMatrix m_mMatrix1 = GenerateRandomMatrix(m_iSideLength, generator);
+    const CMatrix m_mMatrix2 = GenerateRandomMatrix(m_iSideLength, generator);
+    string m_sPauli1, m_sPauli2;
+    for ( unsigned short int q = 0; q < inNumOfQubits; q++ ) {
+        m_sPauli1 += PAULI_CHARS[q % 3 + 1];
+        m_sPauli2 += PAULI_CHARS[(q + 2) % 4];
+    }
 
+    unsigned short int m_iNumOfSuccTests = 0;
+    unsigned short int m_iNumOfUnsuccTests = 0;
+    auto Record = [&](const bool inIsCorrect, const string &inDescription) {
+        if (inIsCorrect)
+            m_iNumOfSuccTests++;
+        else {
+            m_iNumOfUnsuccTests++;
+            cout << inDescription << " FAILED." << endl;
+        }
+    };
 
+    cout << "Number of Iterations: " << inNumOfIterations << endl;
+    cout << "Using " << m_iSideLength << " x " << m_iSideLength << " matrices" << endl;
     cout << "Performing Tests . . . " << endl;
-    for ( unsigned short int i = 1; i <= inNumOfTests; i++ ) {
-        cout << "Test " << i << ": " << endl;
 
-        CMatrix m_mInputMatrix = GenerateHermitianMatrix(inBoundParam, inSideLength);
-        cout << "Input Hermitian Matrix: " << endl;
-        m_mInputMatrix.PrintMatrix();
+    const vector<complex<float>> m_vecExpected = RunAllocatorPipeline(m_mMatrix1, m_mMatrix2, m_sPauli1, m_sPauli2);
+
+    CMatrixArena m_maArena = CMatrixArena(size_t(1) << 14);
+    CMatrixPool m_mpPool;
+    CMatrixAllocator *const m_arrpAllocators[2] = { &m_maArena, &m_mpPool };
+    const string m_arrsAllocatorNames[2] = { "CMatrixArena", "CMatrixPool" };
+    for ( int a = 0; a < 2; a++ ) {
+        bool m_bIsCorrect = true;
+        size_t m_iNumOfWarmUpstreamAllocations = 0;
+        for ( unsigned short int i = 0; i < inNumOfIterations; i++ ) {
+            {
+                CMatrixAllocatorScope m_masScope(*m_arrpAllocators[a]);
+                if ( GetMatrixAllocator() != m_arrpAllocators[a] || RunAllocatorPipeline(m_mMatrix1, m_mMatrix2, m_sPauli1, m_sPauli2) != m_vecExpected )
+                    m_bIsCorrect = false;
+            }
+            if ( a == 0 )
+                m_maArena.Reset();
+            const CAllocatorStatistics &m_asStatistics = (a == 0) ? m_maArena.GetStatistics() : m_mpPool.GetStatistics();
+            if ( i == 0 )
+                m_iNumOfWarmUpstreamAllocations = m_asStatistics.m_iNumOfUpstreamAllocations;
+            if ( m_asStatistics.m_iNumOfBytesInUse != 0 || m_asStatistics.m_iNumOfUpstreamAllocations != m_iNumOfWarmUpstreamAllocations 
+                 || m_asStatistics.m_iNumOfAllocations == 0 || m_asStatistics.m_iHighWaterMark == 0 
+                 || m_asStatistics.m_iHighWaterMark > m_asStatistics.m_iNumOfBytesReserved )
+                m_bIsCorrect = false;
+        }
+        Record(m_bIsCorrect && GetMatrixAllocator() == GetDefaultMatrixAllocator(), "Algebra loop with a " + m_arrsAllocatorNames[a]);
+    }
 
-        cout << "Output Decomposition: " << endl;
-        vector<float> m_vecRealConst = m_mInputMatrix.PauliDecomposition();
-        cout << "(" << m_vecRealConst.at(0) << "I) + " << "(" << m_vecRealConst.at(1) << "X) + " << "(" << m_vecRealConst.at(2) << "Y) + " << "(" << m_vecRealConst.at(3) << "Z)\n" << endl;
-        
-        cout << "Composed Hermitian Matrix from Decomposition" << endl;
-        CMatrix m_mComposedMatrix = ComposeHermitian(m_vecRealConst);
-        if (m_mInputMatrix == m_mComposedMatrix) {
-            m_iNumOfSuccDecomp++;
-            m_mComposedMatrix.PrintMatrix();
+    // A matrix made in a scope gives its storage back to the pool when it is destroyed after the scope.
+    {
+        CMatrix m_mOutlives;
+        {
+            CMatrixAllocatorScope m_masScope(m_mpPool);
+            m_mOutlives = CMatrix(m_iSideLength, m_iSideLength) + m_mMatrix1;
         }
-        else {
-            m_iNumOfUnsuccDecomp++;
-            cout << "Matrices do NOT match." << endl;
+        const CMatrix m_mCopy = m_mOutlives;
+        Record(m_mpPool.GetStatistics().m_iNumOfBytesInUse > 0 && m_mCopy.GetMatrix() == m_mMatrix1.GetMatrix(), "Matrix storage held after its scope");
+    }
+    Record(m_mpPool.GetStatistics().m_iNumOfBytesInUse == 0, "Matrix storage given back after its scope");
+
+    // Nested scopes, and the most recent arena allocation given back at once.
+    {
+        CMatrixAllocatorScope m_masOuterScope(m_mpPool);
+        {
+            CMatrixAllocatorScope m_masInnerScope(m_maArena);
+            Record(GetMatrixAllocator() == &m_maArena, "Inner allocator scope");
         }
+        Record(GetMatrixAllocator() == &m_mpPool, "Outer allocator scope");
     }
+    const size_t m_iNumOfBytesInUse = m_maArena.GetStatistics().m_iNumOfBytesInUse;
+    void *m_pFirst = m_maArena.Allocate(100, 64);
+    void *m_pSecond = m_maArena.Allocate(100, 64);
+    m_maArena.Deallocate(m_pSecond, 100);
+    const bool m_bIsGivenBack = m_maArena.Allocate(100, 64) == m_pSecond && uintptr_t(m_pFirst) % 64 == 0 && uintptr_t(m_pSecond) % 64 == 0;
+    m_maArena.Reset();
+    Record(m_bIsGivenBack && m_iNumOfBytesInUse == 0 && m_maArena.GetStatistics().m_iNumOfBytesInUse == 0, "Giving back the last arena allocation");
+
+    m_mpPool.Release();
+    Record(m_mpPool.GetStatistics().m_iNumOfBytesReserved == 0, "Releasing the pool");
 
     cout << "Finished Tests. " << endl;
-    cout << "    Total Number of successful Hermitian Matrix Decomposition: " << m_iNumOfSuccDecomp << endl;
-    cout << "  Total Number of UNSUCCESSFUL Hermitian Matrix Decomposition: " << m_iNumOfUnsuccDecomp << endl;
-    cout << "      Percentage of successful Hermitian Matrix Decomposition: " << ( m_iNumOfSuccDecomp / (m_iNumOfSuccDecomp + m_iNumOfUnsuccDecomp) ) * 100 << "%" << endl; 
+    cout << "    Total Number of successful matrix allocator tests: " << m_iNumOfSuccTests << endl;
+    cout << "  Total Number of UNSUCCESSFUL matrix allocator tests: " << m_iNumOfUnsuccTests << endl;
+}
+
+
+void BenchmarkMatrixAllocators(const vector<unsigned short int> &inNumOfQubits, const unsigned short int inNumOfIterations)
+/********************************************
+ *       Purpose: Print the time of inNumOfIterations iterations of the algebra loop in TestMatrixAllocators() with the 
+ *                default allocator, a CMatrixArena reset after every iteration and a CMatrixPool, and the arena statistics.
+ *  Precondition: inNumOfIterations >= 1. Every number of qubits is at least 1.
+ * Postcondition: N/A
+********************************************/ 
+{
+    default_random_engine generator;
+    cout << GetNumOfThreads() << " thread(s)" << endl;
+    for ( unsigned short int n : inNumOfQubits ) {
+        const CMatrix m_mMatrix1 = GenerateRandomMatrix(size_t(1) << n, generator);
+        const CMatrix m_mMatrix2 = GenerateRandomMatrix(size_t(1) << n, generator);
+        const string m_sPauli1 = string(n, 'X');
+        const string m_sPauli2 = string(n, 'Y');
+
+        CMatrixArena m_maArena;
+        CMatrixPool m_mpPool;
+        double m_arrdTimes[3];
+        size_t m_arriAllocations[3];
+        for ( int a = 0; a < 3; a++ ) {
+            CMatrixAllocator *m_pAllocator = (a == 0) ? GetDefaultMatrixAllocator() : (a == 1) ? static_cast<CMatrixAllocator *>(&m_maArena) : &m_mpPool;
+            const size_t m_iNumOfAllocations = GetNumOfAllocations();
+            chrono::steady_clock::time_point m_tStart = chrono::steady_clock::now();
+            for ( unsigned short int i = 0; i < inNumOfIterations; i++ ) {
+                {
+                    CMatrixAllocatorScope m_masScope(*m_pAllocator);
+                    RunAllocatorPipeline(m_mMatrix1, m_mMatrix2, m_sPauli1, m_sPauli2);
+                }
+                if ( a == 1 )
+                    m_maArena.Reset();
+            }
+            chrono::duration<double> m_tElapsed = chrono::steady_clock::now() - m_tStart;
+            m_arrdTimes[a] = m_tElapsed.count();
+            m_arriAllocations[a] = GetNumOfAllocations() - m_iNumOfAllocations;
+        }
+
+        const CAllocatorStatistics &m_asArena = m_maArena.GetStatistics();
+        cout << (size_t(1) << n) << " x " << (size_t(1) << n) << " loop, " << inNumOfIterations << " iterations:  default " << m_arrdTimes[0] << " s, "
+             << "arena " << m_arrdTimes[1] << " s, pool " << m_arrdTimes[2] << " s.  Arena: " << m_asArena.m_iNumOfAllocations << " allocations, " 
+             << m_asArena.m_iHighWaterMark << " byte high-water mark, " << m_asArena.m_iNumOfUpstreamAllocations << " block(s)." << endl;
+#if defined(PML_COUNT_ALLOCATIONS)
+        cout << "    Heap allocations:  default " << m_arriAllocations[0] << ", arena " << m_arriAllocations[1] << ", pool " << m_arriAllocations[2] << endl;
+#else
+        (void) m_arriAllocations;
+#endif
+    }
 }
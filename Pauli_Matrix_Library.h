@@ -9,48 +9,1072 @@
 #include <random>
 #include <algorithm>
 #include <array>
+#include <utility>
+#include <iterator>
+#include <memory>
+#include <type_traits>
 #include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
 using namespace std;
 
 
 #ifndef PAULI_MATRIX_LIBRARY
 #define PAULI_MATRIX_LIBRARY
 
-// Square Matrices 
-class CMatrix {
+class CMatrix;
+class CPauliString;
+class CPauliSum;
+class CMonomialMatrix;
+
+// Non-owning reference to a callable such as a lambda, for parameters that are only called before the function returns.
+// Unlike std::function it never allocates, so starting a parallel loop costs no heap allocation.
+template <class Signature> class CFunctionReference;
+template <class R, class... Args>
+class CFunctionReference<R(Args...)> {
+public:
+    template <class F> CFunctionReference(const F &inCallable) : m_pCallable(&inCallable), m_pInvoke(&Invoke<F>) {};
+    R operator()(Args... inArgs) const { return m_pInvoke(m_pCallable, inArgs...); };
+
+private:
+    template <class F> static R Invoke(const void *inCallable, Args... inArgs) { return (*static_cast<const F *>(inCallable))(inArgs...); };
+    const void *m_pCallable;
+    R (*m_pInvoke)(const void *, Args...);
+};
+
+// Heap allocations made through the global operator new and CAlignedAllocator so far. They are only counted when 
+// Pauli_Matrix_Library.cc is compiled with PML_COUNT_ALLOCATIONS, which replaces the global operator new. Otherwise 0.
+size_t GetNumOfAllocations();
+void RecordAllocation();
+
+// Worker threads shared by the large CMatrix, Pauli decomposition and state vector routines.
+// The number of threads comes from SetNumOfThreads(), else the PML_NUM_THREADS environment variable, 
+// else the number of cores. Loops with fewer than PARALLEL_GRAIN_SIZE entries of work stay on the calling thread.
+const size_t PARALLEL_GRAIN_SIZE = 1 << 16;
+size_t GetNumOfThreads();
+void SetNumOfThreads(const size_t inNumOfThreads);
+void ParallelFor(const size_t inBegin, const size_t inEnd, const size_t inGrainSize, const CFunctionReference<void(size_t, size_t)> &inBody);
+
+// Storage of at least HUGE_PAGE_SIZE bytes from AllocateAligned() starts on a HUGE_PAGE_SIZE boundary and, on Linux, 
+// is advised to use transparent huge pages, so sweeps over large matrices take far fewer TLB misses. 
+// Huge pages are on unless the PML_HUGE_PAGES environment variable is 0 or SetHugePages(false) is called.
+const size_t HUGE_PAGE_SIZE = size_t(1) << 21;
+bool GetHugePages();
+void SetHugePages(const bool inIsEnabled);
+void *AllocateAligned(const size_t inNumOfBytes, const size_t inAlignment);
+void FreeAligned(void *inMemory);
+
+// Allocator for vectors whose data must start on an inAlignment byte boundary, such as matrix entries and SIMD planes.
+template <class T, size_t inAlignment = 64>
+class CAlignedAllocator {
+public:
+    typedef T value_type;
+    template <class U> struct rebind { typedef CAlignedAllocator<U, inAlignment> other; };
+
+    CAlignedAllocator() {}
+    template <class U> CAlignedAllocator(const CAlignedAllocator<U, inAlignment> &) {}
+
+    T *allocate(size_t inNumOfElements)  { return static_cast<T *>(AllocateAligned(inNumOfElements * sizeof(T), inAlignment)); }
+    void deallocate(T *inMemory, size_t) { FreeAligned(inMemory); }
+};
+template <class T, class U, size_t inAlignment>
+bool operator==(const CAlignedAllocator<T, inAlignment> &, const CAlignedAllocator<U, inAlignment> &) { return true; }
+template <class T, class U, size_t inAlignment>
+bool operator!=(const CAlignedAllocator<T, inAlignment> &, const CAlignedAllocator<U, inAlignment> &) { return false; }
+
+// Counters kept by a CMatrixArena or CMatrixPool. Byte counts include rounding up to the alignment or size class.
+struct CAllocatorStatistics {
+    size_t m_iNumOfAllocations;          // Calls to Allocate()
+    size_t m_iNumOfUpstreamAllocations;  // Blocks taken from AllocateAligned(). Stays the same once a loop is warmed up.
+    size_t m_iNumOfBytesInUse;           // Bytes handed out and not yet given back
+    size_t m_iHighWaterMark;             // Most bytes in use at once
+    size_t m_iNumOfBytesReserved;        // Bytes held from AllocateAligned(), in use or not
+};
+
+// Source of the heap storage of CMatrix entries. By default storage comes from AllocateAligned(). A CMatrixAllocatorScope 
+// makes another allocator, such as a CMatrixArena or CMatrixPool, the source for every CMatrix that allocates on the 
+// calling thread until the scope ends. Storage remembers its allocator and is always given back to it, so a matrix 
+// may outlive the scope, but not the allocator. Allocators are not thread safe. Use each one from one thread at a time.
+class CMatrixAllocator {
+public:
+    virtual ~CMatrixAllocator() {}
+    virtual void *Allocate(const size_t inNumOfBytes, const size_t inAlignment) = 0;
+    virtual void Deallocate(void *inMemory, const size_t inNumOfBytes) = 0;
+};
+CMatrixAllocator *GetDefaultMatrixAllocator();
+CMatrixAllocator *GetMatrixAllocator();
+
+// Makes ioAllocator the matrix allocator of the calling thread for the lifetime of the scope, then restores the previous one.
+class CMatrixAllocatorScope {
+public:
+    explicit CMatrixAllocatorScope(CMatrixAllocator &ioAllocator);
+    ~CMatrixAllocatorScope();
+    CMatrixAllocatorScope(const CMatrixAllocatorScope &) = delete;
+    CMatrixAllocatorScope &operator=(const CMatrixAllocatorScope &) = delete;
+
+private:
+    CMatrixAllocator *m_pPreviousAllocator;
+};
+
+// Bump pointer arena for the temporaries of one computation. Allocate() advances a pointer through large blocks, 
+// and Reset() hands every byte back in O(1) while keeping the blocks, so the next computation allocates nothing 
+// from the heap. Deallocate() only gives back the most recent allocation, so stack-like temporaries reuse the same bytes.
+class CMatrixArena : public CMatrixAllocator {
+public:
+    explicit CMatrixArena(const size_t inBlockSize = size_t(1) << 20);
+    ~CMatrixArena();
+    CMatrixArena(const CMatrixArena &) = delete;
+    CMatrixArena &operator=(const CMatrixArena &) = delete;
+
+    void *Allocate(const size_t inNumOfBytes, const size_t inAlignment) override;
+    void Deallocate(void *inMemory, const size_t inNumOfBytes) override;
+    void Reset();
+    const CAllocatorStatistics &GetStatistics() const { return m_asStatistics; };
+
+private:
+    struct CBlock { 
+        char *m_pMemory; 
+        size_t m_iSize; 
+    };
+    vector<CBlock> m_vecBlocks;
+    size_t m_iBlockSize;
+    size_t m_iBlockIndex;      // Block the pointer is in
+    size_t m_iOffset;          // Bytes used in that block
+    size_t m_iBytesBeforeBlock; // Bytes in use in the blocks before it, including skipped tails
+    void *m_pLastAllocation;
+    CAllocatorStatistics m_asStatistics;
+};
+
+// Pool of buffers in power of 2 size classes from 64 bytes up. Deallocate() keeps each buffer on the free list of its 
+// class and Allocate() takes it back, so loops that make and destroy matrices of the same shapes on every iteration, 
+// such as Goal1Test() and Goal2Test(), only reach AllocateAligned() on their first iteration. Release() frees the cached buffers.
+class CMatrixPool : public CMatrixAllocator {
+public:
+    CMatrixPool();
+    ~CMatrixPool();
+    CMatrixPool(const CMatrixPool &) = delete;
+    CMatrixPool &operator=(const CMatrixPool &) = delete;
+
+    void *Allocate(const size_t inNumOfBytes, const size_t inAlignment) override;
+    void Deallocate(void *inMemory, const size_t inNumOfBytes) override;
+    void Release();
+    const CAllocatorStatistics &GetStatistics() const { return m_asStatistics; };
+
+private:
+    static const size_t MIN_SIZE_CLASS = 6;    // 2^6 = 64 bytes, which is also the alignment of every buffer
+    vector<vector<void *> > m_vecFreeLists;    // m_vecFreeLists[k] holds free buffers of 2^k bytes
+    CAllocatorStatistics m_asStatistics;
+};
+
+// Vector of trivially copyable T that keeps up to inNumOfInlineElements elements inside the object, on an inAlignment 
+// byte boundary, and only moves them to heap storage from the calling thread's CMatrixAllocator when it grows past that. 
+// Small CMatrix objects, such as the 2 x 2 Pauli matrices, are then made, copied and destroyed without touching the heap. 
+// Has the part of the vector interface that CMatrix uses, and its iterators are pointers. Moving inline elements copies them.
+template <class T, size_t inNumOfInlineElements, size_t inAlignment = 64>
+class CSmallVector {
+    static_assert(is_trivially_copyable<T>::value, "CSmallVector copies its elements as bytes.");
+public:
+    typedef T value_type;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+    CSmallVector() : m_pData(InlineData()), m_iSize(0), m_iCapacity(inNumOfInlineElements), m_pAllocator(NULL) {}
+    explicit CSmallVector(const size_t inSize, const T &inValue = T()) : CSmallVector() { assign(inSize, inValue); }
+    CSmallVector(const CSmallVector &inVector2) : CSmallVector() { assign(inVector2.begin(), inVector2.end()); }
+    CSmallVector(CSmallVector &&inVector2) noexcept : CSmallVector() { TakeFrom(inVector2); }
+    ~CSmallVector() { Release(); }
+    CSmallVector &operator=(const CSmallVector &inVector2) { 
+        if ( this != &inVector2 ) 
+            assign(inVector2.begin(), inVector2.end()); 
+        return *this; 
+    }
+    CSmallVector &operator=(CSmallVector &&inVector2) noexcept { 
+        if ( this != &inVector2 ) {
+            Release();
+            m_pData = InlineData();
+            m_iCapacity = inNumOfInlineElements;
+            m_pAllocator = NULL;
+            TakeFrom(inVector2);
+        }
+        return *this; 
+    }
+
+    size_t size() const                      { return m_iSize; }
+    size_t capacity() const                  { return m_iCapacity; }
+    bool empty() const                       { return m_iSize == 0; }
+    bool IsInline() const                    { return m_pData == InlineData(); }
+    T *data()                                { return m_pData; }
+    const T *data() const                    { return m_pData; }
+    T *begin()                               { return m_pData; }
+    const T *begin() const                   { return m_pData; }
+    T *end()                                 { return m_pData + m_iSize; }
+    const T *end() const                     { return m_pData + m_iSize; }
+    T &operator[](const size_t inIndex)             { return m_pData[inIndex]; }
+    const T &operator[](const size_t inIndex) const { return m_pData[inIndex]; }
+    T &at(const size_t inIndex)              { CheckIndex(inIndex); return m_pData[inIndex]; }
+    const T &at(const size_t inIndex) const  { CheckIndex(inIndex); return m_pData[inIndex]; }
+
+    void clear() { m_iSize = 0; }
+    void reserve(const size_t inCapacity) { 
+        if ( inCapacity > m_iCapacity ) 
+            Reallocate(inCapacity, true); 
+    }
+    void resize(const size_t inSize, const T &inValue = T()) {
+        reserve(inSize);
+        if ( inSize > m_iSize )
+            uninitialized_fill(m_pData + m_iSize, m_pData + inSize, inValue);
+        m_iSize = inSize;
+    }
+    void assign(const size_t inSize, const T &inValue) {
+        if ( inSize > m_iCapacity ) 
+            Reallocate(inSize, false);
+        uninitialized_fill(m_pData, m_pData + inSize, inValue);
+        m_iSize = inSize;
+    }
+    template <class I, class = typename iterator_traits<I>::iterator_category>
+    void assign(I inFirst, I inLast) {
+        const size_t m_iSize2 = size_t(distance(inFirst, inLast));
+        if ( m_iSize2 > m_iCapacity ) 
+            Reallocate(m_iSize2, false);
+        uninitialized_copy(inFirst, inLast, m_pData);
+        m_iSize = m_iSize2;
+    }
+    // Gives up heap storage, returning to the inline buffer when the elements fit in it.
+    void shrink_to_fit() {
+        if ( !IsInline() && m_iSize <= inNumOfInlineElements ) {
+            T *m_pHeapData = m_pData;
+            const size_t m_iHeapCapacity = m_iCapacity;
+            m_pData = InlineData();
+            m_iCapacity = inNumOfInlineElements;
+            uninitialized_copy(m_pHeapData, m_pHeapData + m_iSize, m_pData);
+            m_pAllocator->Deallocate(m_pHeapData, m_iHeapCapacity * sizeof(T));
+            m_pAllocator = NULL;
+        }
+    }
+    void swap(CSmallVector &inVector2) noexcept {
+        if ( !IsInline() && !inVector2.IsInline() ) {
+            std::swap(m_pData, inVector2.m_pData);
+            std::swap(m_iSize, inVector2.m_iSize);
+            std::swap(m_iCapacity, inVector2.m_iCapacity);
+            std::swap(m_pAllocator, inVector2.m_pAllocator);
+            return;
+        }
+        CSmallVector m_vecTemporary = std::move(inVector2);
+        inVector2 = std::move(*this);
+        *this = std::move(m_vecTemporary);
+    }
+
+private:
+    T *InlineData()             { return reinterpret_cast<T *>(m_arrInline); }
+    const T *InlineData() const { return reinterpret_cast<const T *>(m_arrInline); }
+    void Release() { 
+        if ( !IsInline() ) 
+            m_pAllocator->Deallocate(m_pData, m_iCapacity * sizeof(T)); 
+    }
+    // Moves to heap storage of inCapacity elements, keeping the elements when inWillKeep is true.
+    void Reallocate(const size_t inCapacity, const bool inWillKeep) {
+        CMatrixAllocator *m_pNewAllocator = GetMatrixAllocator();
+        T *m_pNewData = static_cast<T *>(m_pNewAllocator->Allocate(inCapacity * sizeof(T), inAlignment));
+        if ( inWillKeep )
+            uninitialized_copy(m_pData, m_pData + m_iSize, m_pNewData);
+        Release();
+        m_pData = m_pNewData;
+        m_iCapacity = inCapacity;
+        m_pAllocator = m_pNewAllocator;
+    }
+    // Takes the elements of inVector2, which must not be this vector, and leaves it empty and inline.
+    void TakeFrom(CSmallVector &inVector2) {
+        if ( inVector2.IsInline() ) {
+            uninitialized_copy(inVector2.m_pData, inVector2.m_pData + inVector2.m_iSize, m_pData);
+            m_iSize = inVector2.m_iSize;
+        }
+        else {
+            m_pData = inVector2.m_pData;
+            m_iSize = inVector2.m_iSize;
+            m_iCapacity = inVector2.m_iCapacity;
+            m_pAllocator = inVector2.m_pAllocator;
+            inVector2.m_pData = inVector2.InlineData();
+            inVector2.m_pAllocator = NULL;
+            inVector2.m_iCapacity = inNumOfInlineElements;
+        }
+        inVector2.m_iSize = 0;
+    }
+    void CheckIndex(const size_t inIndex) const {
+        if ( inIndex >= m_iSize ) {
+            cout << "ERROR: Index " << inIndex << " is out of range for a CSmallVector of size " << m_iSize << "." << '\n'
+                 << "EXITING PROGRAM . . ." << endl;
+            exit(1);
+        }
+    }
+
+    // With no inline elements the object keeps the alignment of T and a placeholder byte.
+    alignas(inNumOfInlineElements > 0 ? inAlignment : alignof(T)) unsigned char m_arrInline[inNumOfInlineElements > 0 ? inNumOfInlineElements * sizeof(T) : 1];
+    T *m_pData;
+    size_t m_iSize;
+    size_t m_iCapacity;
+    CMatrixAllocator *m_pAllocator; // Source of the heap storage. NULL while inline.
+};
+
+// Storage layout of a CMatrix.
+// INTERLEAVED_LAYOUT: one vector<complex<float>> with each real part next to its imaginary part.
+//       SPLIT_LAYOUT: a plane of real parts followed by a plane of imaginary parts. Each plane starts 
+//                     on a 64 byte boundary and is padded with 0's to a multiple of 16 floats.
+enum EMatrixLayout { INTERLEAVED_LAYOUT, SPLIT_LAYOUT };
+
+// Order of the entries of a matrix view made over memory the library does not own. See MakeMatrixView().
+//    ROW_MAJOR: entry (r, c) is at index r * ld + c, like a CMatrix.
+// COLUMN_MAJOR: entry (r, c) is at index c * ld + r, as in BLAS and LAPACK.
+// ld is the leading dimension, the distance between the starts of consecutive rows or columns.
+enum EMatrixOrder { ROW_MAJOR, COLUMN_MAJOR };
+
+// Largest side length of a CMatrix, 2^30 on 64 bit targets, and the most qubits a dense matrix can act on. 
+// Every entry index and byte count of a MAX_SIDE_LENGTH x MAX_SIDE_LENGTH matrix still fits in a size_t, 
+// so only memory limits the size.
+const size_t MAX_NUM_OF_QUBITS = 4 * sizeof(size_t) - 2;
+const size_t MAX_SIDE_LENGTH = size_t(1) << MAX_NUM_OF_QUBITS;
+
+// Interleaved CMatrix entries are stored inside the object, without a heap allocation, for matrices of up to 
+// SMALL_MATRIX_NUM_OF_ENTRIES entries, such as the 2 x 2 Pauli matrices and 4 x 4 two qubit operators.
+const size_t SMALL_MATRIX_NUM_OF_ENTRIES = 16;
+
+// Base of every lazy matrix expression. See the expression templates after CMatrix.
+template <class E> class CAdjointExpression;
+template <class E>
+class CMatrixExpression {
+public:
+    const E &Self() const { return static_cast<const E &>(*this); }
+    CAdjointExpression<E> Adjoint() const;
+};
+
+// Element access through operator() and the matrix views is unchecked in release builds. 
+// Indices are checked when PML_BOUNDS_CHECKS is defined, which it is by default in any build without NDEBUG.
+#if !defined(NDEBUG) && !defined(PML_BOUNDS_CHECKS)
+#define PML_BOUNDS_CHECKS
+#endif
+void ReportIndexOutOfRange(const size_t inRowIndex, const size_t inColIndex, const size_t inRowSize, const size_t inColSize);
+void ReportSplitLayoutData();
+inline void CheckIndexRange(const size_t inRowIndex, const size_t inColIndex, const size_t inRowSize, const size_t inColSize)
+{
+#if defined(PML_BOUNDS_CHECKS)
+    if ( inRowIndex >= inRowSize || inColIndex >= inColSize )
+        ReportIndexOutOfRange(inRowIndex, inColIndex, inRowSize, inColSize);
+#else
+    (void) inRowIndex; (void) inColIndex; (void) inRowSize; (void) inColSize;
+#endif
+}
+
+// Contiguous run of entries in the style of std::span. It does not own the entries.
+template <class T>
+class CSpan {
+public:
+    CSpan() : m_pData(NULL), m_iSize(0) {};
+    CSpan(T *inData, const size_t inSize) : m_pData(inData), m_iSize(inSize) {};
+    T *data() const                            { return m_pData; };
+    size_t size() const                        { return m_iSize; };
+    bool empty() const                         { return m_iSize == 0; };
+    T *begin() const                           { return m_pData; };
+    T *end() const                             { return m_pData + m_iSize; };
+    T &operator[](const size_t inIndex) const  { CheckIndexRange(0, inIndex, 1, m_iSize); return m_pData[inIndex]; };
+
+private:
+    T *m_pData;
+    size_t m_iSize;
+};
+
+// Writable reference to one entry in either layout, returned by the non-const operator() of 
+// CMatrix and CMatrixView. For Example: A(r, c) = B(c, r) or A(r, c) += z
+// It converts to complex<float>, but the templated complex operators and abs() do not see through 
+// the conversion, so use Value() in arithmetic, as in abs(A(r, c).Value() - z).
+template <class T>
+class CEntryReference {
+public:
+    CEntryReference(T *inReal, T *inImag) : m_pReal(inReal), m_pImag(inImag) {};
+    operator complex<float>() const { return complex<float>(*m_pReal, *m_pImag); };
+    complex<float> Value() const    { return complex<float>(*m_pReal, *m_pImag); };
+    float real() const              { return *m_pReal; };
+    float imag() const              { return *m_pImag; };
+    const CEntryReference &operator=(const complex<float> &inZ) const   { *m_pReal = inZ.real(); *m_pImag = inZ.imag(); return *this; };
+    const CEntryReference &operator=(const CEntryReference &inZ) const  { return *this = inZ.Value(); };
+    const CEntryReference &operator+=(const complex<float> &inZ) const  { *m_pReal += inZ.real(); *m_pImag += inZ.imag(); return *this; };
+    const CEntryReference &operator-=(const complex<float> &inZ) const  { *m_pReal -= inZ.real(); *m_pImag -= inZ.imag(); return *this; };
+    const CEntryReference &operator*=(const complex<float> &inZ) const  { return *this = Value() * inZ; };
+
+private:
+    T *m_pReal;
+    T *m_pImag;
+};
+
+// A window onto the entries of a CMatrix, such as a row, a column, a submatrix or every other entry, 
+// that aliases the matrix storage instead of copying it. Writes through a CMatrixView change the matrix. 
+// Anything that reallocates the matrix, such as SetLayout() or assigning a matrix of another size, invalidates its views.
+// Entry (r, c) is at m_pReal[r * m_iRowStride + c * m_iColStride] and likewise through m_pImag, which covers both layouts.
+// Views are matrix expressions, so A = B.Submatrix(0, 0, 4, 4) + C.Submatrix(4, 4, 4, 4) is one fused pass. 
+// CConstMatrixView is the read only view of a const CMatrix. Transposed() swaps the strides, so the transpose 
+// of a row major block is a column major view of the same entries.
+template <class T>
+class CMatrixViewBase : public CMatrixExpression<CMatrixViewBase<T> > {
+public:
+    CMatrixViewBase(T *inReal, T *inImag, const size_t inRowSize, const size_t inColSize, 
+                    const size_t inRowStride, const size_t inColStride, const CMatrix *inOwner) 
+        : m_pReal(inReal), m_pImag(inImag), m_iRowSize(inRowSize), m_iColSize(inColSize), 
+          m_iRowStride(inRowStride), m_iColStride(inColStride), m_pOwner(inOwner) {};
+    CMatrixViewBase(const CMatrixViewBase &inView) = default;
+    template <class U> CMatrixViewBase(const CMatrixViewBase<U> &inView) 
+        : m_pReal(inView.m_pReal), m_pImag(inView.m_pImag), m_iRowSize(inView.m_iRowSize), m_iColSize(inView.m_iColSize), 
+          m_iRowStride(inView.m_iRowStride), m_iColStride(inView.m_iColStride), m_pOwner(inView.m_pOwner) {};
+
+    size_t GetRowSize() const   { return m_iRowSize; };
+    size_t GetColSize() const   { return m_iColSize; };
+    size_t GetRowStride() const { return m_iRowStride; };
+    size_t GetColStride() const { return m_iColStride; };
+    T *GetRealData() const      { return m_pReal; };      // Real part of entry (0, 0).
+    T *GetImagData() const      { return m_pImag; };      // Imaginary part of entry (0, 0).
+    const CMatrix *GetOwner() const { return m_pOwner; }; // NULL for a view made by MakeMatrixView().
+    CEntryReference<T> operator()(const size_t inRowIndex, const size_t inColIndex) const { 
+        CheckIndexRange(inRowIndex, inColIndex, m_iRowSize, m_iColSize);
+        const size_t m_iOffset = inRowIndex * m_iRowStride + inColIndex * m_iColStride;
+        return CEntryReference<T>(m_pReal + m_iOffset, m_pImag + m_iOffset); 
+    };
+
+    CMatrixViewBase Row(const size_t inRowIndex) const    { return Submatrix(inRowIndex, 0, 1, m_iColSize); };
+    CMatrixViewBase Column(const size_t inColIndex) const { return Submatrix(0, inColIndex, m_iRowSize, 1); };
+    CMatrixViewBase Submatrix(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize) const {
+        return Strided(inRowBegin, inColBegin, inRowSize, inColSize, 1, 1);
+    };
+    CMatrixViewBase Strided(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize, 
+                            const size_t inRowStep, const size_t inColStep) const;
+    CMatrixViewBase Transposed() const {
+        return CMatrixViewBase(m_pReal, m_pImag, m_iColSize, m_iRowSize, m_iColStride, m_iRowStride, m_pOwner);
+    };
+
+    // Copy entries into the view. The view must have the size of the expression. 
+    CMatrixViewBase &operator=(const CMatrixViewBase &inView);
+    template <class E> CMatrixViewBase &operator=(const CMatrixExpression<E> &inExpression);
+
+    // Expression Template Interface
+    //-------------------------------------
+    complex<float> EntryAt(const size_t inRowIndex, const size_t inColIndex) const {
+        const size_t m_iOffset = inRowIndex * m_iRowStride + inColIndex * m_iColStride;
+        return complex<float>(m_pReal[m_iOffset], m_pImag[m_iOffset]);
+    };
+    bool IsSafeToAssignTo(const CMatrix *inTarget, const bool) const { return inTarget != m_pOwner; };
+
+private:
+    template <class U> friend class CMatrixViewBase;
+    T *m_pReal;
+    T *m_pImag;
+    size_t m_iRowSize;
+    size_t m_iColSize;
+    size_t m_iRowStride;                                     // In floats.
+    size_t m_iColStride;                                     // In floats.
+    const CMatrix *m_pOwner;
+};
+typedef CMatrixViewBase<float> CMatrixView;
+typedef CMatrixViewBase<const float> CConstMatrixView;
+
+// Dense Matrices of any shape, stored row major in either EMatrixLayout.
+class CMatrix : public CMatrixExpression<CMatrix> {
 public:
     // Base Class Constructors
     //-------------------------------------
     CMatrix();
     CMatrix(string inPauliID);
-    CMatrix(unsigned short int inRowSize, unsigned short int inColSize);
+    CMatrix(size_t inRowSize, size_t inColSize, EMatrixLayout inLayout=INTERLEAVED_LAYOUT);
     CMatrix(const CMatrix &inMatrix2); // Copy Constructor
+    CMatrix(CMatrix &&inMatrix2) noexcept; // Move Constructor
+    template <class E> CMatrix(const CMatrixExpression<E> &inExpression);
     
     // Base Class Methods
     //-------------------------------------
-    vector<complex<float>> GetMatrix() const { return m_vecMatrix; };
-    unsigned short int GetRowSize() const    { return m_iRowSize; };
-    unsigned short int GetColSize() const    { return m_iColSize; }; 
+    vector<complex<float>> GetMatrix() const;
+    size_t GetRowSize() const                { return m_iRowSize; };
+    size_t GetColSize() const                { return m_iColSize; }; 
+    EMatrixLayout GetLayout() const          { return m_eLayout; };
+    void SetLayout(const EMatrixLayout inLayout);
+    size_t GetPlaneSize() const;
+    const float *GetRealPlane() const;
+    const float *GetImagPlane() const;
     void PrintMatrix() const;
-    complex<float> GetValueAt(const unsigned short int inRowIndex,  const unsigned short int inColIndex) const;
-    void ModifyValueAt(const unsigned short int inRowIndex,  const unsigned short int inColIndex, const complex<float> inVal);
+    complex<float> GetValueAt(const size_t inRowIndex,  const size_t inColIndex) const;
+    void ModifyValueAt(const size_t inRowIndex,  const size_t inColIndex, const complex<float> inVal);
     void ConjugateTranspose();
     bool operator==(const CMatrix& inMatrix2);
     complex<float> Trace() const;
-    void operator*(const CMatrix &inMatrix2);      // TODO: Consider changing this to return an object.
-    void MatrixMultiply(const CMatrix &inMatrix2); // TODO: Consider changing this to return an object.
+    CMatrix operator*(const CMatrix &inMatrix2) const;
+    vector<complex<float>> operator*(const vector<complex<float>> &inVector) const;
+    void MatrixMultiply(const CMatrix &inMatrix2);
     vector<float> PauliDecomposition() const;
+    vector<complex<float>> PauliCoefficients() const;
+    CPauliSum PauliDecompositionSparse(const float inDropTolerance=0) const;
+    CMatrix &operator=(const CMatrix &inMatrix2);
+    CMatrix &operator=(CMatrix &&inMatrix2) noexcept;
+    template <class E> CMatrix &operator=(const CMatrixExpression<E> &inExpression);
+
+    // Unchecked Element Access and Views. Indices are only checked under PML_BOUNDS_CHECKS.
+    //-------------------------------------
+    CEntryReference<float> operator()(const size_t inRowIndex, const size_t inColIndex) {
+        CheckIndexRange(inRowIndex, inColIndex, m_iRowSize, m_iColSize);
+        const size_t m_iIndex = inRowIndex * m_iColSize + inColIndex;
+        if ( m_eLayout == INTERLEAVED_LAYOUT ) {
+            float *m_pEntry = reinterpret_cast<float *>(m_vecMatrix.data() + m_iIndex);
+            return CEntryReference<float>(m_pEntry, m_pEntry + 1);
+        }
+        return CEntryReference<float>(m_vecSplitMatrix.data() + m_iIndex, m_vecSplitMatrix.data() + m_vecSplitMatrix.size() / 2 + m_iIndex);
+    };
+    complex<float> operator()(const size_t inRowIndex, const size_t inColIndex) const {
+        CheckIndexRange(inRowIndex, inColIndex, m_iRowSize, m_iColSize);
+        return GetEntry(inRowIndex * m_iColSize + inColIndex);
+    };
+    // Data() spans the interleaved entries in place and needs INTERLEAVED_LAYOUT. It exits on a SPLIT_LAYOUT matrix, 
+    // which has no interleaved entries; read those through View() or operator().
+    CSpan<complex<float> > Data() { 
+        if ( m_eLayout == SPLIT_LAYOUT ) ReportSplitLayoutData();
+        return CSpan<complex<float> >(m_vecMatrix.data(), m_vecMatrix.size()); 
+    };
+    CSpan<const complex<float> > Data() const { 
+        if ( m_eLayout == SPLIT_LAYOUT ) ReportSplitLayoutData();
+        return CSpan<const complex<float> >(m_vecMatrix.data(), m_vecMatrix.size()); 
+    };
+    CMatrixView View()                        { return ViewOf<float>(*this); };
+    CConstMatrixView View() const             { return ViewOf<const float>(*this); };
+    CMatrixView Row(const size_t inRowIndex)                   { return View().Row(inRowIndex); };
+    CConstMatrixView Row(const size_t inRowIndex) const        { return View().Row(inRowIndex); };
+    CMatrixView Column(const size_t inColIndex)                { return View().Column(inColIndex); };
+    CConstMatrixView Column(const size_t inColIndex) const     { return View().Column(inColIndex); };
+    CMatrixView Submatrix(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize) { 
+        return View().Submatrix(inRowBegin, inColBegin, inRowSize, inColSize); 
+    };
+    CConstMatrixView Submatrix(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize) const { 
+        return View().Submatrix(inRowBegin, inColBegin, inRowSize, inColSize); 
+    };
+    CMatrixView Strided(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize, 
+                        const size_t inRowStep, const size_t inColStep) { 
+        return View().Strided(inRowBegin, inColBegin, inRowSize, inColSize, inRowStep, inColStep); 
+    };
+    CConstMatrixView Strided(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize, 
+                             const size_t inRowStep, const size_t inColStep) const { 
+        return View().Strided(inRowBegin, inColBegin, inRowSize, inColSize, inRowStep, inColStep); 
+    };
+
+    // Expression Template Interface
+    //-------------------------------------
+    complex<float> EntryAt(const size_t inRowIndex, const size_t inColIndex) const { return GetEntry(inRowIndex * m_iColSize + inColIndex); };
+    bool IsSafeToAssignTo(const CMatrix *inTarget, const bool inIsTransposed) const { return !inIsTransposed || inTarget != this; };
+
+    friend void MultiplyInto(CMatrix &outMatrix, const CMatrix &inMatrix1, const CMatrix &inMatrix2);
+    friend void MultiplyInto(vector<complex<float>> &outVector, const CMatrix &inMatrix, const vector<complex<float>> &inVector);
+    friend void KroneckerProductInto(CMatrix &outMatrix, const CMatrix *const *inFactors, const size_t inNumOfFactors);
+    friend complex<float> TraceOfProduct(const CMatrix &inMatrix1, const CMatrix &inMatrix2, const bool inIsCompensated);
+    friend complex<float> HilbertSchmidtInner(const CMatrix &inMatrix1, const CMatrix &inMatrix2, const bool inIsCompensated);
+    friend float FrobeniusNorm(const CMatrix &inMatrix, const bool inIsCompensated);
+    friend void MultiplyInto(CMatrix &outMatrix, const CMonomialMatrix &inMonomial, const CMatrix &inMatrix);
+    friend void MultiplyInto(CMatrix &outMatrix, const CMatrix &inMatrix, const CMonomialMatrix &inMonomial);
+    friend void LeftMultiplyPauli(CMatrix &ioMatrix, const CPauliString &inPauli);
+    friend void RightMultiplyPauli(CMatrix &ioMatrix, const CPauliString &inPauli);
+    friend CMatrix ComposePauliCoefficients(const vector<complex<float>> &inCoefficients, const bool inIsParallel);
+    friend CMatrix ComposePauliSum(const CPauliSum &inPauliSum, const bool inIsParallel);
 
 protected:
     // Base Class Data Members
     //-------------------------------------
-    vector<complex<float> > m_vecMatrix; // n * n matrix represented by 1 dimensional vector.
-    unsigned short int m_iRowSize;
-    unsigned short int m_iColSize;
+    CSmallVector<complex<float>, SMALL_MATRIX_NUM_OF_ENTRIES> m_vecMatrix;    // n * n matrix represented by 1 dimensional vector. Empty in SPLIT_LAYOUT.
+    CSmallVector<float, 0> m_vecSplitMatrix;                                  // Real plane then imaginary plane. Empty in INTERLEAVED_LAYOUT.
+    EMatrixLayout m_eLayout;
+    size_t m_iRowSize;
+    size_t m_iColSize;
+
+    // Unchecked access to the entry at 1D index inIndex in either layout.
+    complex<float> GetEntry(const size_t inIndex) const { 
+        return (m_eLayout == INTERLEAVED_LAYOUT) ? m_vecMatrix[inIndex] : complex<float>(m_vecSplitMatrix[inIndex], m_vecSplitMatrix[GetPlaneSize() + inIndex]); 
+    };
+    void ScaleEntries(const complex<float> inZ);
+    void Resize(const size_t inRowSize, const size_t inColSize);
+    template <class E> void AssignExpression(const E &inExpression);
+
+    // View of every entry of inMatrix, which is a CMatrix or a const CMatrix.
+    template <class T, class M> static CMatrixViewBase<T> ViewOf(M &inMatrix) {
+        if ( inMatrix.m_eLayout == INTERLEAVED_LAYOUT ) {
+            T *m_pReal = reinterpret_cast<T *>(inMatrix.m_vecMatrix.data());
+            return CMatrixViewBase<T>(m_pReal, m_pReal + 1, inMatrix.m_iRowSize, inMatrix.m_iColSize, 2 * size_t(inMatrix.m_iColSize), 2, &inMatrix);
+        }
+        T *m_pReal = inMatrix.m_vecSplitMatrix.data();
+        return CMatrixViewBase<T>(m_pReal, m_pReal + inMatrix.m_vecSplitMatrix.size() / 2, inMatrix.m_iRowSize, inMatrix.m_iColSize, 
+                                  inMatrix.m_iColSize, 1, &inMatrix);
+    };
 };
-CMatrix ComposeHermitian(const vector<float> inRealConst);
+void MultiplyInto(CMatrix &outMatrix, const CMatrix &inMatrix1, const CMatrix &inMatrix2);
+void MultiplyInto(vector<complex<float>> &outVector, const CMatrix &inMatrix, const vector<complex<float>> &inVector);
+void KroneckerProductInto(CMatrix &outMatrix, const CMatrix *const *inFactors, const size_t inNumOfFactors);
+void KroneckerProductInto(CMatrix &outMatrix, const vector<CMatrix> &inFactors);
+void KroneckerProductInto(CMatrix &outMatrix, const CMatrix &inMatrix1, const CMatrix &inMatrix2);
+CMatrix KroneckerProduct(const vector<CMatrix> &inFactors);
+complex<float> TraceOfProduct(const CMatrix &inMatrix1, const CMatrix &inMatrix2, const bool inIsCompensated=true);
+complex<float> HilbertSchmidtInner(const CMatrix &inMatrix1, const CMatrix &inMatrix2, const bool inIsCompensated=true);
+float FrobeniusNorm(const CMatrix &inMatrix, const bool inIsCompensated=true);
+string GetSimdInstructionSet();
+bool SetSimdInstructionSet(const string &inInstructionSet);
+void CheckExpressionSizes(const size_t inRowSize1, const size_t inColSize1, 
+                          const size_t inRowSize2, const size_t inColSize2, const char *inOperation);
+void CheckViewRange(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize, 
+                    const size_t inRowStep, const size_t inColStep, const size_t inParentRowSize, const size_t inParentColSize);
+CMatrixView MakeMatrixView(complex<float> *inData, const size_t inRowSize, const size_t inColSize, 
+                           const size_t inLeadingDimension, const EMatrixOrder inOrder=ROW_MAJOR);
+CConstMatrixView MakeMatrixView(const complex<float> *inData, const size_t inRowSize, const size_t inColSize, 
+                                const size_t inLeadingDimension, const EMatrixOrder inOrder=ROW_MAJOR);
+void MultiplyInto(const CMatrixView &outView, const CConstMatrixView &inView1, const CConstMatrixView &inView2);
+CMatrix ComposeHermitian(const vector<float> &inRealConst);
+CMatrix ComposePauliCoefficients(const vector<complex<float>> &inCoefficients, const bool inIsParallel=true);
+CMatrix ComposePauliSum(const CPauliSum &inPauliSum, const bool inIsParallel=true);
+void TestMatrixMultiply(const unsigned short int inNumOfTests=10, const unsigned short int inMaxSideLength=150);
+void TestSimdKernels(const unsigned short int inNumOfTests=10, const unsigned short int inMaxSideLength=100);
+void TestSplitLayout(const unsigned short int inNumOfTests=10, const unsigned short int inMaxSideLength=100);
+void TestMatrixExpressions(const unsigned short int inNumOfTests=10, const unsigned short int inMaxSideLength=100);
+void TestThreadPool(const unsigned short int inSideLength=300);
+void TestKroneckerProduct(const unsigned short int inNumOfTests=20, const unsigned short int inMaxNumOfFactors=4);
+void TestMatrixReductions(const unsigned short int inNumOfTests=10, const unsigned short int inMaxSideLength=200);
+void TestMatrixViews(const unsigned short int inNumOfTests=20, const unsigned short int inMaxSideLength=60);
+void TestSteadyStateAllocations(const unsigned short int inSideLength=64, const unsigned short int inNumOfRepeats=10);
+void TestLargeMatrixStorage(const size_t inSideLength=1024);
+void TestSmallMatrixStorage(const unsigned short int inNumOfRepeats=10);
+void TestMatrixAllocators(const unsigned short int inNumOfIterations=20, const unsigned short int inNumOfQubits=4);
+void TestRectangularMatrices(const unsigned short int inNumOfTests=10, const unsigned short int inMaxSideLength=80);
+void TestFixedMatrices(const unsigned short int inNumOfTests=10);
+void TestDenseMatrices(const unsigned short int inNumOfTests=5, const unsigned short int inMaxNumOfQubits=7);
+void BenchmarkMatrixMultiply(const vector<size_t> &inSideLengths={64, 256, 1024}, const unsigned short int inNumOfRepeats=3, const EMatrixLayout inLayout=INTERLEAVED_LAYOUT);
+void BenchmarkMatrixExpressions(const vector<size_t> &inSideLengths={256, 1024, 4096}, const unsigned short int inNumOfRepeats=3);
+void BenchmarkKroneckerProduct(const vector<unsigned short int> &inNumOfQubits={8, 10, 12}, const unsigned short int inNumOfRepeats=3);
+void BenchmarkMatrixReductions(const vector<size_t> &inSideLengths={256, 1024, 2048}, const unsigned short int inNumOfRepeats=3);
+void BenchmarkLargeMatrixStorage(const size_t inSideLength=8192, const unsigned short int inNumOfRepeats=3);
+void BenchmarkDenseMatrices(const vector<size_t> &inSideLengths={256, 1024}, const unsigned short int inNumOfRepeats=3, const unsigned short int inNumOfQubits=10);
+void BenchmarkMatrixAllocators(const vector<unsigned short int> &inNumOfQubits={2, 4, 6}, const unsigned short int inNumOfIterations=10000);
+
+
+
+// Lazy Matrix Expressions. For Example: H = A + A.Adjoint()
+// A + B, A - B, -A, z * A, A * z, A.Adjoint() and ElementwiseProduct(A, B) only build an expression tree.
+// The tree is evaluated entry by entry in one fused pass when it is assigned to a CMatrix, so no 
+// intermediate matrices are allocated. Expressions hold references to their CMatrix operands, 
+// so assign them in the statement that builds them.
+//
+// Every expression provides GetRowSize(), GetColSize(), EntryAt(r, c) and IsSafeToAssignTo(target, transposed).
+// IsSafeToAssignTo() is false when writing entry (r, c) of target could change an entry that is still to be read, 
+// which only happens when target is read through an odd number of adjoints. Assignment then goes through a temporary.
+//-------------------------------------
 
+// Expressions keep CMatrix operands by reference and every other expression by value.
+template <class E> struct CExpressionOperand          { typedef const E type; };
+template <>        struct CExpressionOperand<CMatrix> { typedef const CMatrix &type; };
+
+struct CAddOperation {
+    static complex<float> Apply(const complex<float> &inZ1, const complex<float> &inZ2) { return inZ1 + inZ2; };
+};
+struct CSubtractOperation {
+    static complex<float> Apply(const complex<float> &inZ1, const complex<float> &inZ2) { return inZ1 - inZ2; };
+};
+struct CElementwiseMultiplyOperation {
+    static complex<float> Apply(const complex<float> &inZ1, const complex<float> &inZ2) { 
+        return complex<float>(inZ1.real() * inZ2.real() - inZ1.imag() * inZ2.imag(), inZ1.real() * inZ2.imag() + inZ1.imag() * inZ2.real()); 
+    };
+};
+
+template <class L, class R, class Op>
+class CBinaryExpression : public CMatrixExpression<CBinaryExpression<L, R, Op> > {
+public:
+    CBinaryExpression(const L &inLeft, const R &inRight, const char *inOperation) : m_left(inLeft), m_right(inRight) {
+        CheckExpressionSizes(inLeft.GetRowSize(), inLeft.GetColSize(), inRight.GetRowSize(), inRight.GetColSize(), inOperation);
+    };
+    size_t GetRowSize() const { return m_left.GetRowSize(); };
+    size_t GetColSize() const { return m_left.GetColSize(); };
+    complex<float> EntryAt(const size_t inRowIndex, const size_t inColIndex) const { 
+        return Op::Apply(m_left.EntryAt(inRowIndex, inColIndex), m_right.EntryAt(inRowIndex, inColIndex)); 
+    };
+    bool IsSafeToAssignTo(const CMatrix *inTarget, const bool inIsTransposed) const { 
+        return m_left.IsSafeToAssignTo(inTarget, inIsTransposed) && m_right.IsSafeToAssignTo(inTarget, inIsTransposed); 
+    };
 
+private:
+    typename CExpressionOperand<L>::type m_left;
+    typename CExpressionOperand<R>::type m_right;
+};
+
+template <class E>
+class CScaledExpression : public CMatrixExpression<CScaledExpression<E> > {
+public:
+    CScaledExpression(const complex<float> &inZ, const E &inExpression) : m_cxZ(inZ), m_expression(inExpression) {};
+    size_t GetRowSize() const { return m_expression.GetRowSize(); };
+    size_t GetColSize() const { return m_expression.GetColSize(); };
+    complex<float> EntryAt(const size_t inRowIndex, const size_t inColIndex) const { 
+        return CElementwiseMultiplyOperation::Apply(m_cxZ, m_expression.EntryAt(inRowIndex, inColIndex)); 
+    };
+    bool IsSafeToAssignTo(const CMatrix *inTarget, const bool inIsTransposed) const { return m_expression.IsSafeToAssignTo(inTarget, inIsTransposed); };
+
+private:
+    complex<float> m_cxZ;
+    typename CExpressionOperand<E>::type m_expression;
+};
+
+template <class E>
+class CAdjointExpression : public CMatrixExpression<CAdjointExpression<E> > {
+public:
+    CAdjointExpression(const E &inExpression) : m_expression(inExpression) {};
+    size_t GetRowSize() const { return m_expression.GetColSize(); };
+    size_t GetColSize() const { return m_expression.GetRowSize(); };
+    complex<float> EntryAt(const size_t inRowIndex, const size_t inColIndex) const { return conj(m_expression.EntryAt(inColIndex, inRowIndex)); };
+    bool IsSafeToAssignTo(const CMatrix *inTarget, const bool inIsTransposed) const { return m_expression.IsSafeToAssignTo(inTarget, !inIsTransposed); };
+
+private:
+    typename CExpressionOperand<E>::type m_expression;
+};
+
+template <class E>
+CAdjointExpression<E> CMatrixExpression<E>::Adjoint() const
+{
+    return CAdjointExpression<E>(Self());
+}
+
+template <class L, class R>
+CBinaryExpression<L, R, CAddOperation> operator+(const CMatrixExpression<L> &inLeft, const CMatrixExpression<R> &inRight)
+{
+    return CBinaryExpression<L, R, CAddOperation>(inLeft.Self(), inRight.Self(), "add");
+}
+
+template <class L, class R>
+CBinaryExpression<L, R, CSubtractOperation> operator-(const CMatrixExpression<L> &inLeft, const CMatrixExpression<R> &inRight)
+{
+    return CBinaryExpression<L, R, CSubtractOperation>(inLeft.Self(), inRight.Self(), "subtract");
+}
+
+template <class L, class R>
+CBinaryExpression<L, R, CElementwiseMultiplyOperation> ElementwiseProduct(const CMatrixExpression<L> &inLeft, const CMatrixExpression<R> &inRight)
+{
+    return CBinaryExpression<L, R, CElementwiseMultiplyOperation>(inLeft.Self(), inRight.Self(), "elementwise multiply");
+}
+
+template <class E>
+CScaledExpression<E> operator*(const complex<float> &inZ, const CMatrixExpression<E> &inExpression)
+{
+    return CScaledExpression<E>(inZ, inExpression.Self());
+}
+
+template <class E>
+CScaledExpression<E> operator*(const CMatrixExpression<E> &inExpression, const complex<float> &inZ)
+{
+    return CScaledExpression<E>(inZ, inExpression.Self());
+}
+
+template <class E>
+CScaledExpression<E> operator-(const CMatrixExpression<E> &inExpression)
+{
+    return CScaledExpression<E>(complex<float>(-1, 0), inExpression.Self());
+}
+
+template <class E>
+CMatrix::CMatrix(const CMatrixExpression<E> &inExpression) 
+    : m_eLayout(INTERLEAVED_LAYOUT), m_iRowSize(0), m_iColSize(0)
+{
+    AssignExpression(inExpression.Self());
+}
+
+template <class E>
+CMatrix &CMatrix::operator=(const CMatrixExpression<E> &inExpression)
+{
+    const E &m_expression = inExpression.Self();
+    if ( m_expression.IsSafeToAssignTo(this, false) )
+        AssignExpression(m_expression);
+    else {
+        CMatrix m_mResult = CMatrix(0, 0, m_eLayout);
+        m_mResult.AssignExpression(m_expression);
+        m_vecMatrix.swap(m_mResult.m_vecMatrix);
+        m_vecSplitMatrix.swap(m_mResult.m_vecSplitMatrix);
+        m_iRowSize = m_mResult.m_iRowSize;
+        m_iColSize = m_mResult.m_iColSize;
+    }
+    return *this;
+}
+
+template <class E>
+void CMatrix::AssignExpression(const E &inExpression)
+{
+    // Entries are written in 32 x 32 tiles so an expression that reads through an adjoint 
+    // still touches its operands one cache friendly tile at a time. Rows of tiles are split across threads.
+    const size_t TILE = 32;
+    Resize(inExpression.GetRowSize(), inExpression.GetColSize());
+    const size_t m_iPlaneSize = GetPlaneSize();
+    const size_t m_iNumOfTileRows = (size_t(m_iRowSize) + TILE - 1) / TILE;
+    const size_t m_iGrainSize = max<size_t>(1, PARALLEL_GRAIN_SIZE / (TILE * max<size_t>(1, m_iColSize)));
+    ParallelFor(0, m_iNumOfTileRows, m_iGrainSize, [&](size_t inTileRowBegin, size_t inTileRowEnd) {
+        for ( size_t tr = inTileRowBegin * TILE; tr < min(inTileRowEnd * TILE, size_t(m_iRowSize)); tr += TILE ) {
+            for ( size_t tc = 0; tc < m_iColSize; tc += TILE ) {
+                const size_t m_iRowEnd = min(tr + TILE, size_t(m_iRowSize));
+                const size_t m_iColEnd = min(tc + TILE, size_t(m_iColSize));
+                for ( size_t r = tr; r < m_iRowEnd; r++ ) {
+                    for ( size_t c = tc; c < m_iColEnd; c++ ) {
+                        const complex<float> m_cxEntry = inExpression.EntryAt(r, c);
+                        if ( m_eLayout == INTERLEAVED_LAYOUT )
+                            m_vecMatrix[r * m_iColSize + c] = m_cxEntry;
+                        else {
+                            m_vecSplitMatrix[r * m_iColSize + c] = m_cxEntry.real();
+                            m_vecSplitMatrix[m_iPlaneSize + r * m_iColSize + c] = m_cxEntry.imag();
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+template <class T>
+CMatrixViewBase<T> CMatrixViewBase<T>::Strided(const size_t inRowBegin, const size_t inColBegin, const size_t inRowSize, const size_t inColSize, 
+                                               const size_t inRowStep, const size_t inColStep) const
+{
+    // Views are made outside hot loops, so their bounds are always checked.
+    CheckViewRange(inRowBegin, inColBegin, inRowSize, inColSize, inRowStep, inColStep, m_iRowSize, m_iColSize);
+    const size_t m_iOffset = inRowBegin * m_iRowStride + inColBegin * m_iColStride;
+    return CMatrixViewBase<T>(m_pReal + m_iOffset, m_pImag + m_iOffset, inRowSize, inColSize, 
+                              inRowStep * m_iRowStride, inColStep * m_iColStride, m_pOwner);
+}
+
+template <class T>
+CMatrixViewBase<T> &CMatrixViewBase<T>::operator=(const CMatrixViewBase &inView)
+{
+    return *this = static_cast<const CMatrixExpression<CMatrixViewBase> &>(inView);
+}
+
+template <class T>
+template <class E>
+CMatrixViewBase<T> &CMatrixViewBase<T>::operator=(const CMatrixExpression<E> &inExpression)
+{
+    const E &m_expression = inExpression.Self();
+    CheckExpressionSizes(m_iRowSize, m_iColSize, m_expression.GetRowSize(), m_expression.GetColSize(), "assign to a view");
+    if ( m_expression.IsSafeToAssignTo(m_pOwner, false) && m_expression.IsSafeToAssignTo(m_pOwner, true) ) {
+        for ( size_t r = 0; r < m_iRowSize; r++ )
+            for ( size_t c = 0; c < m_iColSize; c++ )
+                (*this)(r, c) = m_expression.EntryAt(r, c);
+        return *this;
+    }
+
+    // The expression reads the matrix behind this view, so evaluate it before writing.
+    vector<complex<float> > m_vecEntries(size_t(m_iRowSize) * m_iColSize);
+    for ( size_t r = 0; r < m_iRowSize; r++ )
+        for ( size_t c = 0; c < m_iColSize; c++ )
+            m_vecEntries[r * m_iColSize + c] = m_expression.EntryAt(r, c);
+    for ( size_t r = 0; r < m_iRowSize; r++ )
+        for ( size_t c = 0; c < m_iColSize; c++ )
+            (*this)(r, c) = m_vecEntries[r * m_iColSize + c];
+    return *this;
+}
+
+
+// Square matrix with a side length N fixed at compile time, such as a 2 x 2 single qubit operator. 
+// Its entries are stored row major in a std::array, so it never allocates. The product, sum, difference, scaling, 
+// adjoint and trace are constexpr kernels unrolled over index sequences, so a 2 x 2 product is 8 complex 
+// multiply adds with no loops, and Pauli identities can be checked with static_assert. A CFixedMatrix takes 
+// part in matrix expressions, so CMatrix M = F; copies it into a CMatrix. Element access is never checked.
+template <size_t N>
+class CFixedMatrix : public CMatrixExpression<CFixedMatrix<N> > {
+public:
+    typedef array<complex<float>, N * N> CEntries;
+
+    constexpr CFixedMatrix() : m_arrEntries() {};
+    constexpr CFixedMatrix(const CEntries &inEntries) : m_arrEntries(inEntries) {};
+    explicit CFixedMatrix(const CMatrix &inMatrix) : m_arrEntries() {
+        CheckExpressionSizes(N, N, inMatrix.GetRowSize(), inMatrix.GetColSize(), "convert to a fixed size matrix");
+        for ( size_t r = 0; r < N; r++ )
+            for ( size_t c = 0; c < N; c++ )
+                m_arrEntries[r * N + c] = inMatrix(r, c);
+    };
+    static constexpr CFixedMatrix Identity() { return Generate(IdentityEntry(), make_index_sequence<N * N>()); };
+
+    constexpr complex<float> operator()(const size_t inRowIndex, const size_t inColIndex) const { return m_arrEntries[inRowIndex * N + inColIndex]; };
+    constexpr complex<float> &operator()(const size_t inRowIndex, const size_t inColIndex) { return m_arrEntries[inRowIndex * N + inColIndex]; };
+    constexpr const CEntries &Data() const { return m_arrEntries; };
+
+    constexpr CFixedMatrix operator*(const CFixedMatrix &inMatrix2) const { return Generate(ProductEntry{*this, inMatrix2}, make_index_sequence<N * N>()); };
+    constexpr CFixedMatrix operator+(const CFixedMatrix &inMatrix2) const { return Generate(SumEntry{*this, inMatrix2, 1}, make_index_sequence<N * N>()); };
+    constexpr CFixedMatrix operator-(const CFixedMatrix &inMatrix2) const { return Generate(SumEntry{*this, inMatrix2, -1}, make_index_sequence<N * N>()); };
+    constexpr CFixedMatrix operator*(const complex<float> &inZ) const { return Generate(ScaledEntry{*this, inZ}, make_index_sequence<N * N>()); };
+    friend constexpr CFixedMatrix operator*(const complex<float> &inZ, const CFixedMatrix &inMatrix) { return inMatrix * inZ; };
+    constexpr CFixedMatrix Adjoint() const { return Generate(AdjointEntry{*this}, make_index_sequence<N * N>()); };
+    constexpr complex<float> Trace() const { return TraceOf(make_index_sequence<N>()); };
+    constexpr bool operator==(const CFixedMatrix &inMatrix2) const { return IsEqualTo(inMatrix2, make_index_sequence<N * N>()); };
+    constexpr bool operator!=(const CFixedMatrix &inMatrix2) const { return !(*this == inMatrix2); };
+
+    // Expression Template Interface
+    //-------------------------------------
+    constexpr size_t GetRowSize() const { return N; };
+    constexpr size_t GetColSize() const { return N; };
+    constexpr complex<float> EntryAt(const size_t inRowIndex, const size_t inColIndex) const { return m_arrEntries[inRowIndex * N + inColIndex]; };
+    constexpr bool IsSafeToAssignTo(const CMatrix *, const bool) const { return true; };
+
+private:
+    // std::complex arithmetic is only constexpr from C++20, so the kernels work on real and imaginary parts.
+    static constexpr complex<float> MultiplyEntries(const complex<float> &inZ1, const complex<float> &inZ2) {
+        return complex<float>(inZ1.real() * inZ2.real() - inZ1.imag() * inZ2.imag(), inZ1.real() * inZ2.imag() + inZ1.imag() * inZ2.real());
+    };
+
+    // Entry i of the result, row i / N and column i % N, for every i at once.
+    template <class F, size_t... I>
+    static constexpr CFixedMatrix Generate(const F &inEntry, index_sequence<I...>) { return CFixedMatrix(CEntries{{ inEntry(I / N, I % N)... }}); };
+
+    struct IdentityEntry {
+        constexpr complex<float> operator()(const size_t inRowIndex, const size_t inColIndex) const { return complex<float>(inRowIndex == inColIndex ? 1.0f : 0.0f, 0); };
+    };
+    struct ProductEntry {
+        const CFixedMatrix &m_fmLeft;
+        const CFixedMatrix &m_fmRight;
+        constexpr complex<float> operator()(const size_t inRowIndex, const size_t inColIndex) const { 
+            return DotProduct(inRowIndex, inColIndex, make_index_sequence<N>()); 
+        };
+        // Terms are added left to right, as in the GEMM kernels.
+        template <size_t... S>
+        constexpr complex<float> DotProduct(const size_t inRowIndex, const size_t inColIndex, index_sequence<S...>) const {
+            return complex<float>((0.0f + ... + MultiplyEntries(m_fmLeft(inRowIndex, S), m_fmRight(S, inColIndex)).real()), 
+                                  (0.0f + ... + MultiplyEntries(m_fmLeft(inRowIndex, S), m_fmRight(S, inColIndex)).imag()));
+        };
+    };
+    struct SumEntry {
+        const CFixedMatrix &m_fmLeft;
+        const CFixedMatrix &m_fmRight;
+        float m_fSign;
+        constexpr complex<float> operator()(const size_t inRowIndex, const size_t inColIndex) const { 
+            return complex<float>(m_fmLeft(inRowIndex, inColIndex).real() + m_fSign * m_fmRight(inRowIndex, inColIndex).real(), 
+                                  m_fmLeft(inRowIndex, inColIndex).imag() + m_fSign * m_fmRight(inRowIndex, inColIndex).imag()); 
+        };
+    };
+    struct ScaledEntry {
+        const CFixedMatrix &m_fmMatrix;
+        complex<float> m_cxZ;
+        constexpr complex<float> operator()(const size_t inRowIndex, const size_t inColIndex) const { return MultiplyEntries(m_cxZ, m_fmMatrix(inRowIndex, inColIndex)); };
+    };
+    struct AdjointEntry {
+        const CFixedMatrix &m_fmMatrix;
+        constexpr complex<float> operator()(const size_t inRowIndex, const size_t inColIndex) const { 
+            return complex<float>(m_fmMatrix(inColIndex, inRowIndex).real(), -m_fmMatrix(inColIndex, inRowIndex).imag()); 
+        };
+    };
+
+    template <size_t... D>
+    constexpr complex<float> TraceOf(index_sequence<D...>) const { 
+        return complex<float>((0.0f + ... + m_arrEntries[D * N + D].real()), (0.0f + ... + m_arrEntries[D * N + D].imag())); 
+    };
+    template <size_t... I>
+    constexpr bool IsEqualTo(const CFixedMatrix &inMatrix2, index_sequence<I...>) const { 
+        return (true && ... && (m_arrEntries[I].real() == inMatrix2.m_arrEntries[I].real() && m_arrEntries[I].imag() == inMatrix2.m_arrEntries[I].imag())); 
+    };
+
+    CEntries m_arrEntries;
+};
+typedef CFixedMatrix<2> CFixedMatrix2;   // One qubit.
+typedef CFixedMatrix<4> CFixedMatrix4;   // Two qubits.
+typedef CFixedMatrix<8> CFixedMatrix8;   // Three qubits.
+template <size_t N> struct CExpressionOperand<CFixedMatrix<N> > { typedef const CFixedMatrix<N> &type; };
+
+
+// Real and wide types behind a scalar type T of CDenseMatrix. Sums run in the wide type, 
+// double or complex<double>, so a real scalar never picks up an imaginary part.
+template <class T> struct CScalarTraits { 
+    typedef T RealType; 
+    typedef double WideType; 
+    static const bool IS_COMPLEX = false; 
+};
+template <class T> struct CScalarTraits<complex<T> > { 
+    typedef T RealType; 
+    typedef complex<double> WideType; 
+    static const bool IS_COMPLEX = true; 
+};
+
+// Dense row major matrix of any of the scalar types float, double, complex<float> and complex<double>. 
+// CMatrix is the complex<float> matrix with the SIMD kernels, both layouts and the expression templates. 
+// CDenseMatrix trades those for a choice of precision: complex<double> keeps large Pauli decompositions and 
+// Hamiltonian sums accurate, while float and double store no imaginary parts and do no imaginary arithmetic, 
+// which halves the memory traffic of real symmetric workloads. Members are defined in Pauli_Matrix_Library.cc 
+// and explicitly instantiated for the four scalar types.
+template <class T>
+class CDenseMatrix {
+public:
+    typedef typename CScalarTraits<T>::RealType RealType;
+
+    CDenseMatrix(const size_t inRowSize=0, const size_t inColSize=0);
+    explicit CDenseMatrix(const CMatrix &inMatrix);
+    template <class U> explicit CDenseMatrix(const CDenseMatrix<U> &inMatrix) : CDenseMatrix(inMatrix.GetRowSize(), inMatrix.GetColSize()) {
+        // Only widening conversions compile: complex entries never silently lose their imaginary parts, 
+        // and double entries are never rounded to float.
+        static_assert(CScalarTraits<T>::IS_COMPLEX || !CScalarTraits<U>::IS_COMPLEX, "CDenseMatrix cannot convert complex entries to real ones.");
+        static_assert(sizeof(RealType) >= sizeof(typename CScalarTraits<U>::RealType), "CDenseMatrix cannot convert double entries to float.");
+        for ( size_t i = 0; i < m_vecEntries.size(); i++ )
+            m_vecEntries[i] = T(inMatrix.Data()[i]);
+    };
+    CMatrix ToMatrix() const;
+
+    size_t GetRowSize() const { return m_iRowSize; };
+    size_t GetColSize() const { return m_iColSize; };
+    void Resize(const size_t inRowSize, const size_t inColSize);
+    T &operator()(const size_t inRowIndex, const size_t inColIndex) { 
+        CheckIndexRange(inRowIndex, inColIndex, m_iRowSize, m_iColSize);
+        return m_vecEntries[inRowIndex * m_iColSize + inColIndex]; 
+    };
+    const T &operator()(const size_t inRowIndex, const size_t inColIndex) const { 
+        CheckIndexRange(inRowIndex, inColIndex, m_iRowSize, m_iColSize);
+        return m_vecEntries[inRowIndex * m_iColSize + inColIndex]; 
+    };
+    CSpan<T> Data()             { return CSpan<T>(m_vecEntries.data(), m_vecEntries.size()); };
+    CSpan<const T> Data() const { return CSpan<const T>(m_vecEntries.data(), m_vecEntries.size()); };
+
+    CDenseMatrix operator+(const CDenseMatrix &inMatrix2) const;
+    CDenseMatrix operator-(const CDenseMatrix &inMatrix2) const;
+    CDenseMatrix operator*(const CDenseMatrix &inMatrix2) const;
+    CDenseMatrix operator*(const T &inZ) const;
+    CDenseMatrix Adjoint() const;
+    T Trace() const;
+    RealType FrobeniusNorm() const;
+
+    // Pauli decomposition and composition of 2^n x 2^n matrices, ordered as in CMatrix::PauliCoefficients().
+    vector<complex<RealType> > PauliCoefficients() const;
+    vector<RealType> PauliDecomposition() const;
+    static CDenseMatrix ComposePauliCoefficients(const vector<complex<RealType> > &inCoefficients);
+    static CDenseMatrix ComposeHermitian(const vector<RealType> &inRealConst);
+    static CDenseMatrix ComposePauliSum(const CPauliSum &inPauliSum);
+
+private:
+    size_t m_iRowSize;
+    size_t m_iColSize;
+    vector<T, CAlignedAllocator<T> > m_vecEntries;
+};
+template <class T> void MultiplyInto(CDenseMatrix<T> &outMatrix, const CDenseMatrix<T> &inMatrix1, const CDenseMatrix<T> &inMatrix2);
+
+
+
+// Single Qubit Pauli Products. Pauli matrices are indexed I = 0, X = 1, Y = 2, Z = 3, and 
+// PAULI_PRODUCT_TABLE[a][b] = { c, k } means P_a P_b = i^k P_c. For Example: XY = iZ is PAULI_PRODUCT_TABLE[1][2] = { 3, 1 }.
+struct CPauliProduct {
+    unsigned short int m_iPauliIndex;     // One of the following: { 0, 1, 2, 3 } for { I, X, Y, Z }
+    unsigned short int m_iPhaseExponent;  // Phase is i^k where k is one of the following: { 0, 1, 2, 3 }
+};
+constexpr char PAULI_CHARS[4] = { 'I', 'X', 'Y', 'Z' };
+constexpr CPauliProduct PAULI_PRODUCT_TABLE[4][4] = {
+    //     I         X         Y         Z
+    { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 } },  // I
+    { { 1, 0 }, { 0, 0 }, { 3, 1 }, { 2, 3 } },  // X
+    { { 2, 0 }, { 3, 3 }, { 0, 0 }, { 1, 1 } },  // Y
+    { { 3, 0 }, { 2, 1 }, { 1, 3 }, { 0, 0 } }   // Z
+};
+constexpr complex<float> PAULI_PHASES[4] = { complex<float>(1, 0), complex<float>(0, 1), complex<float>(-1, 0), complex<float>(0, -1) };
+
+// Index of a Pauli character, or -1 when it is not one of the following: { 'I', 'X', 'Y', 'Z' }. Not case sensitive.
+constexpr int PauliCharToIndex(const char inPauliChar) 
+{
+    switch (inPauliChar) {
+        case 'I': case 'i': return 0;
+        case 'X': case 'x': return 1;
+        case 'Y': case 'y': return 2;
+        case 'Z': case 'z': return 3;
+        default:            return -1;
+    }
+}
 
 class CPauliMatrix : public CMatrix {
 public:
@@ -58,13 +1082,18 @@ public:
     //-------------------------------------
     CPauliMatrix();
     CPauliMatrix(string inPauliID);
-    CPauliMatrix(unsigned short int inRowSize, unsigned short int inColSize);
+    CPauliMatrix(size_t inRowSize, size_t inColSize);
+    CPauliMatrix(const CPauliMatrix &inPauli2) = default;
+    CPauliMatrix(CPauliMatrix &&inPauli2) = default;
+    CPauliMatrix &operator=(const CPauliMatrix &inPauli2) = default;
+    CPauliMatrix &operator=(CPauliMatrix &&inPauli2) = default;
 
     // Derived Class Methods
     //-------------------------------------
     string PauliToString() const;
     CPauliMatrix operator*(const CPauliMatrix &inPauli2) const;
-    void operator*(const complex<float> inPhi);
+    CPauliMatrix operator*(const complex<float> inPhi) const;
+    CPauliMatrix &operator*=(const complex<float> inPhi);
 
 protected:
     // Derived Class Data Members    // For Example: XY = iZ This gives m_cxPauliFactor = i and m_sPauliString = "Z", 
@@ -88,15 +1117,23 @@ public:
     // Derived Derived Class Constructors
     //-------------------------------------
     CPauliAlgebraElement(string inPauliID);
-    CPauliAlgebraElement(unsigned short int inRowSize, unsigned short int inColSize);
+    CPauliAlgebraElement(size_t inRowSize, size_t inColSize);
+    CPauliAlgebraElement(const CPauliAlgebraElement &inPAElement2) = default;
+    CPauliAlgebraElement(CPauliAlgebraElement &&inPAElement2) = default;
+    CPauliAlgebraElement &operator=(const CPauliAlgebraElement &inPAElement2) = default;
+    CPauliAlgebraElement &operator=(CPauliAlgebraElement &&inPAElement2) = default;
     
     // Derived Derived Class Methods
     //-------------------------------------
     string PauliAlgebraElementToString() const;
     CPauliAlgebraElement operator*(const CPauliAlgebraElement &inPAElement2) const; // For MakePauliAlgebraElement()
-    void operator*(const complex<float> &inZ);                                      // For MultiplyPauliAlgebraByScalar()
+    CPauliAlgebraElement operator*(const complex<float> &inZ) const;
+    CPauliAlgebraElement &operator*=(const complex<float> &inZ);                    // For MultiplyPauliAlgebraByScalar()
     CPauliAlgebraElement operator+(const CPauliAlgebraElement &inPAElement2) const; // For AddPauliAlgebra()
     CPauliAlgebraElement operator%(const CPauliAlgebraElement &inPAElement2) const; // For MultiplyPauliAlgebra()
+    friend CPauliAlgebraElement MakePauliAlgebraElement(string inPauliGroupString);
+    friend void AddPauliAlgebraInto(CPauliAlgebraElement &outPAElement, const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2);
+    friend void MultiplyPauliAlgebraInto(CPauliAlgebraElement &outPAElement, const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2);
 
 private:
     // Derived Derived Class Data Members  // For Example: -iX @ Y @ Z  This gives pauli_element_phase = -i and pauli_element_string = "X @ Y @ Z"
@@ -109,13 +1146,284 @@ void GetPauliString(const string &inPauliChar1, const string &inPauliChar2, comp
 CPauliAlgebraElement MakePauliAlgebraElement(string inPauliGroupString);
 void MultiplyPauliAlgebraByScalar(const complex<float> &inZ, CPauliAlgebraElement &inPAElement);
 CPauliAlgebraElement AddPauliAlgebra(const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2);
+void AddPauliAlgebraInto(CPauliAlgebraElement &outPAElement, const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2);
 CPauliAlgebraElement MultiplyPauliAlgebra(const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2);
+void MultiplyPauliAlgebraInto(CPauliAlgebraElement &outPAElement, const CPauliAlgebraElement &inPAElement1, const CPauliAlgebraElement &inPAElement2);
 void TestConstructPauliElement( const complex<float> &inZ, const string inPauliGroupString );
 void TestAddPauliAlgebra( const complex<float> &inZ1, const string &inPAString1, const complex<float> &inZ2, const string &inPAString2);
 void TestMultiplyPauliAlgebra( const complex<float> &z1, const string &p1_algebra_string, const complex<float> &z2, const string &p2_algebra_string );
 
+// Compile Time Pauli String of at most 64 qubits. For Example: "XIZY"_pauli
+// The bits are packed as in the first word of a CPauliString, bit q of each word belongs to qubit q, the q-th character. 
+// The _pauli literal is parsed and validated by the compiler, so "XQZ"_pauli does not build and the packed 
+// words are constants in the generated code. A CPauliLiteral converts to a CPauliString without reading any characters.
+class CPauliLiteral {
+public:
+    // Pauli Literal Constructors
+    //-------------------------------------
+    constexpr CPauliLiteral() : m_iXWord(0), m_iZWord(0), m_iNumOfQubits(0), m_iPhaseExponent(0) {};
+    constexpr CPauliLiteral(const uint64_t inXWord, const uint64_t inZWord, const size_t inNumOfQubits, const unsigned short int inPhaseExponent=0) 
+        : m_iXWord(inXWord), m_iZWord(inZWord), m_iNumOfQubits(inNumOfQubits), m_iPhaseExponent(inPhaseExponent & 3) {};
+
+    // Pauli Literal Methods
+    //-------------------------------------
+    constexpr uint64_t GetXWord() const                 { return m_iXWord; };
+    constexpr uint64_t GetZWord() const                 { return m_iZWord; };
+    constexpr size_t GetNumOfQubits() const             { return m_iNumOfQubits; };
+    constexpr unsigned short int GetPhaseExponent() const { return m_iPhaseExponent; };
+    constexpr int GetPauliIndexAt(const size_t inQubitIndex) const {
+        const int m_iXBit = int((m_iXWord >> inQubitIndex) & 1);
+        const int m_iZBit = int((m_iZWord >> inQubitIndex) & 1);
+        return m_iXBit ? 1 + m_iZBit : 3 * m_iZBit;
+    };
+    constexpr char GetPauliAt(const size_t inQubitIndex) const { return PAULI_CHARS[GetPauliIndexAt(inQubitIndex)]; };
+    constexpr bool operator==(const CPauliLiteral &inPauli2) const { 
+        return m_iXWord == inPauli2.m_iXWord && m_iZWord == inPauli2.m_iZWord && 
+               m_iNumOfQubits == inPauli2.m_iNumOfQubits && m_iPhaseExponent == inPauli2.m_iPhaseExponent; 
+    };
+    constexpr bool operator!=(const CPauliLiteral &inPauli2) const { return !(*this == inPauli2); };
+
+    // Qubit by qubit product through PAULI_PRODUCT_TABLE. The shorter literal acts as the identity on the extra qubits.
+    constexpr CPauliLiteral operator*(const CPauliLiteral &inPauli2) const {
+        const size_t m_iNumOfQubits3 = m_iNumOfQubits > inPauli2.m_iNumOfQubits ? m_iNumOfQubits : inPauli2.m_iNumOfQubits;
+        uint64_t m_iXWord3 = 0;
+        uint64_t m_iZWord3 = 0;
+        unsigned short int m_iPhaseExponent3 = m_iPhaseExponent + inPauli2.m_iPhaseExponent;
+        for ( size_t q = 0; q < m_iNumOfQubits3; q++ ) {
+            const CPauliProduct m_ppProduct = PAULI_PRODUCT_TABLE[GetPauliIndexAt(q)][inPauli2.GetPauliIndexAt(q)];
+            m_iXWord3 |= uint64_t(m_ppProduct.m_iPauliIndex == 1 || m_ppProduct.m_iPauliIndex == 2) << q;
+            m_iZWord3 |= uint64_t(m_ppProduct.m_iPauliIndex >= 2) << q;
+            m_iPhaseExponent3 += m_ppProduct.m_iPhaseExponent;
+        }
+        return CPauliLiteral(m_iXWord3, m_iZWord3, m_iNumOfQubits3, m_iPhaseExponent3);
+    };
+
+    // Packs validated characters. Called by the _pauli literal.
+    template <size_t N>
+    static constexpr CPauliLiteral FromPauliChars(const char (&inPauliChars)[N]) {
+        uint64_t m_iXWord = 0;
+        uint64_t m_iZWord = 0;
+        for ( size_t q = 0; q < N; q++ ) {
+            const int m_iPauliIndex = PauliCharToIndex(inPauliChars[q]);
+            m_iXWord |= uint64_t(m_iPauliIndex == 1 || m_iPauliIndex == 2) << q;
+            m_iZWord |= uint64_t(m_iPauliIndex >= 2) << q;
+        }
+        return CPauliLiteral(m_iXWord, m_iZWord, N);
+    };
+
+private:
+    // Pauli Literal Data Members
+    //-------------------------------------
+    uint64_t m_iXWord;
+    uint64_t m_iZWord;
+    size_t m_iNumOfQubits;
+    unsigned short int m_iPhaseExponent; // Phase is i^k where k is one of the following: { 0, 1, 2, 3 }
+};
+
+// "XIZY"_pauli is a CPauliLiteral. Uses the GNU string literal operator template, so every character is a 
+// template argument and a character other than I, X, Y or Z fails the static_assert at compile time.
+template <class CharT, CharT... inPauliChars>
+constexpr CPauliLiteral operator""_pauli()
+{
+    static_assert(sizeof...(inPauliChars) >= 1 && sizeof...(inPauliChars) <= 64, "A _pauli literal must have 1 to 64 Pauli characters.");
+    static_assert(((PauliCharToIndex(char(inPauliChars)) >= 0) && ...), "A _pauli literal may only contain the following Pauli characters: { I, X, Y, Z }");
+    constexpr char m_arrcPauliChars[] = { char(inPauliChars)... };
+    return CPauliLiteral::FromPauliChars(m_arrcPauliChars);
+}
+
+// Bit-packed Pauli String. For Example: -i(X @ Y @ Z) 
+// Qubit q is the q-th character of the string "XYZ". Each qubit is stored as one X bit and one Z bit
+// packed 64 qubits per word:  I = (0, 0),  X = (1, 0),  Z = (0, 1),  Y = (1, 1). 
+// The represented operator is i^k * P_0 @ P_1 @ ... @ P_(n-1) where k = m_iPhaseExponent.
+class CPauliString {
+public:
+    // Pauli String Constructors
+    //-------------------------------------
+    CPauliString();
+    CPauliString(size_t inNumOfQubits);
+    CPauliString(string inPauliGroupString);
+    CPauliString(const CPauliLiteral &inPauliLiteral);
+
+    // Pauli String Methods
+    //-------------------------------------
+    size_t GetNumOfQubits() const                 { return m_iNumOfQubits; };
+    size_t GetNumOfWords() const                  { return m_vecXWords.size(); };
+    const vector<uint64_t>& GetXWords() const     { return m_vecXWords; };
+    const vector<uint64_t>& GetZWords() const     { return m_vecZWords; };
+    unsigned short int GetPhaseExponent() const   { return m_iPhaseExponent; };
+    void SetPhaseExponent(const unsigned short int inPhaseExponent) { m_iPhaseExponent = inPhaseExponent & 3; };
+    complex<float> GetPhase() const;
+    char GetPauliAt(const size_t inQubitIndex) const;
+    void SetPauliAt(const size_t inQubitIndex, const char inPauliChar);
+    size_t Weight() const;
+    bool CommutesWith(const CPauliString &inPauli2) const;
+    bool operator==(const CPauliString &inPauli2) const;
+    bool operator!=(const CPauliString &inPauli2) const { return !(*this == inPauli2); };
+    CPauliString operator*(const CPauliString &inPauli2) const;
+    void operator*=(const CPauliString &inPauli2);
+    uint64_t GetXMask() const;  // Bit n - 1 - q is the X bit of qubit q. Only for n <= 64.
+    uint64_t GetZMask() const;  // Bit n - 1 - q is the Z bit of qubit q. Only for n <= 64.
+    string PauliStringToString() const;
+    CPauliAlgebraElement ToPauliAlgebraElement() const; // Dense 2^n x 2^n matrix. Only for small n.
+
+private:
+    // Pauli String Data Members
+    //-------------------------------------
+    vector<uint64_t> m_vecXWords;        // Bit q % 64 of word q / 64 is the X bit of qubit q.
+    vector<uint64_t> m_vecZWords;        // Bit q % 64 of word q / 64 is the Z bit of qubit q.
+    size_t m_iNumOfQubits;
+    unsigned short int m_iPhaseExponent; // Phase is i^k where k is one of the following: { 0, 1, 2, 3 }
+};
+CPauliString MultiplyPauliString(const CPauliString &inPauli1, const CPauliString &inPauli2);
+bool PauliStringsCommute(const CPauliString &inPauli1, const CPauliString &inPauli2);
+void TestMultiplyPauliString(const string &inPauliString1, const string &inPauliString2);
+void TestPauliStringScaling(const size_t inNumOfQubits=1000, const unsigned short int inNumOfTests=10);
+void ApplyPauliString(vector<complex<float>> &ioState, const CPauliString &inPauli);
+void ApplyPauliString(const vector<complex<float>> &inState, const CPauliString &inPauli, vector<complex<float>> &outState);
+void LeftMultiplyPauli(CMatrix &ioMatrix, const CPauliString &inPauli);
+void RightMultiplyPauli(CMatrix &ioMatrix, const CPauliString &inPauli);
+complex<float> TraceWithPauli(const CMatrix &inMatrix, const CPauliString &inPauli);
+vector<complex<float>> ExpectationValues(const vector<complex<float>> &inState, const vector<CPauliString> &inPauliStrings);
+vector<complex<float>> ExpectationValues(const vector<complex<float>> &inState, const CPauliSum &inPauliSum);
+complex<float> ExpectationValue(const vector<complex<float>> &inState, const CPauliSum &inPauliSum);
+void TestApplyPauliString(const unsigned short int inNumOfQubits=6, const unsigned short int inNumOfTests=10, const unsigned short int inLargeNumOfQubits=22);
+void TestExpectationValues(const unsigned short int inNumOfQubits=12, const size_t inNumOfTerms=2000);
+void TestMultiplyPauli(const unsigned short int inNumOfQubits=5, const unsigned short int inNumOfTests=20);
+void TestPauliLiterals(const unsigned short int inNumOfTests=20);
+
+// Factored Kronecker Operator. For Example: A_0 @ A_1 @ ... @ A_(k-1) with small CMatrix factors.
+// Only the factors are stored, so the operator may be far larger than any dense CMatrix. 
+// It is applied to a vector one factor at a time (mode products), in O(N * (d_0 + ... + d_(k-1))) work 
+// for a length N vector, instead of the O(N^2) of a dense matrix. Factors that are identities are skipped.
+// Products and traces are computed factor by factor. ToMatrix() is the only operation that densifies.
+class CKroneckerOperator {
+public:
+    // Kronecker Operator Constructors
+    //-------------------------------------
+    CKroneckerOperator();                                    // No factors, the 1 x 1 identity.
+    CKroneckerOperator(const vector<CMatrix> &inFactors);
+    CKroneckerOperator(const CPauliString &inPauli);         // One 2 x 2 factor per qubit. The phase goes to the first factor.
+
+    // Kronecker Operator Methods
+    //-------------------------------------
+    size_t GetNumOfFactors() const                           { return m_vecFactors.size(); };
+    const CMatrix &GetFactor(const size_t inFactorIndex) const { return m_vecFactors[inFactorIndex]; };
+    size_t GetRowSize() const                                { return m_iRowSize; };
+    size_t GetColSize() const                                { return m_iColSize; };
+    complex<float> Trace() const;
+    CKroneckerOperator operator*(const CKroneckerOperator &inOperator2) const;
+    vector<complex<float>> operator*(const vector<complex<float>> &inVector) const;
+    CMatrix ToMatrix() const;                                // Dense product. Must fit in MAX_SIDE_LENGTH x MAX_SIDE_LENGTH.
+
+    friend void MultiplyInto(vector<complex<float>> &outVector, const CKroneckerOperator &inOperator, const vector<complex<float>> &inVector);
+
+private:
+    // Kronecker Operator Data Members
+    //-------------------------------------
+    vector<CMatrix> m_vecFactors;
+    vector<bool> m_vecIsIdentity;       // Factor f is an identity matrix and is skipped when applied.
+    size_t m_iRowSize;                  // Product of the factor row sizes.
+    size_t m_iColSize;                  // Product of the factor column sizes.
+};
+void MultiplyInto(vector<complex<float>> &outVector, const CKroneckerOperator &inOperator, const vector<complex<float>> &inVector);
+void TestKroneckerOperator(const unsigned short int inNumOfTests=20, const unsigned short int inMaxNumOfFactors=5, const unsigned short int inLargeNumOfQubits=20);
+void BenchmarkKroneckerOperator(const vector<unsigned short int> &inNumOfQubits={8, 10, 12}, const unsigned short int inNumOfRepeats=3);
+
+// Monomial Matrix. For Example: i^k (X @ Y @ Z), or any other permutation matrix with phases.
+// Row r has exactly one stored entry, m_vecValues[r] in column m_vecColumns[r], so an N x N matrix 
+// takes O(N) memory instead of O(N^2). A Pauli String is monomial: row r of i^k P(x, z) has its entry 
+// in column r ^ x, so CMonomialMatrix(pauliString) is built in O(2^n) without a dense matrix.
+class CMonomialMatrix {
+public:
+    // Monomial Matrix Constructors
+    //-------------------------------------
+    CMonomialMatrix();                                   // 0 x 0
+    CMonomialMatrix(const size_t inSize);                // inSize x inSize identity
+    CMonomialMatrix(const vector<size_t> &inColumns, const vector<complex<float>> &inValues);
+    CMonomialMatrix(const CPauliString &inPauli);        // 2^n x 2^n, at most 62 qubits
+
+    // Monomial Matrix Methods
+    //-------------------------------------
+    size_t GetSize() const                               { return m_vecColumns.size(); };
+    size_t GetColumnOfRow(const size_t inRowIndex) const { return m_vecColumns[inRowIndex]; };
+    complex<float> GetValueOfRow(const size_t inRowIndex) const { return m_vecValues[inRowIndex]; };
+    complex<float> GetValueAt(const size_t inRowIndex, const size_t inColIndex) const {
+        return (m_vecColumns[inRowIndex] == inColIndex) ? m_vecValues[inRowIndex] : complex<float>(0, 0);
+    };
+    CMonomialMatrix operator*(const CMonomialMatrix &inMonomial2) const;
+    CMatrix operator*(const CMatrix &inMatrix) const;
+    vector<complex<float>> operator*(const vector<complex<float>> &inVector) const;
+    CMatrix ToMatrix(const EMatrixLayout inLayout=INTERLEAVED_LAYOUT) const; // GetSize() must be at most MAX_SIDE_LENGTH.
+    void ToCSR(vector<size_t> &outRowPointers, vector<size_t> &outColIndices, vector<complex<float>> &outValues) const;
+
+private:
+    // Monomial Matrix Data Members
+    //-------------------------------------
+    vector<size_t> m_vecColumns;         // Column of the entry in row r.
+    vector<complex<float>> m_vecValues;  // Value of the entry in row r. May be 0.
+};
+CMatrix operator*(const CMatrix &inMatrix, const CMonomialMatrix &inMonomial);
+void MultiplyInto(vector<complex<float>> &outVector, const CMonomialMatrix &inMonomial, const vector<complex<float>> &inVector);
+void MultiplyInto(CMatrix &outMatrix, const CMonomialMatrix &inMonomial, const CMatrix &inMatrix);
+void MultiplyInto(CMatrix &outMatrix, const CMatrix &inMatrix, const CMonomialMatrix &inMonomial);
+void TestMonomialMatrix(const unsigned short int inNumOfQubits=6, const unsigned short int inNumOfTests=10, const unsigned short int inLargeNumOfQubits=20);
+
+// Sum of Pauli Strings with complex coefficients. For Example: 0.5(X @ X) + 0.5(Y @ Y) - (Z @ I)
+// Terms are kept in insertion order in flat arrays. A flat open addressing hash table 
+// keyed on the packed X and Z words maps each Pauli String to its term, so like terms merge in O(1).
+class CPauliSum {
+public:
+    // Pauli Sum Constructors
+    //-------------------------------------
+    CPauliSum();
+    CPauliSum(size_t inNumOfQubits);
+    CPauliSum(const vector<CPauliString> &inPauliStrings, const vector<complex<float>> &inCoefficients);
+    CPauliSum(size_t inNumOfQubits, const vector<uint64_t> &inXWords, const vector<uint64_t> &inZWords, const vector<complex<float>> &inCoefficients);
+
+    // Pauli Sum Methods
+    //-------------------------------------
+    size_t GetNumOfQubits() const                              { return m_iNumOfQubits; };
+    size_t GetNumOfWords() const                               { return m_iNumOfWords; };
+    size_t GetNumOfTerms() const                               { return m_vecCoefficients.size(); };
+    const uint64_t* GetXWordsAt(const size_t inTermIndex) const { return &m_vecTermWords[2 * inTermIndex * m_iNumOfWords]; };
+    const uint64_t* GetZWordsAt(const size_t inTermIndex) const { return &m_vecTermWords[(2 * inTermIndex + 1) * m_iNumOfWords]; };
+    complex<float> GetCoefficientAt(const size_t inTermIndex) const { return m_vecCoefficients[inTermIndex]; };
+    CPauliString GetPauliStringAt(const size_t inTermIndex) const;
+    complex<float> GetCoefficient(const CPauliString &inPauli) const;
+    void Reserve(const size_t inNumOfTerms);
+    void AddTerm(const CPauliString &inPauli, const complex<float> inCoefficient);
+    void RemoveZeroTerms(const float inTolerance=0);
+    CPauliSum operator+(const CPauliSum &inPauliSum2) const;
+    CPauliSum operator-(const CPauliSum &inPauliSum2) const;
+    CPauliSum operator*(const complex<float> &inZ) const;
+    void operator+=(const CPauliSum &inPauliSum2);
+    void operator-=(const CPauliSum &inPauliSum2);
+    void operator*=(const complex<float> &inZ);
+    string PauliSumToString() const;
+
+private:
+    // Pauli Sum Helper Methods
+    //-------------------------------------
+    void AddPackedTerm(const uint64_t *inXWords, const uint64_t *inZWords, const complex<float> inCoefficient);
+    size_t FindSlot(const uint64_t *inXWords, const uint64_t *inZWords, const uint64_t inHash) const;
+    void Rehash(const size_t inNumOfSlots);
+
+    // Pauli Sum Data Members
+    //-------------------------------------
+    size_t m_iNumOfQubits;
+    size_t m_iNumOfWords;                     // Words per X (or Z) half of a key.
+    vector<uint64_t> m_vecTermWords;          // Term t owns words [2 t W, 2 (t + 1) W): X words then Z words.
+    vector<complex<float>> m_vecCoefficients; // Coefficient of term t. Phases of added Pauli Strings are folded in.
+    vector<uint64_t> m_vecTermHashes;         // Hash of term t, kept so rehashing never touches the words.
+    vector<size_t> m_vecSlots;                // Open addressing table of term indices. Power of 2 size. 
+};
+CPauliSum operator*(const complex<float> &inZ, const CPauliSum &inPauliSum);
+void TestPauliSum();
+void TestPauliSumMerging(const size_t inNumOfQubits=40, const size_t inNumOfTerms=100000);
+void TestPauliDecomposition(const unsigned short int inNumOfQubits=3, const unsigned short int inNumOfTests=5, const unsigned short int inBoundParam=10);
+
 CMatrix GenerateHermitianMatrix(const unsigned short int inBoundParam=10, unsigned short int inSideLength=0);
 void Goal1Test(unsigned short int inNumOfTests=10, unsigned short int inBoundParam=10, bool inWillPrintMatrix=false);
-void Goal2Test(unsigned short int inNumOfTests=10, unsigned short int inBoundParam=10, unsigned short int inSideLength=2);
+void Goal2Test(unsigned short int inNumOfTests=10, unsigned short int inBoundParam=10, unsigned short int inSideLength=2, bool inWillPrintMatrix=true);
 
 #endif
\ No newline at end of file
@@ -2,7 +2,7 @@
 *          Author: Daniel Mendez
 *            Date: 11/01/2022
 *         Purpose: Driver code to test Pauli Matrix functions. 
-* Compile Command: g++  -g  -std=gnu++11  -Wall  -Werror  Test_PM_Library.cc  Pauli_Matrix_Library.cc -o  Test_PM_Library
+* Compile Command: g++  -g  -std=gnu++17  -Wall  -Werror  Test_PM_Library.cc  Pauli_Matrix_Library.cc -o  Test_PM_Library
 *     Run Command: ./Test_PM_Library
 *************************************/
 #include "Pauli_Matrix_Library.h"
@@ -78,5 +78,192 @@ int main(void) {
     // const complex<float> z4 = complex<float>(-1, 0);
     // TestMultiplyPauliAlgebra(z3, p3_algebra_string, z4, p4_algebra_string);
 
+
+    cout << "\n*************************** Goal 5: Bit-Packed Pauli Strings ***************************" << endl;
+    // TEST 10
+    // cout << "TESTING: Pauli String Multiplication and Commutation." << endl;
+    // const string p5_string = "XYZI";
+    // const string p6_string = "ZYXX";
+    // TestMultiplyPauliString(p5_string, p6_string);
+
+
+    // TEST 11
+    // cout << "TESTING: Pauli String Multiplication on many qubits." << endl;
+    // const size_t num_of_qubits = 1000;
+    // const unsigned short int num_of_string_tests = 10;
+    // TestPauliStringScaling(num_of_qubits, num_of_string_tests);
+
+
+    // TEST 12
+    // cout << "TESTING: Pauli Sum Addition, Subtraction and Scalar Multiplication." << endl;
+    // TestPauliSum();
+
+
+    // TEST 13
+    // cout << "TESTING: Pauli Sum like term merging with many terms." << endl;
+    // const size_t sum_num_of_qubits = 40;
+    // const size_t sum_num_of_terms = 100000;
+    // TestPauliSumMerging(sum_num_of_qubits, sum_num_of_terms);
+
+
+    cout << "\n*************************** Goal 6: Fast Pauli Decomposition for Multiple Qubits ***************************" << endl;
+    // TEST 14
+    // cout << "TESTING: Fast Pauli Decomposition of 2^n x 2^n matrices." << endl;
+    // const unsigned short int decomp_num_of_qubits = 3;
+    // const unsigned short int decomp_num_of_tests = 5;
+    // const unsigned short int decomp_matrix_entry_bound = 10;
+    // TestPauliDecomposition(decomp_num_of_qubits, decomp_num_of_tests, decomp_matrix_entry_bound);
+
+
+    // TEST 15
+    // cout << "TESTING: Decompose then Compose a 10 qubit Hermitian Matrix." << endl;
+    // const unsigned short int goal2_large_num_of_tests = 2;
+    // const unsigned short int goal2_large_matrix_entry_bound = 15;
+    // const unsigned short int goal2_large_side_length = 1024;
+    // const bool goal2_large_print_matrix = false;
+    // Goal2Test(goal2_large_num_of_tests, goal2_large_matrix_entry_bound, goal2_large_side_length, goal2_large_print_matrix);
+
+
+    cout << "\n*************************** Goal 7: Pauli Strings acting on State Vectors ***************************" << endl;
+    // TEST 16
+    // cout << "TESTING: Apply Pauli Strings to State Vectors without building their matrices." << endl;
+    // const unsigned short int state_num_of_qubits = 6;
+    // const unsigned short int state_num_of_tests = 10;
+    // const unsigned short int state_large_num_of_qubits = 22;
+    // TestApplyPauliString(state_num_of_qubits, state_num_of_tests, state_large_num_of_qubits);
+
+
+    // TEST 17
+    // cout << "TESTING: Batched Pauli String expectation values." << endl;
+    // const unsigned short int expectation_num_of_qubits = 12;
+    // const size_t expectation_num_of_terms = 2000;
+    // TestExpectationValues(expectation_num_of_qubits, expectation_num_of_terms);
+
+
+    cout << "\n*************************** Goal 8: Fast Matrix Multiplication ***************************" << endl;
+    // TEST 18
+    // cout << "TESTING: Cache blocked matrix multiplication against the reference triple loop." << endl;
+    // const unsigned short int matmul_num_of_tests = 10;
+    // const unsigned short int matmul_max_side_length = 150;
+    // TestMatrixMultiply(matmul_num_of_tests, matmul_max_side_length);
+
+
+    // TEST 19
+    // cout << "TESTING: Scalar, AVX2 and AVX-512 matrix kernels against reference loops." << endl;
+    // const unsigned short int simd_num_of_tests = 10;
+    // const unsigned short int simd_max_side_length = 100;
+    // TestSimdKernels(simd_num_of_tests, simd_max_side_length);
+
+
+    // TEST 20
+    // cout << "TESTING: Split real and imaginary plane layout against the interleaved layout." << endl;
+    // const unsigned short int split_num_of_tests = 10;
+    // const unsigned short int split_max_side_length = 100;
+    // TestSplitLayout(split_num_of_tests, split_max_side_length);
+
+
+    cout << "\n*************************** Goal 9: Lazy Matrix Expressions ***************************" << endl;
+    // TEST 21
+    // cout << "TESTING: Fused matrix expressions against explicit loops, including aliased assignments." << endl;
+    // const unsigned short int expression_num_of_tests = 10;
+    // const unsigned short int expression_max_side_length = 100;
+    // TestMatrixExpressions(expression_num_of_tests, expression_max_side_length);
+
+
+    cout << "\n*************************** Goal 10: Parallel Execution ***************************" << endl;
+    // TEST 22
+    // cout << "TESTING: Thread pool results against a single thread, bit for bit." << endl;
+    // const unsigned short int thread_pool_side_length = 300;
+    // TestThreadPool(thread_pool_side_length);
+
+
+    // TEST 23
+    // cout << "TESTING: n-ary Kronecker products and MakePauliAlgebraElement() against the definition." << endl;
+    // const unsigned short int kronecker_num_of_tests = 20;
+    // const unsigned short int kronecker_max_num_of_factors = 4;
+    // TestKroneckerProduct(kronecker_num_of_tests, kronecker_max_num_of_factors);
+
+
+    // TEST 24
+    // cout << "TESTING: Factored Kronecker operators against the dense Kronecker product." << endl;
+    // const unsigned short int kronecker_operator_num_of_tests = 20;
+    // const unsigned short int kronecker_operator_max_num_of_factors = 5;
+    // const unsigned short int kronecker_operator_large_num_of_qubits = 20;
+    // TestKroneckerOperator(kronecker_operator_num_of_tests, kronecker_operator_max_num_of_factors, kronecker_operator_large_num_of_qubits);
+
+
+    cout << "\n*************************** Goal 11: Structured Pauli Operators ***************************" << endl;
+    // TEST 25
+    // cout << "TESTING: Monomial matrices of Pauli Strings against the dense matrix." << endl;
+    // const unsigned short int monomial_num_of_qubits = 6;
+    // const unsigned short int monomial_num_of_tests = 10;
+    // const unsigned short int monomial_large_num_of_qubits = 20;
+    // TestMonomialMatrix(monomial_num_of_qubits, monomial_num_of_tests, monomial_large_num_of_qubits);
+
+
+    // TEST 26
+    // cout << "TESTING: In place multiplication by Pauli Strings and TraceWithPauli() against dense products." << endl;
+    // const unsigned short int multiply_pauli_num_of_qubits = 5;
+    // const unsigned short int multiply_pauli_num_of_tests = 20;
+    // TestMultiplyPauli(multiply_pauli_num_of_qubits, multiply_pauli_num_of_tests);
+
+
+    cout << "\n*************************** Goal 12: Fused Matrix Reductions ***************************" << endl;
+    // TEST 27
+    // cout << "TESTING: TraceOfProduct(), HilbertSchmidtInner() and FrobeniusNorm() against reference loops." << endl;
+    // const unsigned short int reduction_num_of_tests = 10;
+    // const unsigned short int reduction_max_side_length = 200;
+    // TestMatrixReductions(reduction_num_of_tests, reduction_max_side_length);
+
+    // TEST 28
+    // cout << "TESTING: operator(), Data() and Row, Column, Submatrix and Strided views against GetValueAt()." << endl;
+    // const unsigned short int view_num_of_tests = 20;
+    // const unsigned short int view_max_side_length = 60;
+    // TestMatrixViews(view_num_of_tests, view_max_side_length);
+
+    // TEST 29: Build with -DPML_COUNT_ALLOCATIONS, otherwise this test is skipped
+    // cout << "TESTING: Copies, moves, *Into functions and in place operators make no allocations once warmed up." << endl;
+    // const unsigned short int allocation_side_length = 64;
+    // const unsigned short int allocation_num_of_repeats = 10;
+    // TestSteadyStateAllocations(allocation_side_length, allocation_num_of_repeats);
+
+    // TEST 30
+    // cout << "TESTING: Large matrices are aligned, optionally on huge pages, and index every entry past 65535." << endl;
+    // const size_t storage_side_length = 1024;
+    // TestLargeMatrixStorage(storage_side_length);
+
+    // TEST 31
+    // cout << "TESTING: Rectangular products, adjoints and traces, and products of column major and overlapping views." << endl;
+    // const unsigned short int rectangular_num_of_tests = 10;
+    // const unsigned short int rectangular_max_side_length = 80;
+    // TestRectangularMatrices(rectangular_num_of_tests, rectangular_max_side_length);
+
+    // TEST 32
+    // cout << "TESTING: Unrolled 2 x 2, 4 x 4 and 8 x 8 fixed size matrix kernels and 2 x 2 Pauli products." << endl;
+    // const unsigned short int fixed_num_of_tests = 10;
+    // TestFixedMatrices(fixed_num_of_tests);
+
+    // TEST 33
+    // cout << "TESTING: CDenseMatrix in float, double, complex<float> and complex<double> against CMatrix." << endl;
+    // const unsigned short int dense_num_of_tests = 5;
+    // const unsigned short int dense_max_num_of_qubits = 7;
+    // TestDenseMatrices(dense_num_of_tests, dense_max_num_of_qubits);
+
+    // TEST 34
+    // cout << "TESTING: constexpr Pauli product table and compile time \"XIZY\"_pauli literals against Pauli matrices and Pauli Strings." << endl;
+    // const unsigned short int literal_num_of_tests = 20;
+    // TestPauliLiterals(literal_num_of_tests);
+
+    // TEST 35
+    // cout << "TESTING: Matrices of up to 16 entries are stored inline and small matrix and Pauli algebra operations do not allocate." << endl;
+    // const unsigned short int small_storage_num_of_repeats = 10;
+    // TestSmallMatrixStorage(small_storage_num_of_repeats);
+
+    // TEST 36
+    // cout << "TESTING: CMatrixArena and CMatrixPool give the same results as the default allocator and stop allocating once warmed up." << endl;
+    // const unsigned short int allocator_num_of_iterations = 20;
+    // const unsigned short int allocator_num_of_qubits = 4;
+    // TestMatrixAllocators(allocator_num_of_iterations, allocator_num_of_qubits);
+
     return 0;
 }
\ No newline at end of file